@@ -25,7 +25,7 @@ function(CompileHLSLShaders SHADER_FILES)
                 COMMAND ${DXC_COMPILER} -T vs_6_6 -E VSMain ${file} -Fo ${PROJECT_BINARY_DIR}/source/${dirname}/${name}VS.bin
                 COMMAND ${DXC_COMPILER} -T ps_6_6 -E PSMain ${file} -Fo ${PROJECT_BINARY_DIR}/source/${dirname}/${name}PS.bin
                 COMMENT "Compiling ${name} to HLSL binary object files"
-                DEPENDS ${file} ${directory})
+                DEPENDS ${file} ${directory} ${HLSL_HEADERS})
     endforeach ()
 
     add_custom_target(CompileHLSLShaders
@@ -0,0 +1,63 @@
+// Shader side of BindlessResources. Views are read from ResourceDescriptorHeap by the
+// index BindlessResources::Index() returns, and each draw passes its indices as root
+// constants in register b0. Constants written every frame are bound to register b1,
+// which FRAME_CONSTANTS declares.
+//
+// Declare the indices of a draw with DRAW_CONSTANTS, e.g.
+//
+//     struct MaterialIndices { uint Transform; uint Albedo; };
+//     DRAW_CONSTANTS(MaterialIndices, Draw);
+//
+// and read views with the helpers below. Indices that differ between lanes of a wave,
+// e.g. ones read from a buffer, must go through the NonUniform variants.
+
+#ifndef BINDLESS_HLSLI
+#define BINDLESS_HLSLI
+
+#define BINDLESS_INVALID_INDEX 0xFFFFFFFF
+
+#define DRAW_CONSTANTS(Type, Name) ConstantBuffer<Type> Name : register(b0, space0)
+#define FRAME_CONSTANTS(Type, Name) ConstantBuffer<Type> Name : register(b1, space0)
+
+Texture2D<float4> BindlessTexture2D(uint index)
+{
+    Texture2D<float4> texture = ResourceDescriptorHeap[index];
+    return texture;
+}
+
+Texture2D<float4> BindlessTexture2DNonUniform(uint index)
+{
+    Texture2D<float4> texture = ResourceDescriptorHeap[NonUniformResourceIndex(index)];
+    return texture;
+}
+
+TextureCube<float4> BindlessTextureCube(uint index)
+{
+    TextureCube<float4> texture = ResourceDescriptorHeap[index];
+    return texture;
+}
+
+ByteAddressBuffer BindlessByteAddressBuffer(uint index)
+{
+    ByteAddressBuffer buffer = ResourceDescriptorHeap[index];
+    return buffer;
+}
+
+RWByteAddressBuffer BindlessRWByteAddressBuffer(uint index)
+{
+    RWByteAddressBuffer buffer = ResourceDescriptorHeap[index];
+    return buffer;
+}
+
+RWTexture2D<float4> BindlessRWTexture2D(uint index)
+{
+    RWTexture2D<float4> texture = ResourceDescriptorHeap[index];
+    return texture;
+}
+
+// Constant and structured buffers are templated on the caller's struct, which functions
+// cannot return before HLSL 2021, so these declare a local instead.
+#define BINDLESS_CONSTANT_BUFFER(Type, Name, index) ConstantBuffer<Type> Name = ResourceDescriptorHeap[index]
+#define BINDLESS_STRUCTURED_BUFFER(Type, Name, index) StructuredBuffer<Type> Name = ResourceDescriptorHeap[index]
+
+#endif
@@ -1,4 +1,4 @@
-
+#include "../common/Bindless.hlsli"
 
 struct Transform
 {
@@ -7,9 +7,14 @@ struct Transform
     float Time;
 };
 
-ConstantBuffer<Transform> TransformData : register(b0);
+struct DrawIndices
+{
+    uint Texture;
+};
+
+DRAW_CONSTANTS(DrawIndices, Draw);
+FRAME_CONSTANTS(Transform, TransformData);
 SamplerState LinearSampler : register(s0);
-Texture2D gTexture : register(t0);
 
 
 struct VertexInput
@@ -40,7 +45,7 @@ VertexOutput VSMain(VertexInput input)
 
 float4 PSMain(VertexOutput input) : SV_Target
 {
-    float4 diffuse = gTexture.Sample(LinearSampler, input.TexCoord);
+    float4 diffuse = BindlessTexture2D(Draw.Texture).Sample(LinearSampler, input.TexCoord);
     //diffuse *= input.Color;
 
     return diffuse;
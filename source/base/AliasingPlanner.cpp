@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AliasingPlanner.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+    constexpr uint32_t NoResource = UINT32_MAX;
+
+    uint64_t AlignUp(const uint64_t value, const uint64_t alignment)
+    {
+        return alignment == 0 ? value : (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool LifetimesOverlap(const TransientAllocation& a, const TransientAllocation& b)
+    {
+        return a.FirstUse <= b.LastUse && b.FirstUse <= a.LastUse;
+    }
+} // namespace
+
+void AliasingPlanner::Plan(const std::span<const TransientAllocation> resources)
+{
+    m_stats = {};
+    m_heaps.clear();
+    m_barriers.clear();
+    m_placements.assign(resources.size(), {});
+
+    m_heapClasses.clear();
+    uint32_t lastStep = 0;
+    for (const TransientAllocation& resource : resources)
+    {
+        if (resource.Memory.Size == 0)
+        {
+            continue;
+        }
+
+        assert(resource.FirstUse <= resource.LastUse);
+        ++m_stats.Resources;
+        m_stats.UnaliasedBytes += AlignUp(resource.Memory.Size, resource.Memory.Alignment);
+        lastStep = std::max(lastStep, resource.LastUse);
+        if (std::find(m_heapClasses.begin(), m_heapClasses.end(), resource.Memory.HeapClass) == m_heapClasses.end())
+        {
+            m_heapClasses.push_back(resource.Memory.HeapClass);
+        }
+    }
+
+    // Memory alive at each step, from the changes at the start and end of every lifetime.
+    m_liveBytes.assign(lastStep + 2, 0);
+    for (const TransientAllocation& resource : resources)
+    {
+        if (resource.Memory.Size > 0)
+        {
+            m_liveBytes[resource.FirstUse] += resource.Memory.Size;
+            m_liveBytes[resource.LastUse + 1] -= resource.Memory.Size;
+        }
+    }
+    uint64_t live = 0;
+    for (const uint64_t change : m_liveBytes)
+    {
+        live += change;
+        m_stats.PeakLiveBytes = std::max(m_stats.PeakLiveBytes, live);
+    }
+
+    std::sort(m_heapClasses.begin(), m_heapClasses.end());
+    for (const uint32_t heapClass : m_heapClasses)
+    {
+        PlaceHeap(resources, heapClass);
+    }
+    for (const AliasingHeap& heap : m_heaps)
+    {
+        m_stats.AliasedBytes += heap.Size;
+    }
+
+    AddBarriers(resources);
+    m_stats.Barriers = static_cast<uint32_t>(m_barriers.size());
+}
+
+void AliasingPlanner::PlaceHeap(const std::span<const TransientAllocation> resources, const uint32_t heapClass)
+{
+    const auto    heapIndex = static_cast<uint32_t>(m_heaps.size());
+    AliasingHeap& heap = m_heaps.emplace_back();
+    heap.HeapClass = heapClass;
+
+    m_sorted.clear();
+    for (uint32_t resource = 0; resource < resources.size(); ++resource)
+    {
+        const TransientMemory& memory = resources[resource].Memory;
+        if (memory.Size > 0 && memory.HeapClass == heapClass)
+        {
+            m_sorted.push_back(resource);
+        }
+    }
+    std::sort(m_sorted.begin(), m_sorted.end(), [&](const uint32_t a, const uint32_t b) {
+        if (resources[a].Memory.Size != resources[b].Memory.Size)
+        {
+            return resources[a].Memory.Size > resources[b].Memory.Size;
+        }
+        return resources[a].FirstUse != resources[b].FirstUse ? resources[a].FirstUse < resources[b].FirstUse : a < b;
+    });
+
+    m_placed.clear();
+    for (const uint32_t resource : m_sorted)
+    {
+        const TransientAllocation& allocation = resources[resource];
+
+        // Memory taken by the resources alive at the same time, in address order.
+        m_occupied.clear();
+        for (const uint32_t other : m_placed)
+        {
+            if (LifetimesOverlap(allocation, resources[other]))
+            {
+                const uint64_t offset = m_placements[other].Offset;
+                m_occupied.push_back({offset, offset + resources[other].Memory.Size});
+            }
+        }
+        std::sort(m_occupied.begin(), m_occupied.end(),
+                  [](const Range& a, const Range& b) { return a.Begin < b.Begin; });
+
+        // Best fit: the smallest gap that holds the resource, else the end of the heap.
+        uint64_t best = UINT64_MAX;
+        uint64_t bestGap = UINT64_MAX;
+        uint64_t cursor = 0;
+        for (const Range& range : m_occupied)
+        {
+            const uint64_t start = AlignUp(cursor, allocation.Memory.Alignment);
+            if (start + allocation.Memory.Size <= range.Begin && range.Begin - cursor < bestGap)
+            {
+                best = start;
+                bestGap = range.Begin - cursor;
+            }
+            cursor = std::max(cursor, range.End);
+        }
+        if (best == UINT64_MAX)
+        {
+            best = AlignUp(cursor, allocation.Memory.Alignment);
+        }
+
+        m_placements[resource] = {heapIndex, best};
+        heap.Size = std::max(heap.Size, best + allocation.Memory.Size);
+        heap.Alignment = std::max(heap.Alignment, allocation.Memory.Alignment);
+        m_placed.push_back(resource);
+    }
+}
+
+void AliasingPlanner::AddBarriers(const std::span<const TransientAllocation> resources)
+{
+    for (uint32_t resource = 0; resource < resources.size(); ++resource)
+    {
+        const AliasingPlacement& placement = m_placements[resource];
+        if (placement.Heap == UINT32_MAX)
+        {
+            continue;
+        }
+
+        const uint64_t end = placement.Offset + resources[resource].Memory.Size;
+        bool           shared = false;
+        uint32_t       before = NoResource;
+        uint32_t       beforeCount = 0;
+        for (uint32_t other = 0; other < resources.size(); ++other)
+        {
+            const AliasingPlacement& otherPlacement = m_placements[other];
+            if (other == resource || otherPlacement.Heap != placement.Heap || otherPlacement.Offset >= end ||
+                placement.Offset >= otherPlacement.Offset + resources[other].Memory.Size)
+            {
+                continue;
+            }
+
+            shared = true;
+            if (resources[other].LastUse < resources[resource].FirstUse)
+            {
+                before = other;
+                ++beforeCount;
+            }
+        }
+
+        // Even the first resource in a range needs a barrier: the previous frame left another one there.
+        if (shared)
+        {
+            m_barriers.push_back({resources[resource].FirstUse, beforeCount == 1 ? before : NoResource, resource});
+        }
+    }
+
+    std::stable_sort(m_barriers.begin(), m_barriers.end(),
+                     [](const AliasingBarrier& a, const AliasingBarrier& b) { return a.Step < b.Step; });
+}
+
+const AliasingPlacement& AliasingPlanner::Placement(const uint32_t resource) const
+{
+    assert(resource < m_placements.size());
+    return m_placements[resource];
+}
+
+std::span<const AliasingHeap> AliasingPlanner::Heaps() const
+{
+    return m_heaps;
+}
+
+std::span<const AliasingBarrier> AliasingPlanner::Barriers() const
+{
+    return m_barriers;
+}
+
+const AliasingPlanner::Statistics& AliasingPlanner::Stats() const
+{
+    return m_stats;
+}
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// Memory requirements of a transient resource, as reported by GetResourceAllocationInfo.
+struct TransientMemory
+{
+    static constexpr uint64_t DefaultAlignment = 64 * 1024;
+
+    uint64_t Size = 0; ///< Zero for resources that are not placed in a shared heap.
+    uint64_t Alignment = DefaultAlignment;
+    uint32_t HeapClass = 0; ///< Only resources of the same class share a heap, e.g. render targets or buffers.
+};
+
+/// A transient resource to place, with the first and last steps of the frame that use it.
+struct TransientAllocation
+{
+    TransientMemory Memory;
+    uint32_t        FirstUse = 0;
+    uint32_t        LastUse = 0;
+};
+
+/// Where a resource lives in the planned heaps.
+struct AliasingPlacement
+{
+    uint32_t Heap = UINT32_MAX; ///< UINT32_MAX for resources that were not placed.
+    uint64_t Offset = 0;
+};
+
+struct AliasingHeap
+{
+    uint32_t HeapClass = 0;
+    uint64_t Size = 0;
+    uint64_t Alignment = 0;
+};
+
+/// Aliasing barrier to issue before the first use of a resource that reuses another's memory.
+struct AliasingBarrier
+{
+    uint32_t Step = 0;
+    uint32_t Before = UINT32_MAX; ///< UINT32_MAX when several resources used the memory before.
+    uint32_t After = 0;
+};
+
+/// @brief Packs transient resources whose lifetimes do not overlap into shared heaps.
+///
+/// Resources are placed largest first. Each goes into the tightest gap left between
+/// the resources it is alive with, which keeps every heap close to the peak of
+/// memory alive at any step. One heap is planned per heap class.
+///
+/// Reused memory holds garbage, so the first pass using a resource that needs an
+/// aliasing barrier must fully initialize it with a clear, discard or copy.
+class AliasingPlanner final
+{
+public:
+    struct Statistics
+    {
+        uint64_t UnaliasedBytes = 0; ///< Memory if every resource had its own allocation.
+        uint64_t AliasedBytes = 0;   ///< Total size of the planned heaps.
+        uint64_t PeakLiveBytes = 0;  ///< Most memory alive at one step; no plan can do better.
+        uint32_t Resources = 0;
+        uint32_t Barriers = 0;
+    };
+
+    /// @brief Plans the placement of every resource with a non-zero size.
+    /// @param [in] resources Indexed by resource; placements and barriers use the same indices.
+    void Plan(std::span<const TransientAllocation> resources);
+
+    [[nodiscard]] const AliasingPlacement& Placement(uint32_t resource) const;
+
+    [[nodiscard]] std::span<const AliasingHeap> Heaps() const;
+
+    /// @brief Gets the aliasing barriers, ordered by step.
+    [[nodiscard]] std::span<const AliasingBarrier> Barriers() const;
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+private:
+    struct Range
+    {
+        uint64_t Begin;
+        uint64_t End;
+    };
+
+    void PlaceHeap(std::span<const TransientAllocation> resources, uint32_t heapClass);
+
+    void AddBarriers(std::span<const TransientAllocation> resources);
+
+    std::vector<AliasingPlacement> m_placements;
+    std::vector<AliasingHeap>      m_heaps;
+    std::vector<AliasingBarrier>   m_barriers;
+    std::vector<uint32_t>          m_sorted;
+    std::vector<uint32_t>          m_placed;
+    std::vector<Range>             m_occupied;
+    std::vector<uint32_t>          m_heapClasses;
+    std::vector<uint64_t>          m_liveBytes;
+    Statistics                     m_stats;
+};
@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Animation.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "ThreadPool.hpp"
+
+namespace
+{
+    /// Pair of keys surrounding a sample time and the weight of the second one.
+    struct KeySpan
+    {
+        uint32_t From;
+        uint32_t To;
+        float    Weight;
+    };
+
+    KeySpan Locate(const std::vector<float>& times, const float time, const Interpolation mode)
+    {
+        const auto last = static_cast<uint32_t>(times.size() - 1);
+        if (time <= times.front())
+        {
+            return {0, 0, 0.0f};
+        }
+        if (time >= times.back())
+        {
+            return {last, last, 0.0f};
+        }
+
+        const auto next = static_cast<uint32_t>(std::upper_bound(times.begin(), times.end(), time) - times.begin());
+        const uint32_t previous = next - 1;
+        if (mode == Interpolation::Step)
+        {
+            return {previous, previous, 0.0f};
+        }
+
+        const float span = times[next] - times[previous];
+        return {previous, next, span > 0.0f ? (time - times[previous]) / span : 0.0f};
+    }
+
+    Vector3 SampleVector(const Keyframes<Vector3>& keys, const float time)
+    {
+        const KeySpan at = Locate(keys.Times, time, keys.Mode);
+        return Vector3::Lerp(keys.Values[at.From], keys.Values[at.To], at.Weight);
+    }
+
+    /// Normalized lerp of four quaternion pairs along the shortest arc.
+    void Nlerp4(const Quaternion* from, const Quaternion* to, const float* weights, Quaternion* results)
+    {
+        // Transpose so that each vector holds one component of all four quaternions.
+        const XMMATRIX a = XMMatrixTranspose(XMMATRIX(XMLoadFloat4(&from[0]), XMLoadFloat4(&from[1]),
+                                                      XMLoadFloat4(&from[2]), XMLoadFloat4(&from[3])));
+        const XMMATRIX b = XMMatrixTranspose(
+            XMMATRIX(XMLoadFloat4(&to[0]), XMLoadFloat4(&to[1]), XMLoadFloat4(&to[2]), XMLoadFloat4(&to[3])));
+        const XMVECTOR t = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(weights));
+
+        XMVECTOR dot = XMVectorMultiply(a.r[0], b.r[0]);
+        for (int c = 1; c < 4; ++c)
+        {
+            dot = XMVectorMultiplyAdd(a.r[c], b.r[c], dot);
+        }
+
+        // q and -q are the same rotation; negate targets in the opposite hemisphere.
+        const XMVECTOR sign = XMVectorSelect(g_XMOne, g_XMNegativeOne, XMVectorLess(dot, XMVectorZero()));
+
+        XMMATRIX result;
+        XMVECTOR lengthSquared = XMVectorZero();
+        for (int c = 0; c < 4; ++c)
+        {
+            result.r[c] = XMVectorLerpV(a.r[c], XMVectorMultiply(b.r[c], sign), t);
+            lengthSquared = XMVectorMultiplyAdd(result.r[c], result.r[c], lengthSquared);
+        }
+
+        const XMVECTOR inverseLength = XMVectorReciprocalSqrt(lengthSquared);
+        for (int c = 0; c < 4; ++c)
+        {
+            result.r[c] = XMVectorMultiply(result.r[c], inverseLength);
+        }
+
+        result = XMMatrixTranspose(result);
+        for (int i = 0; i < 4; ++i)
+        {
+            XMStoreFloat4(&results[i], result.r[i]);
+        }
+    }
+} // namespace
+
+float WrapClipTime(const float time, const float duration, const bool loop)
+{
+    if (duration <= 0.0f)
+    {
+        return 0.0f;
+    }
+    if (!loop)
+    {
+        return std::clamp(time, 0.0f, duration);
+    }
+
+    const float wrapped = std::fmod(time, duration);
+    return wrapped < 0.0f ? wrapped + duration : wrapped;
+}
+
+AnimationSampler::AnimationSampler(const RotationBlend rotationBlend) : m_rotationBlend(rotationBlend)
+{
+}
+
+void AnimationSampler::Sample(const Skeleton&            skeleton,
+                              const AnimationClip&       clip,
+                              const float                time,
+                              const bool                 loop,
+                              const std::span<JointPose> pose)
+{
+    assert(pose.size() >= skeleton.JointCount() && skeleton.BindPose.size() == skeleton.JointCount());
+
+    std::copy(skeleton.BindPose.begin(), skeleton.BindPose.end(), pose.begin());
+    const float clipTime = WrapClipTime(time, clip.Duration, loop);
+
+    m_rotationFrom.clear();
+    m_rotationTo.clear();
+    m_rotationWeight.clear();
+    m_rotationJoint.clear();
+
+    for (const JointTrack& track : clip.Tracks)
+    {
+        JointPose& joint = pose[track.Joint];
+        if (!track.Translation.Empty())
+        {
+            joint.Translation = SampleVector(track.Translation, clipTime);
+        }
+        if (!track.Scale.Empty())
+        {
+            joint.Scale = SampleVector(track.Scale, clipTime);
+        }
+        if (track.Rotation.Empty())
+        {
+            continue;
+        }
+
+        const KeySpan at = Locate(track.Rotation.Times, clipTime, track.Rotation.Mode);
+        if (at.From == at.To)
+        {
+            joint.Rotation = track.Rotation.Values[at.From];
+            continue;
+        }
+
+        m_rotationFrom.push_back(track.Rotation.Values[at.From]);
+        m_rotationTo.push_back(track.Rotation.Values[at.To]);
+        m_rotationWeight.push_back(at.Weight);
+        m_rotationJoint.push_back(track.Joint);
+    }
+
+    InterpolateRotations(pose);
+}
+
+void AnimationSampler::Blend(const Skeleton&              skeleton,
+                             const std::span<const Layer> layers,
+                             const std::span<JointPose>   pose)
+{
+    const uint32_t jointCount = skeleton.JointCount();
+    m_layerPose.resize(jointCount);
+
+    // Folding each layer in with weight / (sum of weights so far) yields the normalized
+    // weighted average without a separate normalization pass.
+    float totalWeight = 0.0f;
+    for (const Layer& layer : layers)
+    {
+        if (layer.Clip == nullptr || layer.Weight <= 0.0f)
+        {
+            continue;
+        }
+
+        const bool first = totalWeight == 0.0f;
+        totalWeight += layer.Weight;
+        if (first)
+        {
+            Sample(skeleton, *layer.Clip, layer.Time, layer.Loop, pose);
+            continue;
+        }
+
+        Sample(skeleton, *layer.Clip, layer.Time, layer.Loop, m_layerPose);
+
+        const float weight = layer.Weight / totalWeight;
+        m_rotationFrom.resize(jointCount);
+        m_rotationTo.resize(jointCount);
+        m_rotationWeight.assign(jointCount, weight);
+        m_rotationJoint.resize(jointCount);
+        for (uint32_t joint = 0; joint < jointCount; ++joint)
+        {
+            JointPose&       result = pose[joint];
+            const JointPose& sample = m_layerPose[joint];
+            result.Translation = Vector3::Lerp(result.Translation, sample.Translation, weight);
+            result.Scale = Vector3::Lerp(result.Scale, sample.Scale, weight);
+
+            m_rotationFrom[joint] = result.Rotation;
+            m_rotationTo[joint] = sample.Rotation;
+            m_rotationJoint[joint] = joint;
+        }
+
+        InterpolateRotations(pose);
+    }
+
+    if (totalWeight == 0.0f)
+    {
+        std::copy(skeleton.BindPose.begin(), skeleton.BindPose.end(), pose.begin());
+    }
+}
+
+void AnimationSampler::ComputePalette(const Skeleton&                  skeleton,
+                                      const std::span<const JointPose> pose,
+                                      const std::span<Matrix>          palette)
+{
+    const uint32_t jointCount = skeleton.JointCount();
+    assert(pose.size() >= jointCount && palette.size() >= jointCount);
+
+    m_modelSpace.resize(jointCount);
+    for (uint32_t joint = 0; joint < jointCount; ++joint)
+    {
+        const JointPose& local = pose[joint];
+        XMMATRIX         model = XMMatrixAffineTransformation(XMLoadFloat3(&local.Scale),
+                                                      XMVectorZero(),
+                                                      XMLoadFloat4(&local.Rotation),
+                                                      XMLoadFloat3(&local.Translation));
+
+        const int32_t parent = skeleton.Parents[joint];
+        if (parent != Skeleton::NoParent)
+        {
+            assert(static_cast<uint32_t>(parent) < joint);
+            model = XMMatrixMultiply(model, XMLoadFloat4x4(&m_modelSpace[parent]));
+        }
+
+        XMStoreFloat4x4(&m_modelSpace[joint], model);
+        XMStoreFloat4x4(&palette[joint], XMMatrixMultiply(XMLoadFloat4x4(&skeleton.InverseBindMatrices[joint]), model));
+    }
+}
+
+void AnimationSampler::Evaluate(const Skeleton&              skeleton,
+                                const std::span<const Layer> layers,
+                                const std::span<Matrix>      palette)
+{
+    m_pose.resize(skeleton.JointCount());
+    Blend(skeleton, layers, m_pose);
+    ComputePalette(skeleton, m_pose, palette);
+}
+
+void AnimationSampler::InterpolateRotations(const std::span<JointPose> pose)
+{
+    const size_t count = m_rotationJoint.size();
+
+    size_t i = 0;
+    if (m_rotationBlend == RotationBlend::Nlerp)
+    {
+        for (; i + 4 <= count; i += 4)
+        {
+            Quaternion results[4];
+            Nlerp4(&m_rotationFrom[i], &m_rotationTo[i], &m_rotationWeight[i], results);
+            for (size_t k = 0; k < 4; ++k)
+            {
+                pose[m_rotationJoint[i + k]].Rotation = results[k];
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            // Quaternion::Lerp also flips to the shortest arc and normalizes.
+            pose[m_rotationJoint[i]].Rotation =
+                Quaternion::Lerp(m_rotationFrom[i], m_rotationTo[i], m_rotationWeight[i]);
+        }
+        return;
+    }
+
+    for (; i < count; ++i)
+    {
+        pose[m_rotationJoint[i]].Rotation = Quaternion::Slerp(m_rotationFrom[i], m_rotationTo[i], m_rotationWeight[i]);
+    }
+}
+
+CharacterAnimator::CharacterAnimator(const RotationBlend rotationBlend) : m_rotationBlend(rotationBlend)
+{
+}
+
+void CharacterAnimator::Evaluate(const std::span<AnimatedCharacter> characters, ThreadPool& pool)
+{
+    if (m_samplers.size() < pool.ThreadCount())
+    {
+        m_samplers.resize(pool.ThreadCount(), AnimationSampler(m_rotationBlend));
+    }
+
+    pool.ParallelFor(characters.size(), 1, [&](const size_t begin, const size_t end, const uint32_t threadIndex) {
+        AnimationSampler& sampler = m_samplers[threadIndex];
+        for (size_t i = begin; i < end; ++i)
+        {
+            AnimatedCharacter& character = characters[i];
+            if (character.Rig == nullptr)
+            {
+                continue;
+            }
+
+            character.Palette.resize(character.Rig->JointCount());
+            sampler.Evaluate(*character.Rig, character.Layers, character.Palette);
+        }
+    });
+}
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "GraphicsMath.hpp"
+
+class ThreadPool;
+struct CompressedClip;
+class CompressedClipCursor;
+
+/// Local transform of one joint relative to its parent.
+struct JointPose
+{
+    Vector3    Translation = Vector3::Zero;
+    Quaternion Rotation = Quaternion::Identity;
+    Vector3    Scale = Vector3::One;
+};
+
+/// @brief Joint hierarchy of a skinned mesh.
+///
+/// Joints are stored so that every parent precedes its children, which lets model
+/// space transforms be accumulated in a single forward pass.
+struct Skeleton
+{
+    static constexpr int32_t NoParent = -1;
+
+    std::vector<std::string> JointNames;
+    std::vector<int32_t>     Parents;
+    std::vector<JointPose>   BindPose; ///< Pose used for joints a clip does not animate.
+    std::vector<Matrix>      InverseBindMatrices;
+
+    [[nodiscard]] uint32_t JointCount() const
+    {
+        return static_cast<uint32_t>(Parents.size());
+    }
+};
+
+enum class Interpolation : uint8_t
+{
+    Step,
+    Linear,
+};
+
+/// Keyframes of one joint property, with times in seconds in ascending order.
+template <typename T>
+struct Keyframes
+{
+    std::vector<float> Times;
+    std::vector<T>     Values;
+    Interpolation      Mode = Interpolation::Linear;
+
+    [[nodiscard]] bool Empty() const
+    {
+        return Times.empty();
+    }
+};
+
+/// Translation, rotation and scale keys of one joint. Empty channels keep the bind pose.
+struct JointTrack
+{
+    uint32_t              Joint = 0;
+    Keyframes<Vector3>    Translation;
+    Keyframes<Quaternion> Rotation;
+    Keyframes<Vector3>    Scale;
+};
+
+struct AnimationClip
+{
+    std::string             Name;
+    float                   Duration = 0.0f;
+    std::vector<JointTrack> Tracks;
+};
+
+/// @brief Maps a playback time into [0, duration], wrapping when looping and clamping otherwise.
+[[nodiscard]] float WrapClipTime(float time, float duration, bool loop);
+
+enum class RotationBlend : uint8_t
+{
+    Nlerp, ///< Normalized lerp along the shortest arc; fast and accurate for dense keys.
+    Slerp, ///< Constant angular velocity; slower, for sparse keys with large angles.
+};
+
+/// @brief Samples clips into joint poses and turns poses into skinning matrices.
+///
+/// Rotation keys are gathered per sample and interpolated in batches of four,
+/// with the quaternions transposed into component vectors. A sampler keeps scratch
+/// buffers between calls, so one instance should be used per thread.
+class AnimationSampler final
+{
+public:
+    /// One clip contributing to a blend.
+    struct Layer
+    {
+        const AnimationClip* Clip = nullptr;
+        float                Time = 0.0f;
+        float                Weight = 1.0f;
+        bool                 Loop = true; ///< Wraps time into the clip, otherwise clamps it.
+    };
+
+    explicit AnimationSampler(RotationBlend rotationBlend = RotationBlend::Nlerp);
+
+    /// @brief Samples a clip, leaving joints it does not animate in the bind pose.
+    /// @param [out] pose Receives one local pose per skeleton joint.
+    void Sample(const Skeleton& skeleton, const AnimationClip& clip, float time, bool loop, std::span<JointPose> pose);
+
+    /// @brief Decodes a compressed clip, leaving joints it does not animate in the bind pose.
+    /// @param [in,out] cursor Playback position in the clip; reusing it across frames avoids key searches.
+    void Sample(const Skeleton&       skeleton,
+                const CompressedClip& clip,
+                CompressedClipCursor& cursor,
+                float                 time,
+                bool                  loop,
+                std::span<JointPose>  pose);
+
+    /// @brief Samples and blends clips by their normalized weights.
+    ///
+    /// Layers with a weight of zero or less are skipped. If no layer remains the
+    /// result is the bind pose.
+    void Blend(const Skeleton& skeleton, std::span<const Layer> layers, std::span<JointPose> pose);
+
+    /// @brief Computes inverseBind * model-space transform for every joint.
+    /// @param [out] palette Receives one skinning matrix per joint.
+    void ComputePalette(const Skeleton& skeleton, std::span<const JointPose> pose, std::span<Matrix> palette);
+
+    /// @brief Blends the layers and computes the resulting skinning palette.
+    void Evaluate(const Skeleton& skeleton, std::span<const Layer> layers, std::span<Matrix> palette);
+
+private:
+    void InterpolateRotations(std::span<JointPose> pose);
+
+    RotationBlend m_rotationBlend;
+
+    // Rotation keys gathered by Sample() and interpolated as a batch.
+    std::vector<Quaternion> m_rotationFrom;
+    std::vector<Quaternion> m_rotationTo;
+    std::vector<float>      m_rotationWeight;
+    std::vector<uint32_t>   m_rotationJoint;
+
+    std::vector<JointPose> m_layerPose;
+    std::vector<JointPose> m_pose;
+    std::vector<Matrix>    m_modelSpace;
+};
+
+/// A skeleton instance with its animation state and output palette.
+struct AnimatedCharacter
+{
+    const Skeleton*                      Rig = nullptr;
+    std::vector<AnimationSampler::Layer> Layers;
+    std::vector<Matrix>                  Palette; ///< Resized to the joint count by CharacterAnimator.
+};
+
+/// @brief Evaluates the skinning palettes of many characters in parallel.
+class CharacterAnimator final
+{
+public:
+    explicit CharacterAnimator(RotationBlend rotationBlend = RotationBlend::Nlerp);
+
+    /// @param [in] pool Pool the characters are distributed over; each thread gets its own sampler.
+    void Evaluate(std::span<AnimatedCharacter> characters, ThreadPool& pool);
+
+private:
+    RotationBlend                 m_rotationBlend;
+    std::vector<AnimationSampler> m_samplers;
+};
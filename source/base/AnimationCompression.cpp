@@ -0,0 +1,597 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AnimationCompression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    using Words = std::array<uint16_t, 3>;
+
+    constexpr float QuantizedMax = 65535.0f;
+    constexpr float RotationComponentMax = 0.70710678f; // No component but the largest exceeds 1/sqrt(2).
+    constexpr float RotationQuantizedMax = 32767.0f;
+    constexpr float ErrorSampleRate = 60.0f;
+
+    /// Pair of keys of a compressed channel surrounding a sample time.
+    struct KeySpan
+    {
+        uint32_t From;
+        uint32_t To;
+        float    Weight;
+    };
+
+    uint16_t Quantize(const float value, const float min, const float step)
+    {
+        if (step <= 0.0f)
+        {
+            return 0;
+        }
+        return static_cast<uint16_t>(std::lround(std::clamp((value - min) / step, 0.0f, QuantizedMax)));
+    }
+
+    Words EncodeVector(const Vector3& value, const Vector3& min, const Vector3& step)
+    {
+        return {Quantize(value.x, min.x, step.x), Quantize(value.y, min.y, step.y), Quantize(value.z, min.z, step.z)};
+    }
+
+    Vector3 DecodeVector(const uint16_t* words, const Vector3& min, const Vector3& step)
+    {
+        const XMVECTOR quantized = XMVectorSet(words[0], words[1], words[2], 0.0f);
+        return XMVectorMultiplyAdd(quantized, step, min);
+    }
+
+    Words EncodeRotation(Quaternion rotation)
+    {
+        rotation.Normalize();
+        const float components[4] = {rotation.x, rotation.y, rotation.z, rotation.w};
+
+        uint32_t largest = 0;
+        for (uint32_t i = 1; i < 4; ++i)
+        {
+            if (std::fabs(components[i]) > std::fabs(components[largest]))
+            {
+                largest = i;
+            }
+        }
+
+        // q and -q are the same rotation; pick the one whose dropped component is positive.
+        const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+        Words    words = {};
+        uint32_t word = 0;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            if (i != largest)
+            {
+                const float normalized = std::clamp(sign * components[i] / RotationComponentMax, -1.0f, 1.0f);
+                words[word++] = static_cast<uint16_t>(std::lround((normalized * 0.5f + 0.5f) * RotationQuantizedMax));
+            }
+        }
+
+        words[0] |= static_cast<uint16_t>((largest >> 1) << 15);
+        words[1] |= static_cast<uint16_t>((largest & 1) << 15);
+        return words;
+    }
+
+    Quaternion DecodeRotation(const uint16_t* words)
+    {
+        const uint32_t largest = (words[0] >> 15) << 1 | words[1] >> 15;
+
+        constexpr float Scale = 2.0f * RotationComponentMax / RotationQuantizedMax;
+
+        const XMVECTOR quantized = XMVectorSet(words[0] & 0x7fff, words[1] & 0x7fff, words[2], 0.0f);
+        const XMVECTOR small =
+            XMVectorMultiplyAdd(quantized, XMVectorReplicate(Scale), XMVectorReplicate(-RotationComponentMax));
+        const float dropped = std::sqrt(std::max(0.0f, 1.0f - XMVectorGetX(XMVector3Dot(small, small))));
+
+        const float stored[3] = {XMVectorGetX(small), XMVectorGetY(small), XMVectorGetZ(small)};
+        float       components[4];
+        for (uint32_t i = 0, word = 0; i < 4; ++i)
+        {
+            components[i] = i == largest ? dropped : stored[word++];
+        }
+        return Quaternion(components);
+    }
+
+    float Difference(const Vector3& a, const Vector3& b)
+    {
+        return Vector3::Distance(a, b);
+    }
+
+    /// Rotation angle between two quaternions; atan2 stays accurate for the tiny angles compared here.
+    float Difference(const Quaternion& a, const Quaternion& b)
+    {
+        const Quaternion aligned = a.Dot(b) < 0.0f ? -b : b;
+        return 4.0f * std::atan2((a - aligned).Length(), (a + aligned).Length());
+    }
+
+    Vector3 Interpolate(const Vector3& a, const Vector3& b, const float t)
+    {
+        return Vector3::Lerp(a, b, t);
+    }
+
+    Quaternion Interpolate(const Quaternion& a, const Quaternion& b, const float t)
+    {
+        return Quaternion::Lerp(a, b, t);
+    }
+
+    /// Quantized form of one channel before key reduction.
+    template <typename T>
+    struct QuantizedKeys
+    {
+        std::vector<float> Times;        ///< Original times, in quantization steps.
+        std::vector<float> DecodedTimes; ///< Stored times, in quantization steps.
+        std::vector<Words> Encoded;
+        std::vector<T>     Decoded;
+    };
+
+    /// @brief Marks the keys needed to keep linear interpolation of the stored keys within tolerance.
+    ///
+    /// Starts from the first and last key and keeps adding the key that deviates most from the
+    /// interpolation between its kept neighbours.
+    template <typename T>
+    void ReduceLinear(const QuantizedKeys<T>& keys,
+                      const std::vector<T>&   values,
+                      const float             tolerance,
+                      std::vector<bool>&      keep)
+    {
+        const auto last = static_cast<uint32_t>(values.size() - 1);
+        keep[0] = true;
+        keep[last] = true;
+
+        std::vector<std::pair<uint32_t, uint32_t>> segments = {{0, last}};
+        while (!segments.empty())
+        {
+            const auto [first, end] = segments.back();
+            segments.pop_back();
+
+            const float span = keys.DecodedTimes[end] - keys.DecodedTimes[first];
+            float       worstError = tolerance;
+            uint32_t    worst = 0;
+            for (uint32_t key = first + 1; key < end; ++key)
+            {
+                const float t = span > 0.0f ? (keys.Times[key] - keys.DecodedTimes[first]) / span : 0.0f;
+                const T     value = Interpolate(keys.Decoded[first], keys.Decoded[end], std::clamp(t, 0.0f, 1.0f));
+                const float error = Difference(value, values[key]);
+                if (error > worstError)
+                {
+                    worstError = error;
+                    worst = key;
+                }
+            }
+
+            if (worst != 0)
+            {
+                keep[worst] = true;
+                segments.emplace_back(first, worst);
+                segments.emplace_back(worst, end);
+            }
+        }
+    }
+
+    /// Keeps only the step keys whose value differs from the one held before them.
+    template <typename T>
+    void ReduceStep(const QuantizedKeys<T>& keys,
+                    const std::vector<T>&   values,
+                    const float             tolerance,
+                    std::vector<bool>&      keep)
+    {
+        uint32_t held = 0;
+        keep[0] = true;
+        for (uint32_t key = 1; key < values.size(); ++key)
+        {
+            if (Difference(keys.Decoded[held], values[key]) > tolerance)
+            {
+                keep[key] = true;
+                held = key;
+            }
+        }
+    }
+
+    template <typename T, typename Encode, typename Decode>
+    CompressedChannel CompressChannel(const Keyframes<T>&    keys,
+                                      const T&               bindValue,
+                                      const float            tolerance,
+                                      const float            timeScale,
+                                      Encode                 encode,
+                                      Decode                 decode,
+                                      std::vector<uint16_t>& values,
+                                      CompressedClip&        clip)
+    {
+        CompressedChannel channel;
+        channel.Mode = keys.Mode;
+
+        const auto inBindPose = [&](const T& value) { return Difference(value, bindValue) <= tolerance; };
+        if (keys.Empty() || std::all_of(keys.Values.begin(), keys.Values.end(), inBindPose))
+        {
+            return channel;
+        }
+
+        // Quantize first so that the reduction bounds the error of what is actually stored.
+        const size_t     count = keys.Times.size();
+        QuantizedKeys<T> quantized;
+        for (size_t key = 0; key < count; ++key)
+        {
+            const float time = keys.Times[key] * timeScale;
+            quantized.Times.push_back(time);
+            quantized.DecodedTimes.push_back(std::floor(std::clamp(time, 0.0f, QuantizedMax)));
+            quantized.Encoded.push_back(encode(keys.Values[key]));
+            quantized.Decoded.push_back(decode(quantized.Encoded.back().data()));
+        }
+
+        std::vector<bool> keep(count, false);
+        const auto        nearFirst = [&](const T& value) {
+            return Difference(value, quantized.Decoded[0]) <= tolerance;
+        };
+        if (std::all_of(keys.Values.begin(), keys.Values.end(), nearFirst))
+        {
+            keep[0] = true;
+        }
+        else if (keys.Mode == Interpolation::Step)
+        {
+            ReduceStep(quantized, keys.Values, tolerance, keep);
+        }
+        else
+        {
+            ReduceLinear(quantized, keys.Values, tolerance, keep);
+        }
+
+        channel.TimeOffset = static_cast<uint32_t>(clip.Times.size());
+        channel.ValueOffset = static_cast<uint32_t>(values.size() / 3);
+        for (size_t key = 0; key < count; ++key)
+        {
+            if (keep[key])
+            {
+                clip.Times.push_back(static_cast<uint16_t>(quantized.DecodedTimes[key]));
+                values.insert(values.end(), quantized.Encoded[key].begin(), quantized.Encoded[key].end());
+                ++channel.KeyCount;
+            }
+        }
+        return channel;
+    }
+
+    /// Quantization range covering every key of one vector channel type in a clip.
+    void VectorRange(const AnimationClip&                     clip,
+                     Keyframes<Vector3> JointTrack::*const channel,
+                     Vector3&                                 min,
+                     Vector3&                                 step)
+    {
+        Vector3 low(FLT_MAX, FLT_MAX, FLT_MAX);
+        Vector3 high(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for (const JointTrack& track : clip.Tracks)
+        {
+            for (const Vector3& value : (track.*channel).Values)
+            {
+                low = Vector3::Min(low, value);
+                high = Vector3::Max(high, value);
+            }
+        }
+
+        if (low.x > high.x)
+        {
+            min = Vector3::Zero;
+            step = Vector3::Zero;
+            return;
+        }
+
+        min = low;
+        step = (high - low) / QuantizedMax;
+    }
+
+    /// Distance from each joint to its farthest descendant in the bind pose.
+    std::vector<float> BindPoseReach(const Skeleton& skeleton)
+    {
+        const uint32_t       jointCount = skeleton.JointCount();
+        std::vector<Matrix>  model(jointCount);
+        std::vector<Vector3> positions(jointCount);
+        for (uint32_t joint = 0; joint < jointCount; ++joint)
+        {
+            const JointPose& pose = skeleton.BindPose[joint];
+            model[joint] = Matrix::CreateScale(pose.Scale) * Matrix::CreateFromQuaternion(pose.Rotation) *
+                           Matrix::CreateTranslation(pose.Translation);
+
+            const int32_t parent = skeleton.Parents[joint];
+            if (parent != Skeleton::NoParent)
+            {
+                model[joint] *= model[parent];
+            }
+            positions[joint] = model[joint].Translation();
+        }
+
+        std::vector<float> reach(jointCount, 0.0f);
+        for (uint32_t joint = 0; joint < jointCount; ++joint)
+        {
+            for (int32_t ancestor = skeleton.Parents[joint]; ancestor != Skeleton::NoParent;
+                 ancestor = skeleton.Parents[ancestor])
+            {
+                reach[ancestor] = std::max(reach[ancestor], Vector3::Distance(positions[joint], positions[ancestor]));
+            }
+        }
+        return reach;
+    }
+
+    template <typename T>
+    size_t RawSize(const Keyframes<T>& keys)
+    {
+        return keys.Times.size() * (sizeof(float) + sizeof(T));
+    }
+
+    KeySpan Locate(const CompressedClip&    clip,
+                   const CompressedChannel& channel,
+                   CompressedClipCursor&    cursor,
+                   const size_t             channelIndex,
+                   const float              time)
+    {
+        const std::span<const uint16_t> times(clip.Times.data() + channel.TimeOffset, channel.KeyCount);
+
+        const uint32_t key = cursor.Seek(channelIndex, times, time);
+        const uint32_t next = std::min(key + 1, channel.KeyCount - 1);
+        if (channel.Mode == Interpolation::Step || next == key || time <= times[key])
+        {
+            return {key, key, 0.0f};
+        }
+
+        const float from = times[key];
+        const float span = static_cast<float>(times[next]) - from;
+        return {key, next, span > 0.0f ? std::min((time - from) / span, 1.0f) : 0.0f};
+    }
+
+    Vector3 SampleVector(const CompressedClip&        clip,
+                         const CompressedChannel&     channel,
+                         const std::vector<uint16_t>& values,
+                         const Vector3&               min,
+                         const Vector3&               step,
+                         CompressedClipCursor&        cursor,
+                         const size_t                 channelIndex,
+                         const float                  time)
+    {
+        const KeySpan   at = Locate(clip, channel, cursor, channelIndex, time);
+        const uint16_t* keys = values.data() + static_cast<size_t>(channel.ValueOffset) * 3;
+
+        const XMVECTOR from = DecodeVector(keys + static_cast<size_t>(at.From) * 3, min, step);
+        if (at.From == at.To)
+        {
+            return from;
+        }
+        return XMVectorLerp(from, DecodeVector(keys + static_cast<size_t>(at.To) * 3, min, step), at.Weight);
+    }
+} // namespace
+
+size_t CompressedClip::SizeInBytes() const
+{
+    return Tracks.size() * sizeof(CompressedTrack) +
+           (Times.size() + Translations.size() + Rotations.size() + Scales.size()) * sizeof(uint16_t);
+}
+
+uint32_t CompressedClipCursor::Seek(const size_t channel, const std::span<const uint16_t> times, const float time)
+{
+    if (m_keys.size() <= channel)
+    {
+        m_keys.resize(channel + 1, 0);
+    }
+
+    uint32_t&  key = m_keys[channel];
+    const auto count = static_cast<uint32_t>(times.size());
+    if (key >= count || static_cast<float>(times[key]) > time)
+    {
+        const auto next =
+            std::upper_bound(times.begin(), times.end(), time,
+                             [](const float value, const uint16_t keyTime) { return value < keyTime; });
+        key = next == times.begin() ? 0 : static_cast<uint32_t>(next - times.begin() - 1);
+        return key;
+    }
+
+    while (key + 1 < count && static_cast<float>(times[key + 1]) <= time)
+    {
+        ++key;
+    }
+    return key;
+}
+
+void AnimationSampler::Sample(const Skeleton&            skeleton,
+                              const CompressedClip&      clip,
+                              CompressedClipCursor&      cursor,
+                              const float                time,
+                              const bool                 loop,
+                              const std::span<JointPose> pose)
+{
+    assert(pose.size() >= skeleton.JointCount() && skeleton.BindPose.size() == skeleton.JointCount());
+
+    std::copy(skeleton.BindPose.begin(), skeleton.BindPose.end(), pose.begin());
+    const float timeScale = clip.Duration > 0.0f ? QuantizedMax / clip.Duration : 0.0f;
+    const float clipTime = WrapClipTime(time, clip.Duration, loop) * timeScale;
+
+    m_rotationFrom.clear();
+    m_rotationTo.clear();
+    m_rotationWeight.clear();
+    m_rotationJoint.clear();
+
+    for (size_t i = 0; i < clip.Tracks.size(); ++i)
+    {
+        const CompressedTrack& track = clip.Tracks[i];
+        JointPose&             joint = pose[track.Joint];
+        if (track.Translation.KeyCount > 0)
+        {
+            joint.Translation = SampleVector(clip, track.Translation, clip.Translations, clip.TranslationMin,
+                                             clip.TranslationStep, cursor, i * 3, clipTime);
+        }
+        if (track.Scale.KeyCount > 0)
+        {
+            joint.Scale = SampleVector(clip, track.Scale, clip.Scales, clip.ScaleMin, clip.ScaleStep, cursor,
+                                       i * 3 + 2, clipTime);
+        }
+        if (track.Rotation.KeyCount == 0)
+        {
+            continue;
+        }
+
+        const KeySpan   at = Locate(clip, track.Rotation, cursor, i * 3 + 1, clipTime);
+        const uint16_t* keys = clip.Rotations.data() + static_cast<size_t>(track.Rotation.ValueOffset) * 3;
+        const Quaternion from = DecodeRotation(keys + static_cast<size_t>(at.From) * 3);
+        if (at.From == at.To)
+        {
+            joint.Rotation = from;
+            continue;
+        }
+
+        m_rotationFrom.push_back(from);
+        m_rotationTo.push_back(DecodeRotation(keys + static_cast<size_t>(at.To) * 3));
+        m_rotationWeight.push_back(at.Weight);
+        m_rotationJoint.push_back(track.Joint);
+    }
+
+    InterpolateRotations(pose);
+}
+
+AnimationCompressor::AnimationCompressor(const CompressionSettings& settings) : m_settings(settings)
+{
+}
+
+CompressedClip AnimationCompressor::Compress(const Skeleton& skeleton, const AnimationClip& clip)
+{
+    m_report = {};
+
+    // Per-track bounds: an error of angle a at a joint moves a point at distance d by about a * d.
+    const std::vector<float> reach = BindPoseReach(skeleton);
+    m_rotationTolerance.resize(reach.size());
+    m_scaleTolerance.resize(reach.size());
+    for (size_t joint = 0; joint < reach.size(); ++joint)
+    {
+        m_rotationTolerance[joint] = m_settings.PositionTolerance / (reach[joint] + m_settings.VertexDistance);
+        m_scaleTolerance[joint] = m_rotationTolerance[joint];
+    }
+
+    CompressedClip compressed;
+    compressed.Name = clip.Name;
+    compressed.Duration = clip.Duration;
+    VectorRange(clip, &JointTrack::Translation, compressed.TranslationMin, compressed.TranslationStep);
+    VectorRange(clip, &JointTrack::Scale, compressed.ScaleMin, compressed.ScaleStep);
+
+    const float timeScale = clip.Duration > 0.0f ? QuantizedMax / clip.Duration : 0.0f;
+    const auto  encodeTranslation = [&](const Vector3& value) {
+        return EncodeVector(value, compressed.TranslationMin, compressed.TranslationStep);
+    };
+    const auto decodeTranslation = [&](const uint16_t* words) {
+        return DecodeVector(words, compressed.TranslationMin, compressed.TranslationStep);
+    };
+    const auto encodeScale = [&](const Vector3& value) {
+        return EncodeVector(value, compressed.ScaleMin, compressed.ScaleStep);
+    };
+    const auto decodeScale = [&](const uint16_t* words) {
+        return DecodeVector(words, compressed.ScaleMin, compressed.ScaleStep);
+    };
+
+    for (const JointTrack& track : clip.Tracks)
+    {
+        const JointPose& bind = skeleton.BindPose[track.Joint];
+
+        CompressedTrack result;
+        result.Joint = track.Joint;
+        result.Translation = CompressChannel(track.Translation, bind.Translation, m_settings.PositionTolerance,
+                                             timeScale, encodeTranslation, decodeTranslation,
+                                             compressed.Translations, compressed);
+        result.Rotation = CompressChannel(track.Rotation, bind.Rotation, m_rotationTolerance[track.Joint], timeScale,
+                                          EncodeRotation, DecodeRotation, compressed.Rotations, compressed);
+        result.Scale = CompressChannel(track.Scale, bind.Scale, m_scaleTolerance[track.Joint], timeScale, encodeScale,
+                                       decodeScale, compressed.Scales, compressed);
+
+        m_report.RawBytes += RawSize(track.Translation) + RawSize(track.Rotation) + RawSize(track.Scale);
+        m_report.RawKeys += static_cast<uint32_t>(track.Translation.Times.size() + track.Rotation.Times.size() +
+                                                  track.Scale.Times.size());
+
+        if (result.Translation.KeyCount + result.Rotation.KeyCount + result.Scale.KeyCount > 0)
+        {
+            compressed.Tracks.push_back(result);
+        }
+    }
+
+    m_report.CompressedBytes = compressed.SizeInBytes();
+    m_report.CompressedKeys = static_cast<uint32_t>(compressed.Times.size());
+    Measure(skeleton, clip, compressed);
+    return compressed;
+}
+
+const CompressionReport& AnimationCompressor::Report() const
+{
+    return m_report;
+}
+
+void AnimationCompressor::Measure(const Skeleton& skeleton, const AnimationClip& clip, const CompressedClip& compressed)
+{
+    // Every original key time, where the error of piecewise interpolation peaks, plus a regular grid.
+    std::vector<float> times;
+    for (const JointTrack& track : clip.Tracks)
+    {
+        times.insert(times.end(), track.Translation.Times.begin(), track.Translation.Times.end());
+        times.insert(times.end(), track.Rotation.Times.begin(), track.Rotation.Times.end());
+        times.insert(times.end(), track.Scale.Times.begin(), track.Scale.Times.end());
+    }
+    const auto frameCount = static_cast<uint32_t>(std::ceil(clip.Duration * ErrorSampleRate));
+    for (uint32_t frame = 0; frame <= frameCount; ++frame)
+    {
+        times.push_back(frameCount > 0 ? clip.Duration * static_cast<float>(frame) / static_cast<float>(frameCount)
+                                       : 0.0f);
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    // Identity inverse bind matrices make the palette the model space transforms.
+    Skeleton rig = skeleton;
+    std::fill(rig.InverseBindMatrices.begin(), rig.InverseBindMatrices.end(), Matrix::Identity);
+
+    const float   distance = m_settings.VertexDistance;
+    const Vector3 points[] = {Vector3::Zero, Vector3(distance, 0.0f, 0.0f), Vector3(0.0f, distance, 0.0f),
+                              Vector3(0.0f, 0.0f, distance)};
+
+    const uint32_t         jointCount = skeleton.JointCount();
+    AnimationSampler       sampler;
+    CompressedClipCursor   cursor;
+    std::vector<JointPose> rawPose(jointCount);
+    std::vector<JointPose> decodedPose(jointCount);
+    std::vector<Matrix>    rawModel(jointCount);
+    std::vector<Matrix>    decodedModel(jointCount);
+    constexpr float        Slack = 1.001f;
+    for (const float time : times)
+    {
+        const float clamped = std::clamp(time, 0.0f, clip.Duration);
+        sampler.Sample(skeleton, clip, clamped, false, rawPose);
+        sampler.Sample(skeleton, compressed, cursor, clamped, false, decodedPose);
+
+        for (uint32_t joint = 0; joint < jointCount; ++joint)
+        {
+            const float translation = Difference(rawPose[joint].Translation, decodedPose[joint].Translation);
+            const float rotation = Difference(rawPose[joint].Rotation, decodedPose[joint].Rotation);
+            const float scale = Difference(rawPose[joint].Scale, decodedPose[joint].Scale);
+            m_report.MaxTranslationError = std::max(m_report.MaxTranslationError, translation);
+            m_report.MaxRotationError = std::max(m_report.MaxRotationError, rotation);
+            m_report.MaxScaleError = std::max(m_report.MaxScaleError, scale);
+
+            if (translation > m_settings.PositionTolerance * Slack ||
+                rotation > m_rotationTolerance[joint] * Slack || scale > m_scaleTolerance[joint] * Slack)
+            {
+                ++m_report.ToleranceViolations;
+            }
+        }
+
+        sampler.ComputePalette(rig, rawPose, rawModel);
+        sampler.ComputePalette(rig, decodedPose, decodedModel);
+        for (uint32_t joint = 0; joint < jointCount; ++joint)
+        {
+            for (const Vector3& point : points)
+            {
+                const float error = Vector3::Distance(Vector3::Transform(point, rawModel[joint]),
+                                                      Vector3::Transform(point, decodedModel[joint]));
+                m_report.MaxPositionError = std::max(m_report.MaxPositionError, error);
+            }
+        }
+    }
+}
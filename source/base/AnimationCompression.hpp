@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Animation.hpp"
+
+/// Keys of one channel of a CompressedClip.
+struct CompressedChannel
+{
+    uint32_t      TimeOffset = 0;  ///< First key in CompressedClip::Times.
+    uint32_t      ValueOffset = 0; ///< First key in the channel's value array, counted in keys.
+    uint32_t      KeyCount = 0;    ///< Zero when the channel stays in the bind pose.
+    Interpolation Mode = Interpolation::Linear;
+};
+
+struct CompressedTrack
+{
+    uint32_t          Joint = 0;
+    CompressedChannel Translation;
+    CompressedChannel Rotation;
+    CompressedChannel Scale;
+};
+
+/// @brief Animation clip with reduced keys stored as 16-bit integers.
+///
+/// Times are fractions of the duration. Translations and scales are fractions of
+/// ranges shared by the whole clip, three values per key. Rotations use the
+/// smallest-three encoding: the largest component is dropped and rebuilt from the
+/// unit length, the other three take 15 bits each and the index of the dropped one
+/// is kept in the top bits of the first two.
+struct CompressedClip
+{
+    std::string                  Name;
+    float                        Duration = 0.0f;
+    Vector3                      TranslationMin;
+    Vector3                      TranslationStep; ///< Distance covered by one quantization step.
+    Vector3                      ScaleMin;
+    Vector3                      ScaleStep;
+    std::vector<CompressedTrack> Tracks;
+    std::vector<uint16_t>        Times;
+    std::vector<uint16_t>        Translations;
+    std::vector<uint16_t>        Rotations;
+    std::vector<uint16_t>        Scales;
+
+    /// @brief Gets the size of the track table and key data.
+    [[nodiscard]] size_t SizeInBytes() const;
+};
+
+/// @brief Playback position of one character in one compressed clip.
+///
+/// Remembers the key each channel was last sampled at, so that playing forwards
+/// steps to the next key instead of searching for it. Seeking backwards, as when
+/// a clip loops, falls back to a binary search.
+class CompressedClipCursor final
+{
+public:
+    /// @brief Finds the last key at or before time, or the first key if there is none.
+    /// @param [in] channel Index of the channel, three per track in track order.
+    /// @param [in] times Quantized key times of the channel.
+    /// @param [in] time Time in quantization steps.
+    uint32_t Seek(size_t channel, std::span<const uint16_t> times, float time);
+
+private:
+    std::vector<uint32_t> m_keys;
+};
+
+struct CompressionSettings
+{
+    /// Largest acceptable displacement, in meters, of a skinned point caused by one track.
+    float PositionTolerance = 0.0005f;
+
+    /// Distance of skinned vertices from their joint, added to the bind pose reach of
+    /// a joint when converting the position tolerance into rotation and scale bounds.
+    float VertexDistance = 0.03f;
+};
+
+/// Size and error of a compressed clip, measured by decoding it again.
+struct CompressionReport
+{
+    size_t   RawBytes = 0;
+    size_t   CompressedBytes = 0;
+    uint32_t RawKeys = 0;
+    uint32_t CompressedKeys = 0;
+    float    MaxTranslationError = 0.0f; ///< Local space, in meters.
+    float    MaxRotationError = 0.0f;    ///< Local space, in radians.
+    float    MaxScaleError = 0.0f;
+    float    MaxPositionError = 0.0f; ///< Model space, at the joints and VertexDistance around them.
+    uint32_t ToleranceViolations = 0; ///< Samples where a track exceeded its error bound.
+
+    [[nodiscard]] float Ratio() const
+    {
+        return CompressedBytes > 0 ? static_cast<float>(RawBytes) / static_cast<float>(CompressedBytes) : 0.0f;
+    }
+};
+
+/// @brief Cook time compressor for animation clips.
+///
+/// Every track gets its own error bound: translations use the position tolerance
+/// directly, while rotation and scale bounds shrink with the distance from the joint
+/// to its farthest descendant, since small angles at the hip move the hand the most.
+/// Channels that stay within their bound of the bind pose are dropped. The others
+/// are quantized first and then reduced by repeatedly keeping the key that deviates
+/// most from the interpolation between the keys kept so far, so the error of the
+/// stored data is what is bounded.
+class AnimationCompressor final
+{
+public:
+    explicit AnimationCompressor(const CompressionSettings& settings = {});
+
+    [[nodiscard]] CompressedClip Compress(const Skeleton& skeleton, const AnimationClip& clip);
+
+    /// @brief Gets the statistics of the last Compress() call.
+    [[nodiscard]] const CompressionReport& Report() const;
+
+private:
+    void Measure(const Skeleton& skeleton, const AnimationClip& clip, const CompressedClip& compressed);
+
+    CompressionSettings m_settings;
+    CompressionReport   m_report;
+    std::vector<float>  m_rotationTolerance;
+    std::vector<float>  m_scaleTolerance;
+};
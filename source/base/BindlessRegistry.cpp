@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BindlessRegistry.hpp"
+
+#include <cassert>
+
+BindlessHandle BindlessRegistry::Register(const DescriptorAllocation& allocation)
+{
+    assert(allocation.IsValid() && allocation.Count == 1);
+    if (allocation.Offset >= m_slots.size())
+    {
+        m_slots.resize(allocation.Offset + 1);
+    }
+
+    Slot& slot = m_slots[allocation.Offset];
+    assert(!slot.Live);
+    slot.Allocation = allocation;
+    slot.Live = true;
+    // Generation zero is never handed out, so a default constructed handle never matches.
+    ++slot.Generation;
+    if (slot.Generation == 0)
+    {
+        slot.Generation = 1;
+    }
+    ++m_liveCount;
+
+    return {allocation.Offset, slot.Generation};
+}
+
+DescriptorAllocation BindlessRegistry::Unregister(const BindlessHandle& handle)
+{
+    if (!IsValid(handle))
+    {
+        return {};
+    }
+
+    Slot& slot = m_slots[handle.Index];
+    slot.Live = false;
+    --m_liveCount;
+    return slot.Allocation;
+}
+
+bool BindlessRegistry::IsValid(const BindlessHandle& handle) const
+{
+    return handle.Index < m_slots.size() && m_slots[handle.Index].Live &&
+           m_slots[handle.Index].Generation == handle.Generation;
+}
+
+uint32_t BindlessRegistry::Resolve(const BindlessHandle& handle) const
+{
+    return IsValid(handle) ? handle.Index : BindlessHandle::InvalidIndex;
+}
+
+uint32_t BindlessRegistry::LiveCount() const
+{
+    return m_liveCount;
+}
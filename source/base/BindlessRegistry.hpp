@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "DescriptorAllocator.hpp"
+
+/// @brief Refers to one descriptor of the global heap that shaders index directly.
+///
+/// The index is what a draw passes to its shaders. The generation tells a handle apart
+/// from later ones that reuse its index once it was released.
+struct BindlessHandle
+{
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+    uint32_t Index = InvalidIndex;
+    uint32_t Generation = 0;
+
+    [[nodiscard]] bool IsValid() const
+    {
+        return Index != InvalidIndex;
+    }
+
+    bool operator==(const BindlessHandle&) const = default;
+};
+
+/// @brief Tracks which persistent descriptors are registered for bindless access.
+///
+/// Indices are the offsets of single descriptor allocations from a DescriptorAllocator,
+/// so they stay stable while the heap grows. Releasing a handle bumps the generation of
+/// its index, so stale handles are caught instead of reading whatever reuses the index.
+class BindlessRegistry final
+{
+public:
+    /// @brief Registers a single descriptor allocation.
+    [[nodiscard]] BindlessHandle Register(const DescriptorAllocation& allocation);
+
+    /// @brief Unregisters a handle and returns the allocation it was made from, for the caller to free.
+    /// @return An invalid allocation when the handle is stale or was never registered.
+    [[nodiscard]] DescriptorAllocation Unregister(const BindlessHandle& handle);
+
+    [[nodiscard]] bool IsValid(const BindlessHandle& handle) const;
+
+    /// @brief Gets the index to hand to shaders.
+    /// @return BindlessHandle::InvalidIndex when the handle is stale.
+    [[nodiscard]] uint32_t Resolve(const BindlessHandle& handle) const;
+
+    [[nodiscard]] uint32_t LiveCount() const;
+
+private:
+    struct Slot
+    {
+        DescriptorAllocation Allocation;
+        uint32_t             Generation = 0;
+        bool                 Live = false;
+    };
+
+    std::vector<Slot> m_slots;
+    uint32_t          m_liveCount = 0;
+};
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BindlessResources.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+#include "GraphicsPipelineCache.hpp"
+
+BindlessResources::BindlessResources(ID3D12Device* device, DescriptorManager& descriptors)
+    : m_device(device), m_descriptors(descriptors)
+{
+    D3D12_FEATURE_DATA_SHADER_MODEL shaderModel = {D3D_SHADER_MODEL_6_6};
+    if (FAILED(m_device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModel, sizeof(shaderModel))) ||
+        shaderModel.HighestShaderModel < D3D_SHADER_MODEL_6_6)
+    {
+        throw std::runtime_error("Bindless resources need shader model 6.6");
+    }
+}
+
+BindlessHandle BindlessResources::CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc)
+{
+    CD3DX12_CPU_DESCRIPTOR_HANDLE cpuHandle;
+    const BindlessHandle          handle = Allocate(cpuHandle);
+    m_device->CreateConstantBufferView(&desc, cpuHandle);
+    return handle;
+}
+
+BindlessHandle BindlessResources::CreateShaderResourceView(ID3D12Resource*                        resource,
+                                                           const D3D12_SHADER_RESOURCE_VIEW_DESC* desc)
+{
+    CD3DX12_CPU_DESCRIPTOR_HANDLE cpuHandle;
+    const BindlessHandle          handle = Allocate(cpuHandle);
+    m_device->CreateShaderResourceView(resource, desc, cpuHandle);
+    return handle;
+}
+
+BindlessHandle BindlessResources::CreateUnorderedAccessView(ID3D12Resource*                         resource,
+                                                            const D3D12_UNORDERED_ACCESS_VIEW_DESC* desc)
+{
+    CD3DX12_CPU_DESCRIPTOR_HANDLE cpuHandle;
+    const BindlessHandle          handle = Allocate(cpuHandle);
+    m_device->CreateUnorderedAccessView(resource, nullptr, desc, cpuHandle);
+    return handle;
+}
+
+void BindlessResources::Release(const BindlessHandle& handle)
+{
+    const DescriptorAllocation allocation = m_registry.Unregister(handle);
+    assert(allocation.IsValid() && "Released a stale bindless handle");
+    m_descriptors.FreePersistent(allocation);
+}
+
+uint32_t BindlessResources::Index(const BindlessHandle& handle) const
+{
+    const uint32_t index = m_registry.Resolve(handle);
+    assert(index != BindlessHandle::InvalidIndex && "Used a stale bindless handle");
+    return index;
+}
+
+const BindlessRegistry& BindlessResources::Registry() const
+{
+    return m_registry;
+}
+
+winrt::com_ptr<ID3D12RootSignature> BindlessResources::CreateRootSignature(
+    const UINT drawConstantCount, const UINT numStaticSamplers, const D3D12_STATIC_SAMPLER_DESC* staticSamplers) const
+{
+    D3D12_FEATURE_DATA_ROOT_SIGNATURE featureData = {D3D_ROOT_SIGNATURE_VERSION_1_1};
+    if (FAILED(m_device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &featureData, sizeof(featureData))))
+    {
+        throw std::runtime_error("Bindless resources need root signature version 1.1");
+    }
+
+    CD3DX12_ROOT_PARAMETER1 rootParams[2];
+    rootParams[DrawConstantsParameter].InitAsConstants(drawConstantCount, 0, 0, D3D12_SHADER_VISIBILITY_ALL);
+    rootParams[FrameConstantsParameter].InitAsConstantBufferView(
+        1, 0, D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE, D3D12_SHADER_VISIBILITY_ALL);
+
+    // Shaders reach every view through the heap, so the input assembler is the only other input.
+    constexpr D3D12_ROOT_SIGNATURE_FLAGS rootSignatureFlags =
+        D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT |
+        D3D12_ROOT_SIGNATURE_FLAG_CBV_SRV_UAV_HEAP_DIRECTLY_INDEXED |
+        D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS |
+        D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS |
+        D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS;
+
+    CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+    rootSignatureDesc.Init_1_1(_countof(rootParams), rootParams, numStaticSamplers, staticSamplers,
+                               rootSignatureFlags);
+
+    winrt::com_ptr<ID3DBlob> signature;
+    winrt::com_ptr<ID3DBlob> error;
+    winrt::check_hresult(D3DX12SerializeVersionedRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_1,
+                                                               signature.put(), error.put()));
+
+    return GraphicsPipelineCache::CreateRootSignature(m_device, signature->GetBufferPointer(),
+                                                      signature->GetBufferSize());
+}
+
+void BindlessResources::Bind(CommandContext& context, ID3D12RootSignature* rootSignature) const
+{
+    // The heap must be bound before a root signature that indexes it directly.
+    ID3D12DescriptorHeap* heaps[] = {m_descriptors.ShaderVisibleHeap()};
+    context.SetDescriptorHeaps(_countof(heaps), heaps);
+    context.SetGraphicsRootSignature(rootSignature);
+}
+
+BindlessHandle BindlessResources::Allocate(CD3DX12_CPU_DESCRIPTOR_HANDLE& cpuHandle)
+{
+    const DescriptorAllocation allocation = m_descriptors.AllocatePersistent();
+    cpuHandle = m_descriptors.CpuHandle(allocation);
+    return m_registry.Register(allocation);
+}
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+#include <directx/d3d12.h>
+#include <directx/d3dx12.h>
+#include <winrt/base.h>
+
+#include "BindlessRegistry.hpp"
+#include "CommandContext.hpp"
+#include "DescriptorManager.hpp"
+
+/// @brief Exposes the whole CBV/SRV/UAV heap of a DescriptorManager to shaders.
+///
+/// Views are created in persistent descriptors and identified by their index in the heap.
+/// Root signatures made by CreateRootSignature() have no descriptor tables: shaders read
+/// ResourceDescriptorHeap[index] (shader model 6.6) and each draw passes its indices as root
+/// constants, so switching materials never switches tables. Constants that change every
+/// frame are bound as a root view of UploadAllocator memory instead, since they would need
+/// a new descriptor each frame. Bindless.hlsli has the shader side of this.
+class BindlessResources final
+{
+public:
+    /// Root parameter that holds the per-draw indices, visible to shaders as register b0.
+    static constexpr UINT DrawConstantsParameter = 0;
+
+    /// Root constant buffer view for constants written every frame, visible to shaders as register b1.
+    static constexpr UINT FrameConstantsParameter = 1;
+
+    /// @throws std::runtime_error if the device does not support shader model 6.6.
+    BindlessResources(ID3D12Device* device, DescriptorManager& descriptors);
+
+    [[nodiscard]] BindlessHandle CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC& desc);
+
+    [[nodiscard]] BindlessHandle CreateShaderResourceView(ID3D12Resource*                        resource,
+                                                          const D3D12_SHADER_RESOURCE_VIEW_DESC* desc);
+
+    [[nodiscard]] BindlessHandle CreateUnorderedAccessView(ID3D12Resource*                         resource,
+                                                           const D3D12_UNORDERED_ACCESS_VIEW_DESC* desc);
+
+    /// @brief Releases a view. Its index is reused once the frames recorded so far have finished.
+    void Release(const BindlessHandle& handle);
+
+    /// @brief Gets the index shaders use to read the view.
+    [[nodiscard]] uint32_t Index(const BindlessHandle& handle) const;
+
+    [[nodiscard]] const BindlessRegistry& Registry() const;
+
+    /// @brief Creates a root signature with drawConstantCount 32-bit root constants, a root constant
+    /// buffer view and direct heap access.
+    [[nodiscard]] winrt::com_ptr<ID3D12RootSignature> CreateRootSignature(
+        UINT drawConstantCount, UINT numStaticSamplers, const D3D12_STATIC_SAMPLER_DESC* staticSamplers) const;
+
+    /// @brief Binds the heap and a root signature made by CreateRootSignature().
+    void Bind(CommandContext& context, ID3D12RootSignature* rootSignature) const;
+
+private:
+    [[nodiscard]] BindlessHandle Allocate(CD3DX12_CPU_DESCRIPTOR_HANDLE& cpuHandle);
+
+    ID3D12Device*      m_device;
+    DescriptorManager& m_descriptors;
+    BindlessRegistry   m_registry;
+};
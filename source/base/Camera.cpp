@@ -2,6 +2,10 @@
 
 #include "Camera.hpp"
 
+#include <cassert>
+
+#include "TransformKernels.hpp"
+
 Camera::Camera(Vector3 position,
                Vector3 direction,
                Vector3 up,
@@ -14,7 +18,6 @@ Camera::Camera(Vector3 position,
     : m_position(position), m_direction(direction), m_fieldOfView(fov), m_aspectRatio(aspectRatio),
       m_nearPlane(nearPlane), m_farPlane(farPlane), m_viewWidth(viewWidth), m_viewHeight(viewHeight)
 {
-    updateUniforms();
 }
 
 void Camera::setProjection(const float fov,
@@ -30,12 +33,18 @@ void Camera::setProjection(const float fov,
     m_farPlane = farPlane;
     m_viewWidth = viewWidth;
     m_viewHeight = viewHeight;
-    updateUniforms();
+    invalidateProjection();
 }
 
 Matrix Camera::viewProjection() const
 {
-    return m_view * m_projection;
+    updateMatrices();
+    return m_viewProjection;
+}
+
+uint64_t Camera::version() const
+{
+    return m_version;
 }
 
 float Camera::viewWidth() const
@@ -48,13 +57,50 @@ float Camera::viewHeight() const
     return m_viewHeight;
 }
 
+float Camera::fieldOfView() const
+{
+    return m_fieldOfView;
+}
+
+float Camera::aspectRatio() const
+{
+    return m_aspectRatio;
+}
+
+float Camera::nearPlane() const
+{
+    return m_nearPlane;
+}
+
+float Camera::farPlane() const
+{
+    return m_farPlane;
+}
+
+Matrix Camera::view() const
+{
+    updateMatrices();
+    return m_view;
+}
+
+Matrix Camera::projection() const
+{
+    updateMatrices();
+    return m_projection;
+}
+
+Vector3 Camera::position() const
+{
+    return m_position;
+}
+
 void Camera::moveForward(const float dt)
 {
     Vector3 forward = direction();
     forward.y = 0.0f; // Lock movement to the x and z axes
     forward.Normalize();
     m_position += forward * dt * m_speed;
-    updateUniforms();
+    invalidateView();
 }
 
 void Camera::moveBackward(const float dt)
@@ -63,7 +109,7 @@ void Camera::moveBackward(const float dt)
     backward.y = 0.0f; // Lock movement to the x and z axes
     backward.Normalize();
     m_position -= backward * dt * m_speed;
-    updateUniforms();
+    invalidateView();
 }
 
 void Camera::strafeLeft(const float dt)
@@ -71,7 +117,7 @@ void Camera::strafeLeft(const float dt)
     auto _right = right();
     _right.y = 0.0f;
     m_position -= _right * dt * m_speed;
-    updateUniforms();
+    invalidateView();
 }
 
 void Camera::strafeRight(const float dt)
@@ -79,19 +125,19 @@ void Camera::strafeRight(const float dt)
     auto _right = right();
     _right.y = 0.0f;
     m_position += _right * dt * m_speed;
-    updateUniforms();
+    invalidateView();
 }
 
 void Camera::setPosition(const Vector3& position)
 {
     m_position = position;
-    updateUniforms();
+    invalidateView();
 }
 
 void Camera::setRotation(const Vector3& rotation)
 {
     m_rotation = rotation;
-    updateUniforms();
+    invalidateView();
 }
 
 void Camera::rotate(const float pitch, const float yaw)
@@ -99,7 +145,7 @@ void Camera::rotate(const float pitch, const float yaw)
     m_orientation = Quaternion::CreateFromYawPitchRoll(yaw, pitch, 0.0f);
     m_orientation.Normalize();
 
-    updateUniforms();
+    invalidateView();
 }
 
 Vector3 Camera::direction() const
@@ -116,9 +162,58 @@ Vector3 Camera::right() const
     return right;
 }
 
-void Camera::updateUniforms()
+void Camera::invalidateView()
+{
+    m_viewDirty = true;
+    ++m_version;
+}
+
+void Camera::invalidateProjection()
+{
+    m_projectionDirty = true;
+    ++m_version;
+}
+
+void Camera::updateMatrices() const
 {
-    m_view = Matrix::CreateLookAt(m_position, m_position + direction(), Vector3::Up);
-    m_projection = Matrix::CreatePerspectiveFieldOfView(m_fieldOfView, m_aspectRatio, m_nearPlane, m_farPlane);
+    if (!m_viewDirty && !m_projectionDirty)
+    {
+        return;
+    }
+
+    if (m_viewDirty)
+    {
+        m_view = Matrix::CreateLookAt(m_position, m_position + direction(), Vector3::Up);
+        m_viewDirty = false;
+    }
+
+    if (m_projectionDirty)
+    {
+        m_projection = Matrix::CreatePerspectiveFieldOfView(m_fieldOfView, m_aspectRatio, m_nearPlane, m_farPlane);
+        m_projectionDirty = false;
+    }
+
     m_viewProjection = m_view * m_projection;
-}
\ No newline at end of file
+}
+
+void Camera::computeViewProjections(const std::span<const Matrix> views,
+                                    const std::span<const Matrix> projections,
+                                    const std::span<Matrix>       viewProjections)
+{
+    assert(projections.size() == 1 || projections.size() == views.size());
+    assert(viewProjections.size() >= views.size());
+
+    // Cube faces and cascades typically share one projection, which the kernels keep in registers.
+    TransformKernels::MultiplyMatrices(views, projections, viewProjections);
+}
+
+void Camera::computeViewProjections(const std::span<const Camera* const> cameras,
+                                    const std::span<Matrix>              viewProjections)
+{
+    assert(viewProjections.size() >= cameras.size());
+
+    for (size_t i = 0; i < cameras.size(); ++i)
+    {
+        viewProjections[i] = cameras[i]->viewProjection();
+    }
+}
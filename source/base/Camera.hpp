@@ -2,8 +2,16 @@
 
 #pragma once
 
+#include <cstdint>
+#include <span>
+
 #include "GraphicsMath.hpp"
 
+/// @brief First-person perspective camera.
+///
+/// Movement and projection changes only mark the matrices stale; they are rebuilt on
+/// the next read. Reads are therefore not safe to race with each other until the
+/// matrices have been evaluated once after a change.
 class Camera
 {
 public:
@@ -21,8 +29,27 @@ public:
 
     [[nodiscard]] float viewHeight() const;
 
+    [[nodiscard]] float fieldOfView() const;
+
+    [[nodiscard]] float aspectRatio() const;
+
+    [[nodiscard]] float nearPlane() const;
+
+    [[nodiscard]] float farPlane() const;
+
+    [[nodiscard]] Matrix view() const;
+
+    [[nodiscard]] Matrix projection() const;
+
     [[nodiscard]] Matrix viewProjection() const;
 
+    /// @brief Gets a counter that changes whenever the view or projection does.
+    ///
+    /// Consumers can keep the last value they saw and skip re-uploading camera constants while it matches.
+    [[nodiscard]] uint64_t version() const;
+
+    [[nodiscard]] Vector3 position() const;
+
     [[nodiscard]] Vector3 direction() const;
 
     [[nodiscard]] Vector3 right() const;
@@ -44,21 +71,39 @@ public:
     void setProjection(
         float fov, float aspectRatio, float nearPlane, float farPlane, float viewWidth, float viewHeight);
 
+    /// @brief Computes view * projection for many views in one pass.
+    /// @param [in] views View matrices.
+    /// @param [in] projections Either one projection per view or a single shared projection.
+    /// @param [out] viewProjections Receives one matrix per view.
+    static void computeViewProjections(std::span<const Matrix> views,
+                                       std::span<const Matrix> projections,
+                                       std::span<Matrix>       viewProjections);
+
+    /// @brief Gets the view-projection matrix of many cameras, e.g. for split-screen.
+    static void computeViewProjections(std::span<const Camera* const> cameras, std::span<Matrix> viewProjections);
+
 private:
-    void updateUniforms();
-
-    Quaternion m_orientation;
-    Matrix     m_viewProjection;
-    Matrix     m_projection;
-    Matrix     m_view;
-    Vector3    m_position;
-    Vector3    m_direction;
-    Vector3    m_rotation;
-    float      m_fieldOfView;
-    float      m_aspectRatio;
-    float      m_nearPlane;
-    float      m_farPlane;
-    float      m_speed = 10.0f;
-    float      m_viewWidth = 800.0f;
-    float      m_viewHeight = 600.0f;
+    void invalidateView();
+
+    void invalidateProjection();
+
+    void updateMatrices() const;
+
+    Quaternion     m_orientation;
+    mutable Matrix m_viewProjection;
+    mutable Matrix m_projection;
+    mutable Matrix m_view;
+    mutable bool   m_viewDirty = true;
+    mutable bool   m_projectionDirty = true;
+    uint64_t       m_version = 0;
+    Vector3        m_position;
+    Vector3        m_direction;
+    Vector3        m_rotation;
+    float          m_fieldOfView;
+    float          m_aspectRatio;
+    float          m_nearPlane;
+    float          m_farPlane;
+    float          m_speed = 10.0f;
+    float          m_viewWidth = 800.0f;
+    float          m_viewHeight = 600.0f;
 };
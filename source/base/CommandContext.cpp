@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CommandContext.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+void CommandContext::Begin(CommandBackend& backend)
+{
+    m_backend = &backend;
+    m_stats = {};
+    Invalidate();
+}
+
+void CommandContext::Continue(CommandBackend& backend)
+{
+    m_backend = &backend;
+    Invalidate();
+}
+
+void CommandContext::Merge(const Statistics& stats)
+{
+    m_stats.Issued += stats.Issued;
+    m_stats.Elided += stats.Elided;
+}
+
+void CommandContext::Invalidate()
+{
+    m_rootSignature = nullptr;
+    m_pipelineState = nullptr;
+    m_descriptorHeaps.fill(nullptr);
+    m_numDescriptorHeaps = 0;
+    m_topology = UnknownTopology;
+    m_vertexBufferValid.fill(false);
+    m_indexBufferValid = false;
+    InvalidateRootArguments();
+}
+
+CommandBackend& CommandContext::Backend() const
+{
+    assert(m_backend != nullptr);
+    return *m_backend;
+}
+
+const CommandContext::Statistics& CommandContext::Stats() const
+{
+    return m_stats;
+}
+
+bool CommandContext::Filter(const bool redundant)
+{
+    if (redundant)
+    {
+        ++m_stats.Elided;
+        return false;
+    }
+
+    ++m_stats.Issued;
+    return true;
+}
+
+void CommandContext::InvalidateRootArguments()
+{
+    m_rootArguments.fill({});
+}
+
+void CommandContext::InvalidateDescriptorTables()
+{
+    // Root views hold GPU addresses rather than heap offsets, so they survive a heap change.
+    for (RootArgument& argument : m_rootArguments)
+    {
+        if (argument.Kind == RootArgumentKind::DescriptorTable)
+        {
+            argument = {};
+        }
+    }
+}
+
+void CommandContext::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature)
+{
+    if (Filter(rootSignature == m_rootSignature))
+    {
+        m_backend->SetGraphicsRootSignature(rootSignature);
+        m_rootSignature = rootSignature;
+        InvalidateRootArguments();
+    }
+}
+
+void CommandContext::SetDescriptorHeaps(const uint32_t numHeaps, ID3D12DescriptorHeap* const* heaps)
+{
+    const bool redundant = numHeaps != 0 && numHeaps == m_numDescriptorHeaps &&
+                           std::equal(heaps, heaps + numHeaps, m_descriptorHeaps.begin());
+    if (Filter(redundant))
+    {
+        m_backend->SetDescriptorHeaps(numHeaps, heaps);
+
+        m_numDescriptorHeaps = std::min(numHeaps, MaxDescriptorHeaps);
+        std::copy_n(heaps, m_numDescriptorHeaps, m_descriptorHeaps.begin());
+        InvalidateDescriptorTables();
+    }
+}
+
+void CommandContext::SetPipelineState(ID3D12PipelineState* pipelineState)
+{
+    if (Filter(pipelineState == m_pipelineState))
+    {
+        m_backend->SetPipelineState(pipelineState);
+        m_pipelineState = pipelineState;
+    }
+}
+
+void CommandContext::IASetPrimitiveTopology(const uint32_t topology)
+{
+    if (Filter(topology == m_topology))
+    {
+        m_backend->IASetPrimitiveTopology(topology);
+        m_topology = topology;
+    }
+}
+
+void CommandContext::SetGraphicsRootDescriptorTable(const uint32_t rootParameterIndex, const uint64_t baseDescriptor)
+{
+    assert(rootParameterIndex < MaxRootParameters);
+
+    RootArgument& argument = m_rootArguments[rootParameterIndex];
+    if (Filter(argument.Kind == RootArgumentKind::DescriptorTable && argument.Value == baseDescriptor))
+    {
+        m_backend->SetGraphicsRootDescriptorTable(rootParameterIndex, baseDescriptor);
+        argument = {RootArgumentKind::DescriptorTable, baseDescriptor};
+    }
+}
+
+void CommandContext::SetGraphicsRootConstantBufferView(const uint32_t rootParameterIndex, const uint64_t bufferLocation)
+{
+    assert(rootParameterIndex < MaxRootParameters);
+
+    RootArgument& argument = m_rootArguments[rootParameterIndex];
+    if (Filter(argument.Kind == RootArgumentKind::ConstantBufferView && argument.Value == bufferLocation))
+    {
+        m_backend->SetGraphicsRootConstantBufferView(rootParameterIndex, bufferLocation);
+        argument = {RootArgumentKind::ConstantBufferView, bufferLocation};
+    }
+}
+
+void CommandContext::SetGraphicsRoot32BitConstants(const uint32_t rootParameterIndex,
+                                                   const uint32_t num32BitValues,
+                                                   const void*    srcData,
+                                                   const uint32_t destOffsetIn32BitValues)
+{
+    // Constants are cheap to set and rarely repeat exactly, so they are always forwarded.
+    m_backend->SetGraphicsRoot32BitConstants(rootParameterIndex, num32BitValues, srcData, destOffsetIn32BitValues);
+}
+
+void CommandContext::IASetVertexBuffers(const uint32_t          startSlot,
+                                        const uint32_t          numViews,
+                                        const VertexBufferView* views)
+{
+    assert(startSlot + numViews <= MaxVertexBufferSlots);
+
+    bool redundant = views != nullptr;
+    for (uint32_t i = 0; i < numViews && redundant; ++i)
+    {
+        const VertexBufferView& bound = m_vertexBuffers[startSlot + i];
+        redundant = m_vertexBufferValid[startSlot + i] && bound.BufferLocation == views[i].BufferLocation &&
+                    bound.SizeInBytes == views[i].SizeInBytes && bound.StrideInBytes == views[i].StrideInBytes;
+    }
+
+    if (Filter(redundant))
+    {
+        m_backend->IASetVertexBuffers(startSlot, numViews, views);
+        for (uint32_t i = 0; i < numViews; ++i)
+        {
+            m_vertexBufferValid[startSlot + i] = views != nullptr;
+            if (views != nullptr)
+            {
+                m_vertexBuffers[startSlot + i] = views[i];
+            }
+        }
+    }
+}
+
+void CommandContext::IASetIndexBuffer(const IndexBufferView* view)
+{
+    const bool redundant = view != nullptr && m_indexBufferValid &&
+                           m_indexBuffer.BufferLocation == view->BufferLocation &&
+                           m_indexBuffer.SizeInBytes == view->SizeInBytes && m_indexBuffer.Format == view->Format;
+    if (Filter(redundant))
+    {
+        m_backend->IASetIndexBuffer(view);
+        m_indexBufferValid = view != nullptr;
+        if (view != nullptr)
+        {
+            m_indexBuffer = *view;
+        }
+    }
+}
+
+void CommandContext::ResourceBarrier(const uint32_t numBarriers, const D3D12_RESOURCE_BARRIER* barriers)
+{
+    m_backend->ResourceBarrier(numBarriers, barriers);
+}
+
+void CommandContext::DrawInstanced(const uint32_t vertexCountPerInstance,
+                                   const uint32_t instanceCount,
+                                   const uint32_t startVertexLocation,
+                                   const uint32_t startInstanceLocation)
+{
+    m_backend->DrawInstanced(vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation);
+}
+
+void CommandContext::DrawIndexedInstanced(const uint32_t indexCountPerInstance,
+                                          const uint32_t instanceCount,
+                                          const uint32_t startIndexLocation,
+                                          const int32_t  baseVertexLocation,
+                                          const uint32_t startInstanceLocation)
+{
+    m_backend->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation,
+                                    startInstanceLocation);
+}
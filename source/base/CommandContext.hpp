@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+struct ID3D12DescriptorHeap;
+struct ID3D12GraphicsCommandList;
+struct ID3D12PipelineState;
+struct ID3D12RootSignature;
+struct D3D12_RESOURCE_BARRIER;
+
+/// Vertex buffer binding laid out like D3D12_VERTEX_BUFFER_VIEW.
+struct VertexBufferView
+{
+    uint64_t BufferLocation = 0;
+    uint32_t SizeInBytes = 0;
+    uint32_t StrideInBytes = 0;
+};
+
+/// Index buffer binding laid out like D3D12_INDEX_BUFFER_VIEW; Format holds a DXGI_FORMAT.
+struct IndexBufferView
+{
+    uint64_t BufferLocation = 0;
+    uint32_t SizeInBytes = 0;
+    uint32_t Format = 0;
+};
+
+/// @brief Receives the command stream after redundant calls were filtered out.
+///
+/// Objects are opaque pointers that are only compared, descriptors and buffers are GPU
+/// addresses and the topology is a D3D12_PRIMITIVE_TOPOLOGY value.
+class CommandBackend
+{
+public:
+    virtual ~CommandBackend() = default;
+
+    virtual void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) = 0;
+
+    virtual void SetDescriptorHeaps(uint32_t numHeaps, ID3D12DescriptorHeap* const* heaps) = 0;
+
+    virtual void SetPipelineState(ID3D12PipelineState* pipelineState) = 0;
+
+    virtual void IASetPrimitiveTopology(uint32_t topology) = 0;
+
+    virtual void SetGraphicsRootDescriptorTable(uint32_t rootParameterIndex, uint64_t baseDescriptor) = 0;
+
+    virtual void SetGraphicsRootConstantBufferView(uint32_t rootParameterIndex, uint64_t bufferLocation) = 0;
+
+    virtual void SetGraphicsRoot32BitConstants(uint32_t    rootParameterIndex,
+                                               uint32_t    num32BitValues,
+                                               const void* srcData,
+                                               uint32_t    destOffsetIn32BitValues) = 0;
+
+    virtual void IASetVertexBuffers(uint32_t startSlot, uint32_t numViews, const VertexBufferView* views) = 0;
+
+    virtual void IASetIndexBuffer(const IndexBufferView* view) = 0;
+
+    virtual void ResourceBarrier(uint32_t numBarriers, const D3D12_RESOURCE_BARRIER* barriers) = 0;
+
+    virtual void DrawInstanced(uint32_t vertexCountPerInstance,
+                               uint32_t instanceCount,
+                               uint32_t startVertexLocation,
+                               uint32_t startInstanceLocation) = 0;
+
+    virtual void DrawIndexedInstanced(uint32_t indexCountPerInstance,
+                                      uint32_t instanceCount,
+                                      uint32_t startIndexLocation,
+                                      int32_t  baseVertexLocation,
+                                      uint32_t startInstanceLocation) = 0;
+};
+
+/// @brief CommandBackend that records into a D3D12 graphics command list.
+class D3D12CommandBackend final : public CommandBackend
+{
+public:
+    explicit D3D12CommandBackend(ID3D12GraphicsCommandList* commandList);
+
+    [[nodiscard]] ID3D12GraphicsCommandList* CommandList() const;
+
+    void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) override;
+
+    void SetDescriptorHeaps(uint32_t numHeaps, ID3D12DescriptorHeap* const* heaps) override;
+
+    void SetPipelineState(ID3D12PipelineState* pipelineState) override;
+
+    void IASetPrimitiveTopology(uint32_t topology) override;
+
+    void SetGraphicsRootDescriptorTable(uint32_t rootParameterIndex, uint64_t baseDescriptor) override;
+
+    void SetGraphicsRootConstantBufferView(uint32_t rootParameterIndex, uint64_t bufferLocation) override;
+
+    void SetGraphicsRoot32BitConstants(uint32_t    rootParameterIndex,
+                                       uint32_t    num32BitValues,
+                                       const void* srcData,
+                                       uint32_t    destOffsetIn32BitValues) override;
+
+    void IASetVertexBuffers(uint32_t startSlot, uint32_t numViews, const VertexBufferView* views) override;
+
+    void IASetIndexBuffer(const IndexBufferView* view) override;
+
+    void ResourceBarrier(uint32_t numBarriers, const D3D12_RESOURCE_BARRIER* barriers) override;
+
+    void DrawInstanced(uint32_t vertexCountPerInstance,
+                       uint32_t instanceCount,
+                       uint32_t startVertexLocation,
+                       uint32_t startInstanceLocation) override;
+
+    void DrawIndexedInstanced(uint32_t indexCountPerInstance,
+                              uint32_t instanceCount,
+                              uint32_t startIndexLocation,
+                              int32_t  baseVertexLocation,
+                              uint32_t startInstanceLocation) override;
+
+private:
+    ID3D12GraphicsCommandList* m_commandList;
+};
+
+/// @brief Shadows bound pipeline state and drops calls that would not change it.
+///
+/// Call Begin() whenever the underlying command list is reset, since a reset list
+/// starts with undefined state. Changing the root signature forgets every root
+/// argument and changing the descriptor heaps forgets the descriptor tables, matching
+/// D3D12 invalidation rules.
+class CommandContext final
+{
+public:
+    struct Statistics
+    {
+        uint32_t Issued = 0; ///< Filterable calls forwarded to the backend.
+        uint32_t Elided = 0; ///< Filterable calls dropped because the state was already bound.
+    };
+
+    static constexpr uint32_t MaxRootParameters = 64;
+    static constexpr uint32_t MaxVertexBufferSlots = 32; ///< D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT
+    static constexpr uint32_t MaxDescriptorHeaps = 2;
+
+    /// @brief Starts recording into a backend with unknown bound state and clears the statistics.
+    void Begin(CommandBackend& backend);
+
+    /// @brief Moves on to another backend with unknown bound state, keeping the statistics.
+    ///
+    /// Used when a frame continues in a new command list, e.g. after lists recorded on
+    /// other threads.
+    void Continue(CommandBackend& backend);
+
+    /// @brief Forgets all shadowed state, e.g. after recording directly into the command list.
+    void Invalidate();
+
+    /// @brief Adds the calls counted by another context, e.g. one a worker thread recorded with.
+    void Merge(const Statistics& stats);
+
+    [[nodiscard]] CommandBackend& Backend() const;
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+    void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature);
+
+    void SetDescriptorHeaps(uint32_t numHeaps, ID3D12DescriptorHeap* const* heaps);
+
+    void SetPipelineState(ID3D12PipelineState* pipelineState);
+
+    void IASetPrimitiveTopology(uint32_t topology);
+
+    void SetGraphicsRootDescriptorTable(uint32_t rootParameterIndex, uint64_t baseDescriptor);
+
+    void SetGraphicsRootConstantBufferView(uint32_t rootParameterIndex, uint64_t bufferLocation);
+
+    void SetGraphicsRoot32BitConstants(uint32_t    rootParameterIndex,
+                                       uint32_t    num32BitValues,
+                                       const void* srcData,
+                                       uint32_t    destOffsetIn32BitValues);
+
+    void IASetVertexBuffers(uint32_t startSlot, uint32_t numViews, const VertexBufferView* views);
+
+    void IASetIndexBuffer(const IndexBufferView* view);
+
+    void ResourceBarrier(uint32_t numBarriers, const D3D12_RESOURCE_BARRIER* barriers);
+
+    void DrawInstanced(uint32_t vertexCountPerInstance,
+                       uint32_t instanceCount,
+                       uint32_t startVertexLocation,
+                       uint32_t startInstanceLocation);
+
+    void DrawIndexedInstanced(uint32_t indexCountPerInstance,
+                              uint32_t instanceCount,
+                              uint32_t startIndexLocation,
+                              int32_t  baseVertexLocation,
+                              uint32_t startInstanceLocation);
+
+private:
+    enum class RootArgumentKind : uint8_t
+    {
+        Unknown,
+        DescriptorTable,
+        ConstantBufferView,
+    };
+
+    struct RootArgument
+    {
+        RootArgumentKind Kind = RootArgumentKind::Unknown;
+        uint64_t         Value = 0;
+    };
+
+    /// Never a valid D3D12_PRIMITIVE_TOPOLOGY, so the first topology is always issued.
+    static constexpr uint32_t UnknownTopology = UINT32_MAX;
+
+    bool Filter(bool redundant);
+
+    void InvalidateRootArguments();
+
+    void InvalidateDescriptorTables();
+
+    CommandBackend*                                       m_backend = nullptr;
+    Statistics                                            m_stats;
+    ID3D12RootSignature*                                  m_rootSignature = nullptr;
+    ID3D12PipelineState*                                  m_pipelineState = nullptr;
+    std::array<ID3D12DescriptorHeap*, MaxDescriptorHeaps> m_descriptorHeaps{};
+    uint32_t                                              m_numDescriptorHeaps = 0;
+    uint32_t                                              m_topology = UnknownTopology;
+    std::array<RootArgument, MaxRootParameters>           m_rootArguments{};
+    std::array<VertexBufferView, MaxVertexBufferSlots>    m_vertexBuffers{};
+    std::array<bool, MaxVertexBufferSlots>                m_vertexBufferValid{};
+    IndexBufferView                                       m_indexBuffer{};
+    bool                                                  m_indexBufferValid = false;
+};
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CommandContext.hpp"
+
+#include <cstddef>
+
+#include <directx/d3d12.h>
+
+static_assert(CommandContext::MaxVertexBufferSlots == D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT);
+
+// The views are passed straight through, so they must match the D3D12 structures member for member.
+static_assert(sizeof(VertexBufferView) == sizeof(D3D12_VERTEX_BUFFER_VIEW));
+static_assert(offsetof(VertexBufferView, BufferLocation) == offsetof(D3D12_VERTEX_BUFFER_VIEW, BufferLocation));
+static_assert(offsetof(VertexBufferView, SizeInBytes) == offsetof(D3D12_VERTEX_BUFFER_VIEW, SizeInBytes));
+static_assert(offsetof(VertexBufferView, StrideInBytes) == offsetof(D3D12_VERTEX_BUFFER_VIEW, StrideInBytes));
+static_assert(sizeof(IndexBufferView) == sizeof(D3D12_INDEX_BUFFER_VIEW));
+static_assert(offsetof(IndexBufferView, BufferLocation) == offsetof(D3D12_INDEX_BUFFER_VIEW, BufferLocation));
+static_assert(offsetof(IndexBufferView, SizeInBytes) == offsetof(D3D12_INDEX_BUFFER_VIEW, SizeInBytes));
+static_assert(offsetof(IndexBufferView, Format) == offsetof(D3D12_INDEX_BUFFER_VIEW, Format));
+
+D3D12CommandBackend::D3D12CommandBackend(ID3D12GraphicsCommandList* commandList) : m_commandList(commandList)
+{
+}
+
+ID3D12GraphicsCommandList* D3D12CommandBackend::CommandList() const
+{
+    return m_commandList;
+}
+
+void D3D12CommandBackend::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature)
+{
+    m_commandList->SetGraphicsRootSignature(rootSignature);
+}
+
+void D3D12CommandBackend::SetDescriptorHeaps(const uint32_t numHeaps, ID3D12DescriptorHeap* const* heaps)
+{
+    m_commandList->SetDescriptorHeaps(numHeaps, heaps);
+}
+
+void D3D12CommandBackend::SetPipelineState(ID3D12PipelineState* pipelineState)
+{
+    m_commandList->SetPipelineState(pipelineState);
+}
+
+void D3D12CommandBackend::IASetPrimitiveTopology(const uint32_t topology)
+{
+    m_commandList->IASetPrimitiveTopology(static_cast<D3D12_PRIMITIVE_TOPOLOGY>(topology));
+}
+
+void D3D12CommandBackend::SetGraphicsRootDescriptorTable(const uint32_t rootParameterIndex,
+                                                         const uint64_t baseDescriptor)
+{
+    m_commandList->SetGraphicsRootDescriptorTable(rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE{baseDescriptor});
+}
+
+void D3D12CommandBackend::SetGraphicsRootConstantBufferView(const uint32_t rootParameterIndex,
+                                                            const uint64_t bufferLocation)
+{
+    m_commandList->SetGraphicsRootConstantBufferView(rootParameterIndex, bufferLocation);
+}
+
+void D3D12CommandBackend::SetGraphicsRoot32BitConstants(const uint32_t rootParameterIndex,
+                                                        const uint32_t num32BitValues,
+                                                        const void*    srcData,
+                                                        const uint32_t destOffsetIn32BitValues)
+{
+    m_commandList->SetGraphicsRoot32BitConstants(rootParameterIndex, num32BitValues, srcData,
+                                                 destOffsetIn32BitValues);
+}
+
+void D3D12CommandBackend::IASetVertexBuffers(const uint32_t          startSlot,
+                                             const uint32_t          numViews,
+                                             const VertexBufferView* views)
+{
+    m_commandList->IASetVertexBuffers(startSlot, numViews, reinterpret_cast<const D3D12_VERTEX_BUFFER_VIEW*>(views));
+}
+
+void D3D12CommandBackend::IASetIndexBuffer(const IndexBufferView* view)
+{
+    m_commandList->IASetIndexBuffer(reinterpret_cast<const D3D12_INDEX_BUFFER_VIEW*>(view));
+}
+
+void D3D12CommandBackend::ResourceBarrier(const uint32_t numBarriers, const D3D12_RESOURCE_BARRIER* barriers)
+{
+    m_commandList->ResourceBarrier(numBarriers, barriers);
+}
+
+void D3D12CommandBackend::DrawInstanced(const uint32_t vertexCountPerInstance,
+                                        const uint32_t instanceCount,
+                                        const uint32_t startVertexLocation,
+                                        const uint32_t startInstanceLocation)
+{
+    m_commandList->DrawInstanced(vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation);
+}
+
+void D3D12CommandBackend::DrawIndexedInstanced(const uint32_t indexCountPerInstance,
+                                               const uint32_t instanceCount,
+                                               const uint32_t startIndexLocation,
+                                               const int32_t  baseVertexLocation,
+                                               const uint32_t startInstanceLocation)
+{
+    m_commandList->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation,
+                                        startInstanceLocation);
+}
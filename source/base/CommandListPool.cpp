@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CommandListPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "ThreadPool.hpp"
+
+CommandListPool::CommandListPool(CommandListSource& source) : m_source(source)
+{
+}
+
+CommandListPool::~CommandListPool()
+{
+    assert(m_frameLists.empty());
+    for (const PooledCommandList& list : m_freeLists)
+    {
+        m_source.Destroy(list);
+    }
+    for (const RetiredList& retired : m_retiredLists)
+    {
+        m_source.Destroy(retired.List);
+    }
+}
+
+void CommandListPool::BeginFrame(const uint64_t completedFenceValue)
+{
+    const auto finished = std::find_if(m_retiredLists.begin(), m_retiredLists.end(), [&](const RetiredList& retired) {
+        return retired.FenceValue > completedFenceValue;
+    });
+    for (auto retired = m_retiredLists.begin(); retired != finished; ++retired)
+    {
+        m_freeLists.push_back(retired->List);
+    }
+    m_retiredLists.erase(m_retiredLists.begin(), finished);
+}
+
+PooledCommandList CommandListPool::Acquire()
+{
+    PooledCommandList list;
+    if (!m_freeLists.empty())
+    {
+        list = m_freeLists.back();
+        m_freeLists.pop_back();
+    }
+    else
+    {
+        list = m_source.Create();
+        ++m_stats.Lists;
+    }
+
+    m_source.Open(list);
+    m_frameLists.push_back(list);
+    return list;
+}
+
+void CommandListPool::Record(ThreadPool&           pool,
+                             const size_t          count,
+                             const size_t          minCountPerList,
+                             const RecordFunction& record)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    const size_t fullLists = std::max<size_t>(count / std::max<size_t>(minCountPerList, 1), 1);
+    const size_t maxLists = std::min<size_t>(pool.ThreadCount(), fullLists);
+    const size_t countPerList = (count + maxLists - 1) / maxLists;
+    const size_t listCount = (count + countPerList - 1) / countPerList;
+
+    // Acquired here, on the owning thread, so the order is fixed before any worker starts.
+    const size_t first = m_frameLists.size();
+    for (size_t i = 0; i < listCount; ++i)
+    {
+        (void)Acquire();
+    }
+
+    pool.ParallelFor(listCount, 1, [&](const size_t begin, const size_t end, uint32_t) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            record(m_frameLists[first + i], i * countPerList, std::min(count, (i + 1) * countPerList));
+        }
+    });
+}
+
+void CommandListPool::Submit(const uint64_t fenceValue)
+{
+    for (const PooledCommandList& list : m_frameLists)
+    {
+        m_source.Close(list);
+    }
+    if (!m_frameLists.empty())
+    {
+        m_source.Execute(m_frameLists);
+    }
+
+    for (const PooledCommandList& list : m_frameLists)
+    {
+        m_retiredLists.push_back({fenceValue, list});
+    }
+    m_stats.FrameLists = static_cast<uint32_t>(m_frameLists.size());
+    m_frameLists.clear();
+}
+
+const CommandListPool::Statistics& CommandListPool::Stats() const
+{
+    return m_stats;
+}
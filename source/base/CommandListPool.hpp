@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+struct ID3D12Device4;
+struct ID3D12CommandQueue;
+class ThreadPool;
+
+/// Command allocator with the one list that records into it.
+struct PooledCommandList
+{
+    void* Allocator = nullptr;
+    void* List = nullptr;
+};
+
+/// @brief Creates, opens and submits the command lists a CommandListPool hands out.
+///
+/// The D3D12 implementation makes allocators and lists for the type of its queue and
+/// submits to that queue.
+class CommandListSource
+{
+public:
+    virtual ~CommandListSource() = default;
+
+    /// @brief Creates an allocator and a closed list.
+    [[nodiscard]] virtual PooledCommandList Create() = 0;
+
+    virtual void Destroy(const PooledCommandList& list) = 0;
+
+    /// @brief Resets the allocator, whose work the GPU has finished, and opens the list on it.
+    virtual void Open(const PooledCommandList& list) = 0;
+
+    virtual void Close(const PooledCommandList& list) = 0;
+
+    /// @brief Submits closed lists in order with a single call.
+    virtual void Execute(std::span<const PooledCommandList> lists) = 0;
+};
+
+/// @brief CommandListSource that submits to a D3D12 command queue.
+class D3D12CommandListSource final : public CommandListSource
+{
+public:
+    D3D12CommandListSource(ID3D12Device4* device, ID3D12CommandQueue* queue);
+
+    [[nodiscard]] PooledCommandList Create() override;
+
+    void Destroy(const PooledCommandList& list) override;
+
+    void Open(const PooledCommandList& list) override;
+
+    void Close(const PooledCommandList& list) override;
+
+    void Execute(std::span<const PooledCommandList> lists) override;
+
+private:
+    ID3D12Device4*      m_device;
+    ID3D12CommandQueue* m_queue;
+    uint32_t            m_created = 0;
+};
+
+/// @brief Hands out a command allocator and list per recording thread and submits them in order.
+///
+/// Acquire() opens a list for the current frame and Submit() closes every list acquired
+/// since, executes them with one call in the order they were acquired, and tags them with
+/// the fence value the frame signals. BeginFrame() recycles the lists of frames the GPU
+/// has finished, so an allocator is never reset while its commands may still run. The pool
+/// grows to the most lists any frame used. Acquire() and Submit() belong to one thread;
+/// Record() fans the recording itself out.
+class CommandListPool final
+{
+public:
+    /// Records items [begin, end) into an open list. Runs on any thread of the pool.
+    using RecordFunction = std::function<void(const PooledCommandList& list, size_t begin, size_t end)>;
+
+    struct Statistics
+    {
+        uint32_t FrameLists = 0; ///< Lists submitted by the last Submit().
+        uint32_t Lists = 0;      ///< Lists created, free or in use.
+    };
+
+    explicit CommandListPool(CommandListSource& source);
+
+    CommandListPool(const CommandListPool&) = delete;
+    CommandListPool& operator=(const CommandListPool&) = delete;
+
+    ~CommandListPool();
+
+    /// @brief Recycles the lists of frames whose fence value has completed.
+    void BeginFrame(uint64_t completedFenceValue);
+
+    /// @brief Opens a list that is submitted after every list acquired before it.
+    [[nodiscard]] PooledCommandList Acquire();
+
+    /// @brief Records [0, count) into one list per contiguous range, in parallel across the pool.
+    ///
+    /// There are at most ThreadCount() ranges and each holds at least minCountPerList items, so
+    /// small batches do not pay for lists they cannot fill. The lists are acquired in range order,
+    /// which keeps the submission order of the items.
+    void Record(ThreadPool& pool, size_t count, size_t minCountPerList, const RecordFunction& record);
+
+    /// @brief Closes and executes the lists acquired since the last call, tagged with the fence value.
+    void Submit(uint64_t fenceValue);
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+private:
+    struct RetiredList
+    {
+        uint64_t          FenceValue;
+        PooledCommandList List;
+    };
+
+    CommandListSource&             m_source;
+    std::vector<PooledCommandList> m_freeLists;
+    std::vector<RetiredList>       m_retiredLists; ///< In fence order.
+    std::vector<PooledCommandList> m_frameLists;   ///< Open lists of the current frame, in submission order.
+    Statistics                     m_stats;
+};
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CommandListPool.hpp"
+
+#include <string>
+#include <vector>
+
+#include <directx/d3d12.h>
+#include <fmt/xchar.h>
+#include <winrt/base.h>
+
+namespace
+{
+    ID3D12CommandAllocator* Allocator(const PooledCommandList& list)
+    {
+        return static_cast<ID3D12CommandAllocator*>(list.Allocator);
+    }
+
+    ID3D12GraphicsCommandList* GraphicsList(const PooledCommandList& list)
+    {
+        return static_cast<ID3D12GraphicsCommandList*>(list.List);
+    }
+} // namespace
+
+D3D12CommandListSource::D3D12CommandListSource(ID3D12Device4* device, ID3D12CommandQueue* queue)
+    : m_device(device), m_queue(queue)
+{
+}
+
+PooledCommandList D3D12CommandListSource::Create()
+{
+    const D3D12_COMMAND_LIST_TYPE type = m_queue->GetDesc().Type;
+
+    winrt::com_ptr<ID3D12CommandAllocator> allocator;
+    winrt::check_hresult(m_device->CreateCommandAllocator(type, IID_PPV_ARGS(&allocator)));
+    std::wstring name = fmt::format(L"CommandListPool::CommandAllocator{}", m_created);
+    winrt::check_hresult(allocator->SetName(name.c_str()));
+
+    // CreateCommandList1 makes the list closed and unbound, so any free allocator can open it.
+    winrt::com_ptr<ID3D12GraphicsCommandList> list;
+    winrt::check_hresult(m_device->CreateCommandList1(0, type, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&list)));
+    name = fmt::format(L"CommandListPool::CommandList{}", m_created);
+    winrt::check_hresult(list->SetName(name.c_str()));
+
+    ++m_created;
+    return {allocator.detach(), list.detach()};
+}
+
+void D3D12CommandListSource::Destroy(const PooledCommandList& list)
+{
+    winrt::com_ptr<ID3D12CommandAllocator> allocator;
+    allocator.attach(Allocator(list));
+    winrt::com_ptr<ID3D12GraphicsCommandList> commandList;
+    commandList.attach(GraphicsList(list));
+}
+
+void D3D12CommandListSource::Open(const PooledCommandList& list)
+{
+    winrt::check_hresult(Allocator(list)->Reset());
+    winrt::check_hresult(GraphicsList(list)->Reset(Allocator(list), nullptr));
+}
+
+void D3D12CommandListSource::Close(const PooledCommandList& list)
+{
+    winrt::check_hresult(GraphicsList(list)->Close());
+}
+
+void D3D12CommandListSource::Execute(const std::span<const PooledCommandList> lists)
+{
+    std::vector<ID3D12CommandList*> commandLists;
+    commandLists.reserve(lists.size());
+    for (const PooledCommandList& list : lists)
+    {
+        commandLists.push_back(GraphicsList(list));
+    }
+    m_queue->ExecuteCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
+}
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CpuFeatures.hpp"
+
+#include <cstdlib>
+#include <string>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CPU_FEATURES_X64
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+#ifdef CPU_FEATURES_X64
+    struct CpuidRegisters
+    {
+        uint32_t Eax, Ebx, Ecx, Edx;
+    };
+
+    CpuidRegisters Cpuid(const uint32_t leaf, const uint32_t subleaf)
+    {
+        CpuidRegisters registers{};
+#ifdef _MSC_VER
+        int values[4];
+        __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+        registers = {static_cast<uint32_t>(values[0]), static_cast<uint32_t>(values[1]),
+                     static_cast<uint32_t>(values[2]), static_cast<uint32_t>(values[3])};
+#else
+        __cpuid_count(leaf, subleaf, registers.Eax, registers.Ebx, registers.Ecx, registers.Edx);
+#endif
+        return registers;
+    }
+
+    /// Gets which register states the OS saves on context switches.
+    uint64_t EnabledStateMask()
+    {
+#ifdef _MSC_VER
+        return _xgetbv(0);
+#else
+        uint32_t low, high;
+        __asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+        return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+    }
+#endif
+
+    CpuFeatures Detect()
+    {
+        CpuFeatures features;
+#ifdef CPU_FEATURES_X64
+        const CpuidRegisters basic = Cpuid(1, 0);
+        features.SSE2 = (basic.Edx & (1u << 26)) != 0;
+        features.SSE41 = (basic.Ecx & (1u << 19)) != 0;
+
+        const bool osxsave = (basic.Ecx & (1u << 27)) != 0;
+        if (osxsave && Cpuid(0, 0).Eax >= 7)
+        {
+            const CpuidRegisters extended = Cpuid(7, 0);
+            const uint64_t       state = EnabledStateMask();
+            const bool           avxState = (state & 0x6) == 0x6;      // XMM and YMM
+            const bool           avx512State = (state & 0xe6) == 0xe6; // Plus opmask and ZMM
+
+            features.FMA = avxState && (basic.Ecx & (1u << 12)) != 0;
+            features.AVX2 = avxState && (extended.Ebx & (1u << 5)) != 0;
+            features.AVX512F = avx512State && (extended.Ebx & (1u << 16)) != 0;
+        }
+#elif defined(_M_ARM64) || defined(__aarch64__)
+        features.NEON = true;
+#endif
+        return features;
+    }
+
+    std::string ReadOverride()
+    {
+#ifdef _MSC_VER
+        char*  value = nullptr;
+        size_t length = 0;
+        if (_dupenv_s(&value, &length, "D3D12_SIMD_LEVEL") != 0 || value == nullptr)
+        {
+            return {};
+        }
+
+        std::string result(value);
+        free(value);
+        return result;
+#else
+        const char* value = std::getenv("D3D12_SIMD_LEVEL");
+        return value != nullptr ? value : "";
+#endif
+    }
+
+    SimdLevel SelectLevel()
+    {
+        const CpuFeatures& features = CpuFeatures::Get();
+        const std::string  requested = ReadOverride();
+        for (const SimdLevel level :
+             {SimdLevel::NEON, SimdLevel::SSE2, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            if (requested == SimdLevelName(level) && features.Supports(level))
+            {
+                return level;
+            }
+        }
+
+        return features.HighestLevel();
+    }
+} // namespace
+
+const CpuFeatures& CpuFeatures::Get()
+{
+    static const CpuFeatures features = Detect();
+    return features;
+}
+
+SimdLevel CpuFeatures::HighestLevel() const
+{
+    for (const SimdLevel level :
+         {SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE41, SimdLevel::SSE2, SimdLevel::NEON})
+    {
+        if (Supports(level))
+        {
+            return level;
+        }
+    }
+
+    return SimdLevel::Scalar;
+}
+
+bool CpuFeatures::Supports(const SimdLevel level) const
+{
+    switch (level)
+    {
+    case SimdLevel::Scalar:
+        return true;
+    case SimdLevel::NEON:
+        return NEON;
+    case SimdLevel::SSE2:
+        return SSE2;
+    case SimdLevel::SSE41:
+        return SSE2 && SSE41;
+    case SimdLevel::AVX2:
+        return SSE41 && AVX2 && FMA;
+    case SimdLevel::AVX512:
+        return SSE41 && AVX2 && FMA && AVX512F;
+    }
+
+    return false;
+}
+
+SimdLevel SelectedSimdLevel()
+{
+    static const SimdLevel level = SelectLevel();
+    return level;
+}
+
+const char* SimdLevelName(const SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Scalar:
+        return "scalar";
+    case SimdLevel::NEON:
+        return "neon";
+    case SimdLevel::SSE2:
+        return "sse2";
+    case SimdLevel::SSE41:
+        return "sse4.1";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    }
+
+    return "unknown";
+}
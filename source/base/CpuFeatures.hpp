@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+/// Instruction set levels the math kernels are built for, from narrowest to widest.
+enum class SimdLevel : uint8_t
+{
+    Scalar,
+    NEON,
+    SSE2,
+    SSE41,
+    AVX2,   ///< AVX2 with FMA3.
+    AVX512, ///< AVX-512 Foundation.
+};
+
+/// @brief Instruction set features of the CPU the process is running on.
+///
+/// On x86-64 the features come from cpuid, and AVX levels also require the OS to
+/// save the wider registers (checked through xgetbv). On AArch64, NEON is always
+/// available.
+struct CpuFeatures
+{
+    bool SSE2 = false;
+    bool SSE41 = false;
+    bool AVX2 = false;
+    bool FMA = false;
+    bool AVX512F = false;
+    bool NEON = false;
+
+    /// @brief Gets the features of the current CPU, detected on first use.
+    [[nodiscard]] static const CpuFeatures& Get();
+
+    /// @brief Gets the widest level whose features are all present.
+    [[nodiscard]] SimdLevel HighestLevel() const;
+
+    [[nodiscard]] bool Supports(SimdLevel level) const;
+};
+
+/// @brief Gets the level every dispatched kernel uses, chosen once per process.
+///
+/// This is the highest supported level unless the D3D12_SIMD_LEVEL environment
+/// variable names another supported one (neon, sse2, sse4.1, avx2 or avx512), which
+/// is useful for comparing paths on one machine. Unsupported requests are ignored.
+[[nodiscard]] SimdLevel SelectedSimdLevel();
+
+[[nodiscard]] const char* SimdLevelName(SimdLevel level);
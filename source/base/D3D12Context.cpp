@@ -5,12 +5,16 @@
 ///
 #include "D3D12Context.hpp"
 
+#include <cassert>
+
 #include <DirectXColors.h>
 
 #include <fmt/xchar.h>
 
 #include <fmt/format.h>
 
+#include "StreamingCopy.hpp"
+
 namespace
 {
     void FindCompatibleAdapter(const winrt::com_ptr<IDXGIFactory1>& factory, IDXGIAdapter1** adapter)
@@ -111,11 +115,9 @@ D3D12Context::D3D12Context(HWND window) : m_backBufferFormat(DXGI_FORMAT_R16G16B
     winrt::check_hresult(D3D12CreateDevice(adapter.get(), D3D_FEATURE_LEVEL_12_0, IID_PPV_ARGS(&m_device)));
     m_device->SetName(L"D3D12Context::Device");
 
-    D3D12_COMMAND_QUEUE_DESC commandQueueDesc = {};
-    commandQueueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
-    commandQueueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
-    winrt::check_hresult(m_device->CreateCommandQueue(&commandQueueDesc, IID_PPV_ARGS(&m_commandQueue)));
-    winrt::check_hresult(m_commandQueue->SetName(L"D3D12Context::CommandQueue"));
+    m_timelineBackend = std::make_unique<D3D12TimelineBackend>(m_device.get());
+    m_timeline = std::make_unique<FenceTimeline>(*m_timelineBackend);
+    m_releases = std::make_unique<DeferredReleaseQueue>(*m_timeline);
 
     D3D12_DESCRIPTOR_HEAP_DESC rtvDescriptorHeapDesc = {};
     rtvDescriptorHeapDesc.NumDescriptors = FRAME_COUNT;
@@ -128,32 +130,15 @@ D3D12Context::D3D12Context(HWND window) : m_backBufferFormat(DXGI_FORMAT_R16G16B
     dsvDescriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
     winrt::check_hresult(m_device->CreateDescriptorHeap(&dsvDescriptorHeapDesc, IID_PPV_ARGS(&m_dsvDescriptorHeap)));
 
-    for (UINT i = 0; i < FRAME_COUNT; ++i)
+    m_descriptors = std::make_unique<DescriptorManager>(m_device.get());
+    m_bindless = std::make_unique<BindlessResources>(m_device.get(), *m_descriptors);
+    m_uploadPageSource = std::make_unique<D3D12UploadPageSource>(m_device.get());
+    m_uploads = std::make_unique<UploadAllocator>(*m_uploadPageSource);
+    for (uint32_t i = 0; i < QueueTypeCount; ++i)
     {
-        winrt::check_hresult(
-            m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_commandAllocator[i])));
-
-        std::wstring name = fmt::format(L"D3D12Context::CommandAllocator{}", i);
-        winrt::check_hresult(m_commandAllocator[i]->SetName(name.c_str()));
-
-        winrt::check_hresult(m_device->CreateCommandList1(
-            0, D3D12_COMMAND_LIST_TYPE_DIRECT, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&m_commandList[i])));
-
-        name = fmt::format(L"D3D12Context::CommandList{}", i);
-        winrt::check_hresult(m_commandList[i]->SetName(name.c_str()));
-
-        winrt::check_hresult(
-            m_device->CreateFence(m_frameFenceValue[i], D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_frameFence[i])));
-        m_frameFenceValue[i] = 0;
-
-        name = fmt::format(L"D3D12Context::FrameFence{}", i);
-        winrt::check_hresult(m_frameFence[i]->SetName(name.c_str()));
-
-        m_frameFenceEvent[i].attach(CreateEventEx(nullptr, nullptr, 0, EVENT_MODIFY_STATE | SYNCHRONIZE));
-        if (!m_frameFenceEvent[i])
-        {
-            throw std::runtime_error("Failed to allocate frame fence event");
-        }
+        m_commandListSources[i] =
+            std::make_unique<D3D12CommandListSource>(m_device.get(), Queue(static_cast<QueueType>(i)));
+        m_commandLists[i] = std::make_unique<CommandListPool>(*m_commandListSources[i]);
     }
 
     CreateSurfaceResources();
@@ -167,66 +152,107 @@ D3D12Context::~D3D12Context()
 
 void D3D12Context::BeginFrame()
 {
-    WaitForGpuFence(m_frameFence[m_currentBackBufferIndex].get(), m_frameFenceValue[m_currentBackBufferIndex],
-                    m_frameFenceEvent[m_currentBackBufferIndex].get());
+    m_timeline->WaitForCompletion({QueueType::Direct, m_frameFenceValue[m_currentBackBufferIndex]});
+
+    // The direct queue may have run further than the frame waited for, so recycle up to its fence.
+    const uint64_t completed = m_timeline->CompletedValue(QueueType::Direct);
+    m_descriptors->BeginFrame(completed);
+    m_uploads->BeginFrame(completed);
+    m_releases->BeginFrame();
+    m_commandLists[static_cast<size_t>(QueueType::Direct)]->BeginFrame(completed);
+    for (const QueueType queue : {QueueType::Compute, QueueType::Copy})
+    {
+        m_commandLists[static_cast<size_t>(queue)]->BeginFrame(m_timeline->CompletedValue(queue));
+    }
 
     // TODO: Update ConstantBuffers here
 
     // Wait until all queued frames are finished
     WaitForSingleObjectEx(m_frameLatencyAwaitable.get(), INFINITE, FALSE);
 
-    PrepareWork(m_commandAllocator[m_currentBackBufferIndex].get(), m_commandList[m_currentBackBufferIndex].get());
+    m_commandList = PrepareWork();
 }
 
 void D3D12Context::EndFrame()
 {
-    FinalizeWork(m_commandList[m_currentBackBufferIndex].get(), m_commandQueue.get());
+    // Present() signals the direct queue with the next value once the frame is submitted.
+    const uint64_t fenceValue = m_timeline->NextValue(QueueType::Direct);
+
+    // Descriptor copies happen on the CPU, so they only need to land before the work is submitted.
+    m_descriptors->Flush();
+    m_descriptors->EndFrame(fenceValue);
+    m_uploads->EndFrame(fenceValue);
+
+    FinalizeWork(fenceValue);
 
     Present();
 }
 
-void D3D12Context::WaitForGpuFence(ID3D12Fence* fence, UINT64 completionValue, HANDLE fenceEvent)
+TimelinePoint D3D12Context::Submit(const QueueType queue)
 {
-    if (fence->GetCompletedValue() < completionValue)
-    {
-        winrt::check_hresult(fence->SetEventOnCompletion(completionValue, fenceEvent));
+    assert(queue != QueueType::Direct && "Direct queue work is submitted by EndFrame()");
 
-        WaitForSingleObjectEx(fenceEvent, INFINITE, FALSE);
-    }
+    StreamingCopy::Fence();
+
+    m_commandLists[static_cast<size_t>(queue)]->Submit(m_timeline->NextValue(queue));
+    return m_timeline->Signal(queue);
 }
 
-void D3D12Context::PrepareWork(ID3D12CommandAllocator* commandAllocator, ID3D12GraphicsCommandList* commandList)
+ID3D12GraphicsCommandList* D3D12Context::PrepareWork()
 {
-    winrt::check_hresult(commandAllocator->Reset());
-    winrt::check_hresult(commandList->Reset(commandAllocator, nullptr));
+    auto* commandList = static_cast<ID3D12GraphicsCommandList*>(CommandLists().Acquire().List);
 
     commandList->RSSetViewports(1, &m_viewport);
     commandList->RSSetScissorRects(1, &m_scissorRect);
+    return commandList;
+}
 
-    auto barrier =
-        CD3DX12_RESOURCE_BARRIER::Transition(m_renderTarget[m_currentBackBufferIndex].get(),
-                                             D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
-    commandList->ResourceBarrier(1, &barrier);
-
+void D3D12Context::BindTargets(ID3D12GraphicsCommandList* commandList) const
+{
     const auto rtvHandle = RenderTargetView();
     const auto dsvHandle = DepthStencilView();
 
     commandList->OMSetRenderTargets(1, &rtvHandle, FALSE, &dsvHandle);
+}
+
+void D3D12Context::BindSurface()
+{
+    BindTargets(m_commandList);
+
+    m_commandList->ClearRenderTargetView(RenderTargetView(), DirectX::Colors::CornflowerBlue, 0, nullptr);
+    m_commandList->ClearDepthStencilView(DepthStencilView(), D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+}
+
+void D3D12Context::RecordParallel(ThreadPool&           pool,
+                                  const size_t          count,
+                                  const size_t          minCountPerList,
+                                  const RecordFunction& record)
+{
+    if (count == 0)
+    {
+        return;
+    }
 
-    commandList->ClearRenderTargetView(rtvHandle, DirectX::Colors::CornflowerBlue, 0, nullptr);
-    commandList->ClearDepthStencilView(dsvHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+    CommandLists().Record(pool, count, minCountPerList, [&](const PooledCommandList& list, size_t begin, size_t end) {
+        auto* commandList = static_cast<ID3D12GraphicsCommandList*>(list.List);
+        commandList->RSSetViewports(1, &m_viewport);
+        commandList->RSSetScissorRects(1, &m_scissorRect);
+        BindTargets(commandList);
+        record(commandList, begin, end);
+    });
+
+    // Lists run in the order they were acquired, so the rest of the frame needs a list of its own.
+    m_commandList = PrepareWork();
+    BindTargets(m_commandList);
 }
 
-void D3D12Context::FinalizeWork(ID3D12GraphicsCommandList* commandList, ID3D12CommandQueue* commandQueue)
+void D3D12Context::FinalizeWork(const uint64_t fenceValue)
 {
-    auto barrier =
-        CD3DX12_RESOURCE_BARRIER::Transition(m_renderTarget[m_currentBackBufferIndex].get(),
-                                             D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
-    commandList->ResourceBarrier(1, &barrier);
-    winrt::check_hresult(commandList->Close());
+    // Uploads of the frame were streamed and may still sit in write-combining buffers.
+    StreamingCopy::Fence();
 
-    ID3D12CommandList* commandLists[] = {commandList};
-    commandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
+    CommandLists().Submit(fenceValue);
+    m_commandList = nullptr;
 }
 
 CD3DX12_CPU_DESCRIPTOR_HANDLE D3D12Context::RenderTargetView() const
@@ -244,19 +270,26 @@ void D3D12Context::Present()
 {
     winrt::check_hresult(m_swapChain->Present(1, 0));
 
-    winrt::check_hresult(m_commandQueue->Signal(m_frameFence[m_currentBackBufferIndex].get(), m_currentFenceValue));
-    m_frameFenceValue[m_currentBackBufferIndex] = m_currentFenceValue;
-    ++m_currentFenceValue;
+    m_frameFenceValue[m_currentBackBufferIndex] = m_timeline->Signal(QueueType::Direct).Value;
 
     m_currentBackBufferIndex = (m_currentBackBufferIndex + 1) % FRAME_COUNT;
 }
 
 void D3D12Context::CreateSurfaceResources()
 {
-    WaitForGpuCompletion();
+    // Retire the depth buffer before waiting, so it stays alive until the frame after the
+    // resize finishes rather than the GPU being drained for it. Its view is rewritten in place
+    // below, which is safe since OMSetRenderTargets() copies CPU descriptors when recorded.
+    if (m_depthStencilTarget)
+    {
+        DeferRelease(std::move(m_depthStencilTarget));
+    }
 
+    // ResizeBuffers() needs every back buffer released and idle, which means waiting for the
+    // last direct queue frame that drew to each. Compute and copy work carries on.
     for (UINT i = 0; i < FRAME_COUNT; ++i)
     {
+        m_timeline->WaitForCompletion({QueueType::Direct, m_frameFenceValue[i]});
         m_renderTarget[i] = nullptr;
     }
 
@@ -292,7 +325,7 @@ void D3D12Context::CreateSurfaceResources()
         swapChainDesc.Flags = swapChainFlags;
 
         winrt::com_ptr<IDXGISwapChain1> swapChain;
-        winrt::check_hresult(m_factory->CreateSwapChainForHwnd(m_commandQueue.get(), m_window, &swapChainDesc, nullptr,
+        winrt::check_hresult(m_factory->CreateSwapChainForHwnd(CommandQueue(), m_window, &swapChainDesc, nullptr,
                                                                nullptr, swapChain.put()));
         m_swapChain = swapChain.as<IDXGISwapChain3>();
 
@@ -341,19 +374,12 @@ void D3D12Context::CreateSurfaceResources()
 
 void D3D12Context::ResizeSwapChain()
 {
-    WaitForGpuCompletion();
-
     CreateSurfaceResources();
 }
 
 void D3D12Context::WaitForGpuCompletion()
 {
-    winrt::check_hresult(m_commandQueue->Signal(m_frameFence[m_currentBackBufferIndex].get(), m_currentFenceValue));
-    m_frameFenceValue[m_currentBackBufferIndex] = m_currentFenceValue;
-    ++m_currentFenceValue;
-
-    WaitForGpuFence(m_frameFence[m_currentBackBufferIndex].get(), m_frameFenceValue[m_currentBackBufferIndex],
-                    m_frameFenceEvent[m_currentBackBufferIndex].get());
+    m_timeline->WaitForIdle();
 }
 
 ID3D12Device* D3D12Context::Device() const
@@ -363,12 +389,66 @@ ID3D12Device* D3D12Context::Device() const
 
 ID3D12CommandQueue* D3D12Context::CommandQueue() const
 {
-    return m_commandQueue.get();
+    return Queue(QueueType::Direct);
+}
+
+ID3D12CommandQueue* D3D12Context::Queue(const QueueType queue) const
+{
+    return m_timelineBackend->Queue(queue);
 }
 
 ID3D12GraphicsCommandList* D3D12Context::CommandList() const
 {
-    return m_commandList[m_currentBackBufferIndex].get();
+    return m_commandList;
+}
+
+ID3D12Resource* D3D12Context::RenderTarget() const
+{
+    return m_renderTarget[m_currentBackBufferIndex].get();
+}
+
+ID3D12Resource* D3D12Context::DepthStencilTarget() const
+{
+    return m_depthStencilTarget.get();
+}
+
+DescriptorManager& D3D12Context::Descriptors() const
+{
+    return *m_descriptors;
+}
+
+BindlessResources& D3D12Context::Bindless() const
+{
+    return *m_bindless;
+}
+
+UploadAllocator& D3D12Context::Uploads() const
+{
+    return *m_uploads;
+}
+
+CommandListPool& D3D12Context::CommandLists(const QueueType queue) const
+{
+    return *m_commandLists[static_cast<size_t>(queue)];
+}
+
+FenceTimeline& D3D12Context::Timeline() const
+{
+    return *m_timeline;
+}
+
+DeferredReleaseQueue& D3D12Context::Releases() const
+{
+    return *m_releases;
+}
+
+void D3D12Context::DeferRelease(winrt::com_ptr<ID3D12Resource> resource)
+{
+    const D3D12_RESOURCE_DESC            desc = resource->GetDesc();
+    const D3D12_RESOURCE_ALLOCATION_INFO info = m_device->GetResourceAllocationInfo(0, 1, &desc);
+
+    m_releases->Retire(resource.detach(), [](void* object) { static_cast<ID3D12Resource*>(object)->Release(); },
+                       info.SizeInBytes);
 }
 
 DXGI_FORMAT D3D12Context::BackBufferFormat() const
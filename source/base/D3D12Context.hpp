@@ -7,6 +7,8 @@
 
 #include <array>
 #include <cstdint>
+#include <functional>
+#include <memory>
 
 #include <directx/d3d12.h>
 #include <directx/d3dx12.h>
@@ -17,6 +19,15 @@
 #endif
 #include <dstorage.h>
 
+#include "BindlessResources.hpp"
+#include "CommandListPool.hpp"
+#include "DeferredReleaseQueue.hpp"
+#include "DescriptorManager.hpp"
+#include "FenceTimelineD3D12.hpp"
+#include "UploadAllocator.hpp"
+
+class ThreadPool;
+
 class D3D12Context final
 {
     static constexpr UINT FRAME_COUNT = 3;
@@ -24,12 +35,17 @@ class D3D12Context final
 public:
     using StaticSamplers = std::array<const CD3DX12_STATIC_SAMPLER_DESC, 1>;
 
+    /// Records items [begin, end) into a list that starts with the viewport, scissor and
+    /// targets of the frame bound.
+    using RecordFunction = std::function<void(ID3D12GraphicsCommandList* commandList, size_t begin, size_t end)>;
+
     explicit D3D12Context(HWND window);
 
     ~D3D12Context();
 
     ID3D12Device*                 Device() const;
     ID3D12CommandQueue*           CommandQueue() const;
+    ID3D12CommandQueue*           Queue(QueueType queue) const;
     ID3D12GraphicsCommandList*    CommandList() const;
     ID3D12Resource*               RenderTarget() const;
     ID3D12Resource*               DepthStencilTarget() const;
@@ -38,10 +54,54 @@ public:
     DXGI_FORMAT                   BackBufferFormat() const;
     const StaticSamplers          Samplers() const;
 
+    /// @brief Gets the shared CBV/SRV/UAV descriptors, recycled as frames finish.
+    DescriptorManager& Descriptors() const;
+
+    /// @brief Gets the views shaders read from the descriptor heap by index.
+    BindlessResources& Bindless() const;
+
+    /// @brief Gets upload memory for data that only lives until the current frame finishes.
+    UploadAllocator& Uploads() const;
+
+    /// @brief Gets the command lists of a queue, recycled as its fence passes them.
+    CommandListPool& CommandLists(QueueType queue = QueueType::Direct) const;
+
+    /// @brief Gets the fences of the direct, compute and copy queues.
+    ///
+    /// The frame's direct lists are executed by EndFrame(), so a direct queue wait made
+    /// while recording holds back the whole frame.
+    FenceTimeline& Timeline() const;
+
+    /// @brief Gets the queue that releases objects once the GPU has finished with them.
+    DeferredReleaseQueue& Releases() const;
+
+    /// @brief Releases the resource once the current frame has finished, instead of waiting for the GPU.
+    void DeferRelease(winrt::com_ptr<ID3D12Resource> resource);
+
+    /// @brief Executes the lists acquired from the pool of a compute or copy queue since its last submit.
+    ///
+    /// Other queues can Timeline().Wait() for the returned point. Upload memory and
+    /// descriptors of the frame recycle with the direct fence, so work that uses them must be
+    /// waited for by the direct queue before the frame ends.
+    TimelinePoint Submit(QueueType queue);
+
+    /// @brief Records [0, count) across the threads of the pool, one command list per contiguous range.
+    ///
+    /// The lists run after everything recorded so far, and CommandList() moves on to a new
+    /// list so that whatever is recorded next runs after them. Descriptor heaps, root
+    /// signatures and pipeline state start unbound in every list.
+    void RecordParallel(ThreadPool& pool, size_t count, size_t minCountPerList, const RecordFunction& record);
+
     void BeginFrame();
 
     void EndFrame();
 
+    /// @brief Binds and clears the back buffer and depth buffer of the current frame.
+    ///
+    /// Both must already be in their render target and depth write states; the
+    /// frame graph of Example transitions them.
+    void BindSurface();
+
     void Present();
 
     void WaitForGpuCompletion();
@@ -49,11 +109,12 @@ public:
     void ResizeSwapChain();
 
 private:
-    void PrepareWork(ID3D12CommandAllocator* commandAllocator, ID3D12GraphicsCommandList* commandList);
+    /// @brief Opens the next list of the frame, with the viewport and scissor set.
+    ID3D12GraphicsCommandList* PrepareWork();
 
-    void FinalizeWork(ID3D12GraphicsCommandList* commandList, ID3D12CommandQueue* commandQueue);
+    void BindTargets(ID3D12GraphicsCommandList* commandList) const;
 
-    void WaitForGpuFence(ID3D12Fence* fence, UINT64 completionValue, HANDLE fenceEvent);
+    void FinalizeWork(uint64_t fenceValue);
 
     void CreateSurfaceResources();
 
@@ -62,9 +123,12 @@ private:
     CD3DX12_VIEWPORT                          m_viewport;
     CD3DX12_RECT                              m_scissorRect;
     winrt::com_ptr<ID3D12Device9>             m_device;
-    winrt::com_ptr<ID3D12CommandQueue>        m_commandQueue;
-    winrt::com_ptr<ID3D12GraphicsCommandList> m_commandList[FRAME_COUNT];
-    winrt::com_ptr<ID3D12CommandAllocator>    m_commandAllocator[FRAME_COUNT];
+    std::unique_ptr<D3D12TimelineBackend>     m_timelineBackend;
+    std::unique_ptr<FenceTimeline>            m_timeline;
+    std::unique_ptr<DeferredReleaseQueue>     m_releases;
+    std::unique_ptr<D3D12CommandListSource>   m_commandListSources[QueueTypeCount];
+    std::unique_ptr<CommandListPool>          m_commandLists[QueueTypeCount];
+    ID3D12GraphicsCommandList*                m_commandList = nullptr; ///< List the frame records into next.
     winrt::com_ptr<IDXGIFactory6>             m_factory;
     winrt::com_ptr<IDXGISwapChain3>           m_swapChain;
     winrt::com_ptr<ID3D12Resource>            m_renderTarget[FRAME_COUNT];
@@ -72,13 +136,14 @@ private:
     winrt::com_ptr<ID3D12DescriptorHeap>      m_rtvDescriptorHeap;
     UINT                                      m_rtvDescriptorSize;
     winrt::com_ptr<ID3D12DescriptorHeap>      m_dsvDescriptorHeap;
+    std::unique_ptr<DescriptorManager>        m_descriptors;
+    std::unique_ptr<BindlessResources>        m_bindless;
+    std::unique_ptr<D3D12UploadPageSource>    m_uploadPageSource;
+    std::unique_ptr<UploadAllocator>          m_uploads;
 #ifdef _DEBUG
     winrt::com_ptr<IDXGIInfoQueue> m_infoQueue;
 #endif
-    winrt::handle               m_frameLatencyAwaitable;
-    winrt::com_ptr<ID3D12Fence> m_frameFence[FRAME_COUNT];
-    winrt::handle               m_frameFenceEvent[FRAME_COUNT];
-    UINT64                      m_frameFenceValue[FRAME_COUNT]{0};
-    UINT64                      m_currentFenceValue = 1;
-    UINT                        m_currentBackBufferIndex = 0;
+    winrt::handle m_frameLatencyAwaitable;
+    uint64_t      m_frameFenceValue[FRAME_COUNT]{0}; ///< Direct queue value each back buffer's last frame signaled.
+    UINT          m_currentBackBufferIndex = 0;
 };
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DeferredReleaseQueue.hpp"
+
+#include <algorithm>
+
+DeferredReleaseQueue::DeferredReleaseQueue(FenceTimeline& timeline) : m_timeline(timeline)
+{
+}
+
+DeferredReleaseQueue::~DeferredReleaseQueue()
+{
+    for (const RetiredObject& retired : m_retired)
+    {
+        Release(retired);
+    }
+}
+
+void DeferredReleaseQueue::Retire(void* const                          object,
+                                  const ReleaseFunction                release,
+                                  const uint64_t                       bytes,
+                                  const std::span<const TimelinePoint> points)
+{
+    RetiredObject retired = {object, release, bytes, {}};
+    for (const TimelinePoint& point : points)
+    {
+        uint64_t& value = retired.Values[static_cast<size_t>(point.Queue)];
+        value = std::max(value, point.Value);
+    }
+    m_retired.push_back(retired);
+
+    ++m_stats.PendingReleases;
+    m_stats.PendingBytes += bytes;
+}
+
+void DeferredReleaseQueue::Retire(void* const object, const ReleaseFunction release, const uint64_t bytes)
+{
+    const TimelinePoint frame = {QueueType::Direct, m_timeline.NextValue(QueueType::Direct)};
+    Retire(object, release, bytes, {&frame, 1});
+}
+
+void DeferredReleaseQueue::BeginFrame()
+{
+    if (m_retired.empty())
+    {
+        return;
+    }
+
+    // One fence read per queue, instead of one per object.
+    std::array<uint64_t, QueueTypeCount> completed{};
+    for (uint32_t queue = 0; queue < QueueTypeCount; ++queue)
+    {
+        completed[queue] = m_timeline.CompletedValue(static_cast<QueueType>(queue));
+    }
+
+    // Keeps the objects still in use in retire order, without allocating.
+    size_t kept = 0;
+    for (size_t i = 0; i < m_retired.size(); ++i)
+    {
+        const RetiredObject& retired = m_retired[i];
+        bool                 complete = true;
+        for (uint32_t queue = 0; queue < QueueTypeCount; ++queue)
+        {
+            complete = complete && retired.Values[queue] <= completed[queue];
+        }
+
+        if (complete)
+        {
+            Release(retired);
+        }
+        else
+        {
+            m_retired[kept++] = retired;
+        }
+    }
+    m_retired.resize(kept);
+}
+
+const DeferredReleaseQueue::Statistics& DeferredReleaseQueue::Stats() const
+{
+    return m_stats;
+}
+
+void DeferredReleaseQueue::Release(const RetiredObject& retired)
+{
+    retired.Release(retired.Object);
+
+    --m_stats.PendingReleases;
+    m_stats.PendingBytes -= retired.Bytes;
+    m_stats.ReleasedBytes += retired.Bytes;
+}
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "FenceTimeline.hpp"
+
+/// @brief Holds on to objects the GPU may still use until the timeline passes them.
+///
+/// Retire() takes an object with the points of every queue that may still read it, and
+/// BeginFrame() releases the objects whose points have all completed, so resizes and
+/// evictions drop resources without flushing the GPU. Objects are released with the
+/// function given to Retire(). All calls belong to one thread.
+class DeferredReleaseQueue final
+{
+public:
+    using ReleaseFunction = void (*)(void* object);
+
+    struct Statistics
+    {
+        uint32_t PendingReleases = 0;
+        uint64_t PendingBytes = 0;
+        uint64_t ReleasedBytes = 0; ///< Bytes released over the lifetime of the queue.
+    };
+
+    explicit DeferredReleaseQueue(FenceTimeline& timeline);
+
+    DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+    DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+
+    ~DeferredReleaseQueue();
+
+    /// @brief Releases the object once the GPU has reached every point.
+    ///
+    /// @param [in] bytes Memory the object holds, for the counters only.
+    void Retire(void* object, ReleaseFunction release, uint64_t bytes, std::span<const TimelinePoint> points);
+
+    /// @brief Releases the object once the current frame, the next value of the direct queue, has finished.
+    void Retire(void* object, ReleaseFunction release, uint64_t bytes);
+
+    /// @brief Releases the objects whose points have completed.
+    void BeginFrame();
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+private:
+    struct RetiredObject
+    {
+        void*                                Object;
+        ReleaseFunction                      Release;
+        uint64_t                             Bytes;
+        std::array<uint64_t, QueueTypeCount> Values; ///< Value each queue must reach; zero if unused.
+    };
+
+    void Release(const RetiredObject& retired);
+
+    FenceTimeline&             m_timeline;
+    std::vector<RetiredObject> m_retired; ///< In retire order, which is not completion order across queues.
+    Statistics                 m_stats;
+};
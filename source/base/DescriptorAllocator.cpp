@@ -0,0 +1,368 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DescriptorAllocator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+DescriptorAllocator::DescriptorAllocator(const uint32_t capacity)
+{
+    m_freeLists.fill(NoBlock);
+    Grow(capacity);
+}
+
+void DescriptorAllocator::MapSize(const uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+{
+    // Sizes below SecondLevelCount get a list each; above, every power of two splits into SecondLevelCount lists.
+    if (size < SecondLevelCount)
+    {
+        firstLevel = 0;
+        secondLevel = size;
+        return;
+    }
+
+    const uint32_t log = std::bit_width(size) - 1;
+    firstLevel = log - SecondLevelBits + 1;
+    secondLevel = (size >> (log - SecondLevelBits)) ^ SecondLevelCount;
+}
+
+uint32_t DescriptorAllocator::FindFreeBlock(const uint32_t size) const
+{
+    // Round up to the next size class, so every range in the class found is large enough.
+    uint32_t rounded = size;
+    if (size >= SecondLevelCount)
+    {
+        rounded += (1u << (std::bit_width(size) - 1 - SecondLevelBits)) - 1;
+    }
+
+    uint32_t firstLevel = 0;
+    uint32_t secondLevel = 0;
+    MapSize(rounded, firstLevel, secondLevel);
+
+    uint32_t secondLevelMap = m_secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+    if (secondLevelMap == 0)
+    {
+        const uint32_t firstLevelMap =
+            firstLevel + 1 < FirstLevelCount ? m_firstLevelBitmap & (~0u << (firstLevel + 1)) : 0;
+        if (firstLevelMap == 0)
+        {
+            // Only the class of the size itself is left, where some ranges may still be large enough.
+            MapSize(size, firstLevel, secondLevel);
+            uint32_t block = m_freeLists[firstLevel * SecondLevelCount + secondLevel];
+            while (block != NoBlock && m_blocks[block].Size < size)
+            {
+                block = m_blocks[block].NextFree;
+            }
+            return block;
+        }
+        firstLevel = std::countr_zero(firstLevelMap);
+        secondLevelMap = m_secondLevelBitmaps[firstLevel];
+    }
+
+    secondLevel = std::countr_zero(secondLevelMap);
+    return m_freeLists[firstLevel * SecondLevelCount + secondLevel];
+}
+
+DescriptorAllocation DescriptorAllocator::Allocate(const uint32_t count)
+{
+    if (count == 0)
+    {
+        return {};
+    }
+
+    const uint32_t block = FindFreeBlock(count);
+    if (block == NoBlock)
+    {
+        return {};
+    }
+    RemoveFree(block);
+
+    // Return the tail of the range to the free lists.
+    if (m_blocks[block].Size > count)
+    {
+        const uint32_t remainder = NewBlock(m_blocks[block].Offset + count, m_blocks[block].Size - count);
+        Block&         split = m_blocks[remainder];
+        split.PrevPhysical = block;
+        split.NextPhysical = m_blocks[block].NextPhysical;
+        if (split.NextPhysical != NoBlock)
+        {
+            m_blocks[split.NextPhysical].PrevPhysical = remainder;
+        }
+        else
+        {
+            m_lastBlock = remainder;
+        }
+        m_blocks[block].NextPhysical = remainder;
+        m_blocks[block].Size = count;
+        InsertFree(remainder);
+    }
+
+    m_allocated += count;
+    return {m_blocks[block].Offset, count, block};
+}
+
+void DescriptorAllocator::Free(const DescriptorAllocation& allocation)
+{
+    if (!allocation.IsValid())
+    {
+        return;
+    }
+
+    uint32_t block = allocation.Block;
+    assert(block < m_blocks.size() && !m_blocks[block].Free && m_blocks[block].Offset == allocation.Offset);
+    m_allocated -= m_blocks[block].Size;
+
+    // Merge with free neighbours so large ranges can be handed out again.
+    const uint32_t next = m_blocks[block].NextPhysical;
+    if (next != NoBlock && m_blocks[next].Free)
+    {
+        RemoveFree(next);
+        m_blocks[block].Size += m_blocks[next].Size;
+        RetireBlock(next);
+    }
+
+    const uint32_t previous = m_blocks[block].PrevPhysical;
+    if (previous != NoBlock && m_blocks[previous].Free)
+    {
+        RemoveFree(previous);
+        m_blocks[previous].Size += m_blocks[block].Size;
+        RetireBlock(block);
+        block = previous;
+    }
+
+    InsertFree(block);
+}
+
+void DescriptorAllocator::FreeDeferred(const DescriptorAllocation& allocation)
+{
+    if (allocation.IsValid())
+    {
+        m_pendingFrees.emplace_back(Untagged, allocation);
+    }
+}
+
+void DescriptorAllocator::EndFrame(const uint64_t fenceValue)
+{
+    for (auto& [tag, allocation] : m_pendingFrees)
+    {
+        tag = std::min(tag, fenceValue);
+    }
+}
+
+void DescriptorAllocator::Release(const uint64_t completedFenceValue)
+{
+    const auto finished = [&](const auto& entry) { return entry.first <= completedFenceValue; };
+    for (const auto& entry : m_pendingFrees)
+    {
+        if (finished(entry))
+        {
+            Free(entry.second);
+        }
+    }
+    std::erase_if(m_pendingFrees, finished);
+}
+
+void DescriptorAllocator::Grow(const uint32_t capacity)
+{
+    if (capacity <= m_capacity)
+    {
+        return;
+    }
+
+    const uint32_t added = capacity - m_capacity;
+    if (m_lastBlock != NoBlock && m_blocks[m_lastBlock].Free)
+    {
+        RemoveFree(m_lastBlock);
+        m_blocks[m_lastBlock].Size += added;
+        InsertFree(m_lastBlock);
+    }
+    else
+    {
+        const uint32_t block = NewBlock(m_capacity, added);
+        m_blocks[block].PrevPhysical = m_lastBlock;
+        if (m_lastBlock != NoBlock)
+        {
+            m_blocks[m_lastBlock].NextPhysical = block;
+        }
+        m_lastBlock = block;
+        InsertFree(block);
+    }
+    m_capacity = capacity;
+}
+
+uint32_t DescriptorAllocator::Capacity() const
+{
+    return m_capacity;
+}
+
+uint32_t DescriptorAllocator::AllocatedCount() const
+{
+    return m_allocated;
+}
+
+uint32_t DescriptorAllocator::NewBlock(const uint32_t offset, const uint32_t size)
+{
+    uint32_t block = 0;
+    if (!m_retiredBlocks.empty())
+    {
+        block = m_retiredBlocks.back();
+        m_retiredBlocks.pop_back();
+        m_blocks[block] = {};
+    }
+    else
+    {
+        block = static_cast<uint32_t>(m_blocks.size());
+        m_blocks.emplace_back();
+    }
+
+    m_blocks[block].Offset = offset;
+    m_blocks[block].Size = size;
+    return block;
+}
+
+void DescriptorAllocator::InsertFree(const uint32_t block)
+{
+    uint32_t firstLevel = 0;
+    uint32_t secondLevel = 0;
+    MapSize(m_blocks[block].Size, firstLevel, secondLevel);
+
+    uint32_t& head = m_freeLists[firstLevel * SecondLevelCount + secondLevel];
+    m_blocks[block].Free = true;
+    m_blocks[block].PrevFree = NoBlock;
+    m_blocks[block].NextFree = head;
+    if (head != NoBlock)
+    {
+        m_blocks[head].PrevFree = block;
+    }
+    head = block;
+
+    m_firstLevelBitmap |= 1u << firstLevel;
+    m_secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+}
+
+void DescriptorAllocator::RemoveFree(const uint32_t block)
+{
+    uint32_t firstLevel = 0;
+    uint32_t secondLevel = 0;
+    MapSize(m_blocks[block].Size, firstLevel, secondLevel);
+
+    Block& node = m_blocks[block];
+    if (node.PrevFree != NoBlock)
+    {
+        m_blocks[node.PrevFree].NextFree = node.NextFree;
+    }
+    else
+    {
+        m_freeLists[firstLevel * SecondLevelCount + secondLevel] = node.NextFree;
+    }
+    if (node.NextFree != NoBlock)
+    {
+        m_blocks[node.NextFree].PrevFree = node.PrevFree;
+    }
+    node.Free = false;
+
+    if (m_freeLists[firstLevel * SecondLevelCount + secondLevel] == NoBlock)
+    {
+        m_secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+        if (m_secondLevelBitmaps[firstLevel] == 0)
+        {
+            m_firstLevelBitmap &= ~(1u << firstLevel);
+        }
+    }
+}
+
+void DescriptorAllocator::RetireBlock(const uint32_t block)
+{
+    // Unlink a block whose range was merged into its previous neighbour.
+    const Block& node = m_blocks[block];
+    if (node.PrevPhysical != NoBlock)
+    {
+        m_blocks[node.PrevPhysical].NextPhysical = node.NextPhysical;
+    }
+    if (node.NextPhysical != NoBlock)
+    {
+        m_blocks[node.NextPhysical].PrevPhysical = node.PrevPhysical;
+    }
+    else
+    {
+        m_lastBlock = node.PrevPhysical;
+    }
+    m_retiredBlocks.push_back(block);
+}
+
+DescriptorRing::DescriptorRing(const uint32_t capacity) : m_capacity(capacity)
+{
+}
+
+DescriptorAllocation DescriptorRing::Allocate(const uint32_t count)
+{
+    const uint64_t used = m_allocatedTotal - m_releasedTotal;
+    if (count == 0 || count > m_capacity - used)
+    {
+        return {};
+    }
+
+    if (used == 0 && m_frames.empty())
+    {
+        m_head = 0;
+        m_tail = 0;
+    }
+
+    // Ranges must be contiguous: when the end of the ring is too short, skip it and start over at zero.
+    uint32_t offset = m_head;
+    if (m_head >= m_tail || used == 0)
+    {
+        if (m_capacity - m_head < count)
+        {
+            if (count > m_tail)
+            {
+                return {};
+            }
+            m_allocatedTotal += m_capacity - m_head;
+            offset = 0;
+        }
+    }
+    else if (m_tail - m_head < count)
+    {
+        return {};
+    }
+
+    m_head = offset + count == m_capacity ? 0 : offset + count;
+    m_allocatedTotal += count;
+    return {offset, count, DescriptorAllocation::Invalid};
+}
+
+void DescriptorRing::EndFrame(const uint64_t fenceValue)
+{
+    m_frames.push_back({fenceValue, m_allocatedTotal, m_head});
+}
+
+void DescriptorRing::Release(const uint64_t completedFenceValue)
+{
+    const auto completed = std::find_if(m_frames.begin(), m_frames.end(), [&](const Frame& frame) {
+        return frame.FenceValue > completedFenceValue;
+    });
+    if (completed == m_frames.begin())
+    {
+        return;
+    }
+
+    const Frame& last = *(completed - 1);
+    m_tail = last.Head;
+    m_releasedTotal = last.AllocatedTotal;
+    m_frames.erase(m_frames.begin(), completed);
+}
+
+uint32_t DescriptorRing::Capacity() const
+{
+    return m_capacity;
+}
+
+uint32_t DescriptorRing::UsedCount() const
+{
+    return static_cast<uint32_t>(m_allocatedTotal - m_releasedTotal);
+}
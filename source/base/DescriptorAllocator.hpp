@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// Contiguous range of descriptors in a heap.
+struct DescriptorAllocation
+{
+    static constexpr uint32_t Invalid = UINT32_MAX;
+
+    uint32_t Offset = Invalid;
+    uint32_t Count = 0;
+    uint32_t Block = Invalid; ///< Identifies persistent allocations to DescriptorAllocator::Free.
+
+    [[nodiscard]] bool IsValid() const
+    {
+        return Offset != Invalid;
+    }
+};
+
+/// @brief Allocates persistent descriptor ranges with a two-level segregated fit (TLSF) free list.
+///
+/// Free ranges are binned by size class, so allocation and free are O(1): a pair of
+/// bitmaps finds a large enough range and neighbouring free ranges merge when a
+/// range is freed. The allocator only manages offsets; a DescriptorManager maps them
+/// to heaps, so it runs and can be measured without a device.
+class DescriptorAllocator final
+{
+public:
+    explicit DescriptorAllocator(uint32_t capacity = 0);
+
+    /// @brief Allocates count consecutive descriptors.
+    /// @return An invalid allocation when no free range is large enough.
+    [[nodiscard]] DescriptorAllocation Allocate(uint32_t count);
+
+    void Free(const DescriptorAllocation& allocation);
+
+    /// @brief Frees the allocation once the frame being recorded has finished, so frames in flight
+    /// never see its descriptors reused.
+    void FreeDeferred(const DescriptorAllocation& allocation);
+
+    /// @brief Tags the frees deferred since the previous frame with the frame's fence value.
+    void EndFrame(uint64_t fenceValue);
+
+    /// @brief Frees the deferred allocations of frames the GPU has finished.
+    void Release(uint64_t completedFenceValue);
+
+    /// @brief Adds descriptors at the end of the range; existing allocations keep their offsets.
+    void Grow(uint32_t capacity);
+
+    [[nodiscard]] uint32_t Capacity() const;
+
+    [[nodiscard]] uint32_t AllocatedCount() const;
+
+private:
+    static constexpr uint32_t SecondLevelBits = 2;
+    static constexpr uint32_t SecondLevelCount = 1u << SecondLevelBits;
+    static constexpr uint32_t FirstLevelCount = 32;
+    static constexpr uint32_t NoBlock = UINT32_MAX;
+    static constexpr uint64_t Untagged = UINT64_MAX;
+
+    /// A free or allocated range, linked to its neighbours in the heap and, when free, in its size class.
+    struct Block
+    {
+        uint32_t Offset = 0;
+        uint32_t Size = 0;
+        uint32_t PrevPhysical = NoBlock;
+        uint32_t NextPhysical = NoBlock;
+        uint32_t PrevFree = NoBlock;
+        uint32_t NextFree = NoBlock;
+        bool     Free = false;
+    };
+
+    static void MapSize(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+
+    [[nodiscard]] uint32_t FindFreeBlock(uint32_t size) const;
+
+    uint32_t NewBlock(uint32_t offset, uint32_t size);
+
+    void InsertFree(uint32_t block);
+
+    void RemoveFree(uint32_t block);
+
+    void RetireBlock(uint32_t block);
+
+    std::vector<Block>                                       m_blocks;
+    std::vector<uint32_t>                                    m_retiredBlocks;
+    std::vector<std::pair<uint64_t, DescriptorAllocation>>   m_pendingFrees;
+    std::array<uint32_t, FirstLevelCount * SecondLevelCount> m_freeLists;
+    std::array<uint32_t, FirstLevelCount>                    m_secondLevelBitmaps{};
+    uint32_t                                                 m_firstLevelBitmap = 0;
+    uint32_t                                                 m_lastBlock = NoBlock;
+    uint32_t                                                 m_capacity = 0;
+    uint32_t                                                 m_allocated = 0;
+};
+
+/// @brief Hands out descriptors for tables that live for one frame, from a ring.
+///
+/// Allocation bumps the head. EndFrame() tags everything allocated since the previous
+/// frame with the frame's fence value, and Release() returns those ranges once the GPU
+/// has passed the fence.
+class DescriptorRing final
+{
+public:
+    explicit DescriptorRing(uint32_t capacity = 0);
+
+    /// @return An invalid allocation when the frames in flight use the whole ring.
+    [[nodiscard]] DescriptorAllocation Allocate(uint32_t count);
+
+    void EndFrame(uint64_t fenceValue);
+
+    void Release(uint64_t completedFenceValue);
+
+    [[nodiscard]] uint32_t Capacity() const;
+
+    [[nodiscard]] uint32_t UsedCount() const;
+
+private:
+    struct Frame
+    {
+        uint64_t FenceValue;
+        uint64_t AllocatedTotal;
+        uint32_t Head;
+    };
+
+    std::vector<Frame> m_frames;
+    uint32_t           m_capacity = 0;
+    uint32_t           m_head = 0;
+    uint32_t           m_tail = 0;
+    uint64_t           m_allocatedTotal = 0; ///< Descriptors ever allocated, including skipped ones at the end.
+    uint64_t           m_releasedTotal = 0;
+};
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DescriptorManager.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+DescriptorManager::DescriptorManager(ID3D12Device*  device,
+                                     const uint32_t persistentCapacity,
+                                     const uint32_t transientCapacity)
+    : m_device(device),
+      m_descriptorSize(device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)),
+      m_persistent(persistentCapacity), m_transient(transientCapacity)
+{
+    m_stagingHeap = CreateHeap(persistentCapacity, false);
+    m_shaderVisibleHeap = CreateHeap(persistentCapacity + transientCapacity, true);
+}
+
+DescriptorAllocation DescriptorManager::AllocatePersistent(const uint32_t count)
+{
+    DescriptorAllocation allocation = m_persistent.Allocate(count);
+    if (!allocation.IsValid())
+    {
+        Grow(count);
+        allocation = m_persistent.Allocate(count);
+    }
+    return allocation;
+}
+
+void DescriptorManager::FreePersistent(const DescriptorAllocation& allocation)
+{
+    m_persistent.FreeDeferred(allocation);
+}
+
+CD3DX12_CPU_DESCRIPTOR_HANDLE DescriptorManager::CpuHandle(const DescriptorAllocation& allocation, const uint32_t index)
+{
+    assert(allocation.IsValid() && index < allocation.Count);
+    m_dirtyRanges.emplace_back(allocation.Offset + index, 1);
+    return CD3DX12_CPU_DESCRIPTOR_HANDLE(m_stagingHeap->GetCPUDescriptorHandleForHeapStart(),
+                                         static_cast<INT>(allocation.Offset + index), m_descriptorSize);
+}
+
+CD3DX12_GPU_DESCRIPTOR_HANDLE DescriptorManager::GpuHandle(const DescriptorAllocation& allocation,
+                                                           const uint32_t              index) const
+{
+    assert(allocation.IsValid() && index < allocation.Count);
+    return CD3DX12_GPU_DESCRIPTOR_HANDLE(m_shaderVisibleHeap->GetGPUDescriptorHandleForHeapStart(),
+                                         static_cast<INT>(allocation.Offset + index), m_descriptorSize);
+}
+
+CD3DX12_GPU_DESCRIPTOR_HANDLE DescriptorManager::BuildTable(const std::span<const DescriptorAllocation> descriptors)
+{
+    uint32_t count = 0;
+    for (const DescriptorAllocation& descriptor : descriptors)
+    {
+        count += descriptor.Count;
+    }
+
+    const DescriptorAllocation table = m_transient.Allocate(count);
+    if (!table.IsValid())
+    {
+        throw std::runtime_error("Transient descriptor ring is full");
+    }
+
+    // Transient tables follow the persistent descriptors in the shader visible heap.
+    const INT                           offset = static_cast<INT>(m_persistent.Capacity() + table.Offset);
+    const CD3DX12_CPU_DESCRIPTOR_HANDLE target(m_shaderVisibleHeap->GetCPUDescriptorHandleForHeapStart(), offset,
+                                               m_descriptorSize);
+
+    m_copySources.clear();
+    m_copySizes.clear();
+    for (const DescriptorAllocation& descriptor : descriptors)
+    {
+        m_copySources.push_back(CD3DX12_CPU_DESCRIPTOR_HANDLE(m_stagingHeap->GetCPUDescriptorHandleForHeapStart(),
+                                                              static_cast<INT>(descriptor.Offset), m_descriptorSize));
+        m_copySizes.push_back(descriptor.Count);
+    }
+    const D3D12_CPU_DESCRIPTOR_HANDLE targets[] = {target};
+    const UINT                        targetSizes[] = {count};
+    m_device->CopyDescriptors(1, targets, targetSizes, static_cast<UINT>(m_copySources.size()), m_copySources.data(),
+                              m_copySizes.data(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    return CD3DX12_GPU_DESCRIPTOR_HANDLE(m_shaderVisibleHeap->GetGPUDescriptorHandleForHeapStart(), offset,
+                                         m_descriptorSize);
+}
+
+ID3D12DescriptorHeap* DescriptorManager::ShaderVisibleHeap() const
+{
+    return m_shaderVisibleHeap.get();
+}
+
+void DescriptorManager::Flush()
+{
+    if (m_dirtyRanges.empty())
+    {
+        return;
+    }
+
+    // Merge the written descriptors into as few ranges as possible, then copy them in one call.
+    std::sort(m_dirtyRanges.begin(), m_dirtyRanges.end());
+    m_copySources.clear();
+    m_copyTargets.clear();
+    m_copySizes.clear();
+
+    const auto source = m_stagingHeap->GetCPUDescriptorHandleForHeapStart();
+    const auto target = m_shaderVisibleHeap->GetCPUDescriptorHandleForHeapStart();
+    uint32_t   begin = m_dirtyRanges.front().first;
+    uint32_t   end = begin;
+    const auto addRange = [&] {
+        m_copySources.push_back(CD3DX12_CPU_DESCRIPTOR_HANDLE(source, static_cast<INT>(begin), m_descriptorSize));
+        m_copyTargets.push_back(CD3DX12_CPU_DESCRIPTOR_HANDLE(target, static_cast<INT>(begin), m_descriptorSize));
+        m_copySizes.push_back(end - begin);
+    };
+    for (const auto& [offset, count] : m_dirtyRanges)
+    {
+        if (offset > end)
+        {
+            addRange();
+            begin = offset;
+        }
+        end = std::max(end, offset + count);
+    }
+    addRange();
+
+    const auto rangeCount = static_cast<UINT>(m_copySizes.size());
+    m_device->CopyDescriptors(rangeCount, m_copyTargets.data(), m_copySizes.data(), rangeCount, m_copySources.data(),
+                              m_copySizes.data(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    m_dirtyRanges.clear();
+}
+
+void DescriptorManager::BeginFrame(const uint64_t completedFenceValue)
+{
+    m_transient.Release(completedFenceValue);
+    m_persistent.Release(completedFenceValue);
+    std::erase_if(m_retiredHeaps, [&](const auto& entry) { return entry.first <= completedFenceValue; });
+}
+
+void DescriptorManager::EndFrame(const uint64_t fenceValue)
+{
+    m_transient.EndFrame(fenceValue);
+    m_persistent.EndFrame(fenceValue);
+    for (auto& [tag, heap] : m_retiredHeaps)
+    {
+        tag = std::min(tag, fenceValue);
+    }
+}
+
+void DescriptorManager::Grow(const uint32_t minimumCount)
+{
+    const uint32_t oldCapacity = m_persistent.Capacity();
+    const uint32_t capacity = std::max(oldCapacity * 2, oldCapacity + minimumCount);
+
+    // The staging heap holds every persistent descriptor, so it fills both new heaps.
+    winrt::com_ptr<ID3D12DescriptorHeap> stagingHeap = CreateHeap(capacity, false);
+    winrt::com_ptr<ID3D12DescriptorHeap> shaderVisibleHeap = CreateHeap(capacity + m_transient.Capacity(), true);
+    if (oldCapacity > 0)
+    {
+        m_device->CopyDescriptorsSimple(oldCapacity, stagingHeap->GetCPUDescriptorHandleForHeapStart(),
+                                        m_stagingHeap->GetCPUDescriptorHandleForHeapStart(),
+                                        D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        m_device->CopyDescriptorsSimple(oldCapacity, shaderVisibleHeap->GetCPUDescriptorHandleForHeapStart(),
+                                        m_stagingHeap->GetCPUDescriptorHandleForHeapStart(),
+                                        D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    }
+    m_dirtyRanges.clear();
+
+    // Frames in flight may still read the old shader visible heap; the staging heap is CPU only.
+    m_retiredHeaps.emplace_back(Untagged, std::move(m_shaderVisibleHeap));
+    m_stagingHeap = std::move(stagingHeap);
+    m_shaderVisibleHeap = std::move(shaderVisibleHeap);
+    m_persistent.Grow(capacity);
+}
+
+winrt::com_ptr<ID3D12DescriptorHeap> DescriptorManager::CreateHeap(const uint32_t count, const bool shaderVisible) const
+{
+    D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+    desc.NumDescriptors = count;
+    desc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    desc.Flags = shaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+    winrt::com_ptr<ID3D12DescriptorHeap> heap;
+    winrt::check_hresult(m_device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&heap)));
+    winrt::check_hresult(heap->SetName(shaderVisible ? L"DescriptorManager::ShaderVisibleHeap"
+                                                     : L"DescriptorManager::StagingHeap"));
+    return heap;
+}
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <directx/d3d12.h>
+#include <directx/d3dx12.h>
+#include <winrt/base.h>
+
+#include "DescriptorAllocator.hpp"
+
+/// @brief Owns the shader visible CBV/SRV/UAV heap that every example binds.
+///
+/// The front of the heap holds persistent descriptors. They are written to a CPU-only
+/// staging heap and copied to the shader visible heap in batches by Flush(), which also
+/// lets the heaps grow: a larger heap is filled from the staging copy. The back of the
+/// heap is a ring for tables that live for one frame.
+///
+/// Growing replaces the shader visible heap, so callers fetch it and GPU handles every
+/// frame rather than keeping them. Retired heaps and freed descriptors are kept until the
+/// frames that may use them have finished.
+class DescriptorManager final
+{
+public:
+    static constexpr uint32_t DefaultPersistentCapacity = 1024;
+    static constexpr uint32_t DefaultTransientCapacity = 4096;
+
+    explicit DescriptorManager(ID3D12Device* device,
+                               uint32_t      persistentCapacity = DefaultPersistentCapacity,
+                               uint32_t      transientCapacity = DefaultTransientCapacity);
+
+    /// @brief Allocates descriptors that live until freed, growing the heaps when full.
+    [[nodiscard]] DescriptorAllocation AllocatePersistent(uint32_t count = 1);
+
+    /// @brief Frees persistent descriptors once the frames recorded so far have finished with them.
+    void FreePersistent(const DescriptorAllocation& allocation);
+
+    /// @brief Gets the staging handle to write a persistent descriptor to, and queues it for Flush().
+    ///
+    /// Rewriting a descriptor that frames in flight still read is a race; allocate a new one instead.
+    [[nodiscard]] CD3DX12_CPU_DESCRIPTOR_HANDLE CpuHandle(const DescriptorAllocation& allocation, uint32_t index = 0);
+
+    [[nodiscard]] CD3DX12_GPU_DESCRIPTOR_HANDLE GpuHandle(const DescriptorAllocation& allocation,
+                                                          uint32_t                    index = 0) const;
+
+    /// @brief Copies persistent descriptors into a contiguous table that lives until the end of the frame.
+    /// @throws std::runtime_error if the frames in flight use the whole ring.
+    [[nodiscard]] CD3DX12_GPU_DESCRIPTOR_HANDLE BuildTable(std::span<const DescriptorAllocation> descriptors);
+
+    [[nodiscard]] ID3D12DescriptorHeap* ShaderVisibleHeap() const;
+
+    /// @brief Copies the persistent descriptors written since the last call to the shader visible heap.
+    void Flush();
+
+    /// @brief Recycles the transient tables, freed descriptors and heaps of finished frames.
+    void BeginFrame(uint64_t completedFenceValue);
+
+    /// @brief Tags the transient tables and frees of the frame with the fence value it signals.
+    void EndFrame(uint64_t fenceValue);
+
+private:
+    static constexpr uint64_t Untagged = UINT64_MAX;
+
+    void Grow(uint32_t minimumCount);
+
+    [[nodiscard]] winrt::com_ptr<ID3D12DescriptorHeap> CreateHeap(uint32_t count, bool shaderVisible) const;
+
+    ID3D12Device*                                                          m_device;
+    UINT                                                                   m_descriptorSize;
+    DescriptorAllocator                                                    m_persistent;
+    DescriptorRing                                                         m_transient;
+    winrt::com_ptr<ID3D12DescriptorHeap>                                   m_stagingHeap;
+    winrt::com_ptr<ID3D12DescriptorHeap>                                   m_shaderVisibleHeap;
+    std::vector<std::pair<uint32_t, uint32_t>>                             m_dirtyRanges;
+    std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>                               m_copySources;
+    std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>                               m_copyTargets;
+    std::vector<UINT>                                                      m_copySizes;
+    std::vector<std::pair<uint64_t, winrt::com_ptr<ID3D12DescriptorHeap>>> m_retiredHeaps;
+};
@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DrawQueue.hpp"
+
+#include <chrono>
+
+#include "ThreadPool.hpp"
+
+namespace
+{
+    constexpr uint32_t RadixBits = 8;
+    constexpr uint32_t RadixBuckets = 1u << RadixBits;
+    constexpr uint32_t RadixPasses = 64 / RadixBits;
+
+    // Below this many packets per chunk the histogram overhead outweighs the parallelism.
+    constexpr size_t MinPacketsPerChunk = 4096;
+
+    constexpr uint32_t InvalidState = UINT32_MAX;
+} // namespace
+
+void DrawQueue::Clear()
+{
+    m_packets.clear();
+    m_sortedIndices.clear();
+}
+
+void DrawQueue::Reserve(const size_t count)
+{
+    m_packets.reserve(count);
+}
+
+void DrawQueue::Push(const DrawPacket& packet)
+{
+    m_packets.push_back(packet);
+}
+
+size_t DrawQueue::Size() const
+{
+    return m_packets.size();
+}
+
+const DrawQueue::Statistics& DrawQueue::Stats() const
+{
+    return m_stats;
+}
+
+std::span<const uint32_t> DrawQueue::SortedIndices() const
+{
+    return m_sortedIndices;
+}
+
+const DrawPacket& DrawQueue::Packet(const uint32_t index) const
+{
+    return m_packets[index];
+}
+
+void DrawQueue::Sort(ThreadPool& pool)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const size_t count = m_packets.size();
+    m_entries.resize(count);
+    m_scratch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_entries[i] = {m_packets[i].Key, static_cast<uint32_t>(i)};
+    }
+
+    // Chunks are fixed for all passes so each one owns a stable slice of every bucket.
+    const size_t chunkCount =
+        std::clamp<size_t>(count / MinPacketsPerChunk, 1, static_cast<size_t>(pool.ThreadCount()) * 4);
+    const size_t chunkSize = (count + chunkCount - 1) / std::max<size_t>(chunkCount, 1);
+    m_histograms.resize(chunkCount * RadixBuckets);
+
+    SortEntry* source = m_entries.data();
+    SortEntry* destination = m_scratch.data();
+    for (uint32_t pass = 0; pass < RadixPasses && count > 1; ++pass)
+    {
+        const uint32_t shift = pass * RadixBits;
+
+        pool.ParallelFor(chunkCount, 1, [&](const size_t begin, const size_t end, uint32_t) {
+            for (size_t chunk = begin; chunk < end; ++chunk)
+            {
+                uint32_t* histogram = &m_histograms[chunk * RadixBuckets];
+                std::fill_n(histogram, RadixBuckets, 0u);
+
+                const size_t first = chunk * chunkSize;
+                const size_t last = std::min(first + chunkSize, count);
+                for (size_t i = first; i < last; ++i)
+                {
+                    ++histogram[(source[i].Key >> shift) & (RadixBuckets - 1)];
+                }
+            }
+        });
+
+        // Convert per-chunk counts into exclusive write offsets, bucket-major then chunk-minor.
+        uint32_t offset = 0;
+        bool     uniformDigit = false;
+        for (uint32_t bucket = 0; bucket < RadixBuckets; ++bucket)
+        {
+            uint32_t bucketTotal = 0;
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                uint32_t& slot = m_histograms[chunk * RadixBuckets + bucket];
+                const uint32_t chunkCountForBucket = slot;
+                slot = offset + bucketTotal;
+                bucketTotal += chunkCountForBucket;
+            }
+
+            if (bucketTotal == count)
+            {
+                uniformDigit = true;
+                break;
+            }
+            offset += bucketTotal;
+        }
+
+        // Keys share this digit (common for the layer/pass bytes), so the pass would be an identity permutation.
+        if (uniformDigit)
+        {
+            continue;
+        }
+
+        pool.ParallelFor(chunkCount, 1, [&](const size_t begin, const size_t end, uint32_t) {
+            for (size_t chunk = begin; chunk < end; ++chunk)
+            {
+                uint32_t* offsets = &m_histograms[chunk * RadixBuckets];
+
+                const size_t first = chunk * chunkSize;
+                const size_t last = std::min(first + chunkSize, count);
+                for (size_t i = first; i < last; ++i)
+                {
+                    destination[offsets[(source[i].Key >> shift) & (RadixBuckets - 1)]++] = source[i];
+                }
+            }
+        });
+
+        std::swap(source, destination);
+    }
+
+    m_sortedIndices.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_sortedIndices[i] = source[i].Index;
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    m_stats.SortMilliseconds = std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+void DrawQueue::Submit(DrawSubmitter& submitter)
+{
+    const double sortMilliseconds = m_stats.SortMilliseconds;
+    m_stats = Submit(submitter, 0, m_sortedIndices.size());
+    m_stats.SortMilliseconds = sortMilliseconds;
+}
+
+DrawQueue::Statistics DrawQueue::Submit(DrawSubmitter& submitter, const size_t first, const size_t count) const
+{
+    Statistics stats;
+
+    uint32_t pipeline = InvalidState;
+    uint32_t material = InvalidState;
+    uint32_t geometry = InvalidState;
+
+    const size_t last = std::min(first + count, m_sortedIndices.size());
+    for (size_t i = first; i < last; ++i)
+    {
+        const DrawPacket& packet = m_packets[m_sortedIndices[i]];
+
+        if (packet.PipelineId != pipeline)
+        {
+            submitter.BindPipeline(packet.PipelineId);
+            pipeline = packet.PipelineId;
+            ++stats.StateChanges;
+        }
+        else
+        {
+            ++stats.StateChangesAvoided;
+        }
+
+        if (packet.MaterialId != material)
+        {
+            submitter.BindMaterial(packet.MaterialId);
+            material = packet.MaterialId;
+            ++stats.StateChanges;
+        }
+        else
+        {
+            ++stats.StateChangesAvoided;
+        }
+
+        if (packet.GeometryId != geometry)
+        {
+            submitter.BindGeometry(packet.GeometryId);
+            geometry = packet.GeometryId;
+            ++stats.StateChanges;
+        }
+        else
+        {
+            ++stats.StateChangesAvoided;
+        }
+
+        submitter.Draw(packet);
+        ++stats.Packets;
+    }
+
+    return stats;
+}
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class ThreadPool;
+
+/// @brief Packs draw ordering criteria into a single 64-bit integer.
+///
+/// From most to least significant bit: layer (4), pass (4), pipeline (16),
+/// material (16) and quantized view depth (24). Sorting the keys ascending groups
+/// draws by layer and pass first, then by pipeline and material to minimize state
+/// changes, and finally front-to-back within identical state.
+struct DrawKey
+{
+    static constexpr uint32_t LayerBits = 4;
+    static constexpr uint32_t PassBits = 4;
+    static constexpr uint32_t PipelineBits = 16;
+    static constexpr uint32_t MaterialBits = 16;
+    static constexpr uint32_t DepthBits = 24;
+
+    static constexpr uint32_t DepthShift = 0;
+    static constexpr uint32_t MaterialShift = DepthShift + DepthBits;
+    static constexpr uint32_t PipelineShift = MaterialShift + MaterialBits;
+    static constexpr uint32_t PassShift = PipelineShift + PipelineBits;
+    static constexpr uint32_t LayerShift = PassShift + PassBits;
+
+    static_assert(LayerShift + LayerBits == 64, "Draw key fields must fill 64 bits");
+
+    /// @brief Builds a key.
+    /// @param [in] depth Normalized view depth in [0, 1].
+    /// @param [in] backToFront Inverts the depth ordering, e.g. for blended passes.
+    static constexpr uint64_t Make(const uint32_t layer,
+                                   const uint32_t pass,
+                                   const uint32_t pipeline,
+                                   const uint32_t material,
+                                   const float    depth,
+                                   const bool     backToFront = false)
+    {
+        constexpr uint32_t maxDepth = (1u << DepthBits) - 1;
+
+        auto quantized = static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(maxDepth));
+        if (backToFront)
+        {
+            quantized = maxDepth - quantized;
+        }
+
+        return (static_cast<uint64_t>(layer & Mask(LayerBits)) << LayerShift) |
+               (static_cast<uint64_t>(pass & Mask(PassBits)) << PassShift) |
+               (static_cast<uint64_t>(pipeline & Mask(PipelineBits)) << PipelineShift) |
+               (static_cast<uint64_t>(material & Mask(MaterialBits)) << MaterialShift) |
+               (static_cast<uint64_t>(quantized) << DepthShift);
+    }
+
+    static constexpr uint32_t Layer(const uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> LayerShift) & Mask(LayerBits);
+    }
+
+    static constexpr uint32_t Pass(const uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> PassShift) & Mask(PassBits);
+    }
+
+    static constexpr uint32_t Pipeline(const uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> PipelineShift) & Mask(PipelineBits);
+    }
+
+    static constexpr uint32_t Material(const uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> MaterialShift) & Mask(MaterialBits);
+    }
+
+private:
+    static constexpr uint32_t Mask(const uint32_t bits)
+    {
+        return (1u << bits) - 1;
+    }
+};
+
+/// @brief Everything needed to issue one indexed draw.
+struct DrawPacket
+{
+    uint64_t Key = 0;
+    uint32_t PipelineId = 0;
+    uint32_t MaterialId = 0;
+    uint32_t GeometryId = 0;
+    uint32_t IndexCount = 0;
+    uint32_t InstanceCount = 1;
+    uint32_t StartIndex = 0;
+    int32_t  BaseVertex = 0;
+    uint32_t ObjectIndex = 0;
+};
+
+/// @brief Receives sorted draws. Bind calls are only made when the bound id changes.
+class DrawSubmitter
+{
+public:
+    virtual ~DrawSubmitter() = default;
+
+    virtual void BindPipeline(uint32_t pipelineId) = 0;
+
+    virtual void BindMaterial(uint32_t materialId) = 0;
+
+    virtual void BindGeometry(uint32_t geometryId) = 0;
+
+    virtual void Draw(const DrawPacket& packet) = 0;
+};
+
+/// @brief Collects draw packets, radix sorts them by key and submits them with redundant state removed.
+class DrawQueue final
+{
+public:
+    struct Statistics
+    {
+        uint32_t Packets = 0;             ///< Packets submitted.
+        uint32_t StateChanges = 0;        ///< Pipeline, material and geometry binds issued.
+        uint32_t StateChangesAvoided = 0; ///< Binds skipped because the state was already bound.
+        double   SortMilliseconds = 0.0;  ///< Wall time of the last Sort().
+    };
+
+    void Clear();
+
+    void Reserve(size_t count);
+
+    void Push(const DrawPacket& packet);
+
+    [[nodiscard]] size_t Size() const;
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+    /// @brief Sorts the queued packets by key using a parallel LSD radix sort.
+    /// @param [in] pool Pool used for the histogram and scatter phases.
+    void Sort(ThreadPool& pool);
+
+    /// @brief Gets the packet indices in sorted order. Valid after Sort().
+    [[nodiscard]] std::span<const uint32_t> SortedIndices() const;
+
+    /// @brief Gets the packet at a queue index.
+    [[nodiscard]] const DrawPacket& Packet(uint32_t index) const;
+
+    /// @brief Submits packets in sorted order, eliding binds of state that is already current.
+    void Submit(DrawSubmitter& submitter);
+
+    /// @brief Submits a sub-range of the sorted packets, e.g. a worker's share of the queue.
+    /// @param [in] first Index of the first sorted packet to submit.
+    /// @param [in] count Number of sorted packets to submit.
+    /// @return Statistics for the submitted range.
+    Statistics Submit(DrawSubmitter& submitter, size_t first, size_t count) const;
+
+private:
+    struct SortEntry
+    {
+        uint64_t Key;
+        uint32_t Index;
+    };
+
+    std::vector<DrawPacket> m_packets;
+    std::vector<SortEntry>  m_entries;
+    std::vector<SortEntry>  m_scratch;
+    std::vector<uint32_t>   m_histograms;
+    std::vector<uint32_t>   m_sortedIndices;
+    Statistics              m_stats;
+};
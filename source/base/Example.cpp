@@ -5,10 +5,15 @@
 
 #include "Example.hpp"
 
+#include <mutex>
+
 #include <SDL3/SDL_properties.h>
 
 #include <fmt/format.h>
 
+#include "CpuFeatures.hpp"
+#include "TransformKernels.hpp"
+
 Example::Example(const char* title, uint32_t width, uint32_t height, const bool fullscreen)
 {
     if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS))
@@ -17,6 +22,8 @@ Example::Example(const char* title, uint32_t width, uint32_t height, const bool
         abort();
     }
 
+    SDL_Log("SIMD path: %s (%s kernels)", SimdLevelName(SelectedSimdLevel()), TransformKernels::PathName());
+
     int flags = SDL_WINDOW_HIGH_PIXEL_DENSITY | SDL_WINDOW_RESIZABLE;
     if (fullscreen)
     {
@@ -43,6 +50,9 @@ Example::Example(const char* title, uint32_t width, uint32_t height, const bool
     auto hwnd = static_cast<HWND>(
         SDL_GetPointerProperty(SDL_GetWindowProperties(m_window), SDL_PROP_WINDOW_WIN32_HWND_POINTER, nullptr));
     m_context = std::make_unique<D3D12Context>(hwnd);
+    m_threadPool = std::make_unique<ThreadPool>();
+    m_pipelines = std::make_unique<GraphicsPipelineCache>(
+        m_context->Device(), std::filesystem::path(SDL_GetBasePath()) / "PipelineLibrary.bin");
     m_keyboard = std::make_unique<Keyboard>();
     m_mouse = std::make_unique<Mouse>(m_window);
 
@@ -83,6 +93,11 @@ uint32_t Example::GetFrameHeight() const
     return h;
 }
 
+const CommandContext::Statistics& Example::GetCommandStatistics() const
+{
+    return m_commandContext.Stats();
+}
+
 int Example::Run([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 {
     if (!Load())
@@ -178,8 +193,7 @@ int Example::Run([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 
         m_context->BeginFrame();
 
-        const auto commandList = m_context->CommandList();
-        Render(commandList, m_timer);
+        RecordFrame();
 
         m_context->EndFrame();
 
@@ -189,9 +203,64 @@ int Example::Run([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 
     m_context->WaitForGpuCompletion();
 
+    // Pipelines compiled this run load from the library next time instead of compiling again.
+    try
+    {
+        m_pipelines->Save();
+    }
+    catch (const std::exception& e)
+    {
+        SDL_Log("Pipeline library not saved: %s", e.what());
+    }
+
     return 0;
 }
 
+void Example::RecordFrame()
+{
+    // The swap chain hands out back buffers in the present state and expects them
+    // back the same way; the depth buffer stays writable between frames.
+    m_frameGraph.Reset();
+    const FrameGraphResource backBuffer =
+        m_frameGraph.Import("BackBuffer", ResourceUsage::Present, ResourceUsage::Present);
+    const FrameGraphResource depthStencil =
+        m_frameGraph.Import("DepthStencil", ResourceUsage::DepthWrite, ResourceUsage::DepthWrite);
+
+    const FrameGraphPass scene = m_frameGraph.AddPass("Scene", [this](CommandContext& context) {
+        m_context->BindSurface();
+        Render(context, m_timer);
+    });
+    m_frameGraph.Write(scene, backBuffer, ResourceUsage::RenderTarget);
+    m_frameGraph.Write(scene, depthStencil, ResourceUsage::DepthWrite);
+    m_frameGraph.Compile();
+
+    ID3D12Resource* const resources[] = {m_context->RenderTarget(), m_context->DepthStencilTarget()};
+
+    m_commandContext.Begin(m_commandBackend.emplace(m_context->CommandList()));
+    m_frameGraph.Execute(m_commandContext, resources);
+}
+
+void Example::RecordParallel(const size_t count, const size_t minCountPerList, const RecordFunction& record)
+{
+    std::mutex                 statsMutex;
+    CommandContext::Statistics stats;
+
+    m_context->RecordParallel(*m_threadPool, count, minCountPerList,
+                              [&](ID3D12GraphicsCommandList* commandList, size_t begin, size_t end) {
+                                  D3D12CommandBackend backend(commandList);
+                                  CommandContext      context;
+                                  context.Begin(backend);
+                                  record(context, begin, end);
+
+                                  std::lock_guard lock(statsMutex);
+                                  stats.Issued += context.Stats().Issued;
+                                  stats.Elided += context.Stats().Elided;
+                              });
+
+    m_commandContext.Merge(stats);
+    m_commandContext.Continue(m_commandBackend.emplace(m_context->CommandList()));
+}
+
 void Example::Quit()
 {
     m_running = false;
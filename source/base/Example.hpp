@@ -7,14 +7,20 @@
 
 #include <SDL3/SDL.h>
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "Camera.hpp"
+#include "CommandContext.hpp"
 #include "D3D12Context.hpp"
+#include "FrameGraph.hpp"
 #include "GameTimer.hpp"
+#include "GraphicsPipelineCache.hpp"
 #include "Keyboard.hpp"
 #include "Mouse.hpp"
+#include "ThreadPool.hpp"
 
 class Example
 {
@@ -31,22 +37,44 @@ public:
 
     [[nodiscard]] uint32_t GetFrameHeight() const;
 
+    /// @brief Gets the issued and elided state-setting calls recorded by the last frame.
+    [[nodiscard]] const CommandContext::Statistics& GetCommandStatistics() const;
+
     virtual bool Load() = 0;
 
     virtual void Update(const GameTimer& timer) = 0;
 
-    virtual void Render(ID3D12GraphicsCommandList* commandList, const GameTimer& timer) = 0;
+    virtual void Render(CommandContext& context, const GameTimer& timer) = 0;
 
 protected:
+    /// Records items [begin, end) on a worker thread, e.g. a range of sorted draw packets.
+    using RecordFunction = std::function<void(CommandContext& context, size_t begin, size_t end)>;
+
     static constexpr int FRAME_COUNT = 3;
 
-    SDL_Window*                   m_window;
-    std::unique_ptr<Camera>       m_camera;
-    std::unique_ptr<Keyboard>     m_keyboard;
-    std::unique_ptr<Mouse>        m_mouse;
-    std::unique_ptr<D3D12Context> m_context;
+    /// @brief Records [0, count) into command lists of their own across m_threadPool.
+    ///
+    /// Call from Render(). The lists run between what the frame recorded before and after the
+    /// call, each starting with the viewport and surface bound but no other state. The context
+    /// passed to Render() keeps working and counts the calls of the workers too.
+    /// @param [in] minCountPerList Fewest items worth a list of their own.
+    void RecordParallel(size_t count, size_t minCountPerList, const RecordFunction& record);
+
+    SDL_Window*                            m_window;
+    std::unique_ptr<Camera>                m_camera;
+    std::unique_ptr<Keyboard>              m_keyboard;
+    std::unique_ptr<Mouse>                 m_mouse;
+    std::unique_ptr<D3D12Context>          m_context;
+    std::unique_ptr<ThreadPool>            m_threadPool;
+    std::unique_ptr<GraphicsPipelineCache> m_pipelines;
 
 private:
-    GameTimer m_timer;
-    bool      m_running;
+    /// @brief Builds the frame graph of one frame around the back buffer, then records it.
+    void RecordFrame();
+
+    GameTimer                          m_timer;
+    std::optional<D3D12CommandBackend> m_commandBackend;
+    CommandContext                     m_commandContext;
+    FrameGraph                         m_frameGraph;
+    bool                               m_running;
 };
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FenceTimeline.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+FenceTimeline::FenceTimeline(TimelineBackend& backend) : m_backend(backend)
+{
+}
+
+TimelinePoint FenceTimeline::Signal(const QueueType queue)
+{
+    QueueState&    state = State(queue);
+    const uint64_t value = state.NextValue++;
+    m_backend.Signal(queue, value);
+    ++m_stats.Signals;
+    return {queue, value};
+}
+
+uint64_t FenceTimeline::NextValue(const QueueType queue) const
+{
+    return m_queues[static_cast<size_t>(queue)].NextValue;
+}
+
+TimelinePoint FenceTimeline::LastSignaled(const QueueType queue) const
+{
+    return {queue, NextValue(queue) - 1};
+}
+
+void FenceTimeline::Wait(const QueueType queue, const TimelinePoint point)
+{
+    assert(point.Value < NextValue(point.Queue) && "Waiting for a value that was never signaled deadlocks the queue");
+
+    // A queue runs its own work in order, and the other checks cover the point already.
+    uint64_t& waited = State(queue).Waited[static_cast<size_t>(point.Queue)];
+    if (point.Queue == queue || waited >= point.Value || State(point.Queue).Completed >= point.Value)
+    {
+        ++m_stats.ElidedGpuWaits;
+        return;
+    }
+
+    m_backend.Wait(queue, point);
+    waited = point.Value;
+    ++m_stats.GpuWaits;
+}
+
+bool FenceTimeline::IsComplete(const TimelinePoint point)
+{
+    return State(point.Queue).Completed >= point.Value || CompletedValue(point.Queue) >= point.Value;
+}
+
+uint64_t FenceTimeline::CompletedValue(const QueueType queue)
+{
+    QueueState& state = State(queue);
+    state.Completed = std::max(state.Completed, m_backend.CompletedValue(queue));
+    ++m_stats.FenceQueries;
+    return state.Completed;
+}
+
+void FenceTimeline::WaitForCompletion(const TimelinePoint point)
+{
+    if (IsComplete(point))
+    {
+        return;
+    }
+
+    m_backend.WaitForCompletion(point);
+    State(point.Queue).Completed = point.Value;
+    ++m_stats.CpuWaits;
+}
+
+void FenceTimeline::WaitForIdle()
+{
+    for (uint32_t queue = 0; queue < QueueTypeCount; ++queue)
+    {
+        WaitForCompletion(Signal(static_cast<QueueType>(queue)));
+    }
+}
+
+const FenceTimeline::Statistics& FenceTimeline::Stats() const
+{
+    return m_stats;
+}
+
+FenceTimeline::QueueState& FenceTimeline::State(const QueueType queue)
+{
+    return m_queues[static_cast<size_t>(queue)];
+}
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/// Hardware queues work can be submitted to, matching the D3D12 command list types.
+enum class QueueType : uint8_t
+{
+    Direct,
+    Compute,
+    Copy,
+};
+
+constexpr uint32_t QueueTypeCount = 3;
+
+/// Point on the timeline of a queue, reached once the fence of the queue has Value.
+struct TimelinePoint
+{
+    QueueType Queue = QueueType::Direct;
+    uint64_t  Value = 0;
+};
+
+/// @brief Queue and fence operations a FenceTimeline is built on.
+///
+/// The D3D12 implementation owns a queue and a fence per QueueType.
+class TimelineBackend
+{
+public:
+    virtual ~TimelineBackend() = default;
+
+    /// @brief Sets the fence of the queue to value once the work submitted so far has finished.
+    virtual void Signal(QueueType queue, uint64_t value) = 0;
+
+    /// @brief Holds back later work on the queue until the point is reached, without blocking the CPU.
+    virtual void Wait(QueueType queue, TimelinePoint point) = 0;
+
+    [[nodiscard]] virtual uint64_t CompletedValue(QueueType queue) = 0;
+
+    /// @brief Blocks the calling thread until the point is reached.
+    virtual void WaitForCompletion(TimelinePoint point) = 0;
+};
+
+/// @brief One monotonically increasing fence per queue, with waits between queues.
+///
+/// Signal() hands out the next value of a queue, so a TimelinePoint names all work
+/// submitted to that queue before it. Wait() makes a queue wait on the GPU for a point of
+/// another queue, skipping waits an earlier wait or the completed value already covers.
+/// IsComplete() answers from the last completed value it saw and only queries the fence
+/// when that is not enough, so it never blocks and is cheap to call per resource. All
+/// calls belong to one thread.
+class FenceTimeline final
+{
+public:
+    struct Statistics
+    {
+        uint32_t Signals = 0;
+        uint32_t GpuWaits = 0;       ///< Waits passed on to the backend.
+        uint32_t ElidedGpuWaits = 0; ///< Waits already covered, by queue order, an earlier wait or completion.
+        uint32_t CpuWaits = 0;       ///< Times the calling thread blocked.
+        uint32_t FenceQueries = 0;   ///< Completed values read from the backend.
+    };
+
+    explicit FenceTimeline(TimelineBackend& backend);
+
+    /// @brief Signals the next value of the queue after the work submitted to it so far.
+    TimelinePoint Signal(QueueType queue);
+
+    /// @brief Gets the value the next Signal() of the queue returns, e.g. to tag work before submitting it.
+    [[nodiscard]] uint64_t NextValue(QueueType queue) const;
+
+    /// @brief Gets the point of the last Signal() of the queue; its value is zero before the first.
+    [[nodiscard]] TimelinePoint LastSignaled(QueueType queue) const;
+
+    /// @brief Makes later work on the queue wait on the GPU until the point is reached.
+    void Wait(QueueType queue, TimelinePoint point);
+
+    /// @brief Checks whether the GPU has reached the point, without blocking.
+    [[nodiscard]] bool IsComplete(TimelinePoint point);
+
+    /// @brief Reads the completed value of the queue from its fence.
+    [[nodiscard]] uint64_t CompletedValue(QueueType queue);
+
+    /// @brief Blocks the calling thread until the point is reached.
+    void WaitForCompletion(TimelinePoint point);
+
+    /// @brief Signals every queue and blocks until all of them have finished their work.
+    void WaitForIdle();
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+private:
+    struct QueueState
+    {
+        uint64_t                             NextValue = 1;
+        uint64_t                             Completed = 0; ///< Last completed value read, never ahead of the fence.
+        std::array<uint64_t, QueueTypeCount> Waited{};      ///< Highest value of each queue waited for.
+    };
+
+    QueueState& State(QueueType queue);
+
+    TimelineBackend&                       m_backend;
+    std::array<QueueState, QueueTypeCount> m_queues{};
+    Statistics                             m_stats;
+};
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FenceTimelineD3D12.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include <fmt/xchar.h>
+
+namespace
+{
+    constexpr D3D12_COMMAND_LIST_TYPE ListTypes[QueueTypeCount] = {
+        D3D12_COMMAND_LIST_TYPE_DIRECT, D3D12_COMMAND_LIST_TYPE_COMPUTE, D3D12_COMMAND_LIST_TYPE_COPY};
+
+    constexpr const wchar_t* QueueNames[QueueTypeCount] = {L"Direct", L"Compute", L"Copy"};
+} // namespace
+
+D3D12TimelineBackend::D3D12TimelineBackend(ID3D12Device* device)
+{
+    for (uint32_t i = 0; i < QueueTypeCount; ++i)
+    {
+        D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+        queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        queueDesc.Type = ListTypes[i];
+
+        winrt::check_hresult(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_queues[i])));
+        std::wstring name = fmt::format(L"FenceTimeline::{}Queue", QueueNames[i]);
+        winrt::check_hresult(m_queues[i]->SetName(name.c_str()));
+
+        winrt::check_hresult(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fences[i])));
+        name = fmt::format(L"FenceTimeline::{}Fence", QueueNames[i]);
+        winrt::check_hresult(m_fences[i]->SetName(name.c_str()));
+    }
+
+    m_event.attach(CreateEventEx(nullptr, nullptr, 0, EVENT_MODIFY_STATE | SYNCHRONIZE));
+    if (!m_event)
+    {
+        throw std::runtime_error("Failed to allocate fence timeline event");
+    }
+}
+
+ID3D12CommandQueue* D3D12TimelineBackend::Queue(const QueueType queue) const
+{
+    return m_queues[static_cast<size_t>(queue)].get();
+}
+
+void D3D12TimelineBackend::Signal(const QueueType queue, const uint64_t value)
+{
+    const auto index = static_cast<size_t>(queue);
+    winrt::check_hresult(m_queues[index]->Signal(m_fences[index].get(), value));
+}
+
+void D3D12TimelineBackend::Wait(const QueueType queue, const TimelinePoint point)
+{
+    ID3D12Fence* fence = m_fences[static_cast<size_t>(point.Queue)].get();
+    winrt::check_hresult(m_queues[static_cast<size_t>(queue)]->Wait(fence, point.Value));
+}
+
+uint64_t D3D12TimelineBackend::CompletedValue(const QueueType queue)
+{
+    return m_fences[static_cast<size_t>(queue)]->GetCompletedValue();
+}
+
+void D3D12TimelineBackend::WaitForCompletion(const TimelinePoint point)
+{
+    ID3D12Fence* fence = m_fences[static_cast<size_t>(point.Queue)].get();
+    if (fence->GetCompletedValue() < point.Value)
+    {
+        winrt::check_hresult(fence->SetEventOnCompletion(point.Value, m_event.get()));
+
+        WaitForSingleObjectEx(m_event.get(), INFINITE, FALSE);
+    }
+}
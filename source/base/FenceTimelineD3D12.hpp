@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <directx/d3d12.h>
+#include <winrt/base.h>
+
+#include "FenceTimeline.hpp"
+
+/// @brief TimelineBackend with a D3D12 command queue and fence for each QueueType.
+class D3D12TimelineBackend final : public TimelineBackend
+{
+public:
+    explicit D3D12TimelineBackend(ID3D12Device* device);
+
+    D3D12TimelineBackend(const D3D12TimelineBackend&) = delete;
+    D3D12TimelineBackend& operator=(const D3D12TimelineBackend&) = delete;
+
+    [[nodiscard]] ID3D12CommandQueue* Queue(QueueType queue) const;
+
+    void Signal(QueueType queue, uint64_t value) override;
+
+    void Wait(QueueType queue, TimelinePoint point) override;
+
+    [[nodiscard]] uint64_t CompletedValue(QueueType queue) override;
+
+    void WaitForCompletion(TimelinePoint point) override;
+
+private:
+    std::array<winrt::com_ptr<ID3D12CommandQueue>, QueueTypeCount> m_queues;
+    std::array<winrt::com_ptr<ID3D12Fence>, QueueTypeCount>        m_fences;
+    winrt::handle                                                  m_event;
+};
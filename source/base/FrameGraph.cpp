@@ -0,0 +1,497 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FrameGraph.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+    constexpr uint32_t NoPass = UINT32_MAX;
+
+    /// Combines the uses of one resource within a pass. A write state covers any reads
+    /// in the same pass, e.g. depth testing while writing depth.
+    uint32_t CombineUsage(const uint32_t current, const uint32_t usage)
+    {
+        if (ResourceUsage::IsWrite(current) || ResourceUsage::IsWrite(usage))
+        {
+            return (current | usage) & ResourceUsage::WriteMask;
+        }
+        return current | usage;
+    }
+} // namespace
+
+void FrameGraph::Reset()
+{
+    m_resources.clear();
+    m_passes.clear();
+    m_accesses.clear();
+    m_order.clear();
+    m_barriers.clear();
+    m_barrierOffsets.clear();
+    m_stats = {};
+}
+
+FrameGraphResource FrameGraph::Import(const std::string_view name,
+                                      const uint32_t         initialUsage,
+                                      const uint32_t         finalUsage)
+{
+    ResourceNode& resource = m_resources.emplace_back();
+    resource.Name = name;
+    resource.InitialUsage = initialUsage;
+    resource.FinalUsage = finalUsage;
+    resource.Imported = true;
+    return static_cast<FrameGraphResource>(m_resources.size() - 1);
+}
+
+FrameGraphResource FrameGraph::CreateTransient(const std::string_view name, const TransientMemory& memory)
+{
+    ResourceNode& resource = m_resources.emplace_back();
+    resource.Name = name;
+    resource.Memory = memory;
+    return static_cast<FrameGraphResource>(m_resources.size() - 1);
+}
+
+FrameGraphPass FrameGraph::AddPass(const std::string_view name, ExecuteFunction execute)
+{
+    PassNode& pass = m_passes.emplace_back();
+    pass.Name = name;
+    pass.Execute = std::move(execute);
+    return static_cast<FrameGraphPass>(m_passes.size() - 1);
+}
+
+void FrameGraph::Read(const FrameGraphPass pass, const FrameGraphResource resource, const uint32_t usage)
+{
+    assert(pass < m_passes.size() && resource < m_resources.size() && !ResourceUsage::IsWrite(usage));
+    m_accesses.push_back({pass, resource, usage});
+}
+
+void FrameGraph::Write(const FrameGraphPass pass, const FrameGraphResource resource, const uint32_t usage)
+{
+    assert(pass < m_passes.size() && resource < m_resources.size() && ResourceUsage::IsWrite(usage));
+    m_accesses.push_back({pass, resource, usage});
+}
+
+void FrameGraph::SetSideEffects(const FrameGraphPass pass)
+{
+    m_passes[pass].SideEffects = true;
+}
+
+void FrameGraph::Compile()
+{
+    m_stats = {};
+    m_stats.Passes = static_cast<uint32_t>(m_passes.size());
+
+    BuildEdges();
+    Cull();
+    Schedule();
+    ComputeBarriers();
+}
+
+void FrameGraph::BuildEdges()
+{
+    const auto passCount = static_cast<uint32_t>(m_passes.size());
+    const auto resourceCount = static_cast<uint32_t>(m_resources.size());
+
+    // Bucket accesses by pass; a counting sort keeps the declaration order within each pass.
+    m_accessOffsets.assign(passCount + 1, 0);
+    for (const Access& access : m_accesses)
+    {
+        ++m_accessOffsets[access.Pass + 1];
+    }
+    for (uint32_t pass = 0; pass < passCount; ++pass)
+    {
+        m_accessOffsets[pass + 1] += m_accessOffsets[pass];
+    }
+    m_cursor.assign(m_accessOffsets.begin(), m_accessOffsets.end() - 1);
+    m_passAccesses.resize(m_accesses.size());
+    for (const Access& access : m_accesses)
+    {
+        m_passAccesses[m_cursor[access.Pass]++] = access;
+    }
+
+    // Walk the passes in declaration order, tracking the last writer and the readers since.
+    m_edges.clear();
+    m_lastWriter.assign(resourceCount, NoPass);
+    m_readers.resize(std::max<size_t>(m_readers.size(), resourceCount));
+    for (uint32_t resource = 0; resource < resourceCount; ++resource)
+    {
+        m_readers[resource].clear();
+    }
+
+    for (uint32_t pass = 0; pass < passCount; ++pass)
+    {
+        const auto accesses = std::span(m_passAccesses).subspan(m_accessOffsets[pass],
+                                                                m_accessOffsets[pass + 1] - m_accessOffsets[pass]);
+        for (const Access& access : accesses)
+        {
+            if (ResourceUsage::IsWrite(access.Usage))
+            {
+                continue;
+            }
+
+            const FrameGraphPass writer = m_lastWriter[access.Resource];
+            if (writer != NoPass && writer != pass)
+            {
+                m_edges.push_back({writer, pass, true});
+            }
+            m_readers[access.Resource].push_back(pass);
+        }
+
+        for (const Access& access : accesses)
+        {
+            if (!ResourceUsage::IsWrite(access.Usage))
+            {
+                continue;
+            }
+
+            // Later writes may only load part of the earlier contents, so they keep the earlier writer alive.
+            const FrameGraphPass writer = m_lastWriter[access.Resource];
+            if (writer != NoPass && writer != pass)
+            {
+                m_edges.push_back({writer, pass, true});
+            }
+            for (const FrameGraphPass reader : m_readers[access.Resource])
+            {
+                if (reader != pass)
+                {
+                    m_edges.push_back({reader, pass, false});
+                }
+            }
+            m_readers[access.Resource].clear();
+            m_lastWriter[access.Resource] = pass;
+        }
+    }
+
+    m_edgeOffsets.assign(passCount + 1, 0);
+    for (const Edge& edge : m_edges)
+    {
+        ++m_edgeOffsets[edge.From + 1];
+    }
+    for (uint32_t pass = 0; pass < passCount; ++pass)
+    {
+        m_edgeOffsets[pass + 1] += m_edgeOffsets[pass];
+    }
+    m_cursor.assign(m_edgeOffsets.begin(), m_edgeOffsets.end() - 1);
+    m_edgesBySource.resize(m_edges.size());
+    for (const Edge& edge : m_edges)
+    {
+        m_edgesBySource[m_cursor[edge.From]++] = edge;
+    }
+}
+
+void FrameGraph::Cull()
+{
+    // Edges always point to later passes, so one backwards sweep sees every consumer before its producers.
+    for (auto pass = static_cast<uint32_t>(m_passes.size()); pass-- > 0;)
+    {
+        bool alive = m_passes[pass].SideEffects;
+        for (uint32_t i = m_accessOffsets[pass]; i < m_accessOffsets[pass + 1] && !alive; ++i)
+        {
+            const Access& access = m_passAccesses[i];
+            alive = ResourceUsage::IsWrite(access.Usage) && m_resources[access.Resource].Imported;
+        }
+        for (uint32_t i = m_edgeOffsets[pass]; i < m_edgeOffsets[pass + 1] && !alive; ++i)
+        {
+            const Edge& edge = m_edgesBySource[i];
+            alive = edge.Data && !m_passes[edge.To].Culled;
+        }
+
+        m_passes[pass].Culled = !alive;
+        if (!alive)
+        {
+            ++m_stats.CulledPasses;
+        }
+    }
+}
+
+void FrameGraph::Schedule()
+{
+    const auto passCount = static_cast<uint32_t>(m_passes.size());
+
+    m_inDegree.assign(passCount, 0);
+    for (const Edge& edge : m_edges)
+    {
+        if (!m_passes[edge.From].Culled && !m_passes[edge.To].Culled)
+        {
+            ++m_inDegree[edge.To];
+        }
+    }
+
+    m_ready.clear();
+    for (uint32_t pass = 0; pass < passCount; ++pass)
+    {
+        if (!m_passes[pass].Culled && m_inDegree[pass] == 0)
+        {
+            m_ready.push_back(pass);
+        }
+    }
+
+    // Kahn's algorithm, preferring the earliest declared pass that does not depend on the
+    // pass just scheduled. Putting other work between a producer and its consumer gives
+    // split barriers room to overlap.
+    m_order.clear();
+    m_stamp.assign(passCount, 0);
+    while (!m_ready.empty())
+    {
+        const auto step = static_cast<uint32_t>(m_order.size());
+        auto       next = std::find_if(m_ready.begin(), m_ready.end(),
+                                       [&](const FrameGraphPass pass) { return m_stamp[pass] != step; });
+        if (next == m_ready.end())
+        {
+            next = m_ready.begin();
+        }
+
+        const FrameGraphPass pass = *next;
+        m_ready.erase(next);
+        m_order.push_back(pass);
+
+        for (uint32_t i = m_edgeOffsets[pass]; i < m_edgeOffsets[pass + 1]; ++i)
+        {
+            const FrameGraphPass successor = m_edgesBySource[i].To;
+            if (m_passes[successor].Culled)
+            {
+                continue;
+            }
+
+            m_stamp[successor] = step + 1;
+            if (--m_inDegree[successor] == 0)
+            {
+                m_ready.insert(std::lower_bound(m_ready.begin(), m_ready.end(), successor), successor);
+            }
+        }
+    }
+
+    assert(m_order.size() + m_stats.CulledPasses == passCount);
+}
+
+void FrameGraph::ComputeBarriers()
+{
+    const auto resourceCount = static_cast<uint32_t>(m_resources.size());
+    const auto stepCount = static_cast<uint32_t>(m_order.size());
+
+    m_segments.resize(std::max<size_t>(m_segments.size(), resourceCount));
+    for (uint32_t resource = 0; resource < resourceCount; ++resource)
+    {
+        m_segments[resource].clear();
+    }
+
+    for (uint32_t step = 0; step < stepCount; ++step)
+    {
+        const FrameGraphPass pass = m_order[step];
+        for (uint32_t i = m_accessOffsets[pass]; i < m_accessOffsets[pass + 1]; ++i)
+        {
+            const Access&         access = m_passAccesses[i];
+            std::vector<Segment>& segments = m_segments[access.Resource];
+            if (!segments.empty() && segments.back().FirstStep == step)
+            {
+                segments.back().Usage = CombineUsage(segments.back().Usage, access.Usage);
+                continue;
+            }
+            segments.push_back({access.Usage, step, step});
+        }
+    }
+
+    // Aliasing barriers go first in their batch, before the new resource is transitioned or used.
+    m_pendingBarriers.clear();
+    PlanAliasing();
+
+    for (uint32_t resource = 0; resource < resourceCount; ++resource)
+    {
+        std::vector<Segment>& segments = m_segments[resource];
+        ResourceNode&         node = m_resources[resource];
+
+        // Merge runs of reads into one state, and writes that need no barrier between them.
+        size_t merged = 0;
+        for (size_t i = 1; i < segments.size(); ++i)
+        {
+            Segment&       last = segments[merged];
+            const Segment& next = segments[i];
+
+            const bool reads = !ResourceUsage::IsWrite(last.Usage) && !ResourceUsage::IsWrite(next.Usage);
+            const bool writes = last.Usage == next.Usage && next.Usage != ResourceUsage::UnorderedAccess;
+            if (reads || writes)
+            {
+                last.Usage |= next.Usage;
+                last.LastStep = next.LastStep;
+            }
+            else
+            {
+                segments[++merged] = next;
+            }
+        }
+        if (!segments.empty())
+        {
+            segments.resize(merged + 1);
+        }
+
+        // Transient resources start in the state of their first use.
+        if (!node.Imported && !segments.empty())
+        {
+            node.InitialUsage = segments.front().Usage;
+        }
+        uint32_t usage = node.InitialUsage;
+        uint32_t available = 0;
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            const Segment& segment = segments[i];
+            if (usage != segment.Usage)
+            {
+                AddTransition(resource, usage, segment.Usage, available, segment.FirstStep);
+            }
+            else if (i > 0)
+            {
+                // Only unordered access writes stay in separate segments with the same state.
+                FrameGraphBarrier barrier;
+                barrier.Resource = resource;
+                barrier.Before = usage;
+                barrier.After = usage;
+                barrier.Kind = FrameGraphBarrier::Type::UnorderedAccess;
+                AddBarrier(segment.FirstStep, barrier);
+            }
+
+            usage = segment.Usage;
+            available = segment.LastStep + 1;
+        }
+
+        if (node.Imported && usage != node.FinalUsage)
+        {
+            AddTransition(resource, usage, node.FinalUsage, available, stepCount);
+        }
+    }
+
+    // Bucket the barriers by step so each batch is contiguous.
+    m_barrierOffsets.assign(stepCount + 2, 0);
+    for (const auto& [step, barrier] : m_pendingBarriers)
+    {
+        ++m_barrierOffsets[step + 1];
+    }
+    for (uint32_t step = 0; step <= stepCount; ++step)
+    {
+        if (m_barrierOffsets[step + 1] > 0)
+        {
+            ++m_stats.BarrierBatches;
+        }
+        m_barrierOffsets[step + 1] += m_barrierOffsets[step];
+    }
+    m_cursor.assign(m_barrierOffsets.begin(), m_barrierOffsets.end() - 1);
+    m_barriers.resize(m_pendingBarriers.size());
+    for (const auto& [step, barrier] : m_pendingBarriers)
+    {
+        m_barriers[m_cursor[step]++] = barrier;
+    }
+
+    m_stats.Barriers = static_cast<uint32_t>(m_barriers.size());
+}
+
+void FrameGraph::PlanAliasing()
+{
+    m_allocations.resize(m_resources.size());
+    for (uint32_t resource = 0; resource < m_resources.size(); ++resource)
+    {
+        const ResourceNode&         node = m_resources[resource];
+        const std::vector<Segment>& segments = m_segments[resource];
+
+        TransientAllocation& allocation = m_allocations[resource];
+        allocation = {};
+        if (!node.Imported && !segments.empty())
+        {
+            allocation.Memory = node.Memory;
+            allocation.FirstUse = segments.front().FirstStep;
+            allocation.LastUse = segments.back().LastStep;
+        }
+    }
+    m_aliasing.Plan(m_allocations);
+
+    for (const AliasingBarrier& aliasing : m_aliasing.Barriers())
+    {
+        FrameGraphBarrier barrier;
+        barrier.Resource = aliasing.After;
+        barrier.Kind = FrameGraphBarrier::Type::Aliasing;
+        barrier.Previous = aliasing.Before;
+        AddBarrier(aliasing.Step, barrier);
+    }
+}
+
+void FrameGraph::AddTransition(const FrameGraphResource resource,
+                               const uint32_t           before,
+                               const uint32_t           after,
+                               const uint32_t           available,
+                               const uint32_t           needed)
+{
+    FrameGraphBarrier barrier;
+    barrier.Resource = resource;
+    barrier.Before = before;
+    barrier.After = after;
+
+    if (available == needed)
+    {
+        AddBarrier(needed, barrier);
+        return;
+    }
+
+    barrier.Part = FrameGraphBarrier::Split::Begin;
+    AddBarrier(available, barrier);
+    barrier.Part = FrameGraphBarrier::Split::End;
+    AddBarrier(needed, barrier);
+    ++m_stats.SplitBarriers;
+}
+
+void FrameGraph::AddBarrier(const uint32_t step, const FrameGraphBarrier& barrier)
+{
+    m_pendingBarriers.emplace_back(step, barrier);
+}
+
+std::span<const FrameGraphPass> FrameGraph::ExecutionOrder() const
+{
+    return m_order;
+}
+
+std::span<const FrameGraphBarrier> FrameGraph::Barriers(const uint32_t step) const
+{
+    assert(step + 1 < m_barrierOffsets.size());
+    return std::span(m_barriers).subspan(m_barrierOffsets[step], m_barrierOffsets[step + 1] - m_barrierOffsets[step]);
+}
+
+bool FrameGraph::IsCulled(const FrameGraphPass pass) const
+{
+    return m_passes[pass].Culled;
+}
+
+const std::string& FrameGraph::PassName(const FrameGraphPass pass) const
+{
+    return m_passes[pass].Name;
+}
+
+const std::string& FrameGraph::ResourceName(const FrameGraphResource resource) const
+{
+    return m_resources[resource].Name;
+}
+
+uint32_t FrameGraph::InitialUsage(const FrameGraphResource resource) const
+{
+    return m_resources[resource].InitialUsage;
+}
+
+const AliasingPlanner& FrameGraph::Aliasing() const
+{
+    return m_aliasing;
+}
+
+uint32_t FrameGraph::PassCount() const
+{
+    return static_cast<uint32_t>(m_passes.size());
+}
+
+uint32_t FrameGraph::ResourceCount() const
+{
+    return static_cast<uint32_t>(m_resources.size());
+}
+
+const FrameGraph::Statistics& FrameGraph::Stats() const
+{
+    return m_stats;
+}
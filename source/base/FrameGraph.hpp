@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "AliasingPlanner.hpp"
+
+class CommandContext;
+struct ID3D12Resource;
+
+/// @brief Ways a pass can use a resource.
+///
+/// The values are bit flags so that several reads in the same pass, or in
+/// consecutive passes, combine into one state. Each maps to the D3D12 resource
+/// state of the same name.
+struct ResourceUsage
+{
+    static constexpr uint32_t None = 0;
+    static constexpr uint32_t RenderTarget = 1u << 0;
+    static constexpr uint32_t DepthWrite = 1u << 1;
+    static constexpr uint32_t DepthRead = 1u << 2;
+    static constexpr uint32_t PixelShaderResource = 1u << 3;
+    static constexpr uint32_t NonPixelShaderResource = 1u << 4;
+    static constexpr uint32_t UnorderedAccess = 1u << 5;
+    static constexpr uint32_t CopySource = 1u << 6;
+    static constexpr uint32_t CopyDest = 1u << 7;
+    static constexpr uint32_t Present = 1u << 8;
+
+    static constexpr uint32_t WriteMask = RenderTarget | DepthWrite | UnorderedAccess | CopyDest;
+
+    static constexpr bool IsWrite(const uint32_t usage)
+    {
+        return (usage & WriteMask) != 0;
+    }
+};
+
+using FrameGraphResource = uint32_t;
+using FrameGraphPass = uint32_t;
+
+/// One barrier computed by FrameGraph::Compile.
+struct FrameGraphBarrier
+{
+    enum class Type : uint8_t
+    {
+        Transition,
+        UnorderedAccess, ///< Orders two passes writing the same unordered access resource.
+        Aliasing,        ///< Hands shared heap memory from Previous to Resource.
+    };
+
+    enum class Split : uint8_t
+    {
+        None,
+        Begin, ///< Issued right after the last use in the old state.
+        End,   ///< Issued right before the first use in the new state.
+    };
+
+    FrameGraphResource Resource = 0;
+    uint32_t           Before = ResourceUsage::None;
+    uint32_t           After = ResourceUsage::None;
+    Type               Kind = Type::Transition;
+    Split              Part = Split::None;
+    FrameGraphResource Previous = UINT32_MAX; ///< Aliasing only; UINT32_MAX when several resources used the memory.
+};
+
+/// @brief Orders the passes of a frame and derives the barriers between them.
+///
+/// Passes declare the resources they read and write, and the order of declaration
+/// defines which write a read sees. Compile() culls passes whose results are never
+/// used, orders the rest and computes one batch of barriers before each pass. When
+/// other passes run between two uses of a resource, its transition is split so the
+/// GPU can overlap it with that work. Transient resources given a size are packed into
+/// shared heaps by an AliasingPlanner. Compilation uses no device, so it can run and
+/// be measured anywhere; Execute() records the result through a CommandContext.
+///
+/// The graph is meant to be rebuilt every frame: Reset() keeps all allocations.
+class FrameGraph final
+{
+public:
+    using ExecuteFunction = std::function<void(CommandContext&)>;
+
+    struct Statistics
+    {
+        uint32_t Passes = 0;
+        uint32_t CulledPasses = 0;
+        uint32_t Barriers = 0;       ///< Barriers issued, counting both halves of a split barrier.
+        uint32_t SplitBarriers = 0;  ///< Transitions issued as begin and end halves.
+        uint32_t BarrierBatches = 0; ///< ResourceBarrier calls.
+    };
+
+    /// @brief Forgets all passes and resources, keeping allocations for the next frame.
+    void Reset();
+
+    /// @brief Adds a resource owned outside the graph, such as a back buffer.
+    ///
+    /// The resource is transitioned from initialUsage on first use and back to
+    /// finalUsage when the frame ends. Passes writing it are never culled.
+    FrameGraphResource Import(std::string_view name, uint32_t initialUsage, uint32_t finalUsage);
+
+    /// @brief Adds a resource that only lives during the frame. It starts in the state of its first use.
+    /// @param [in] memory Size and alignment of the resource; transients with a size share heaps
+    ///                    with others whose lifetimes do not overlap.
+    FrameGraphResource CreateTransient(std::string_view name, const TransientMemory& memory = {});
+
+    FrameGraphPass AddPass(std::string_view name, ExecuteFunction execute);
+
+    void Read(FrameGraphPass pass, FrameGraphResource resource, uint32_t usage);
+
+    void Write(FrameGraphPass pass, FrameGraphResource resource, uint32_t usage);
+
+    /// @brief Keeps a pass even if nothing reads its results, e.g. for readbacks or debug output.
+    void SetSideEffects(FrameGraphPass pass);
+
+    void Compile();
+
+    /// @brief Records the compiled frame, issuing each batch of barriers before its pass.
+    /// @param [in] resources Native resource for every graph resource, indexed by handle.
+    void Execute(CommandContext& context, std::span<ID3D12Resource* const> resources) const;
+
+    /// @brief Gets the passes that survived culling, in the order they execute.
+    [[nodiscard]] std::span<const FrameGraphPass> ExecutionOrder() const;
+
+    /// @brief Gets the barriers to issue before a step of the execution order.
+    /// @param [in] step Index into ExecutionOrder(); its size gives the barriers that end the frame.
+    [[nodiscard]] std::span<const FrameGraphBarrier> Barriers(uint32_t step) const;
+
+    [[nodiscard]] bool IsCulled(FrameGraphPass pass) const;
+
+    [[nodiscard]] const std::string& PassName(FrameGraphPass pass) const;
+
+    [[nodiscard]] const std::string& ResourceName(FrameGraphResource resource) const;
+
+    /// @brief Gets the state to create a resource in; for transients, the state of their first use.
+    [[nodiscard]] uint32_t InitialUsage(FrameGraphResource resource) const;
+
+    /// @brief Gets the heaps and placements of the transient resources, indexed by resource handle.
+    ///
+    /// Placed resources created at these offsets in their InitialUsage() state can be passed to
+    /// Execute(), which issues the aliasing barriers between them.
+    [[nodiscard]] const AliasingPlanner& Aliasing() const;
+
+    [[nodiscard]] uint32_t PassCount() const;
+
+    [[nodiscard]] uint32_t ResourceCount() const;
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+private:
+    struct ResourceNode
+    {
+        std::string     Name;
+        TransientMemory Memory;
+        uint32_t        InitialUsage = ResourceUsage::None;
+        uint32_t        FinalUsage = ResourceUsage::None;
+        bool            Imported = false;
+    };
+
+    struct PassNode
+    {
+        std::string     Name;
+        ExecuteFunction Execute;
+        bool            SideEffects = false;
+        bool            Culled = false;
+    };
+
+    struct Access
+    {
+        FrameGraphPass     Pass;
+        FrameGraphResource Resource;
+        uint32_t           Usage;
+    };
+
+    /// Ordering constraint between two passes. Only data edges keep their source alive.
+    struct Edge
+    {
+        FrameGraphPass From;
+        FrameGraphPass To;
+        bool           Data;
+    };
+
+    /// Consecutive uses of a resource that share one state.
+    struct Segment
+    {
+        uint32_t Usage;
+        uint32_t FirstStep;
+        uint32_t LastStep;
+    };
+
+    /// Native barriers of one batch. Defined where D3D12 is available, so this header cannot own them directly.
+    struct NativeBarrierBatch;
+
+    void BuildEdges();
+
+    void Cull();
+
+    void Schedule();
+
+    void ComputeBarriers();
+
+    void PlanAliasing();
+
+    /// Adds a transition that may start before step available and must end before step needed.
+    void AddTransition(FrameGraphResource resource,
+                       uint32_t           before,
+                       uint32_t           after,
+                       uint32_t           available,
+                       uint32_t           needed);
+
+    void AddBarrier(uint32_t step, const FrameGraphBarrier& barrier);
+
+    std::vector<ResourceNode> m_resources;
+    std::vector<PassNode>     m_passes;
+    std::vector<Access>       m_accesses;
+
+    // Compilation scratch and results, kept between frames to avoid allocations.
+    std::vector<uint32_t>                               m_accessOffsets;
+    std::vector<uint32_t>                               m_cursor;
+    std::vector<Access>                                 m_passAccesses;
+    std::vector<Edge>                                   m_edges;
+    std::vector<uint32_t>                               m_edgeOffsets;
+    std::vector<Edge>                                   m_edgesBySource;
+    std::vector<FrameGraphPass>                         m_lastWriter;
+    std::vector<std::vector<FrameGraphPass>>            m_readers;
+    std::vector<uint32_t>                               m_inDegree;
+    std::vector<FrameGraphPass>                         m_ready;
+    std::vector<uint32_t>                               m_stamp;
+    std::vector<FrameGraphPass>                         m_order;
+    std::vector<std::vector<Segment>>                   m_segments;
+    std::vector<std::pair<uint32_t, FrameGraphBarrier>> m_pendingBarriers;
+    std::vector<uint32_t>                               m_barrierOffsets;
+    std::vector<FrameGraphBarrier>                      m_barriers;
+    std::vector<TransientAllocation>                    m_allocations;
+    AliasingPlanner                                     m_aliasing;
+    Statistics                                          m_stats;
+
+    // Created by the first Execute() and reused by the following ones.
+    mutable std::unique_ptr<NativeBarrierBatch, void (*)(NativeBarrierBatch*)> m_nativeBarriers{nullptr, nullptr};
+};
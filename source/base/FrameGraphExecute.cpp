@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FrameGraph.hpp"
+
+#include <cassert>
+#include <vector>
+
+#include <directx/d3dx12.h>
+
+#include "CommandContext.hpp"
+
+namespace
+{
+    D3D12_RESOURCE_STATES ToResourceState(const uint32_t usage)
+    {
+        static constexpr std::pair<uint32_t, D3D12_RESOURCE_STATES> States[] = {
+            {ResourceUsage::RenderTarget, D3D12_RESOURCE_STATE_RENDER_TARGET},
+            {ResourceUsage::DepthWrite, D3D12_RESOURCE_STATE_DEPTH_WRITE},
+            {ResourceUsage::DepthRead, D3D12_RESOURCE_STATE_DEPTH_READ},
+            {ResourceUsage::PixelShaderResource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE},
+            {ResourceUsage::NonPixelShaderResource, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE},
+            {ResourceUsage::UnorderedAccess, D3D12_RESOURCE_STATE_UNORDERED_ACCESS},
+            {ResourceUsage::CopySource, D3D12_RESOURCE_STATE_COPY_SOURCE},
+            {ResourceUsage::CopyDest, D3D12_RESOURCE_STATE_COPY_DEST},
+            {ResourceUsage::Present, D3D12_RESOURCE_STATE_PRESENT},
+        };
+
+        D3D12_RESOURCE_STATES states = D3D12_RESOURCE_STATE_COMMON;
+        for (const auto& [flag, state] : States)
+        {
+            if ((usage & flag) != 0)
+            {
+                states |= state;
+            }
+        }
+        return states;
+    }
+
+    D3D12_RESOURCE_BARRIER ToNativeBarrier(const FrameGraphBarrier& barrier,
+                                           ID3D12Resource*          resource,
+                                           ID3D12Resource*          previous)
+    {
+        if (barrier.Kind == FrameGraphBarrier::Type::UnorderedAccess)
+        {
+            return CD3DX12_RESOURCE_BARRIER::UAV(resource);
+        }
+        if (barrier.Kind == FrameGraphBarrier::Type::Aliasing)
+        {
+            return CD3DX12_RESOURCE_BARRIER::Aliasing(previous, resource);
+        }
+
+        D3D12_RESOURCE_BARRIER_FLAGS flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        if (barrier.Part == FrameGraphBarrier::Split::Begin)
+        {
+            flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+        }
+        else if (barrier.Part == FrameGraphBarrier::Split::End)
+        {
+            flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+        }
+        return CD3DX12_RESOURCE_BARRIER::Transition(resource, ToResourceState(barrier.Before),
+                                                    ToResourceState(barrier.After),
+                                                    D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, flags);
+    }
+} // namespace
+
+struct FrameGraph::NativeBarrierBatch
+{
+    std::vector<D3D12_RESOURCE_BARRIER> Barriers;
+};
+
+void FrameGraph::Execute(CommandContext& context, const std::span<ID3D12Resource* const> resources) const
+{
+    assert(resources.size() >= m_resources.size());
+
+    if (!m_nativeBarriers)
+    {
+        m_nativeBarriers = {new NativeBarrierBatch, [](NativeBarrierBatch* batch) { delete batch; }};
+    }
+    std::vector<D3D12_RESOURCE_BARRIER>& batch = m_nativeBarriers->Barriers;
+
+    const auto issue = [&](const uint32_t step) {
+        batch.clear();
+        for (const FrameGraphBarrier& barrier : Barriers(step))
+        {
+            ID3D12Resource* previous = barrier.Previous < resources.size() ? resources[barrier.Previous] : nullptr;
+            batch.push_back(ToNativeBarrier(barrier, resources[barrier.Resource], previous));
+        }
+        if (!batch.empty())
+        {
+            context.ResourceBarrier(static_cast<UINT>(batch.size()), batch.data());
+        }
+    };
+
+    const auto order = ExecutionOrder();
+    for (uint32_t step = 0; step < order.size(); ++step)
+    {
+        issue(step);
+        if (const PassNode& pass = m_passes[order[step]]; pass.Execute)
+        {
+            pass.Execute(context);
+        }
+    }
+    issue(static_cast<uint32_t>(order.size()));
+}
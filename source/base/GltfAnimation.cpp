@@ -0,0 +1,479 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#define CGLTF_IMPLEMENTATION
+#include <cgltf.h>
+
+#include "GltfAnimation.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include <SDL3/SDL.h>
+
+namespace
+{
+    using JointIndices = std::unordered_map<const cgltf_node*, uint32_t>;
+
+    struct GltfDeleter
+    {
+        void operator()(cgltf_data* data) const
+        {
+            cgltf_free(data);
+        }
+    };
+
+    using GltfData = std::unique_ptr<cgltf_data, GltfDeleter>;
+
+    std::string PathForResource(const char* fileName)
+    {
+        const auto            basePath = SDL_GetBasePath();
+        std::filesystem::path path = std::string(basePath);
+
+        path.append(fileName);
+        return path.string();
+    }
+
+    GltfData Parse(const std::string& path)
+    {
+        cgltf_options options{};
+        cgltf_data*   data = nullptr;
+        if (cgltf_parse_file(&options, path.c_str(), &data) != cgltf_result_success)
+        {
+            throw std::runtime_error(fmt::format("Failed to parse glTF file {}", path));
+        }
+
+        GltfData result(data);
+        if (cgltf_load_buffers(&options, data, path.c_str()) != cgltf_result_success)
+        {
+            throw std::runtime_error(fmt::format("Failed to load buffers of glTF file {}", path));
+        }
+        return result;
+    }
+
+    JointPose LocalPose(const cgltf_node& node)
+    {
+        JointPose pose;
+        if (node.has_matrix)
+        {
+            Matrix(node.matrix).Decompose(pose.Scale, pose.Rotation, pose.Translation);
+            return pose;
+        }
+
+        if (node.has_translation)
+        {
+            pose.Translation = Vector3(node.translation);
+        }
+        if (node.has_rotation)
+        {
+            pose.Rotation = Quaternion(node.rotation);
+        }
+        if (node.has_scale)
+        {
+            pose.Scale = Vector3(node.scale);
+        }
+        return pose;
+    }
+
+    uint32_t Depth(const cgltf_node* node)
+    {
+        uint32_t depth = 0;
+        for (; node->parent != nullptr; node = node->parent)
+        {
+            ++depth;
+        }
+        return depth;
+    }
+
+    /// Non-joint nodes between two joints are assumed to have identity transforms.
+    Skeleton LoadSkeleton(const cgltf_skin& skin, JointIndices& jointIndices)
+    {
+        // glTF does not order skin joints; sorting by depth puts every parent before its children.
+        std::vector<uint32_t> order(skin.joints_count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+            return Depth(skin.joints[a]) < Depth(skin.joints[b]);
+        });
+        for (uint32_t joint = 0; joint < order.size(); ++joint)
+        {
+            jointIndices[skin.joints[order[joint]]] = joint;
+        }
+
+        Skeleton skeleton;
+        skeleton.InverseBindMatrices.resize(order.size(), Matrix::Identity);
+        for (uint32_t joint = 0; joint < order.size(); ++joint)
+        {
+            const cgltf_node* node = skin.joints[order[joint]];
+
+            int32_t parent = Skeleton::NoParent;
+            for (const cgltf_node* ancestor = node->parent; ancestor != nullptr; ancestor = ancestor->parent)
+            {
+                if (const auto found = jointIndices.find(ancestor); found != jointIndices.end())
+                {
+                    parent = static_cast<int32_t>(found->second);
+                    break;
+                }
+            }
+
+            skeleton.JointNames.emplace_back(node->name != nullptr ? node->name : "");
+            skeleton.Parents.push_back(parent);
+            skeleton.BindPose.push_back(LocalPose(*node));
+
+            if (skin.inverse_bind_matrices != nullptr)
+            {
+                float values[16];
+                cgltf_accessor_read_float(skin.inverse_bind_matrices, order[joint], values, 16);
+                skeleton.InverseBindMatrices[joint] = Matrix(values);
+            }
+        }
+
+        return skeleton;
+    }
+
+    template <typename T>
+    void ReadKeyframes(const cgltf_animation_sampler& sampler, Keyframes<T>& keys)
+    {
+        constexpr cgltf_size ComponentCount = sizeof(T) / sizeof(float);
+
+        const cgltf_size count = sampler.input->count;
+        keys.Times.resize(count);
+        keys.Values.resize(count);
+        keys.Mode =
+            sampler.interpolation == cgltf_interpolation_type_step ? Interpolation::Step : Interpolation::Linear;
+
+        // Cubic spline outputs hold an in-tangent, value and out-tangent per key.
+        const bool cubic = sampler.interpolation == cgltf_interpolation_type_cubic_spline;
+        for (cgltf_size key = 0; key < count; ++key)
+        {
+            float values[4] = {};
+            cgltf_accessor_read_float(sampler.input, key, &keys.Times[key], 1);
+            cgltf_accessor_read_float(sampler.output, cubic ? key * 3 + 1 : key, values, ComponentCount);
+            keys.Values[key] = T(values);
+        }
+    }
+
+    void ReadRotationKeyframes(const cgltf_animation_sampler& sampler, Keyframes<Quaternion>& keys)
+    {
+        ReadKeyframes(sampler, keys);
+
+        // Keep neighbouring keys in the same hemisphere so interpolation takes the short way.
+        for (size_t key = 0; key < keys.Values.size(); ++key)
+        {
+            keys.Values[key].Normalize();
+            if (key > 0 && keys.Values[key].Dot(keys.Values[key - 1]) < 0.0f)
+            {
+                keys.Values[key] = -keys.Values[key];
+            }
+        }
+    }
+
+    const cgltf_accessor* FindAttribute(const cgltf_attribute*     attributes,
+                                        const cgltf_size           count,
+                                        const cgltf_attribute_type type)
+    {
+        for (cgltf_size i = 0; i < count; ++i)
+        {
+            if (attributes[i].type == type && attributes[i].index == 0)
+            {
+                return attributes[i].data;
+            }
+        }
+        return nullptr;
+    }
+
+    const cgltf_accessor* FindAttribute(const cgltf_primitive& primitive, const cgltf_attribute_type type)
+    {
+        return FindAttribute(primitive.attributes, primitive.attributes_count, type);
+    }
+
+    /// Reads the x, y and z components of a vector attribute into three planes. Sparse accessors are
+    /// expanded, which is how exporters usually store morph target deltas.
+    std::vector<float> ReadPlanarVectors(const cgltf_accessor* accessor)
+    {
+        if (accessor == nullptr)
+        {
+            return {};
+        }
+
+        const cgltf_size   count = accessor->count;
+        const cgltf_size   componentCount = cgltf_num_components(accessor->type);
+        std::vector<float> values(count * componentCount);
+        cgltf_accessor_unpack_floats(accessor, values.data(), values.size());
+
+        std::vector<float> planes(count * 3);
+        for (cgltf_size vertex = 0; vertex < count; ++vertex)
+        {
+            for (cgltf_size component = 0; component < 3; ++component)
+            {
+                planes[component * count + vertex] = values[vertex * componentCount + component];
+            }
+        }
+        return planes;
+    }
+
+    ConstVector3Stream Planes(const std::vector<float>& planes, const size_t count)
+    {
+        if (planes.empty())
+        {
+            return {};
+        }
+        return {planes.data(), planes.data() + count, planes.data() + count * 2};
+    }
+
+    std::vector<uint32_t> ReadIndices(const cgltf_primitive& primitive, const cgltf_size vertexCount)
+    {
+        std::vector<uint32_t> indices;
+        if (primitive.indices == nullptr)
+        {
+            indices.resize(vertexCount);
+            std::iota(indices.begin(), indices.end(), 0);
+            return indices;
+        }
+
+        indices.resize(primitive.indices->count);
+        for (cgltf_size i = 0; i < indices.size(); ++i)
+        {
+            indices[i] = static_cast<uint32_t>(cgltf_accessor_read_index(primitive.indices, i));
+        }
+        return indices;
+    }
+
+    /// Loads the first primitive of the first mesh bound to the skin. Only JOINTS_0 and WEIGHTS_0 are read.
+    SkinnedMesh LoadSkinnedMesh(const cgltf_data& data, const cgltf_skin& skin, const JointIndices& jointIndices)
+    {
+        SkinnedMesh mesh;
+        const auto  node = std::find_if(data.nodes, data.nodes + data.nodes_count, [&](const cgltf_node& candidate) {
+            return candidate.skin == &skin && candidate.mesh != nullptr && candidate.mesh->primitives_count > 0;
+        });
+        if (node == data.nodes + data.nodes_count)
+        {
+            return mesh;
+        }
+
+        const cgltf_primitive& primitive = node->mesh->primitives[0];
+        const cgltf_accessor*  positions = FindAttribute(primitive, cgltf_attribute_type_position);
+        const cgltf_accessor*  joints = FindAttribute(primitive, cgltf_attribute_type_joints);
+        const cgltf_accessor*  weights = FindAttribute(primitive, cgltf_attribute_type_weights);
+        if (primitive.type != cgltf_primitive_type_triangles || positions == nullptr || joints == nullptr ||
+            weights == nullptr)
+        {
+            return mesh;
+        }
+
+        mesh.Positions = ReadPlanarVectors(positions);
+        mesh.Normals = ReadPlanarVectors(FindAttribute(primitive, cgltf_attribute_type_normal));
+        mesh.Tangents = ReadPlanarVectors(FindAttribute(primitive, cgltf_attribute_type_tangent));
+
+        const cgltf_size count = positions->count;
+        mesh.Joints.resize(count * 4);
+        mesh.Weights.resize(count * 4);
+        for (cgltf_size vertex = 0; vertex < count; ++vertex)
+        {
+            cgltf_uint skinJoints[4] = {};
+            float      vertexWeights[4] = {};
+            cgltf_accessor_read_uint(joints, vertex, skinJoints, 4);
+            cgltf_accessor_read_float(weights, vertex, vertexWeights, 4);
+
+            // Weights are renormalized since exporters often store them with 8 or 16 bit precision.
+            const float total = vertexWeights[0] + vertexWeights[1] + vertexWeights[2] + vertexWeights[3];
+            for (cgltf_size i = 0; i < 4; ++i)
+            {
+                const cgltf_size joint = std::min<cgltf_size>(skinJoints[i], skin.joints_count - 1);
+                mesh.Joints[i * count + vertex] = static_cast<uint16_t>(jointIndices.at(skin.joints[joint]));
+                mesh.Weights[i * count + vertex] = total > 0.0f ? vertexWeights[i] / total : (i == 0 ? 1.0f : 0.0f);
+            }
+        }
+
+        mesh.Indices = ReadIndices(primitive, count);
+        return mesh;
+    }
+
+    MorphTargetSet LoadMorphTargets(const cgltf_node& node, const cgltf_primitive& primitive, const size_t vertexCount)
+    {
+        const cgltf_mesh& mesh = *node.mesh;
+
+        MorphTargetSet set;
+        set.VertexCount = vertexCount;
+        for (cgltf_size i = 0; i < primitive.targets_count; ++i)
+        {
+            const cgltf_morph_target& target = primitive.targets[i];
+            const std::vector<float>  positions = ReadPlanarVectors(
+                FindAttribute(target.attributes, target.attributes_count, cgltf_attribute_type_position));
+            const std::vector<float>  normals = ReadPlanarVectors(
+                FindAttribute(target.attributes, target.attributes_count, cgltf_attribute_type_normal));
+
+            std::string name = i < mesh.target_names_count ? mesh.target_names[i] : "";
+            set.Targets.push_back(MakeSparseMorphTarget(std::move(name), vertexCount, Planes(positions, vertexCount),
+                                                        Planes(normals, vertexCount)));
+        }
+
+        // Node weights override the mesh defaults.
+        const float*     weights = node.weights_count > 0 ? node.weights : mesh.weights;
+        const cgltf_size weightCount = node.weights_count > 0 ? node.weights_count : mesh.weights_count;
+        set.DefaultWeights.assign(primitive.targets_count, 0.0f);
+        std::copy_n(weights, std::min<cgltf_size>(weightCount, primitive.targets_count), set.DefaultWeights.begin());
+        return set;
+    }
+
+    MorphWeightTrack LoadWeightTrack(const cgltf_animation&         animation,
+                                     const cgltf_animation_sampler& sampler,
+                                     const uint32_t                 targetCount)
+    {
+        MorphWeightTrack track;
+        track.Name = animation.name != nullptr ? animation.name : "";
+        track.TargetCount = targetCount;
+        track.Mode =
+            sampler.interpolation == cgltf_interpolation_type_step ? Interpolation::Step : Interpolation::Linear;
+
+        const cgltf_size count = sampler.input->count;
+        track.Times.resize(count);
+        track.Values.resize(count * targetCount);
+
+        // As for joint channels, cubic splines keep only their key values.
+        const bool cubic = sampler.interpolation == cgltf_interpolation_type_cubic_spline;
+        for (cgltf_size key = 0; key < count; ++key)
+        {
+            cgltf_accessor_read_float(sampler.input, key, &track.Times[key], 1);
+
+            const cgltf_size first = (cubic ? key * 3 + 1 : key) * targetCount;
+            for (uint32_t target = 0; target < targetCount; ++target)
+            {
+                cgltf_accessor_read_float(sampler.output, first + target, &track.Values[key * targetCount + target], 1);
+            }
+        }
+
+        track.Duration = count > 0 ? track.Times.back() : 0.0f;
+        return track;
+    }
+
+    /// Morph target weight channels are not part of the skeleton.
+    bool IsTransformPath(const cgltf_animation_path_type path)
+    {
+        return path == cgltf_animation_path_type_translation || path == cgltf_animation_path_type_rotation ||
+               path == cgltf_animation_path_type_scale;
+    }
+
+    AnimationClip LoadClip(const cgltf_animation& animation, const JointIndices& jointIndices)
+    {
+        AnimationClip clip;
+        clip.Name = animation.name != nullptr ? animation.name : "";
+
+        std::unordered_map<uint32_t, size_t> trackIndices;
+        for (cgltf_size i = 0; i < animation.channels_count; ++i)
+        {
+            const cgltf_animation_channel& channel = animation.channels[i];
+            const auto                     joint = jointIndices.find(channel.target_node);
+            if (joint == jointIndices.end() || channel.sampler == nullptr || !IsTransformPath(channel.target_path))
+            {
+                continue;
+            }
+
+            const auto [track, inserted] = trackIndices.try_emplace(joint->second, clip.Tracks.size());
+            if (inserted)
+            {
+                clip.Tracks.emplace_back().Joint = joint->second;
+            }
+
+            JointTrack& target = clip.Tracks[track->second];
+            switch (channel.target_path)
+            {
+            case cgltf_animation_path_type_translation:
+                ReadKeyframes(*channel.sampler, target.Translation);
+                break;
+            case cgltf_animation_path_type_rotation:
+                ReadRotationKeyframes(*channel.sampler, target.Rotation);
+                break;
+            default:
+                ReadKeyframes(*channel.sampler, target.Scale);
+                break;
+            }
+
+            if (channel.sampler->input->count > 0)
+            {
+                float last = 0.0f;
+                cgltf_accessor_read_float(channel.sampler->input, channel.sampler->input->count - 1, &last, 1);
+                clip.Duration = std::max(clip.Duration, last);
+            }
+        }
+
+        // Sampling in joint order keeps pose writes sequential.
+        std::sort(clip.Tracks.begin(), clip.Tracks.end(),
+                  [](const JointTrack& a, const JointTrack& b) { return a.Joint < b.Joint; });
+        return clip;
+    }
+} // namespace
+
+SkinnedAnimationSet LoadGltfAnimations(const char* fileName)
+{
+    const std::string path = PathForResource(fileName);
+    const GltfData    data = Parse(path);
+    if (data->skins_count == 0)
+    {
+        throw std::runtime_error(fmt::format("glTF file {} has no skin", path));
+    }
+
+    SkinnedAnimationSet set;
+    JointIndices        jointIndices;
+    set.Rig = LoadSkeleton(data->skins[0], jointIndices);
+    set.Mesh = LoadSkinnedMesh(*data, data->skins[0], jointIndices);
+    for (cgltf_size i = 0; i < data->animations_count; ++i)
+    {
+        set.Clips.push_back(LoadClip(data->animations[i], jointIndices));
+    }
+    return set;
+}
+
+MorphAnimationSet LoadGltfMorphTargets(const char* fileName)
+{
+    const std::string path = PathForResource(fileName);
+    const GltfData    data = Parse(path);
+
+    const cgltf_node* nodes = data->nodes;
+    const cgltf_node* nodesEnd = nodes + data->nodes_count;
+    const auto        node = std::find_if(nodes, nodesEnd, [](const cgltf_node& candidate) {
+        return candidate.mesh != nullptr && candidate.mesh->primitives_count > 0 &&
+               candidate.mesh->primitives[0].targets_count > 0;
+    });
+    if (node == nodesEnd)
+    {
+        throw std::runtime_error(fmt::format("glTF file {} has no morph targets", path));
+    }
+
+    const cgltf_primitive& primitive = node->mesh->primitives[0];
+    const cgltf_accessor*  positions = FindAttribute(primitive, cgltf_attribute_type_position);
+    if (positions == nullptr)
+    {
+        throw std::runtime_error(fmt::format("Morph target mesh in glTF file {} has no positions", path));
+    }
+
+    MorphAnimationSet set;
+    set.Positions = ReadPlanarVectors(positions);
+    set.Normals = ReadPlanarVectors(FindAttribute(primitive, cgltf_attribute_type_normal));
+    set.Indices = ReadIndices(primitive, positions->count);
+    set.Targets = LoadMorphTargets(*node, primitive, positions->count);
+
+    const auto targetCount = static_cast<uint32_t>(primitive.targets_count);
+    for (cgltf_size i = 0; i < data->animations_count; ++i)
+    {
+        const cgltf_animation& animation = data->animations[i];
+        for (cgltf_size c = 0; c < animation.channels_count; ++c)
+        {
+            const cgltf_animation_channel& channel = animation.channels[c];
+            if (channel.target_node == node && channel.target_path == cgltf_animation_path_type_weights &&
+                channel.sampler != nullptr)
+            {
+                set.Tracks.push_back(LoadWeightTrack(animation, *channel.sampler, targetCount));
+                break;
+            }
+        }
+    }
+    return set;
+}
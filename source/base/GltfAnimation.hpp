@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+
+#include "Animation.hpp"
+#include "MorphTargets.hpp"
+#include "Skinning.hpp"
+
+/// Skeleton of the first skin in a glTF file, every animation targeting its joints and
+/// the first mesh primitive bound to it.
+struct SkinnedAnimationSet
+{
+    Skeleton                   Rig;
+    std::vector<AnimationClip> Clips;
+    SkinnedMesh                Mesh; ///< Empty when no triangle primitive with joints and weights uses the skin.
+};
+
+/// @brief Loads the skeleton, animation clips and skinned mesh of a .gltf or .glb file.
+///
+/// Cubic spline channels keep only their key values and are sampled linearly.
+/// Throws std::runtime_error if the file cannot be loaded or has no skin.
+/// @param [in] fileName Path relative to the executable, as for File.
+[[nodiscard]] SkinnedAnimationSet LoadGltfAnimations(const char* fileName);
+
+/// First mesh primitive with morph targets in a glTF file and the animations of its weights.
+struct MorphAnimationSet
+{
+    std::vector<float>            Positions; ///< Base positions as x, y and z planes.
+    std::vector<float>            Normals;   ///< Base normals as planes, empty when the mesh has none.
+    std::vector<uint32_t>         Indices;
+    MorphTargetSet                Targets;
+    std::vector<MorphWeightTrack> Tracks; ///< One per animation that drives the weights.
+};
+
+/// @brief Loads the morph targets and weight animations of a .gltf or .glb file.
+///
+/// Sparse and dense delta accessors are both stored sparsely, skipping vertices a
+/// target does not move. Throws std::runtime_error if the file cannot be loaded or
+/// has no morph targets.
+/// @param [in] fileName Path relative to the executable, as for File.
+[[nodiscard]] MorphAnimationSet LoadGltfMorphTargets(const char* fileName);
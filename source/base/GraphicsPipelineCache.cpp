@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "GraphicsPipelineCache.hpp"
+
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // {5A1F3C62-8E4B-4D2A-9C1E-7B3D2F6A8E91}
+    constexpr GUID RootSignatureKeyGuid = {
+        0x5a1f3c62, 0x8e4b, 0x4d2a, {0x9c, 0x1e, 0x7b, 0x3d, 0x2f, 0x6a, 0x8e, 0x91}};
+
+    using PipelineDesc = D3D12_GRAPHICS_PIPELINE_STATE_DESC;
+
+    constexpr D3D12_SHADER_BYTECODE PipelineDesc::* ShaderStages[] = {
+        &PipelineDesc::VS, &PipelineDesc::PS, &PipelineDesc::DS, &PipelineDesc::HS, &PipelineDesc::GS};
+
+    std::span<const std::byte> Bytecode(const D3D12_SHADER_BYTECODE& shader)
+    {
+        return {static_cast<const std::byte*>(shader.pShaderBytecode), shader.BytecodeLength};
+    }
+
+    PipelineDescription::StencilOp Describe(const D3D12_DEPTH_STENCILOP_DESC& op)
+    {
+        return {static_cast<uint32_t>(op.StencilFailOp), static_cast<uint32_t>(op.StencilDepthFailOp),
+                static_cast<uint32_t>(op.StencilPassOp), static_cast<uint32_t>(op.StencilFunc)};
+    }
+
+    /// Description with copies of everything it points to, for compiling after the caller returned.
+    struct OwnedDescription
+    {
+        PipelineDesc                            Description = {};
+        winrt::com_ptr<ID3D12RootSignature>     RootSignature;
+        std::vector<std::byte>                  Shaders[std::size(ShaderStages)];
+        std::vector<D3D12_INPUT_ELEMENT_DESC>   InputElements;
+        std::vector<D3D12_SO_DECLARATION_ENTRY> StreamOutputEntries;
+        std::vector<UINT>                       StreamOutputStrides;
+        std::deque<std::string>                 SemanticNames; ///< A deque, so the names never move.
+
+        explicit OwnedDescription(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) : Description(desc)
+        {
+            RootSignature.copy_from(desc.pRootSignature);
+            for (size_t i = 0; i < std::size(ShaderStages); ++i)
+            {
+                const std::span<const std::byte> bytecode = Bytecode(desc.*ShaderStages[i]);
+                Shaders[i].assign(bytecode.begin(), bytecode.end());
+                Description.*ShaderStages[i] = {Shaders[i].data(), Shaders[i].size()};
+            }
+
+            InputElements.assign(desc.InputLayout.pInputElementDescs,
+                                 desc.InputLayout.pInputElementDescs + desc.InputLayout.NumElements);
+            for (D3D12_INPUT_ELEMENT_DESC& element : InputElements)
+            {
+                element.SemanticName = SemanticNames.emplace_back(element.SemanticName).c_str();
+            }
+            Description.InputLayout = {InputElements.data(), static_cast<UINT>(InputElements.size())};
+
+            const D3D12_STREAM_OUTPUT_DESC&                     streamOutput = desc.StreamOutput;
+            StreamOutputEntries.assign(streamOutput.pSODeclaration,
+                                       streamOutput.pSODeclaration + streamOutput.NumEntries);
+            for (D3D12_SO_DECLARATION_ENTRY& entry : StreamOutputEntries)
+            {
+                if (entry.SemanticName != nullptr)
+                {
+                    entry.SemanticName = SemanticNames.emplace_back(entry.SemanticName).c_str();
+                }
+            }
+            StreamOutputStrides.assign(streamOutput.pBufferStrides,
+                                       streamOutput.pBufferStrides + streamOutput.NumStrides);
+            Description.StreamOutput.pSODeclaration = StreamOutputEntries.data();
+            Description.StreamOutput.pBufferStrides = StreamOutputStrides.data();
+
+            // The library replaces cached blobs, and a caller's blob would not outlive the call.
+            Description.CachedPSO = {};
+        }
+    };
+} // namespace
+
+GraphicsPipelineCache::GraphicsPipelineCache(ID3D12Device*         device,
+                                             std::filesystem::path path,
+                                             const int32_t         workerCount)
+    : m_path(std::move(path)),
+      m_cache([](void* pipeline) { static_cast<ID3D12PipelineState*>(pipeline)->Release(); }, workerCount)
+{
+    winrt::check_hresult(device->QueryInterface(IID_PPV_ARGS(&m_device)));
+
+    // The device rejects a library from another driver or adapter, so start over with an empty one.
+    m_libraryBlob = PipelineLibraryFile::Read(m_path);
+    if (m_libraryBlob.empty() || FAILED(m_device->CreatePipelineLibrary(m_libraryBlob.data(), m_libraryBlob.size(),
+                                                                        IID_PPV_ARGS(&m_library))))
+    {
+        m_libraryBlob.clear();
+        if (FAILED(m_device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_library))))
+        {
+            m_library = nullptr;
+        }
+    }
+}
+
+GraphicsPipelineCache::~GraphicsPipelineCache() = default;
+
+winrt::com_ptr<ID3D12RootSignature> GraphicsPipelineCache::CreateRootSignature(ID3D12Device* device,
+                                                                               const void*   blob,
+                                                                               const size_t  size)
+{
+    winrt::com_ptr<ID3D12RootSignature> rootSignature;
+    winrt::check_hresult(device->CreateRootSignature(0, blob, size, IID_PPV_ARGS(&rootSignature)));
+
+    const PipelineKey key = PipelineHasher().Add(std::span(static_cast<const std::byte*>(blob), size)).Key();
+    winrt::check_hresult(rootSignature->SetPrivateData(RootSignatureKeyGuid, sizeof(key), &key));
+    return rootSignature;
+}
+
+PipelineKey GraphicsPipelineCache::Key(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    PipelineDescription description;
+
+    if (desc.pRootSignature != nullptr)
+    {
+        UINT size = sizeof(description.RootSignature);
+        if (FAILED(desc.pRootSignature->GetPrivateData(RootSignatureKeyGuid, &size, &description.RootSignature)))
+        {
+            throw std::invalid_argument("Root signature was not made by GraphicsPipelineCache::CreateRootSignature");
+        }
+    }
+
+    for (size_t i = 0; i < std::size(ShaderStages); ++i)
+    {
+        description.Shaders[i] = Bytecode(desc.*ShaderStages[i]);
+    }
+
+    const D3D12_STREAM_OUTPUT_DESC&                     streamOutput = desc.StreamOutput;
+    std::vector<PipelineDescription::StreamOutputEntry> streamOutputEntries(streamOutput.NumEntries);
+    for (UINT i = 0; i < streamOutput.NumEntries; ++i)
+    {
+        const D3D12_SO_DECLARATION_ENTRY& entry = streamOutput.pSODeclaration[i];
+        streamOutputEntries[i] = {entry.Stream,         entry.SemanticName,   entry.SemanticIndex,
+                                  entry.StartComponent, entry.ComponentCount, entry.OutputSlot};
+    }
+    description.StreamOutput = streamOutputEntries;
+    description.StreamOutputStrides = {streamOutput.pBufferStrides, streamOutput.NumStrides};
+    description.RasterizedStream = streamOutput.RasterizedStream;
+
+    const D3D12_BLEND_DESC& blend = desc.BlendState;
+    description.AlphaToCoverageEnable = blend.AlphaToCoverageEnable;
+    description.IndependentBlendEnable = blend.IndependentBlendEnable;
+    for (size_t i = 0; i < std::size(blend.RenderTarget); ++i)
+    {
+        const D3D12_RENDER_TARGET_BLEND_DESC& target = blend.RenderTarget[i];
+        PipelineDescription::TargetBlend&     described = description.Blend[i];
+        described.BlendEnable = target.BlendEnable;
+        described.LogicOpEnable = target.LogicOpEnable;
+        described.SrcBlend = target.SrcBlend;
+        described.DestBlend = target.DestBlend;
+        described.BlendOp = target.BlendOp;
+        described.SrcBlendAlpha = target.SrcBlendAlpha;
+        described.DestBlendAlpha = target.DestBlendAlpha;
+        described.BlendOpAlpha = target.BlendOpAlpha;
+        described.LogicOp = target.LogicOp;
+        described.RenderTargetWriteMask = target.RenderTargetWriteMask;
+    }
+    description.SampleMask = desc.SampleMask;
+
+    const D3D12_RASTERIZER_DESC& raster = desc.RasterizerState;
+    description.FillMode = raster.FillMode;
+    description.CullMode = raster.CullMode;
+    description.FrontCounterClockwise = raster.FrontCounterClockwise;
+    description.DepthBias = raster.DepthBias;
+    description.DepthBiasClamp = raster.DepthBiasClamp;
+    description.SlopeScaledDepthBias = raster.SlopeScaledDepthBias;
+    description.DepthClipEnable = raster.DepthClipEnable;
+    description.MultisampleEnable = raster.MultisampleEnable;
+    description.AntialiasedLineEnable = raster.AntialiasedLineEnable;
+    description.ForcedSampleCount = raster.ForcedSampleCount;
+    description.ConservativeRaster = raster.ConservativeRaster;
+
+    const D3D12_DEPTH_STENCIL_DESC& depthStencil = desc.DepthStencilState;
+    description.DepthEnable = depthStencil.DepthEnable;
+    description.DepthWriteMask = depthStencil.DepthWriteMask;
+    description.DepthFunc = depthStencil.DepthFunc;
+    description.StencilEnable = depthStencil.StencilEnable;
+    description.StencilReadMask = depthStencil.StencilReadMask;
+    description.StencilWriteMask = depthStencil.StencilWriteMask;
+    description.FrontFace = Describe(depthStencil.FrontFace);
+    description.BackFace = Describe(depthStencil.BackFace);
+
+    std::vector<PipelineDescription::InputElement> inputLayout(desc.InputLayout.NumElements);
+    for (UINT i = 0; i < desc.InputLayout.NumElements; ++i)
+    {
+        const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+        inputLayout[i] = {element.SemanticName,
+                          element.SemanticIndex,
+                          static_cast<uint32_t>(element.Format),
+                          element.InputSlot,
+                          element.AlignedByteOffset,
+                          static_cast<uint32_t>(element.InputSlotClass),
+                          element.InstanceDataStepRate};
+    }
+    description.InputLayout = inputLayout;
+
+    description.IBStripCutValue = desc.IBStripCutValue;
+    description.PrimitiveTopologyType = desc.PrimitiveTopologyType;
+    description.NumRenderTargets = desc.NumRenderTargets;
+    for (size_t i = 0; i < std::size(desc.RTVFormats); ++i)
+    {
+        description.RTVFormats[i] = desc.RTVFormats[i];
+    }
+    description.DSVFormat = desc.DSVFormat;
+    description.SampleCount = desc.SampleDesc.Count;
+    description.SampleQuality = desc.SampleDesc.Quality;
+    description.NodeMask = desc.NodeMask;
+    description.Flags = desc.Flags;
+    return description.Key();
+}
+
+PipelineKey GraphicsPipelineCache::Request(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    const PipelineKey key = Key(desc);
+    if (!m_cache.Contains(key))
+    {
+        auto owned = std::make_shared<OwnedDescription>(desc);
+        m_cache.Request(key, [this, key, owned] { return static_cast<void*>(Create(key, owned->Description)); });
+    }
+    return key;
+}
+
+ID3D12PipelineState* GraphicsPipelineCache::Get(const PipelineKey& key, ID3D12PipelineState* fallback)
+{
+    return static_cast<ID3D12PipelineState*>(m_cache.Get(key, fallback));
+}
+
+ID3D12PipelineState* GraphicsPipelineCache::Wait(const PipelineKey& key)
+{
+    return static_cast<ID3D12PipelineState*>(m_cache.Wait(key));
+}
+
+void GraphicsPipelineCache::Save()
+{
+    // Serialize() must not race StorePipeline() on the workers.
+    m_cache.WaitForIdle();
+    if (m_library == nullptr || !m_libraryChanged.exchange(false))
+    {
+        return;
+    }
+
+    std::vector<std::byte> blob(m_library->GetSerializedSize());
+    winrt::check_hresult(m_library->Serialize(blob.data(), blob.size()));
+    PipelineLibraryFile::Write(m_path, blob);
+}
+
+PipelineCache::Statistics GraphicsPipelineCache::Stats() const
+{
+    return m_cache.Stats();
+}
+
+uint32_t GraphicsPipelineCache::LibraryHits() const
+{
+    return m_libraryHits.load(std::memory_order_relaxed);
+}
+
+ID3D12PipelineState* GraphicsPipelineCache::Create(const PipelineKey&                        key,
+                                                   const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    // The library synchronizes itself; only loading one name from several threads needs a lock,
+    // and the cache creates each key once.
+    const std::string  hex = key.ToString();
+    const std::wstring name(hex.begin(), hex.end());
+
+    winrt::com_ptr<ID3D12PipelineState> pipeline;
+    if (m_library != nullptr &&
+        SUCCEEDED(m_library->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&pipeline))))
+    {
+        m_libraryHits.fetch_add(1, std::memory_order_relaxed);
+        return pipeline.detach();
+    }
+
+    winrt::check_hresult(m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipeline)));
+    if (m_library != nullptr && SUCCEEDED(m_library->StorePipeline(name.c_str(), pipeline.get())))
+    {
+        m_libraryChanged.store(true, std::memory_order_relaxed);
+    }
+    return pipeline.detach();
+}
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <directx/d3d12.h>
+#include <winrt/base.h>
+
+#include "PipelineCache.hpp"
+
+/// @brief Graphics pipeline state objects keyed by their whole description, compiled on
+/// worker threads and kept across runs in an ID3D12PipelineLibrary on disk.
+///
+/// The key covers the root signature, the bytecode of every shader stage, the input layout,
+/// stream output, rasterizer, blend and depth stencil state, and the target formats, so it
+/// also names the pipeline in the library. Root signatures must come from
+/// CreateRootSignature(), which tags them with the hash of their blob. A library written by
+/// another driver or adapter is rejected by the device and replaced.
+class GraphicsPipelineCache final
+{
+public:
+    /// @param [in] path File the library is loaded from and saved to.
+    /// @param [in] workerCount Compile threads, as for PipelineCache.
+    GraphicsPipelineCache(ID3D12Device* device, std::filesystem::path path, int32_t workerCount = -1);
+
+    GraphicsPipelineCache(const GraphicsPipelineCache&) = delete;
+    GraphicsPipelineCache& operator=(const GraphicsPipelineCache&) = delete;
+
+    ~GraphicsPipelineCache();
+
+    /// @brief Creates a root signature from its serialized blob, tagged so pipelines using it can be keyed.
+    [[nodiscard]] static winrt::com_ptr<ID3D12RootSignature> CreateRootSignature(ID3D12Device* device,
+                                                                                 const void*   blob,
+                                                                                 size_t        size);
+
+    /// @brief Gets the key of a pipeline without requesting it.
+    /// @throws std::invalid_argument if the root signature was not made by CreateRootSignature().
+    [[nodiscard]] static PipelineKey Key(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+    /// @brief Queues the compilation of the pipeline unless its key is known.
+    ///
+    /// Everything the description points to is copied, so it only has to live for the call.
+    PipelineKey Request(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+    /// @brief Gets the pipeline once it is compiled, and the fallback until then.
+    [[nodiscard]] ID3D12PipelineState* Get(const PipelineKey& key, ID3D12PipelineState* fallback = nullptr);
+
+    /// @brief Blocks until the pipeline is compiled.
+    /// @throws winrt::hresult_error if compilation failed.
+    ID3D12PipelineState* Wait(const PipelineKey& key);
+
+    /// @brief Waits for pending compiles and writes the library to disk if it gained pipelines.
+    /// @throws std::runtime_error if the file cannot be written.
+    void Save();
+
+    [[nodiscard]] PipelineCache::Statistics Stats() const;
+
+    /// @brief Gets the number of pipelines loaded from the library instead of compiled.
+    [[nodiscard]] uint32_t LibraryHits() const;
+
+private:
+    ID3D12PipelineState* Create(const PipelineKey& key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+    std::filesystem::path                 m_path;
+    winrt::com_ptr<ID3D12Device1>         m_device;
+    std::vector<std::byte>                m_libraryBlob; ///< Backs m_library, which reads from it in place.
+    winrt::com_ptr<ID3D12PipelineLibrary> m_library;     ///< Null where the driver has no pipeline libraries.
+    std::atomic<uint32_t>                 m_libraryHits = 0;
+    std::atomic<bool>                     m_libraryChanged = false;
+    PipelineCache                         m_cache; ///< Last, so its workers stop before the library goes.
+};
@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "LightClusters.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ThreadPool.hpp"
+
+namespace
+{
+    constexpr size_t LightsPerChunk = 64;
+
+    /// Smallest sphere enclosing a spot light cone.
+    void SpotBoundingSphere(const SpotLight& light, Vector3& center, float& radius)
+    {
+        const float cosAngle = std::cos(light.HalfAngle);
+        if (light.HalfAngle > XM_PIDIV4)
+        {
+            center = light.Position + light.Direction * (cosAngle * light.Range);
+            radius = std::sin(light.HalfAngle) * light.Range;
+        }
+        else
+        {
+            radius = light.Range / (2.0f * cosAngle);
+            center = light.Position + light.Direction * radius;
+        }
+    }
+
+    uint32_t ToTile(const float ndc, const uint32_t tileCount)
+    {
+        const float tile = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tileCount));
+        return static_cast<uint32_t>(std::clamp(tile, 0.0f, static_cast<float>(tileCount - 1)));
+    }
+} // namespace
+
+LightClusters::LightClusters(const Settings& settings) : m_settings(settings)
+{
+    m_clusters.resize(ClusterCount(), ClusterRange{0, 0});
+}
+
+uint32_t LightClusters::ClusterCount() const
+{
+    return m_settings.TilesX * m_settings.TilesY * m_settings.Slices;
+}
+
+uint32_t LightClusters::ClusterIndex(const uint32_t tileX, const uint32_t tileY, const uint32_t slice) const
+{
+    return (slice * m_settings.TilesY + tileY) * m_settings.TilesX + tileX;
+}
+
+uint32_t LightClusters::SliceForDepth(const float viewDepth) const
+{
+    const float slices = static_cast<float>(m_settings.Slices);
+    const float slice = std::floor(std::log(std::max(viewDepth, m_near) / m_near) / m_logDepthRatio * slices);
+    return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(m_settings.Slices - 1)));
+}
+
+float LightClusters::SliceDepth(const uint32_t slice) const
+{
+    return m_near * std::pow(m_far / m_near, static_cast<float>(slice) / static_cast<float>(m_settings.Slices));
+}
+
+LightClusters::ShaderParameters LightClusters::Parameters() const
+{
+    const float sliceScale = static_cast<float>(m_settings.Slices) / m_logDepthRatio;
+    return {m_settings.TilesX, m_settings.TilesY, m_settings.Slices, sliceScale, -sliceScale * std::log(m_near)};
+}
+
+std::span<const uint32_t> LightClusters::LightIndices() const
+{
+    return m_lightIndices;
+}
+
+std::span<const LightClusters::ClusterRange> LightClusters::Clusters() const
+{
+    return m_clusters;
+}
+
+void LightClusters::Build(const Camera&                     camera,
+                          const std::span<const PointLight> pointLights,
+                          const std::span<const SpotLight>  spotLights,
+                          ThreadPool&                       pool)
+{
+    m_near = camera.nearPlane();
+    m_far = camera.farPlane();
+    m_logDepthRatio = std::log(m_far / m_near);
+
+    const float tanHalfFov = std::tan(0.5f * camera.fieldOfView());
+    Frustum     frustum;
+    frustum.View = camera.view();
+    frustum.ProjectionX = 1.0f / (camera.aspectRatio() * tanHalfFov);
+    frustum.ProjectionY = 1.0f / tanHalfFov;
+    frustum.Near = m_near;
+    frustum.Far = m_far;
+
+    // Each chunk of lights records (cluster, light) pairs into its own list, so merging in
+    // chunk order keeps every cluster's lights sorted regardless of thread scheduling.
+    const size_t lightCount = pointLights.size() + spotLights.size();
+    m_chunkPairs.resize((lightCount + LightsPerChunk - 1) / LightsPerChunk);
+    for (auto& pairs : m_chunkPairs)
+    {
+        pairs.clear();
+    }
+
+    pool.ParallelFor(lightCount, LightsPerChunk, [&](const size_t begin, const size_t end, uint32_t) {
+        auto& pairs = m_chunkPairs[begin / LightsPerChunk];
+        for (size_t light = begin; light < end; ++light)
+        {
+            if (light < pointLights.size())
+            {
+                const PointLight& point = pointLights[light];
+                BinSphere(frustum, point.Position, point.Radius, static_cast<uint32_t>(light), pairs);
+            }
+            else
+            {
+                Vector3 center;
+                float   radius;
+                SpotBoundingSphere(spotLights[light - pointLights.size()], center, radius);
+                BinSphere(frustum, center, radius, static_cast<uint32_t>(light), pairs);
+            }
+        }
+    });
+
+    m_clusters.assign(ClusterCount(), ClusterRange{0, 0});
+    for (const auto& pairs : m_chunkPairs)
+    {
+        for (const uint64_t pair : pairs)
+        {
+            ++m_clusters[pair >> 32].Count;
+        }
+    }
+
+    uint32_t offset = 0;
+    for (auto& cluster : m_clusters)
+    {
+        cluster.Offset = offset;
+        offset += cluster.Count;
+        cluster.Count = 0;
+    }
+
+    m_lightIndices.resize(offset);
+    for (const auto& pairs : m_chunkPairs)
+    {
+        for (const uint64_t pair : pairs)
+        {
+            ClusterRange& cluster = m_clusters[pair >> 32];
+            m_lightIndices[cluster.Offset + cluster.Count++] = static_cast<uint32_t>(pair);
+        }
+    }
+}
+
+void LightClusters::BinSphere(const Frustum&         frustum,
+                              const Vector3&         center,
+                              const float            radius,
+                              const uint32_t         lightIndex,
+                              std::vector<uint64_t>& pairs) const
+{
+    Vector3 viewCenter;
+    XMStoreFloat3(&viewCenter, XMVector3Transform(XMLoadFloat3(&center), frustum.View));
+
+    // Camera space is right-handed and looks down -Z.
+    const float depth = -viewCenter.z;
+    const float minDepth = depth - radius;
+    const float maxDepth = depth + radius;
+    if (maxDepth <= frustum.Near || minDepth >= frustum.Far)
+    {
+        return;
+    }
+
+    const uint32_t firstSlice = SliceForDepth(std::max(minDepth, frustum.Near));
+    const uint32_t lastSlice = SliceForDepth(std::min(maxDepth, frustum.Far));
+    for (uint32_t slice = firstSlice; slice <= lastSlice; ++slice)
+    {
+        const float sliceNear = std::max({SliceDepth(slice), minDepth, frustum.Near});
+        const float sliceFar = std::min(SliceDepth(slice + 1), maxDepth);
+        if (sliceNear > sliceFar)
+        {
+            continue;
+        }
+
+        // Widest cross-section of the sphere within this slice's depth range.
+        const float closest = std::clamp(depth, sliceNear, sliceFar);
+        const float offset = closest - depth;
+        const float sectionRadius = std::sqrt(std::max(radius * radius - offset * offset, 0.0f));
+
+        // Project the section's box, dividing each side by whichever slice depth pushes it outward.
+        const float minX = viewCenter.x - sectionRadius;
+        const float maxX = viewCenter.x + sectionRadius;
+        const float minY = viewCenter.y - sectionRadius;
+        const float maxY = viewCenter.y + sectionRadius;
+        const float ndcMinX = frustum.ProjectionX * minX / (minX < 0.0f ? sliceNear : sliceFar);
+        const float ndcMaxX = frustum.ProjectionX * maxX / (maxX > 0.0f ? sliceNear : sliceFar);
+        const float ndcMinY = frustum.ProjectionY * minY / (minY < 0.0f ? sliceNear : sliceFar);
+        const float ndcMaxY = frustum.ProjectionY * maxY / (maxY > 0.0f ? sliceNear : sliceFar);
+        if (ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f)
+        {
+            continue;
+        }
+
+        // Tile rows run top to bottom while NDC y runs bottom to top.
+        const uint32_t tileMinX = ToTile(ndcMinX, m_settings.TilesX);
+        const uint32_t tileMaxX = ToTile(ndcMaxX, m_settings.TilesX);
+        const uint32_t tileMinY = ToTile(-ndcMaxY, m_settings.TilesY);
+        const uint32_t tileMaxY = ToTile(-ndcMinY, m_settings.TilesY);
+        for (uint32_t tileY = tileMinY; tileY <= tileMaxY; ++tileY)
+        {
+            for (uint32_t tileX = tileMinX; tileX <= tileMaxX; ++tileX)
+            {
+                const uint64_t cluster = ClusterIndex(tileX, tileY, slice);
+                pairs.push_back(cluster << 32 | lightIndex);
+            }
+        }
+    }
+}
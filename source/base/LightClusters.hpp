@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Camera.hpp"
+#include "GraphicsMath.hpp"
+
+class ThreadPool;
+
+struct PointLight
+{
+    Vector3 Position;
+    float   Radius;
+};
+
+struct SpotLight
+{
+    Vector3 Position;
+    float   Range;
+    Vector3 Direction;
+    float   HalfAngle; ///< Outer cone half angle in radians.
+};
+
+/// @brief Assigns lights to a froxel grid for clustered forward shading.
+///
+/// The camera frustum is split into TilesX * TilesY screen tiles and Slices depth
+/// slices spaced exponentially between the near and far planes. Build() bins light
+/// bounding spheres into the clusters they touch and produces a compact light
+/// index list plus one (offset, count) pair per cluster, both laid out for direct
+/// upload into structured buffers. Point lights use indices [0, pointCount) and spot
+/// lights follow at [pointCount, pointCount + spotCount).
+class LightClusters final
+{
+public:
+    struct Settings
+    {
+        uint32_t TilesX = 16;
+        uint32_t TilesY = 9;
+        uint32_t Slices = 24;
+    };
+
+    /// Matches a StructuredBuffer<uint2> element.
+    struct ClusterRange
+    {
+        uint32_t Offset;
+        uint32_t Count;
+    };
+
+    /// Constants a shader needs to find its cluster: slice = log(viewDepth) * SliceScale + SliceBias.
+    struct ShaderParameters
+    {
+        uint32_t TilesX;
+        uint32_t TilesY;
+        uint32_t Slices;
+        float    SliceScale;
+        float    SliceBias;
+    };
+
+    explicit LightClusters(const Settings& settings = {});
+
+    [[nodiscard]] uint32_t ClusterCount() const;
+
+    [[nodiscard]] uint32_t ClusterIndex(uint32_t tileX, uint32_t tileY, uint32_t slice) const;
+
+    /// @brief Gets the depth slice containing a positive view-space depth.
+    [[nodiscard]] uint32_t SliceForDepth(float viewDepth) const;
+
+    [[nodiscard]] ShaderParameters Parameters() const;
+
+    [[nodiscard]] std::span<const uint32_t> LightIndices() const;
+
+    [[nodiscard]] std::span<const ClusterRange> Clusters() const;
+
+    /// @brief Rebuilds the cluster light lists for the current camera.
+    void Build(const Camera&               camera,
+               std::span<const PointLight> pointLights,
+               std::span<const SpotLight>  spotLights,
+               ThreadPool&                 pool);
+
+private:
+    struct Frustum
+    {
+        Matrix View;
+        float  ProjectionX;
+        float  ProjectionY;
+        float  Near;
+        float  Far;
+    };
+
+    void BinSphere(const Frustum&         frustum,
+                   const Vector3&         center,
+                   float                  radius,
+                   uint32_t               lightIndex,
+                   std::vector<uint64_t>& pairs) const;
+
+    [[nodiscard]] float SliceDepth(uint32_t slice) const;
+
+    Settings                           m_settings;
+    float                              m_near = 0.1f;
+    float                              m_far = 1000.0f;
+    float                              m_logDepthRatio = 1.0f;
+    std::vector<uint32_t>              m_lightIndices;
+    std::vector<ClusterRange>          m_clusters;
+    std::vector<std::vector<uint64_t>> m_chunkPairs;
+};
@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "LodSelector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // Closest distance used when the camera is inside an object's bounding sphere.
+    constexpr float MinProjectionDistance = 1e-3f;
+
+    // Fraction by which the budget error scale relaxes each frame once the budget is met.
+    constexpr float ErrorScaleDecay = 0.95f;
+
+    XMVECTOR LoadLanes(const std::vector<float>& values, const size_t index)
+    {
+        return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&values[index]));
+    }
+
+    void StoreLanes(std::vector<float>& values, const size_t index, FXMVECTOR lanes)
+    {
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&values[index]), lanes);
+    }
+} // namespace
+
+LodSelector::LodSelector(const Settings& settings) : m_settings(settings)
+{
+}
+
+uint32_t LodSelector::AddObject(const Vector3&                  center,
+                                const float                     radius,
+                                const std::span<const float>    lodErrors,
+                                const std::span<const uint32_t> lodTriangles)
+{
+    if (lodErrors.empty() || lodErrors.size() != lodTriangles.size())
+    {
+        throw std::invalid_argument("LOD errors and triangle counts must be non-empty and the same length");
+    }
+
+    const auto object = static_cast<uint32_t>(m_count++);
+
+    const size_t padded = (m_count + 3) & ~size_t{3};
+    if (m_centerX.size() < padded)
+    {
+        m_centerX.resize(padded, 0.0f);
+        m_centerY.resize(padded, 0.0f);
+        m_centerZ.resize(padded, 0.0f);
+        m_radius.resize(padded, 0.0f);
+        m_maxLod.resize(padded, 0.0f);
+        m_screenScale.resize(padded, 0.0f);
+        m_previousLod.resize(padded, 0.0f);
+        m_currentLod.resize(padded, 0.0f);
+        for (uint32_t lod = 0; lod < MaxLods; ++lod)
+        {
+            m_error[lod].resize(padded, 0.0f);
+            m_triangles[lod].resize(padded, 0);
+        }
+    }
+
+    const size_t lodCount = std::min<size_t>(lodErrors.size(), MaxLods);
+    m_maxLod[object] = static_cast<float>(lodCount - 1);
+    for (size_t lod = 0; lod < lodCount; ++lod)
+    {
+        m_error[lod][object] = lodErrors[lod];
+        m_triangles[lod][object] = lodTriangles[lod];
+    }
+
+    SetBounds(object, center, radius);
+    return object;
+}
+
+void LodSelector::SetBounds(const uint32_t object, const Vector3& center, const float radius)
+{
+    m_centerX[object] = center.x;
+    m_centerY[object] = center.y;
+    m_centerZ[object] = center.z;
+    m_radius[object] = radius;
+}
+
+void LodSelector::SetSettings(const Settings& settings)
+{
+    m_settings = settings;
+}
+
+size_t LodSelector::ObjectCount() const
+{
+    return m_count;
+}
+
+uint32_t LodSelector::Lod(const uint32_t object) const
+{
+    return static_cast<uint32_t>(m_previousLod[object]);
+}
+
+const LodSelector::Statistics& LodSelector::Stats() const
+{
+    return m_stats;
+}
+
+void LodSelector::Select(const Camera& camera)
+{
+    ComputeScreenScale(camera);
+
+    float    errorScale = std::max(1.0f, m_stats.ErrorScale * ErrorScaleDecay);
+    uint64_t triangles = SelectLods(errorScale);
+
+    if (m_settings.TriangleBudget != 0)
+    {
+        // Coarsen everything together rather than starving whichever objects happen to be processed last.
+        for (uint32_t i = 0; i < m_settings.MaxBudgetIterations && triangles > m_settings.TriangleBudget; ++i)
+        {
+            errorScale *= 2.0f;
+            triangles = SelectLods(errorScale);
+        }
+
+        ++m_stats.Frames;
+        if (triangles <= m_settings.TriangleBudget)
+        {
+            ++m_stats.FramesWithinBudget;
+        }
+    }
+
+    m_stats.Triangles = triangles;
+    m_stats.ErrorScale = errorScale;
+    std::swap(m_previousLod, m_currentLod);
+}
+
+void LodSelector::ComputeScreenScale(const Camera& camera)
+{
+    // Pixels covered by one world unit at distance d: viewportHeight / (2 * d * tan(fov / 2)).
+    const float    pixelsPerUnit = camera.viewHeight() / (2.0f * std::tan(0.5f * camera.fieldOfView()));
+    const Vector3  position = camera.position();
+    const XMVECTOR cameraX = XMVectorReplicate(position.x);
+    const XMVECTOR cameraY = XMVectorReplicate(position.y);
+    const XMVECTOR cameraZ = XMVectorReplicate(position.z);
+    const XMVECTOR scale = XMVectorReplicate(pixelsPerUnit);
+    const XMVECTOR minDistance = XMVectorReplicate(MinProjectionDistance);
+
+    for (size_t i = 0; i < m_centerX.size(); i += 4)
+    {
+        const XMVECTOR dx = XMVectorSubtract(LoadLanes(m_centerX, i), cameraX);
+        const XMVECTOR dy = XMVectorSubtract(LoadLanes(m_centerY, i), cameraY);
+        const XMVECTOR dz = XMVectorSubtract(LoadLanes(m_centerZ, i), cameraZ);
+
+        XMVECTOR distanceSq = XMVectorMultiply(dx, dx);
+        distanceSq = XMVectorMultiplyAdd(dy, dy, distanceSq);
+        distanceSq = XMVectorMultiplyAdd(dz, dz, distanceSq);
+
+        // Measure to the nearest point of the sphere so large objects refine before the camera reaches them.
+        XMVECTOR distance = XMVectorSubtract(XMVectorSqrt(distanceSq), LoadLanes(m_radius, i));
+        distance = XMVectorMax(distance, minDistance);
+
+        StoreLanes(m_screenScale, i, XMVectorDivide(scale, distance));
+    }
+}
+
+uint64_t LodSelector::SelectLods(const float errorScale)
+{
+    const float    threshold = m_settings.ErrorThresholdPixels;
+    const XMVECTOR idealThreshold = XMVectorReplicate(threshold);
+    const XMVECTOR coarserThreshold = XMVectorReplicate(threshold * (1.0f - m_settings.Hysteresis));
+    const XMVECTOR finerThreshold = XMVectorReplicate(threshold * (1.0f + m_settings.Hysteresis));
+
+    // Relaxing the threshold by errorScale is the same as shrinking every projected error by it.
+    const XMVECTOR globalScale = XMVectorReplicate(1.0f / errorScale);
+
+    for (size_t i = 0; i < m_centerX.size(); i += 4)
+    {
+        const XMVECTOR scale = XMVectorMultiply(LoadLanes(m_screenScale, i), globalScale);
+        const XMVECTOR maxLod = LoadLanes(m_maxLod, i);
+        const XMVECTOR previous = LoadLanes(m_previousLod, i);
+
+        // Errors grow with the level, so the last passing level is the coarsest acceptable one.
+        XMVECTOR ideal = XMVectorZero();
+        XMVECTOR coarser = XMVectorZero();
+        XMVECTOR previousError = XMVectorZero();
+        for (uint32_t lod = 0; lod < MaxLods; ++lod)
+        {
+            const XMVECTOR level = XMVectorReplicate(static_cast<float>(lod));
+            const XMVECTOR error = XMVectorMultiply(LoadLanes(m_error[lod], i), scale);
+            const XMVECTOR valid = XMVectorLessOrEqual(level, maxLod);
+
+            ideal = XMVectorSelect(ideal, level, XMVectorAndInt(valid, XMVectorLessOrEqual(error, idealThreshold)));
+            coarser =
+                XMVectorSelect(coarser, level, XMVectorAndInt(valid, XMVectorLessOrEqual(error, coarserThreshold)));
+            previousError = XMVectorSelect(previousError, error, XMVectorEqual(previous, level));
+        }
+
+        // Only drop detail once comfortably under the threshold, and only add it once clearly over.
+        const XMVECTOR toCoarser = XMVectorGreater(ideal, previous);
+        const XMVECTOR toFiner =
+            XMVectorAndInt(XMVectorLess(ideal, previous), XMVectorGreater(previousError, finerThreshold));
+
+        XMVECTOR lod = XMVectorSelect(previous, XMVectorMax(previous, coarser), toCoarser);
+        lod = XMVectorSelect(lod, ideal, toFiner);
+        StoreLanes(m_currentLod, i, lod);
+    }
+
+    uint64_t triangles = 0;
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        triangles += m_triangles[static_cast<uint32_t>(m_currentLod[i])][i];
+    }
+
+    return triangles;
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Camera.hpp"
+#include "GraphicsMath.hpp"
+
+/// @brief Chooses a level of detail per object from its projected screen-space error.
+///
+/// Each object has a bounding sphere and up to MaxLods levels, each with a world-space
+/// geometric error (increasing from LOD 0) and a triangle count. Errors are projected
+/// using the camera field of view and viewport height. Hysteresis bands around the
+/// pixel threshold keep objects from flipping between levels, and when the selection
+/// exceeds the triangle budget the threshold is relaxed for all objects until it fits.
+class LodSelector final
+{
+public:
+    static constexpr uint32_t MaxLods = 4;
+
+    struct Settings
+    {
+        float    ErrorThresholdPixels = 1.0f; ///< Largest acceptable projected error.
+        float    Hysteresis = 0.2f;           ///< Relative band around the threshold that suppresses switches.
+        uint64_t TriangleBudget = 0;          ///< Per-frame triangle budget, 0 disables it.
+        uint32_t MaxBudgetIterations = 6;     ///< Number of times the threshold may double per frame.
+    };
+
+    struct Statistics
+    {
+        uint64_t Triangles = 0;          ///< Triangles selected in the last frame.
+        float    ErrorScale = 1.0f;      ///< Factor the threshold was relaxed by in the last frame.
+        uint32_t Frames = 0;             ///< Frames selected with a budget enabled.
+        uint32_t FramesWithinBudget = 0; ///< Frames that ended within the budget.
+
+        [[nodiscard]] float BudgetHitRate() const
+        {
+            return Frames == 0 ? 1.0f : static_cast<float>(FramesWithinBudget) / static_cast<float>(Frames);
+        }
+    };
+
+    explicit LodSelector(const Settings& settings = {});
+
+    /// @brief Adds an object.
+    /// @param [in] lodErrors World-space geometric error per level, non-decreasing.
+    /// @param [in] lodTriangles Triangle count per level, same length as lodErrors.
+    /// @return Index of the object.
+    uint32_t AddObject(const Vector3&            center,
+                       float                     radius,
+                       std::span<const float>    lodErrors,
+                       std::span<const uint32_t> lodTriangles);
+
+    void SetBounds(uint32_t object, const Vector3& center, float radius);
+
+    void SetSettings(const Settings& settings);
+
+    [[nodiscard]] size_t ObjectCount() const;
+
+    [[nodiscard]] uint32_t Lod(uint32_t object) const;
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+    /// @brief Selects levels for all objects as seen from the camera.
+    void Select(const Camera& camera);
+
+private:
+    void ComputeScreenScale(const Camera& camera);
+
+    uint64_t SelectLods(float errorScale);
+
+    Settings   m_settings;
+    Statistics m_stats;
+    size_t     m_count = 0;
+
+    // Object data in structure-of-arrays form, padded to a multiple of four for vector loads.
+    std::vector<float>    m_centerX;
+    std::vector<float>    m_centerY;
+    std::vector<float>    m_centerZ;
+    std::vector<float>    m_radius;
+    std::vector<float>    m_maxLod;
+    std::vector<float>    m_error[MaxLods];
+    std::vector<uint32_t> m_triangles[MaxLods];
+    std::vector<float>    m_screenScale;
+    std::vector<float>    m_previousLod;
+    std::vector<float>    m_currentLod;
+};
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MorphTargets.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    /// Untouched vertices between two displaced ones that are stored as zeros rather than splitting the span.
+    constexpr uint32_t MaxSpanGap = 8;
+
+    bool Displaced(const ConstVector3Stream deltas, const size_t vertex, const float threshold)
+    {
+        if (deltas.X == nullptr)
+        {
+            return false;
+        }
+        return std::abs(deltas.X[vertex]) > threshold || std::abs(deltas.Y[vertex]) > threshold ||
+               std::abs(deltas.Z[vertex]) > threshold;
+    }
+
+    void CopyPlanes(const ConstVector3Stream source, const Vector3Stream target, const size_t count)
+    {
+        std::copy_n(source.X, count, target.X);
+        std::copy_n(source.Y, count, target.Y);
+        std::copy_n(source.Z, count, target.Z);
+    }
+
+    /// target[i] += deltas[i] * weight, four elements at a time.
+    void Accumulate(float* target, const float* deltas, const uint32_t count, const FXMVECTOR weight)
+    {
+        uint32_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            auto*          sum = reinterpret_cast<XMFLOAT4*>(target + i);
+            const XMVECTOR delta = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(deltas + i));
+            XMStoreFloat4(sum, XMVectorMultiplyAdd(delta, weight, XMLoadFloat4(sum)));
+        }
+
+        const float scalar = XMVectorGetX(weight);
+        for (; i < count; ++i)
+        {
+            target[i] += deltas[i] * scalar;
+        }
+    }
+
+    void AccumulateTarget(const std::vector<MorphSpan>& spans,
+                          const float*                  deltas,
+                          const uint32_t                deltaCount,
+                          const FXMVECTOR               weight,
+                          const Vector3Stream           target)
+    {
+        float* planes[3] = {target.X, target.Y, target.Z};
+        for (const MorphSpan& span : spans)
+        {
+            for (uint32_t component = 0; component < 3; ++component)
+            {
+                Accumulate(planes[component] + span.FirstVertex, deltas + component * deltaCount + span.FirstDelta,
+                           span.VertexCount, weight);
+            }
+        }
+    }
+} // namespace
+
+MorphTarget MakeSparseMorphTarget(std::string              name,
+                                  const size_t             vertexCount,
+                                  const ConstVector3Stream positionDeltas,
+                                  const ConstVector3Stream normalDeltas,
+                                  const float              threshold)
+{
+    MorphTarget target;
+    target.Name = std::move(name);
+
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        if (!Displaced(positionDeltas, vertex, threshold) && !Displaced(normalDeltas, vertex, threshold))
+        {
+            continue;
+        }
+
+        const auto index = static_cast<uint32_t>(vertex);
+        if (!target.Spans.empty())
+        {
+            MorphSpan&     last = target.Spans.back();
+            const uint32_t end = last.FirstVertex + last.VertexCount;
+            if (index - end <= MaxSpanGap)
+            {
+                target.DeltaCount += index + 1 - end;
+                last.VertexCount = index + 1 - last.FirstVertex;
+                continue;
+            }
+        }
+
+        target.Spans.push_back({index, 1, target.DeltaCount});
+        ++target.DeltaCount;
+    }
+
+    const auto gather = [&target](const ConstVector3Stream deltas, std::vector<float>& planes) {
+        const float* sources[3] = {deltas.X, deltas.Y, deltas.Z};
+        planes.resize(static_cast<size_t>(target.DeltaCount) * 3);
+        for (const MorphSpan& span : target.Spans)
+        {
+            for (uint32_t component = 0; component < 3; ++component)
+            {
+                std::copy_n(sources[component] + span.FirstVertex, span.VertexCount,
+                            planes.begin() + component * target.DeltaCount + span.FirstDelta);
+            }
+        }
+    };
+
+    if (positionDeltas.X != nullptr)
+    {
+        gather(positionDeltas, target.PositionDeltas);
+    }
+    if (normalDeltas.X != nullptr)
+    {
+        gather(normalDeltas, target.NormalDeltas);
+    }
+    return target;
+}
+
+void MorphWeightTrack::Evaluate(const float time, const bool loop, const std::span<float> weights) const
+{
+    assert(weights.size() >= TargetCount && Values.size() == Times.size() * TargetCount);
+
+    if (Times.empty())
+    {
+        std::fill_n(weights.begin(), TargetCount, 0.0f);
+        return;
+    }
+
+    const float  trackTime = WrapClipTime(time, Duration, loop);
+    const size_t next = std::upper_bound(Times.begin(), Times.end(), trackTime) - Times.begin();
+    const size_t from = next == 0 ? 0 : next - 1;
+    const size_t to = std::min(next, Times.size() - 1);
+
+    float amount = 0.0f;
+    if (Mode == Interpolation::Linear && to != from)
+    {
+        amount = (trackTime - Times[from]) / (Times[to] - Times[from]);
+    }
+
+    const float* a = Values.data() + from * TargetCount;
+    const float* b = Values.data() + to * TargetCount;
+    for (uint32_t target = 0; target < TargetCount; ++target)
+    {
+        weights[target] = a[target] + (b[target] - a[target]) * amount;
+    }
+}
+
+void MorphBlender::Blend(const MorphTargetSet&        targets,
+                         const std::span<const float> weights,
+                         const ConstVector3Stream     basePositions,
+                         const ConstVector3Stream     baseNormals,
+                         const Vector3Stream          positions,
+                         const Vector3Stream          normals)
+{
+    assert(weights.size() >= targets.Targets.size());
+    assert(normals.X == nullptr || baseNormals.X != nullptr);
+
+    // Pick the active targets once, so idle ones cost nothing per vertex.
+    m_active.clear();
+    for (uint32_t target = 0; target < targets.Targets.size(); ++target)
+    {
+        if (std::abs(weights[target]) > WeightEpsilon)
+        {
+            m_active.push_back(target);
+        }
+    }
+
+    CopyPlanes(basePositions, positions, targets.VertexCount);
+    if (normals.X != nullptr)
+    {
+        CopyPlanes(baseNormals, normals, targets.VertexCount);
+    }
+
+    for (const uint32_t index : m_active)
+    {
+        const MorphTarget& target = targets.Targets[index];
+        const XMVECTOR     weight = XMVectorReplicate(weights[index]);
+
+        if (!target.PositionDeltas.empty())
+        {
+            AccumulateTarget(target.Spans, target.PositionDeltas.data(), target.DeltaCount, weight, positions);
+        }
+        if (normals.X != nullptr && !target.NormalDeltas.empty())
+        {
+            AccumulateTarget(target.Spans, target.NormalDeltas.data(), target.DeltaCount, weight, normals);
+        }
+    }
+}
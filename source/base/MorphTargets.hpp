@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Animation.hpp"
+#include "TransformKernels.hpp"
+
+/// Run of consecutive vertices displaced by a morph target.
+struct MorphSpan
+{
+    uint32_t FirstVertex = 0;
+    uint32_t VertexCount = 0;
+    uint32_t FirstDelta = 0; ///< Index of the span's first delta in each delta plane.
+};
+
+/// @brief Displacements of one morph target, stored only for the vertices it moves.
+///
+/// Deltas are stored as x, y and z planes of DeltaCount elements, in span order.
+/// Short gaps between displaced vertices are stored as well so spans stay long
+/// enough to be accumulated four vertices at a time.
+struct MorphTarget
+{
+    std::string            Name;
+    std::vector<MorphSpan> Spans;
+    uint32_t               DeltaCount = 0;
+    std::vector<float>     PositionDeltas; ///< Empty when the target only changes normals.
+    std::vector<float>     NormalDeltas;   ///< Empty when the target does not change normals.
+};
+
+/// Morph targets of one mesh primitive.
+struct MorphTargetSet
+{
+    size_t                   VertexCount = 0;
+    std::vector<MorphTarget> Targets;
+    std::vector<float>       DefaultWeights; ///< Weights used when no animation drives the targets.
+};
+
+/// @brief Builds a sparse target from dense per-vertex deltas.
+/// @param [in] positionDeltas Optional, X is null when absent.
+/// @param [in] normalDeltas Optional, X is null when absent.
+/// @param [in] threshold Vertices whose deltas are all at most this large are skipped.
+[[nodiscard]] MorphTarget MakeSparseMorphTarget(std::string        name,
+                                                size_t             vertexCount,
+                                                ConstVector3Stream positionDeltas,
+                                                ConstVector3Stream normalDeltas,
+                                                float              threshold = 1.0e-6f);
+
+/// Keyframes of every target weight of a mesh, with times in seconds in ascending order.
+struct MorphWeightTrack
+{
+    std::string        Name;
+    float              Duration = 0.0f;
+    uint32_t           TargetCount = 0;
+    std::vector<float> Times;
+    std::vector<float> Values; ///< TargetCount weights per key.
+    Interpolation      Mode = Interpolation::Linear;
+
+    /// @brief Evaluates all weights at a time; called once per frame before blending.
+    /// @param [out] weights Receives TargetCount weights.
+    void Evaluate(float time, bool loop, std::span<float> weights) const;
+};
+
+/// @brief Applies weighted morph targets to the base positions and normals of a mesh.
+///
+/// Targets whose weight is near zero are skipped, and the others add their deltas
+/// span by span with SIMD multiply-adds. Normals are not renormalized; the skinner or
+/// the shader does so. A blender keeps scratch buffers between calls, so one instance
+/// should be used per thread.
+class MorphBlender final
+{
+public:
+    /// Weights at most this large in magnitude leave the mesh unchanged to the eye.
+    static constexpr float WeightEpsilon = 1.0e-3f;
+
+    /// @param [in] weights One weight per target.
+    /// @param [in] baseNormals Optional, X is null when absent.
+    /// @param [out] positions Streams with room for targets.VertexCount elements.
+    /// @param [out] normals Optional, X is null when not needed.
+    void Blend(const MorphTargetSet&  targets,
+               std::span<const float> weights,
+               ConstVector3Stream     basePositions,
+               ConstVector3Stream     baseNormals,
+               Vector3Stream          positions,
+               Vector3Stream          normals);
+
+    /// @brief Gets the number of targets applied by the last call to Blend.
+    [[nodiscard]] uint32_t ActiveTargetCount() const
+    {
+        return static_cast<uint32_t>(m_active.size());
+    }
+
+private:
+    std::vector<uint32_t> m_active;
+};
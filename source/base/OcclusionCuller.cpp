@@ -0,0 +1,437 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "OcclusionCuller.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+
+#include <SDL3/SDL.h>
+
+#include "ThreadPool.hpp"
+
+namespace
+{
+    // Vertices closer than this (in clip-space w) are treated as crossing the near plane.
+    constexpr float NearClipW = 1e-5f;
+
+    // Triangles with a smaller screen-space area cover no pixel centers worth rasterizing.
+    constexpr float MinTriangleArea = 1e-8f;
+
+    uint32_t AlignUp(const uint32_t value, const uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+} // namespace
+
+OcclusionCuller::OcclusionCuller(const uint32_t width, const uint32_t height)
+    : m_width(AlignUp(std::max(width, 1u), TileWidth)), m_height(AlignUp(std::max(height, 1u), TileHeight))
+{
+    m_tilesX = m_width / TileWidth;
+    m_tilesY = m_height / TileHeight;
+    m_blocksX = m_width / BlockWidth;
+    m_blocksY = m_height / BlockHeight;
+
+    m_depth.resize(static_cast<size_t>(m_width) * m_height, 1.0f);
+    m_blockMaxDepth.resize(static_cast<size_t>(m_blocksX) * m_blocksY, 1.0f);
+    m_tileBins.resize(static_cast<size_t>(m_tilesX) * m_tilesY);
+}
+
+uint32_t OcclusionCuller::Width() const
+{
+    return m_width;
+}
+
+uint32_t OcclusionCuller::Height() const
+{
+    return m_height;
+}
+
+const OcclusionCuller::Statistics& OcclusionCuller::Stats() const
+{
+    return m_stats;
+}
+
+void OcclusionCuller::BeginFrame(const Camera& camera)
+{
+    m_viewProjection = camera.viewProjection();
+
+    std::ranges::fill(m_depth, 1.0f);
+    std::ranges::fill(m_blockMaxDepth, 1.0f);
+    m_triangles.clear();
+    for (auto& bin : m_tileBins)
+    {
+        bin.clear();
+    }
+
+    m_stats = {};
+}
+
+void OcclusionCuller::AddOccluder(std::span<const Vector3>  vertices,
+                                  std::span<const uint16_t> indices,
+                                  const Matrix&             world)
+{
+    AddOccluderTriangles(vertices, indices, world);
+}
+
+void OcclusionCuller::AddOccluder(std::span<const Vector3>  vertices,
+                                  std::span<const uint32_t> indices,
+                                  const Matrix&             world)
+{
+    AddOccluderTriangles(vertices, indices, world);
+}
+
+template <typename TIndex>
+void OcclusionCuller::AddOccluderTriangles(std::span<const Vector3> vertices,
+                                           std::span<const TIndex>  indices,
+                                           const Matrix&            world)
+{
+    const XMMATRIX transform = XMMatrixMultiply(world, m_viewProjection);
+
+    m_clipVertices.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        XMStoreFloat4(&m_clipVertices[i], XMVector3Transform(XMLoadFloat3(&vertices[i]), transform));
+    }
+
+    const float halfWidth = 0.5f * static_cast<float>(m_width);
+    const float halfHeight = 0.5f * static_cast<float>(m_height);
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        ++m_stats.OccluderTriangles;
+
+        Vector4 screen[3];
+        bool    clipped = false;
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            const Vector4& clip = m_clipVertices[indices[i + corner]];
+            // Dropping near-clipped occluders only loses occlusion, never correctness.
+            if (clip.w < NearClipW || clip.z < 0.0f)
+            {
+                clipped = true;
+                break;
+            }
+
+            const float invW = 1.0f / clip.w;
+            screen[corner] = Vector4((clip.x * invW + 1.0f) * halfWidth, (1.0f - clip.y * invW) * halfHeight,
+                                     clip.z * invW, 0.0f);
+        }
+
+        if (!clipped)
+        {
+            BinTriangle(screen[0], screen[1], screen[2]);
+        }
+    }
+}
+
+void OcclusionCuller::BinTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2)
+{
+    const float minX = std::max(std::min({v0.x, v1.x, v2.x}), 0.0f);
+    const float minY = std::max(std::min({v0.y, v1.y, v2.y}), 0.0f);
+    const float maxX = std::min(std::max({v0.x, v1.x, v2.x}), static_cast<float>(m_width));
+    const float maxY = std::min(std::max({v0.y, v1.y, v2.y}), static_cast<float>(m_height));
+    if (minX >= maxX || minY >= maxY || std::min({v0.z, v1.z, v2.z}) > 1.0f)
+    {
+        return;
+    }
+
+    // Edge function E(p) = A * p.x + B * p.y + C for the edge opposite each vertex.
+    const Vector4* v[3] = {&v0, &v1, &v2};
+    Triangle       triangle{};
+    for (int edge = 0; edge < 3; ++edge)
+    {
+        const Vector4& a = *v[(edge + 1) % 3];
+        const Vector4& b = *v[(edge + 2) % 3];
+        triangle.EdgeA[edge] = a.y - b.y;
+        triangle.EdgeB[edge] = b.x - a.x;
+        triangle.EdgeC[edge] = a.x * b.y - a.y * b.x;
+    }
+
+    const float area = triangle.EdgeA[0] * v0.x + triangle.EdgeB[0] * v0.y + triangle.EdgeC[0];
+    if (std::abs(area) < MinTriangleArea)
+    {
+        return;
+    }
+
+    // Depth is affine in screen space, so fold the barycentric weights into a plane equation.
+    const float invArea = 1.0f / area;
+    triangle.DepthA = (v0.z * triangle.EdgeA[0] + v1.z * triangle.EdgeA[1] + v2.z * triangle.EdgeA[2]) * invArea;
+    triangle.DepthB = (v0.z * triangle.EdgeB[0] + v1.z * triangle.EdgeB[1] + v2.z * triangle.EdgeB[2]) * invArea;
+    triangle.DepthC = (v0.z * triangle.EdgeC[0] + v1.z * triangle.EdgeC[1] + v2.z * triangle.EdgeC[2]) * invArea;
+
+    // Normalize winding so that interior pixels always have positive edge values.
+    if (area < 0.0f)
+    {
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            triangle.EdgeA[edge] = -triangle.EdgeA[edge];
+            triangle.EdgeB[edge] = -triangle.EdgeB[edge];
+            triangle.EdgeC[edge] = -triangle.EdgeC[edge];
+        }
+    }
+
+    triangle.MinX = minX;
+    triangle.MinY = minY;
+    triangle.MaxX = maxX;
+    triangle.MaxY = maxY;
+
+    const auto triangleIndex = static_cast<uint32_t>(m_triangles.size());
+    m_triangles.push_back(triangle);
+    ++m_stats.BinnedTriangles;
+
+    const uint32_t tileMinX = static_cast<uint32_t>(minX) / TileWidth;
+    const uint32_t tileMinY = static_cast<uint32_t>(minY) / TileHeight;
+    const uint32_t tileMaxX = std::min(static_cast<uint32_t>(maxX) / TileWidth, m_tilesX - 1);
+    const uint32_t tileMaxY = std::min(static_cast<uint32_t>(maxY) / TileHeight, m_tilesY - 1);
+    for (uint32_t ty = tileMinY; ty <= tileMaxY; ++ty)
+    {
+        for (uint32_t tx = tileMinX; tx <= tileMaxX; ++tx)
+        {
+            m_tileBins[ty * m_tilesX + tx].push_back(triangleIndex);
+        }
+    }
+}
+
+void OcclusionCuller::Rasterize(ThreadPool& pool)
+{
+    pool.ParallelFor(m_tileBins.size(), 1, [this](const size_t begin, const size_t end, uint32_t) {
+        for (size_t tile = begin; tile < end; ++tile)
+        {
+            RasterizeTile(static_cast<uint32_t>(tile));
+        }
+    });
+}
+
+void OcclusionCuller::RasterizeTile(const uint32_t tileIndex)
+{
+    const auto& bin = m_tileBins[tileIndex];
+    if (bin.empty())
+    {
+        return;
+    }
+
+    const uint32_t tileX0 = (tileIndex % m_tilesX) * TileWidth;
+    const uint32_t tileY0 = (tileIndex / m_tilesX) * TileHeight;
+    const uint32_t tileX1 = tileX0 + TileWidth;
+    const uint32_t tileY1 = tileY0 + TileHeight;
+
+    const XMVECTOR laneOffsets = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+    const XMVECTOR laneStep = XMVectorReplicate(4.0f);
+    const XMVECTOR zero = XMVectorZero();
+    const XMVECTOR one = XMVectorSplatOne();
+
+    for (const uint32_t triangleIndex : bin)
+    {
+        const Triangle& triangle = m_triangles[triangleIndex];
+
+        // Spans start on a 4-pixel boundary; tiles are multiples of 4 wide so a span never leaves its tile.
+        const uint32_t x0 = std::max(tileX0, static_cast<uint32_t>(triangle.MinX) & ~3u);
+        const uint32_t y0 = std::max(tileY0, static_cast<uint32_t>(triangle.MinY));
+        const uint32_t x1 = std::min(tileX1, static_cast<uint32_t>(std::ceil(triangle.MaxX)));
+        const uint32_t y1 = std::min(tileY1, static_cast<uint32_t>(std::ceil(triangle.MaxY)));
+
+        const XMVECTOR edgeA0 = XMVectorReplicate(triangle.EdgeA[0]);
+        const XMVECTOR edgeA1 = XMVectorReplicate(triangle.EdgeA[1]);
+        const XMVECTOR edgeA2 = XMVectorReplicate(triangle.EdgeA[2]);
+        const XMVECTOR depthA = XMVectorReplicate(triangle.DepthA);
+
+        for (uint32_t y = y0; y < y1; ++y)
+        {
+            const float    py = static_cast<float>(y) + 0.5f;
+            const XMVECTOR row0 = XMVectorReplicate(triangle.EdgeB[0] * py + triangle.EdgeC[0]);
+            const XMVECTOR row1 = XMVectorReplicate(triangle.EdgeB[1] * py + triangle.EdgeC[1]);
+            const XMVECTOR row2 = XMVectorReplicate(triangle.EdgeB[2] * py + triangle.EdgeC[2]);
+            const XMVECTOR rowDepth = XMVectorReplicate(triangle.DepthB * py + triangle.DepthC);
+
+            float*   depthRow = &m_depth[static_cast<size_t>(y) * m_width];
+            XMVECTOR px = XMVectorAdd(XMVectorReplicate(static_cast<float>(x0)), laneOffsets);
+            for (uint32_t x = x0; x < x1; x += 4, px = XMVectorAdd(px, laneStep))
+            {
+                const XMVECTOR e0 = XMVectorMultiplyAdd(edgeA0, px, row0);
+                const XMVECTOR e1 = XMVectorMultiplyAdd(edgeA1, px, row1);
+                const XMVECTOR e2 = XMVectorMultiplyAdd(edgeA2, px, row2);
+
+                XMVECTOR inside = XMVectorAndInt(XMVectorGreater(e0, zero), XMVectorGreater(e1, zero));
+                inside = XMVectorAndInt(inside, XMVectorGreater(e2, zero));
+                if (!XMVector4NotEqualInt(inside, XMVectorFalseInt()))
+                {
+                    continue;
+                }
+
+                const XMVECTOR depth = XMVectorClamp(XMVectorMultiplyAdd(depthA, px, rowDepth), zero, one);
+                auto*          destination = reinterpret_cast<XMFLOAT4*>(depthRow + x);
+                const XMVECTOR current = XMLoadFloat4(destination);
+                XMStoreFloat4(destination, XMVectorSelect(current, XMVectorMin(current, depth), inside));
+            }
+        }
+    }
+
+    // Rebuild the max-depth level for the blocks covered by this tile.
+    for (uint32_t by = tileY0 / BlockHeight; by < tileY1 / BlockHeight; ++by)
+    {
+        for (uint32_t bx = tileX0 / BlockWidth; bx < tileX1 / BlockWidth; ++bx)
+        {
+            XMVECTOR blockMax = XMVectorZero();
+            for (uint32_t y = by * BlockHeight; y < (by + 1) * BlockHeight; ++y)
+            {
+                const float* depthRow = &m_depth[static_cast<size_t>(y) * m_width + bx * BlockWidth];
+                for (uint32_t x = 0; x < BlockWidth; x += 4)
+                {
+                    blockMax = XMVectorMax(blockMax, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(depthRow + x)));
+                }
+            }
+
+            blockMax = XMVectorMax(blockMax, XMVectorSwizzle<2, 3, 0, 1>(blockMax));
+            blockMax = XMVectorMax(blockMax, XMVectorSwizzle<1, 0, 3, 2>(blockMax));
+            m_blockMaxDepth[by * m_blocksX + bx] = XMVectorGetX(blockMax);
+        }
+    }
+}
+
+bool OcclusionCuller::IsVisible(const BoundingBox& bounds) const
+{
+    XMFLOAT3 corners[BoundingBox::CORNER_COUNT];
+    bounds.GetCorners(corners);
+
+    const XMMATRIX viewProjection = m_viewProjection;
+    const float    halfWidth = 0.5f * static_cast<float>(m_width);
+    const float    halfHeight = 0.5f * static_cast<float>(m_height);
+
+    float minX = FLT_MAX;
+    float minY = FLT_MAX;
+    float maxX = -FLT_MAX;
+    float maxY = -FLT_MAX;
+    float minDepth = FLT_MAX;
+    for (const auto& corner : corners)
+    {
+        XMFLOAT4 clip;
+        XMStoreFloat4(&clip, XMVector3Transform(XMLoadFloat3(&corner), viewProjection));
+
+        // Boxes that straddle the camera cannot be resolved against a screen-space buffer.
+        if (clip.w < NearClipW || clip.z < 0.0f)
+        {
+            return true;
+        }
+
+        const float invW = 1.0f / clip.w;
+        const float x = (clip.x * invW + 1.0f) * halfWidth;
+        const float y = (1.0f - clip.y * invW) * halfHeight;
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+        minDepth = std::min(minDepth, clip.z * invW);
+    }
+
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(m_width) || minY >= static_cast<float>(m_height))
+    {
+        return false;
+    }
+
+    const auto pixelMinX = static_cast<int32_t>(std::max(minX, 0.0f));
+    const auto pixelMinY = static_cast<int32_t>(std::max(minY, 0.0f));
+    const auto pixelMaxX = static_cast<int32_t>(std::min(maxX, static_cast<float>(m_width - 1)));
+    const auto pixelMaxY = static_cast<int32_t>(std::min(maxY, static_cast<float>(m_height - 1)));
+    return IsRectVisible(pixelMinX, pixelMinY, pixelMaxX, pixelMaxY, minDepth);
+}
+
+bool OcclusionCuller::IsRectVisible(const int32_t minX,
+                                    const int32_t minY,
+                                    const int32_t maxX,
+                                    const int32_t maxY,
+                                    const float   minDepth) const
+{
+    const int32_t blockMinX = minX / static_cast<int32_t>(BlockWidth);
+    const int32_t blockMinY = minY / static_cast<int32_t>(BlockHeight);
+    const int32_t blockMaxX = maxX / static_cast<int32_t>(BlockWidth);
+    const int32_t blockMaxY = maxY / static_cast<int32_t>(BlockHeight);
+
+    for (int32_t by = blockMinY; by <= blockMaxY; ++by)
+    {
+        for (int32_t bx = blockMinX; bx <= blockMaxX; ++bx)
+        {
+            // The whole block is nearer than the box, nothing to refine.
+            if (minDepth >= m_blockMaxDepth[by * m_blocksX + bx])
+            {
+                continue;
+            }
+
+            const int32_t x0 = std::max(minX, bx * static_cast<int32_t>(BlockWidth));
+            const int32_t y0 = std::max(minY, by * static_cast<int32_t>(BlockHeight));
+            const int32_t x1 = std::min(maxX, (bx + 1) * static_cast<int32_t>(BlockWidth) - 1);
+            const int32_t y1 = std::min(maxY, (by + 1) * static_cast<int32_t>(BlockHeight) - 1);
+            for (int32_t y = y0; y <= y1; ++y)
+            {
+                const float* depthRow = &m_depth[static_cast<size_t>(y) * m_width];
+                for (int32_t x = x0; x <= x1; ++x)
+                {
+                    if (minDepth < depthRow[x])
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void OcclusionCuller::TestVisibility(std::span<const BoundingBox> bounds, std::span<uint8_t> visible, ThreadPool& pool)
+{
+    std::atomic<uint32_t> culled = 0;
+    pool.ParallelFor(bounds.size(), 256, [&](const size_t begin, const size_t end, uint32_t) {
+        uint32_t localCulled = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const bool isVisible = IsVisible(bounds[i]);
+            visible[i] = isVisible ? 1 : 0;
+            localCulled += isVisible ? 0 : 1;
+        }
+        culled.fetch_add(localCulled, std::memory_order_relaxed);
+    });
+
+    m_stats.TestedObjects += static_cast<uint32_t>(bounds.size());
+    m_stats.CulledObjects += culled.load();
+}
+
+bool OcclusionCuller::SaveDepthImage(const char* fileName) const
+{
+    SDL_Surface* surface = SDL_CreateSurface(static_cast<int>(m_width), static_cast<int>(m_height),
+                                             SDL_PIXELFORMAT_RGB24);
+    if (surface == nullptr)
+    {
+        return false;
+    }
+
+    // Post-projection depth bunches up near 1, so stretch the covered range to the full gray scale.
+    float nearest = 1.0f;
+    for (const float depth : m_depth)
+    {
+        nearest = std::min(nearest, depth);
+    }
+    const float range = std::max(1.0f - nearest, 1e-6f);
+
+    for (uint32_t y = 0; y < m_height; ++y)
+    {
+        auto* pixel = static_cast<uint8_t*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch;
+        for (uint32_t x = 0; x < m_width; ++x)
+        {
+            const float depth = m_depth[static_cast<size_t>(y) * m_width + x];
+            const auto  intensity = static_cast<uint8_t>((1.0f - (depth - nearest) / range) * 255.0f);
+            pixel[0] = intensity;
+            pixel[1] = intensity;
+            pixel[2] = intensity;
+            pixel += 3;
+        }
+    }
+
+    const bool saved = SDL_SaveBMP(surface, fileName);
+    SDL_DestroySurface(surface);
+    return saved;
+}
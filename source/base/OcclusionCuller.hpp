@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Camera.hpp"
+#include "GraphicsMath.hpp"
+
+class ThreadPool;
+
+/// @brief Software occlusion culler backed by a coarse CPU depth buffer.
+///
+/// Occluder triangles are transformed with the camera view-projection, binned into
+/// screen-space tiles and rasterized (four pixels at a time) into a low resolution
+/// depth buffer. A per-block max-depth level sits on top of it so most visibility
+/// queries resolve without touching individual pixels. Depth follows the D3D
+/// convention used by Camera: 0 is the near plane and 1 the far plane.
+class OcclusionCuller final
+{
+public:
+    /// Pixel footprint of one hierarchical depth block.
+    static constexpr uint32_t BlockWidth = 8;
+    static constexpr uint32_t BlockHeight = 8;
+
+    /// Pixel footprint of one binning tile; each tile is rasterized by a single thread.
+    static constexpr uint32_t TileWidth = 64;
+    static constexpr uint32_t TileHeight = 32;
+
+    struct Statistics
+    {
+        uint32_t OccluderTriangles = 0; ///< Triangles submitted through AddOccluder.
+        uint32_t BinnedTriangles = 0;   ///< Triangles that survived clipping and were binned.
+        uint32_t TestedObjects = 0;     ///< Bounds tested through TestVisibility.
+        uint32_t CulledObjects = 0;     ///< Bounds found to be fully occluded.
+    };
+
+    /// @brief Constructor
+    /// @param [in] width Depth buffer width, rounded up to a multiple of TileWidth.
+    /// @param [in] height Depth buffer height, rounded up to a multiple of TileHeight.
+    explicit OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+
+    [[nodiscard]] uint32_t Width() const;
+
+    [[nodiscard]] uint32_t Height() const;
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+    /// @brief Clears the depth buffer and captures the camera view-projection for this frame.
+    /// @param [in] camera The camera the scene is rendered from.
+    void BeginFrame(const Camera& camera);
+
+    /// @brief Transforms and bins an occluder mesh. Must be called between BeginFrame and Rasterize.
+    /// @param [in] vertices Object-space vertex positions.
+    /// @param [in] indices Triangle list indices.
+    /// @param [in] world Object to world transform.
+    void AddOccluder(std::span<const Vector3> vertices, std::span<const uint16_t> indices, const Matrix& world);
+
+    /// @copydoc AddOccluder
+    void AddOccluder(std::span<const Vector3> vertices, std::span<const uint32_t> indices, const Matrix& world);
+
+    /// @brief Rasterizes all binned occluders and rebuilds the hierarchical depth level.
+    /// @param [in] pool Pool used to rasterize tiles in parallel.
+    void Rasterize(ThreadPool& pool);
+
+    /// @brief Tests a world-space bounding box against the rasterized occluders.
+    /// @return True if any part of the box may be visible.
+    [[nodiscard]] bool IsVisible(const BoundingBox& bounds) const;
+
+    /// @brief Tests many bounding boxes in parallel.
+    /// @param [in] bounds World-space bounding boxes.
+    /// @param [out] visible Receives 1 for potentially visible boxes and 0 for occluded ones.
+    /// @param [in] pool Pool used to distribute the tests.
+    void TestVisibility(std::span<const BoundingBox> bounds, std::span<uint8_t> visible, ThreadPool& pool);
+
+    /// @brief Writes the depth buffer to a grayscale BMP file for debugging.
+    /// @param [in] fileName Destination path.
+    /// @return True if the image was written.
+    bool SaveDepthImage(const char* fileName) const;
+
+private:
+    /// Screen-space triangle set up for edge-function rasterization.
+    struct Triangle
+    {
+        float EdgeA[3];
+        float EdgeB[3];
+        float EdgeC[3];
+        float DepthA;
+        float DepthB;
+        float DepthC;
+        float MinX, MinY, MaxX, MaxY;
+    };
+
+    template <typename TIndex>
+    void AddOccluderTriangles(std::span<const Vector3> vertices, std::span<const TIndex> indices, const Matrix& world);
+
+    void BinTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2);
+
+    void RasterizeTile(uint32_t tileIndex);
+
+    [[nodiscard]] bool IsRectVisible(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY, float minDepth) const;
+
+    uint32_t                           m_width;
+    uint32_t                           m_height;
+    uint32_t                           m_tilesX;
+    uint32_t                           m_tilesY;
+    uint32_t                           m_blocksX;
+    uint32_t                           m_blocksY;
+    Matrix                             m_viewProjection;
+    std::vector<float>                 m_depth;
+    std::vector<float>                 m_blockMaxDepth;
+    std::vector<Triangle>              m_triangles;
+    std::vector<std::vector<uint32_t>> m_tileBins;
+    std::vector<Vector4>               m_clipVertices;
+    Statistics                         m_stats;
+};
@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+// Keying and compilation half of the pipeline cache; GraphicsPipelineCache in the D3D12
+// library builds pipeline state objects on top of it.
+
+#include "PipelineCache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+PipelineCache::PipelineCache(const ReleaseFunction release, int32_t workerCount) : m_release(release)
+{
+    if (workerCount < 0)
+    {
+        // Leave the other half to the frame, which must not stall behind the driver compiler.
+        workerCount = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()) / 2, 1);
+    }
+
+    m_workers.reserve(workerCount);
+    for (int32_t i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&PipelineCache::WorkerMain, this);
+    }
+}
+
+PipelineCache::~PipelineCache()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+        m_jobs.clear();
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+
+    for (const auto& [key, entry] : m_entries)
+    {
+        if (entry->State.load(std::memory_order_acquire) == EntryState::Ready)
+        {
+            m_release(entry->Pipeline);
+        }
+    }
+}
+
+bool PipelineCache::Request(const PipelineKey& key, CreateFunction create)
+{
+    ++m_requests;
+    auto [slot, inserted] = m_entries.try_emplace(key);
+    if (!inserted)
+    {
+        return false;
+    }
+    slot->second = std::make_unique<Entry>();
+    Entry& entry = *slot->second;
+
+    {
+        std::lock_guard lock(m_mutex);
+        ++m_pending;
+        if (!m_workers.empty())
+        {
+            m_jobs.push_back({&entry, std::move(create)});
+        }
+    }
+
+    // Without workers the pipeline is created right away, as a ThreadPool without workers runs inline.
+    if (m_workers.empty())
+    {
+        Run(entry, create);
+    }
+    else
+    {
+        m_wakeCondition.notify_one();
+    }
+    return true;
+}
+
+bool PipelineCache::Contains(const PipelineKey& key) const
+{
+    return m_entries.contains(key);
+}
+
+void* PipelineCache::Get(const PipelineKey& key, void* fallback)
+{
+    const auto entry = m_entries.find(key);
+    if (entry != m_entries.end() && entry->second->State.load(std::memory_order_acquire) == EntryState::Ready)
+    {
+        return entry->second->Pipeline;
+    }
+
+    ++m_fallbacks;
+    return fallback;
+}
+
+void* PipelineCache::Wait(const PipelineKey& key)
+{
+    const auto found = m_entries.find(key);
+    if (found == m_entries.end())
+    {
+        throw std::out_of_range(fmt::format("Pipeline {} was never requested", key.ToString()));
+    }
+    Entry& entry = *found->second;
+
+    std::unique_lock lock(m_mutex);
+    m_doneCondition.wait(lock, [&] { return entry.State.load(std::memory_order_relaxed) != EntryState::Pending; });
+
+    if (entry.State.load(std::memory_order_relaxed) == EntryState::Failed)
+    {
+        std::rethrow_exception(entry.Error);
+    }
+    return entry.Pipeline;
+}
+
+void PipelineCache::WaitForIdle()
+{
+    std::unique_lock lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_pending == 0; });
+}
+
+PipelineCache::Statistics PipelineCache::Stats() const
+{
+    std::lock_guard lock(m_mutex);
+    return {m_requests, static_cast<uint32_t>(m_entries.size()), m_pending, m_failed, m_fallbacks};
+}
+
+void PipelineCache::Run(Entry& entry, const CreateFunction& create)
+{
+    void*              pipeline = nullptr;
+    std::exception_ptr error;
+    try
+    {
+        pipeline = create();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        entry.Pipeline = pipeline;
+        entry.Error = error;
+        entry.State.store(error ? EntryState::Failed : EntryState::Ready, std::memory_order_release);
+        m_failed += error ? 1 : 0;
+        --m_pending;
+    }
+    m_doneCondition.notify_all();
+}
+
+void PipelineCache::WorkerMain()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_wakeCondition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+        if (m_stopping)
+        {
+            return;
+        }
+
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+
+        Run(*job.Target, job.Create);
+
+        lock.lock();
+    }
+}
+
+namespace
+{
+    constexpr uint32_t LibraryMagic = 0x4C4F5350; // "PSOL"
+    constexpr uint32_t LibraryVersion = 1;
+
+    struct LibraryHeader
+    {
+        uint32_t    Magic;
+        uint32_t    Version;
+        uint64_t    Size;
+        PipelineKey Checksum; ///< Of the blob, so a torn or corrupted file is never handed to the driver.
+    };
+} // namespace
+
+std::vector<std::byte> PipelineLibraryFile::Read(const std::filesystem::path& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    LibraryHeader header = {};
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.Magic != LibraryMagic ||
+        header.Version != LibraryVersion)
+    {
+        return {};
+    }
+
+    std::error_code error;
+    const uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize != sizeof(header) + header.Size)
+    {
+        return {};
+    }
+
+    std::vector<std::byte> blob(static_cast<size_t>(header.Size));
+    if (!stream.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(blob.size())) ||
+        PipelineHasher().Add(blob).Key() != header.Checksum)
+    {
+        return {};
+    }
+    return blob;
+}
+
+void PipelineLibraryFile::Write(const std::filesystem::path& path, const std::span<const std::byte> blob)
+{
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        const LibraryHeader header = {LibraryMagic, LibraryVersion, blob.size(), PipelineHasher().Add(blob).Key()};
+
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        stream.close();
+        if (!stream)
+        {
+            throw std::runtime_error(fmt::format("Failed to write pipeline library {}", temporary.string()));
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        throw std::runtime_error(
+            fmt::format("Failed to replace pipeline library {}: {}", path.string(), error.message()));
+    }
+}
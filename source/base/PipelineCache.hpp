@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PipelineKey.hpp"
+
+/// @brief Creates pipelines on worker threads and hands them out by key.
+///
+/// Request() queues the creation of a pipeline the first time it sees its key. Get() returns
+/// the pipeline once it is ready and the fallback until then, so frames keep going while the
+/// driver compiles. Pipelines are opaque pointers, released with the function given to the
+/// constructor. Request() and Get() belong to one thread; the create functions run on the workers.
+class PipelineCache final
+{
+public:
+    /// Creates the pipeline on a worker thread; may throw.
+    using CreateFunction = std::function<void*()>;
+    using ReleaseFunction = void (*)(void* pipeline);
+
+    struct Statistics
+    {
+        uint32_t Requests = 0;  ///< Calls to Request(), including keys already known.
+        uint32_t Pipelines = 0; ///< Distinct keys requested.
+        uint32_t Pending = 0;   ///< Pipelines queued or being created.
+        uint32_t Failed = 0;    ///< Pipelines whose create function threw.
+        uint32_t Fallbacks = 0; ///< Calls to Get() answered with the fallback.
+    };
+
+    /// @param [in] workerCount Number of threads creating pipelines, or -1 for half the hardware threads.
+    explicit PipelineCache(ReleaseFunction release, int32_t workerCount = -1);
+
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    /// @brief Drops the requests no worker has started, waits for the rest and releases every pipeline.
+    ~PipelineCache();
+
+    /// @brief Queues the creation of the pipeline unless the key was requested before.
+    /// @returns Whether the key was new.
+    bool Request(const PipelineKey& key, CreateFunction create);
+
+    /// @brief Checks whether the key was requested, whatever the state of its pipeline.
+    [[nodiscard]] bool Contains(const PipelineKey& key) const;
+
+    /// @brief Gets the pipeline, or the fallback while it is being created, failed or was never requested.
+    [[nodiscard]] void* Get(const PipelineKey& key, void* fallback = nullptr);
+
+    /// @brief Blocks until the pipeline has been created.
+    /// @throws std::out_of_range if the key was never requested, or whatever the create function threw.
+    void* Wait(const PipelineKey& key);
+
+    /// @brief Blocks until every requested pipeline has been created or has failed.
+    void WaitForIdle();
+
+    [[nodiscard]] Statistics Stats() const;
+
+private:
+    enum class EntryState : uint8_t
+    {
+        Pending,
+        Ready,
+        Failed,
+    };
+
+    struct Entry
+    {
+        std::atomic<EntryState> State = EntryState::Pending;
+        void*                   Pipeline = nullptr; ///< Written before State turns Ready.
+        std::exception_ptr      Error;              ///< Written before State turns Failed.
+    };
+
+    struct Job
+    {
+        Entry*         Target;
+        CreateFunction Create;
+    };
+
+    using EntryMap = std::unordered_map<PipelineKey, std::unique_ptr<Entry>, PipelineKeyHash>;
+
+    /// @brief Creates the pipeline of the entry and publishes it, or the exception it threw.
+    void Run(Entry& entry, const CreateFunction& create);
+
+    void WorkerMain();
+
+    ReleaseFunction          m_release;
+    EntryMap                 m_entries; ///< Only touched by the requesting thread.
+    std::vector<std::thread> m_workers;
+    mutable std::mutex       m_mutex;
+    std::condition_variable  m_wakeCondition;
+    std::condition_variable  m_doneCondition;
+    std::deque<Job>          m_jobs;
+    uint32_t                 m_pending = 0;
+    uint32_t                 m_failed = 0;
+    uint32_t                 m_requests = 0;
+    uint32_t                 m_fallbacks = 0;
+    bool                     m_stopping = false;
+};
+
+/// @brief Reads and writes the blob of a pipeline library, with a header that rejects files
+/// that are truncated, corrupted or from another version of the format.
+namespace PipelineLibraryFile
+{
+    /// @brief Reads the blob, or returns nothing when the file is missing or not valid.
+    [[nodiscard]] std::vector<std::byte> Read(const std::filesystem::path& path);
+
+    /// @brief Writes the blob next to the file and moves it into place, so a crash leaves the old file.
+    /// @throws std::runtime_error if the file cannot be written.
+    void Write(const std::filesystem::path& path, std::span<const std::byte> blob);
+} // namespace PipelineLibraryFile
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PipelineKey.hpp"
+
+#include <cstring>
+
+#include <fmt/format.h>
+
+namespace
+{
+    constexpr uint64_t Prime1 = 0x9E3779B185EBCA87;
+    constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4F;
+    constexpr uint64_t Prime3 = 0xFF51AFD7ED558CCD;
+
+    /// Final mix of MurmurHash3, so every input bit reaches every output bit.
+    uint64_t Avalanche(uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCD;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53;
+        value ^= value >> 33;
+        return value;
+    }
+
+    void AddStencilOp(PipelineHasher& hasher, const PipelineDescription::StencilOp& op)
+    {
+        hasher.Add(op.StencilFailOp).Add(op.StencilDepthFailOp).Add(op.StencilPassOp).Add(op.StencilFunc);
+    }
+} // namespace
+
+std::string PipelineKey::ToString() const
+{
+    return fmt::format("{:016x}{:016x}", High, Low);
+}
+
+PipelineHasher& PipelineHasher::Add(const std::span<const std::byte> bytes)
+{
+    Mix(bytes.size());
+
+    const std::byte* data = bytes.data();
+    size_t           remaining = bytes.size();
+    for (; remaining >= sizeof(uint64_t); remaining -= sizeof(uint64_t), data += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        Mix(word);
+    }
+    if (remaining != 0)
+    {
+        // The length went in first, so zero padding cannot be confused with trailing zero bytes.
+        uint64_t word = 0;
+        std::memcpy(&word, data, remaining);
+        Mix(word);
+    }
+    return *this;
+}
+
+PipelineHasher& PipelineHasher::Add(const std::string_view text)
+{
+    return Add(std::as_bytes(std::span(text.data(), text.size())));
+}
+
+PipelineHasher& PipelineHasher::Add(const char* text)
+{
+    if (text == nullptr)
+    {
+        Mix(UINT64_MAX);
+        return *this;
+    }
+    return Add(std::string_view(text));
+}
+
+PipelineKey PipelineHasher::Key() const
+{
+    return {Avalanche(m_low ^ m_words), Avalanche(m_high + m_words * Prime1)};
+}
+
+void PipelineHasher::Mix(const uint64_t word)
+{
+    // A round of XXH64 on one lane and a multiply-xorshift on the other, so the lanes do not collide together.
+    m_low = std::rotl(m_low + word * Prime2, 31) * Prime1;
+    m_high = (m_high ^ word) * Prime3;
+    m_high ^= m_high >> 29;
+    ++m_words;
+}
+
+PipelineKey PipelineDescription::Key() const
+{
+    PipelineHasher hasher;
+    hasher.Add(RootSignature.Low).Add(RootSignature.High);
+    for (const std::span<const std::byte> bytecode : Shaders)
+    {
+        hasher.Add(bytecode);
+    }
+
+    hasher.Add(StreamOutput.size());
+    for (const StreamOutputEntry& entry : StreamOutput)
+    {
+        hasher.Add(entry.Stream).Add(entry.SemanticName).Add(entry.SemanticIndex);
+        hasher.Add(entry.StartComponent).Add(entry.ComponentCount).Add(entry.OutputSlot);
+    }
+    hasher.Add(StreamOutputStrides.size());
+    for (const uint32_t stride : StreamOutputStrides)
+    {
+        hasher.Add(stride);
+    }
+    hasher.Add(RasterizedStream);
+
+    hasher.Add(AlphaToCoverageEnable).Add(IndependentBlendEnable);
+    for (const TargetBlend& target : Blend)
+    {
+        hasher.Add(target.BlendEnable).Add(target.LogicOpEnable);
+        hasher.Add(target.SrcBlend).Add(target.DestBlend).Add(target.BlendOp);
+        hasher.Add(target.SrcBlendAlpha).Add(target.DestBlendAlpha).Add(target.BlendOpAlpha);
+        hasher.Add(target.LogicOp).Add(target.RenderTargetWriteMask);
+    }
+    hasher.Add(SampleMask);
+
+    hasher.Add(FillMode).Add(CullMode).Add(FrontCounterClockwise);
+    hasher.Add(DepthBias).Add(DepthBiasClamp).Add(SlopeScaledDepthBias);
+    hasher.Add(DepthClipEnable).Add(MultisampleEnable).Add(AntialiasedLineEnable);
+    hasher.Add(ForcedSampleCount).Add(ConservativeRaster);
+
+    hasher.Add(DepthEnable).Add(DepthWriteMask).Add(DepthFunc);
+    hasher.Add(StencilEnable).Add(StencilReadMask).Add(StencilWriteMask);
+    AddStencilOp(hasher, FrontFace);
+    AddStencilOp(hasher, BackFace);
+
+    hasher.Add(InputLayout.size());
+    for (const InputElement& element : InputLayout)
+    {
+        hasher.Add(element.SemanticName).Add(element.SemanticIndex).Add(element.Format);
+        hasher.Add(element.InputSlot).Add(element.AlignedByteOffset);
+        hasher.Add(element.InputSlotClass).Add(element.InstanceDataStepRate);
+    }
+
+    hasher.Add(IBStripCutValue).Add(PrimitiveTopologyType).Add(NumRenderTargets);
+    for (const uint32_t format : RTVFormats)
+    {
+        hasher.Add(format);
+    }
+    hasher.Add(DSVFormat).Add(SampleCount).Add(SampleQuality);
+    hasher.Add(NodeMask).Add(Flags);
+    return hasher.Key();
+}
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/// 128-bit identity of a pipeline, stable across runs, so it can name pipelines stored on disk.
+struct PipelineKey
+{
+    uint64_t Low = 0;
+    uint64_t High = 0;
+
+    bool operator==(const PipelineKey& other) const = default;
+
+    /// @brief Formats the key as 32 hex digits.
+    [[nodiscard]] std::string ToString() const;
+};
+
+struct PipelineKeyHash
+{
+    size_t operator()(const PipelineKey& key) const noexcept
+    {
+        return static_cast<size_t>(key.Low);
+    }
+};
+
+/// @brief Accumulates the state of a pipeline into a PipelineKey.
+///
+/// Two lanes with different mixing functions take every 8 bytes of input. Each step is
+/// invertible in the lane state, so no input is forgotten as more follows, and two pipelines
+/// only share a key if both 64-bit halves collide. Spans and strings add their length first,
+/// so neighbouring fields cannot trade bytes. Words are read in native order, which is
+/// little-endian on every platform D3D12 runs on, so keys stay stable across runs and builds.
+class PipelineHasher final
+{
+public:
+    PipelineHasher& Add(std::span<const std::byte> bytes);
+
+    PipelineHasher& Add(std::string_view text);
+
+    /// @brief Adds a C string; nullptr hashes differently from the empty string.
+    PipelineHasher& Add(const char* text);
+
+    PipelineHasher& Add(float value)
+    {
+        return Add(std::bit_cast<uint32_t>(value));
+    }
+
+    template <typename T>
+        requires std::is_integral_v<T> || std::is_enum_v<T>
+    PipelineHasher& Add(const T value)
+    {
+        Mix(static_cast<uint64_t>(value));
+        return *this;
+    }
+
+    [[nodiscard]] PipelineKey Key() const;
+
+private:
+    void Mix(uint64_t word);
+
+    uint64_t m_low = 0x9E3779B97F4A7C15;
+    uint64_t m_high = 0xC2B2AE3D27D4EB4F;
+    uint64_t m_words = 0;
+};
+
+/// @brief The state of a graphics pipeline its key covers, with the fields of
+/// D3D12_GRAPHICS_PIPELINE_STATE_DESC in platform independent types.
+///
+/// Enums and BOOLs become uint32_t. Spans and names point into memory the caller keeps alive
+/// while computing the key, so filling one in from a D3D12 description copies no bytecode.
+struct PipelineDescription
+{
+    struct StreamOutputEntry
+    {
+        uint32_t    Stream = 0;
+        const char* SemanticName = nullptr;
+        uint32_t    SemanticIndex = 0;
+        uint8_t     StartComponent = 0;
+        uint8_t     ComponentCount = 0;
+        uint8_t     OutputSlot = 0;
+    };
+
+    struct TargetBlend
+    {
+        uint32_t BlendEnable = 0;
+        uint32_t LogicOpEnable = 0;
+        uint32_t SrcBlend = 0;
+        uint32_t DestBlend = 0;
+        uint32_t BlendOp = 0;
+        uint32_t SrcBlendAlpha = 0;
+        uint32_t DestBlendAlpha = 0;
+        uint32_t BlendOpAlpha = 0;
+        uint32_t LogicOp = 0;
+        uint8_t  RenderTargetWriteMask = 0;
+    };
+
+    struct StencilOp
+    {
+        uint32_t StencilFailOp = 0;
+        uint32_t StencilDepthFailOp = 0;
+        uint32_t StencilPassOp = 0;
+        uint32_t StencilFunc = 0;
+    };
+
+    struct InputElement
+    {
+        const char* SemanticName = nullptr;
+        uint32_t    SemanticIndex = 0;
+        uint32_t    Format = 0;
+        uint32_t    InputSlot = 0;
+        uint32_t    AlignedByteOffset = 0;
+        uint32_t    InputSlotClass = 0;
+        uint32_t    InstanceDataStepRate = 0;
+    };
+
+    static constexpr size_t StageCount = 5;
+    static constexpr size_t TargetCount = 8;
+
+    PipelineKey                                        RootSignature;
+    std::array<std::span<const std::byte>, StageCount> Shaders; ///< VS, PS, DS, HS and GS bytecode.
+
+    std::span<const StreamOutputEntry> StreamOutput;
+    std::span<const uint32_t>          StreamOutputStrides;
+    uint32_t                           RasterizedStream = 0;
+
+    uint32_t                             AlphaToCoverageEnable = 0;
+    uint32_t                             IndependentBlendEnable = 0;
+    std::array<TargetBlend, TargetCount> Blend{};
+    uint32_t                             SampleMask = 0;
+
+    uint32_t FillMode = 0;
+    uint32_t CullMode = 0;
+    uint32_t FrontCounterClockwise = 0;
+    int32_t  DepthBias = 0;
+    float    DepthBiasClamp = 0.0f;
+    float    SlopeScaledDepthBias = 0.0f;
+    uint32_t DepthClipEnable = 0;
+    uint32_t MultisampleEnable = 0;
+    uint32_t AntialiasedLineEnable = 0;
+    uint32_t ForcedSampleCount = 0;
+    uint32_t ConservativeRaster = 0;
+
+    uint32_t  DepthEnable = 0;
+    uint32_t  DepthWriteMask = 0;
+    uint32_t  DepthFunc = 0;
+    uint32_t  StencilEnable = 0;
+    uint8_t   StencilReadMask = 0;
+    uint8_t   StencilWriteMask = 0;
+    StencilOp FrontFace;
+    StencilOp BackFace;
+
+    std::span<const InputElement> InputLayout;
+
+    uint32_t                          IBStripCutValue = 0;
+    uint32_t                          PrimitiveTopologyType = 0;
+    uint32_t                          NumRenderTargets = 0;
+    std::array<uint32_t, TargetCount> RTVFormats{};
+    uint32_t                          DSVFormat = 0;
+    uint32_t                          SampleCount = 0;
+    uint32_t                          SampleQuality = 0;
+    uint32_t                          NodeMask = 0;
+    uint32_t                          Flags = 0;
+
+    /// @brief Hashes every field in declaration order, counting spans by their length.
+    [[nodiscard]] PipelineKey Key() const;
+};
@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ShadowCascades.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#include "ThreadPool.hpp"
+
+namespace
+{
+    // Multiple of four so every chunk but the last is made of whole vector groups.
+    constexpr size_t CastersPerChunk = 1024;
+
+    /// Light-space bounds of four boxes, one box per lane.
+    struct BoundsLanes
+    {
+        XMVECTOR Min[3];
+        XMVECTOR Max[3];
+    };
+
+    /// Transforms up to four boxes starting at first into light space.
+    BoundsLanes LoadLightBounds(const std::span<const BoundingBox> boxes, const size_t first, const Matrix& lightView)
+    {
+        float        center[3][4] = {};
+        float        extent[3][4] = {};
+        const size_t count = std::min<size_t>(4, boxes.size() - first);
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            const BoundingBox& box = boxes[first + lane];
+            center[0][lane] = box.Center.x;
+            center[1][lane] = box.Center.y;
+            center[2][lane] = box.Center.z;
+            extent[0][lane] = box.Extents.x;
+            extent[1][lane] = box.Extents.y;
+            extent[2][lane] = box.Extents.z;
+        }
+
+        XMVECTOR centers[3];
+        XMVECTOR extents[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            centers[axis] = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(center[axis]));
+            extents[axis] = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(extent[axis]));
+        }
+
+        // Row vectors: each output axis is a dot product with one column of the matrix,
+        // and the rotated extent is the same product with absolute values.
+        BoundsLanes lanes{};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            XMVECTOR c = XMVectorReplicate(lightView.m[3][axis]);
+            XMVECTOR e = XMVectorZero();
+            for (int input = 0; input < 3; ++input)
+            {
+                const float weight = lightView.m[input][axis];
+                c = XMVectorMultiplyAdd(centers[input], XMVectorReplicate(weight), c);
+                e = XMVectorMultiplyAdd(extents[input], XMVectorReplicate(std::abs(weight)), e);
+            }
+
+            lanes.Min[axis] = XMVectorSubtract(c, e);
+            lanes.Max[axis] = XMVectorAdd(c, e);
+        }
+
+        // Unused lanes get inverted bounds so they never overlap anything.
+        if (count < 4)
+        {
+            const XMVECTOR lane = XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f);
+            const XMVECTOR valid = XMVectorLess(lane, XMVectorReplicate(static_cast<float>(count)));
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                lanes.Min[axis] = XMVectorSelect(XMVectorReplicate(FLT_MAX), lanes.Min[axis], valid);
+                lanes.Max[axis] = XMVectorSelect(XMVectorReplicate(-FLT_MAX), lanes.Max[axis], valid);
+            }
+        }
+
+        return lanes;
+    }
+
+    /// Lane mask of boxes overlapping bounds on the first axisCount axes.
+    XMVECTOR Overlaps(const BoundsLanes& lanes, const std::array<float, 6>& bounds, const int axisCount)
+    {
+        XMVECTOR mask = XMVectorTrueInt();
+        for (int axis = 0; axis < axisCount; ++axis)
+        {
+            const XMVECTOR above = XMVectorGreaterOrEqual(lanes.Max[axis], XMVectorReplicate(bounds[2 * axis]));
+            const XMVECTOR below = XMVectorLessOrEqual(lanes.Min[axis], XMVectorReplicate(bounds[2 * axis + 1]));
+            mask = XMVectorAndInt(mask, XMVectorAndInt(above, below));
+        }
+
+        return mask;
+    }
+
+    bool AnyLane(FXMVECTOR mask)
+    {
+        return XMVector4NotEqualInt(mask, XMVectorFalseInt());
+    }
+
+    float HorizontalMin(FXMVECTOR v)
+    {
+        XMFLOAT4 lanes;
+        XMStoreFloat4(&lanes, v);
+        return std::min({lanes.x, lanes.y, lanes.z, lanes.w});
+    }
+
+    float HorizontalMax(FXMVECTOR v)
+    {
+        XMFLOAT4 lanes;
+        XMStoreFloat4(&lanes, v);
+        return std::max({lanes.x, lanes.y, lanes.z, lanes.w});
+    }
+
+    bool IsEmpty(const std::array<float, 6>& bounds)
+    {
+        return bounds[0] > bounds[1];
+    }
+} // namespace
+
+ShadowCascades::ShadowCascades(const Settings& settings)
+{
+    SetSettings(settings);
+}
+
+void ShadowCascades::SetSettings(const Settings& settings)
+{
+    if (settings.CascadeCount == 0 || settings.CascadeCount > MaxCascades)
+    {
+        throw std::invalid_argument("Cascade count must be between 1 and ShadowCascades::MaxCascades");
+    }
+
+    if (settings.ShadowMapSize <= 2)
+    {
+        throw std::invalid_argument("Shadow map size must be larger than two texels");
+    }
+
+    m_settings = settings;
+}
+
+uint32_t ShadowCascades::CascadeCount() const
+{
+    return m_settings.CascadeCount;
+}
+
+const ShadowCascade& ShadowCascades::Cascade(const uint32_t index) const
+{
+    return m_cascades[index];
+}
+
+void ShadowCascades::Plan(const Camera&                      camera,
+                          const Vector3&                     lightDirection,
+                          const std::span<const BoundingBox> receivers,
+                          const std::span<const BoundingBox> casters,
+                          ThreadPool&                        pool)
+{
+    // The light view is anchored at the origin rather than following the camera, so
+    // texel-snapped bounds stay put in light space while the camera moves.
+    Vector3 direction = lightDirection;
+    direction.Normalize();
+    const Vector3 up = std::abs(direction.y) > 0.99f ? Vector3::Forward : Vector3::Up;
+    const Matrix  lightView = Matrix::CreateLookAt(Vector3::Zero, direction, up);
+
+    ComputeSplits(camera);
+    FitReceivers(camera, lightView, receivers);
+    CullCasters(lightView, casters, pool);
+    BuildProjections(lightView);
+}
+
+void ShadowCascades::ComputeSplits(const Camera& camera)
+{
+    const float nearPlane = camera.nearPlane();
+    const float farPlane =
+        m_settings.MaxDistance > 0.0f ? std::min(m_settings.MaxDistance, camera.farPlane()) : camera.farPlane();
+    const float lambda = m_settings.SplitLambda;
+    const auto  count = static_cast<float>(m_settings.CascadeCount);
+
+    float previous = nearPlane;
+    for (uint32_t i = 0; i < m_settings.CascadeCount; ++i)
+    {
+        const float t = static_cast<float>(i + 1) / count;
+        const float logarithmic = nearPlane * std::pow(farPlane / nearPlane, t);
+        const float uniform = nearPlane + (farPlane - nearPlane) * t;
+
+        m_cascades[i].SplitNear = previous;
+        m_cascades[i].SplitFar = lambda * logarithmic + (1.0f - lambda) * uniform;
+        previous = m_cascades[i].SplitFar;
+    }
+}
+
+void ShadowCascades::FitReceivers(const Camera&                      camera,
+                                  const Matrix&                      lightView,
+                                  const std::span<const BoundingBox> receivers)
+{
+    const Matrix viewToLight = camera.view().Invert() * lightView;
+    const float  tanY = std::tan(0.5f * camera.fieldOfView());
+    const float  tanX = tanY * camera.aspectRatio();
+    const float  tanDiagonal = std::sqrt(tanX * tanX + tanY * tanY);
+
+    for (uint32_t c = 0; c < m_settings.CascadeCount; ++c)
+    {
+        ShadowCascade& cascade = m_cascades[c];
+
+        Bounds& slice = m_sliceBounds[c];
+        slice = {FLT_MAX, -FLT_MAX, FLT_MAX, -FLT_MAX, FLT_MAX, -FLT_MAX};
+        for (const float depth : {cascade.SplitNear, cascade.SplitFar})
+        {
+            for (const float sy : {-1.0f, 1.0f})
+            {
+                for (const float sx : {-1.0f, 1.0f})
+                {
+                    // Camera space is right-handed and looks down -Z.
+                    const Vector3 corner(sx * depth * tanX, sy * depth * tanY, -depth);
+                    const Vector3 light = Vector3::Transform(corner, viewToLight);
+                    slice[0] = std::min(slice[0], light.x);
+                    slice[1] = std::max(slice[1], light.x);
+                    slice[2] = std::min(slice[2], light.y);
+                    slice[3] = std::max(slice[3], light.y);
+                    slice[4] = std::min(slice[4], light.z);
+                    slice[5] = std::max(slice[5], light.z);
+                }
+            }
+        }
+
+        // The slice diameter does not change as the camera turns, so neither does the texel
+        // size. Snapping may widen the bounds by up to a texel per side, hence the two spare.
+        const float nearRadius = cascade.SplitNear * tanDiagonal;
+        const float farRadius = cascade.SplitFar * tanDiagonal;
+        const float depth = cascade.SplitFar - cascade.SplitNear;
+        const float diameter =
+            std::max(2.0f * farRadius, std::sqrt((nearRadius + farRadius) * (nearRadius + farRadius) + depth * depth));
+        cascade.TexelSize = diameter / static_cast<float>(m_settings.ShadowMapSize - 2);
+    }
+
+    XMVECTOR fitted[MaxCascades][6];
+    for (uint32_t c = 0; c < m_settings.CascadeCount; ++c)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            fitted[c][2 * axis] = XMVectorReplicate(FLT_MAX);
+            fitted[c][2 * axis + 1] = XMVectorReplicate(-FLT_MAX);
+        }
+    }
+
+    for (size_t first = 0; first < receivers.size(); first += 4)
+    {
+        const BoundsLanes lanes = LoadLightBounds(receivers, first, lightView);
+        for (uint32_t c = 0; c < m_settings.CascadeCount; ++c)
+        {
+            const Bounds&  slice = m_sliceBounds[c];
+            const XMVECTOR mask = Overlaps(lanes, slice, 3);
+            if (!AnyLane(mask))
+            {
+                continue;
+            }
+
+            // Clip to the slice so a long receiver does not stretch cascades it barely enters.
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const XMVECTOR lo = XMVectorMax(lanes.Min[axis], XMVectorReplicate(slice[2 * axis]));
+                const XMVECTOR hi = XMVectorMin(lanes.Max[axis], XMVectorReplicate(slice[2 * axis + 1]));
+                fitted[c][2 * axis] = XMVectorSelect(fitted[c][2 * axis], XMVectorMin(fitted[c][2 * axis], lo), mask);
+                fitted[c][2 * axis + 1] =
+                    XMVectorSelect(fitted[c][2 * axis + 1], XMVectorMax(fitted[c][2 * axis + 1], hi), mask);
+            }
+        }
+    }
+
+    for (uint32_t c = 0; c < m_settings.CascadeCount; ++c)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            m_receiverBounds[c][2 * axis] = HorizontalMin(fitted[c][2 * axis]);
+            m_receiverBounds[c][2 * axis + 1] = HorizontalMax(fitted[c][2 * axis + 1]);
+        }
+    }
+}
+
+void ShadowCascades::CullCasters(const Matrix&                      lightView,
+                                 const std::span<const BoundingBox> casters,
+                                 ThreadPool&                        pool)
+{
+    const uint32_t cascadeCount = m_settings.CascadeCount;
+    const size_t   chunkCount = (casters.size() + CastersPerChunk - 1) / CastersPerChunk;
+    m_chunkCasters.resize(chunkCount * MaxCascades);
+    for (auto& chunk : m_chunkCasters)
+    {
+        chunk.clear();
+    }
+
+    // A pool without workers runs everything as one range, leaving the other chunks untouched.
+    std::array<float, MaxCascades> lowest;
+    lowest.fill(-FLT_MAX);
+    m_chunkNearZ.assign(chunkCount, lowest);
+
+    pool.ParallelFor(casters.size(), CastersPerChunk, [&](const size_t begin, const size_t end, uint32_t) {
+        const size_t chunk = begin / CastersPerChunk;
+
+        XMVECTOR nearZ[MaxCascades];
+        for (uint32_t c = 0; c < cascadeCount; ++c)
+        {
+            nearZ[c] = XMVectorReplicate(-FLT_MAX);
+        }
+
+        for (size_t first = begin; first < end; first += 4)
+        {
+            const BoundsLanes lanes = LoadLightBounds(casters.first(end), first, lightView);
+            for (uint32_t c = 0; c < cascadeCount; ++c)
+            {
+                const Bounds& receivers = m_receiverBounds[c];
+                if (IsEmpty(receivers))
+                {
+                    continue;
+                }
+
+                // Light-space z grows towards the light, so casters entirely below the
+                // receivers' lowest point cannot shadow them.
+                XMVECTOR mask = Overlaps(lanes, receivers, 2);
+                mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(lanes.Max[2], XMVectorReplicate(receivers[4])));
+                if (!AnyLane(mask))
+                {
+                    continue;
+                }
+
+                nearZ[c] = XMVectorSelect(nearZ[c], XMVectorMax(nearZ[c], lanes.Max[2]), mask);
+
+                uint32_t hits[4];
+                XMStoreInt4(hits, mask);
+                auto& list = m_chunkCasters[chunk * MaxCascades + c];
+                for (uint32_t lane = 0; lane < 4; ++lane)
+                {
+                    if (hits[lane] != 0)
+                    {
+                        list.push_back(static_cast<uint32_t>(first + lane));
+                    }
+                }
+            }
+        }
+
+        for (uint32_t c = 0; c < cascadeCount; ++c)
+        {
+            m_chunkNearZ[chunk][c] = HorizontalMax(nearZ[c]);
+        }
+    });
+
+    // Merging in chunk order keeps each list sorted by caster index.
+    for (uint32_t c = 0; c < cascadeCount; ++c)
+    {
+        auto& list = m_cascades[c].Casters;
+        list.clear();
+        m_casterNearZ[c] = -FLT_MAX;
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            const auto& chunkList = m_chunkCasters[chunk * MaxCascades + c];
+            list.insert(list.end(), chunkList.begin(), chunkList.end());
+            m_casterNearZ[c] = std::max(m_casterNearZ[c], m_chunkNearZ[chunk][c]);
+        }
+    }
+}
+
+void ShadowCascades::BuildProjections(const Matrix& lightView)
+{
+    const auto mapSize = static_cast<float>(m_settings.ShadowMapSize);
+
+    for (uint32_t c = 0; c < m_settings.CascadeCount; ++c)
+    {
+        ShadowCascade& cascade = m_cascades[c];
+        const Bounds&  bounds = m_receiverBounds[c];
+        if (IsEmpty(bounds))
+        {
+            cascade.ViewProjection = Matrix::Identity;
+            cascade.ShadowTransform = Matrix::Identity;
+            cascade.ViewportWidth = 0;
+            cascade.ViewportHeight = 0;
+            continue;
+        }
+
+        const float texel = cascade.TexelSize;
+        const float minX = std::floor(bounds[0] / texel) * texel;
+        const float minY = std::floor(bounds[2] / texel) * texel;
+        cascade.ViewportWidth = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil((bounds[1] - minX) / texel)));
+        cascade.ViewportHeight = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil((bounds[3] - minY) / texel)));
+        const float maxX = minX + static_cast<float>(cascade.ViewportWidth) * texel;
+        const float maxY = minY + static_cast<float>(cascade.ViewportHeight) * texel;
+
+        // Pull the near plane up to the highest relevant caster, and pad both planes by a
+        // texel so flat receivers still get a valid depth range.
+        const float nearZ = std::max(m_casterNearZ[c], bounds[5]) + texel;
+        const float farZ = bounds[4] - texel;
+
+        // The light looks down -Z, so distances along its view are negated z values.
+        const Matrix projection = Matrix::CreateOrthographicOffCenter(minX, maxX, minY, maxY, -nearZ, -farZ);
+        cascade.ViewProjection = lightView * projection;
+
+        // Clip space to texture space, squeezed into the viewport at the top-left of the map.
+        const float  scaleX = static_cast<float>(cascade.ViewportWidth) / mapSize;
+        const float  scaleY = static_cast<float>(cascade.ViewportHeight) / mapSize;
+        const Matrix toTexture = Matrix::CreateScale(0.5f * scaleX, -0.5f * scaleY, 1.0f) *
+                                 Matrix::CreateTranslation(0.5f * scaleX, 0.5f * scaleY, 0.0f);
+        cascade.ShadowTransform = cascade.ViewProjection * toTexture;
+    }
+}
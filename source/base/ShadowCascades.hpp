@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Camera.hpp"
+#include "GraphicsMath.hpp"
+
+class ThreadPool;
+
+struct ShadowCascade
+{
+    Matrix                ViewProjection;  ///< World to clip space, used when rendering the cascade.
+    Matrix                ShadowTransform; ///< World to shadow map texture coordinates and depth.
+    float                 SplitNear = 0.0f;
+    float                 SplitFar = 0.0f;
+    float                 TexelSize = 0.0f;  ///< World-space size of one shadow map texel.
+    uint32_t              ViewportWidth = 0; ///< Texels covered from the map's top-left corner, 0 if empty.
+    uint32_t              ViewportHeight = 0;
+    std::vector<uint32_t> Casters; ///< Indices of casters that can shadow this cascade's receivers.
+};
+
+/// @brief Plans cascaded shadow maps for a directional light.
+///
+/// The camera depth range is divided with the practical split scheme, blending
+/// logarithmic and uniform distances. Each cascade's orthographic projection is then
+/// fitted to the light-space bounds of the receivers inside its slice rather than the
+/// whole slice. The texel size only depends on the slice's bounding sphere, and the
+/// bounds are snapped to whole texels, so the shadow map does not shimmer as the
+/// camera moves or turns. Because the fitted bounds are usually smaller than the map,
+/// each cascade reports the viewport it needs and its ShadowTransform already accounts
+/// for it. Casters are culled against every cascade four at a time.
+class ShadowCascades final
+{
+public:
+    static constexpr uint32_t MaxCascades = 4;
+
+    struct Settings
+    {
+        uint32_t CascadeCount = 4;
+        uint32_t ShadowMapSize = 2048; ///< Width and height of each cascade's shadow map.
+        float    SplitLambda = 0.75f;  ///< 0 gives uniform splits and 1 logarithmic splits.
+        float    MaxDistance = 0.0f;   ///< Furthest shadowed distance, 0 uses the camera far plane.
+    };
+
+    explicit ShadowCascades(const Settings& settings = {});
+
+    void SetSettings(const Settings& settings);
+
+    [[nodiscard]] uint32_t CascadeCount() const;
+
+    [[nodiscard]] const ShadowCascade& Cascade(uint32_t index) const;
+
+    /// @brief Computes splits, projections and caster lists for the current frame.
+    /// @param [in] lightDirection Direction the light travels in, need not be normalized.
+    /// @param [in] receivers World-space bounds of the visible shadow receivers.
+    /// @param [in] casters World-space bounds of all potential shadow casters.
+    /// @param [in] pool Pool used to cull casters in parallel.
+    void Plan(const Camera&                camera,
+              const Vector3&               lightDirection,
+              std::span<const BoundingBox> receivers,
+              std::span<const BoundingBox> casters,
+              ThreadPool&                  pool);
+
+private:
+    /// Light-space bounds in the order MinX, MaxX, MinY, MaxY, MinZ, MaxZ.
+    using Bounds = std::array<float, 6>;
+
+    void ComputeSplits(const Camera& camera);
+
+    void FitReceivers(const Camera& camera, const Matrix& lightView, std::span<const BoundingBox> receivers);
+
+    void CullCasters(const Matrix& lightView, std::span<const BoundingBox> casters, ThreadPool& pool);
+
+    void BuildProjections(const Matrix& lightView);
+
+    Settings                                    m_settings;
+    std::array<ShadowCascade, MaxCascades>      m_cascades;
+    std::array<Bounds, MaxCascades>             m_sliceBounds{};
+    std::array<Bounds, MaxCascades>             m_receiverBounds{};
+    std::array<float, MaxCascades>              m_casterNearZ{};
+    std::vector<std::vector<uint32_t>>          m_chunkCasters;
+    std::vector<std::array<float, MaxCascades>> m_chunkNearZ;
+};
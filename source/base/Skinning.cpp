@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Skinning.hpp"
+
+#include <cassert>
+
+#include "CpuFeatures.hpp"
+#include "SkinningKernelTable.hpp"
+#include "ThreadPool.hpp"
+
+namespace
+{
+    /// Vertices per task; large enough to amortize dispatch, small enough to balance across threads.
+    constexpr size_t GrainSize = 2048;
+
+    const SkinningKernelTable& SelectKernels()
+    {
+#ifdef TRANSFORM_KERNELS_X64
+        switch (SelectedSimdLevel())
+        {
+        case SimdLevel::AVX512:
+        case SimdLevel::AVX2:
+            return Avx2SkinningKernels;
+        default:
+            break;
+        }
+#endif
+        return GenericSkinningKernels;
+    }
+
+    const SkinningKernelTable& Kernels()
+    {
+        static const SkinningKernelTable& kernels = SelectKernels();
+        return kernels;
+    }
+} // namespace
+
+void ComputeDualQuaternions(const std::span<const Matrix> palette, std::vector<float>& dualQuaternions)
+{
+    dualQuaternions.resize(palette.size() * DualQuaternionStride);
+    for (size_t joint = 0; joint < palette.size(); ++joint)
+    {
+        Matrix     matrix = palette[joint];
+        Vector3    scale;
+        Quaternion rotation;
+        Vector3    translation;
+        matrix.Decompose(scale, rotation, translation);
+
+        // dual = 0.5 * (0, translation) * rotation
+        const XMVECTOR real = XMLoadFloat4(&rotation);
+        const XMVECTOR t = XMLoadFloat3(&translation);
+        const XMVECTOR vector = XMVectorMultiplyAdd(XMVectorSplatW(real), t, XMVector3Cross(t, real));
+        const XMVECTOR dual = XMVectorScale(XMVectorSetW(vector, -XMVectorGetX(XMVector3Dot(t, real))), 0.5f);
+
+        float* target = dualQuaternions.data() + joint * DualQuaternionStride;
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(target), real);
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(target + 4), dual);
+    }
+}
+
+SkinnedMeshStreams SkinnedMesh::Streams() const
+{
+    const size_t count = VertexCount();
+    const auto   planes = [count](const std::vector<float>& values) -> ConstVector3Stream {
+        if (values.empty())
+        {
+            return {};
+        }
+        return {values.data(), values.data() + count, values.data() + count * 2};
+    };
+
+    SkinnedMeshStreams streams;
+    streams.VertexCount = count;
+    streams.Positions = planes(Positions);
+    streams.Normals = planes(Normals);
+    streams.Tangents = planes(Tangents);
+    streams.Joints = Joints.data();
+    streams.Weights = Weights.data();
+    return streams;
+}
+
+const char* CpuSkinner::PathName()
+{
+    return Kernels().Name;
+}
+
+void CpuSkinner::Skin(const SkinnedMeshStreams&     mesh,
+                      const std::span<const Matrix> palette,
+                      const SkinningMethod          method,
+                      const SkinnedVertexStreams&   output,
+                      ThreadPool&                   pool)
+{
+    assert(output.Positions.X != nullptr && !palette.empty());
+    assert((output.Normals.X == nullptr || mesh.Normals.X != nullptr) &&
+           (output.Tangents.X == nullptr || mesh.Tangents.X != nullptr));
+
+    const SkinningKernelTable& kernels = Kernels();
+    if (method == SkinningMethod::Linear)
+    {
+        pool.ParallelFor(mesh.VertexCount, GrainSize, [&](const size_t begin, const size_t end, uint32_t) {
+            kernels.SkinLinear(mesh, begin, end, palette.data(), output);
+        });
+        return;
+    }
+
+    // The palette is converted once per call, so the kernels only blend and apply dual quaternions.
+    ComputeDualQuaternions(palette, m_dualQuaternions);
+
+    pool.ParallelFor(mesh.VertexCount, GrainSize, [&](const size_t begin, const size_t end, uint32_t) {
+        kernels.SkinDualQuaternion(mesh, begin, end, m_dualQuaternions.data(), output);
+    });
+}
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "GraphicsMath.hpp"
+#include "TransformKernels.hpp"
+
+class ThreadPool;
+
+/// @brief Read-only vertex streams of a skinned mesh.
+///
+/// Every attribute is stored as planes of VertexCount elements: x, y and z for the
+/// vectors, and influence 0 to 3 for the joints and weights. The joint and weight of
+/// influence i of vertex v are at [i * VertexCount + v], and weights sum to one.
+/// Unused influences have a weight of zero but must still name a valid joint.
+struct SkinnedMeshStreams
+{
+    size_t             VertexCount = 0;
+    ConstVector3Stream Positions = {};
+    ConstVector3Stream Normals = {};  ///< Optional, X is null when absent.
+    ConstVector3Stream Tangents = {}; ///< Optional, X is null when absent.
+    const uint16_t*    Joints = nullptr;
+    const float*       Weights = nullptr;
+};
+
+/// @brief Destination of skinned vertices, e.g. planes of a mapped upload buffer.
+///
+/// Element v of each stream receives vertex v. Streams whose X is null are skipped.
+/// The memory is only written, never read, so write-combined memory is fine.
+struct SkinnedVertexStreams
+{
+    Vector3Stream Positions = {};
+    Vector3Stream Normals = {};
+    Vector3Stream Tangents = {};
+};
+
+/// Vertex data of a skinned mesh primitive in the planar layout of SkinnedMeshStreams.
+struct SkinnedMesh
+{
+    std::vector<float>    Positions;
+    std::vector<float>    Normals;  ///< Empty when the mesh has none.
+    std::vector<float>    Tangents; ///< Empty when the mesh has none. Handedness is not stored.
+    std::vector<uint16_t> Joints;
+    std::vector<float>    Weights;
+    std::vector<uint32_t> Indices;
+
+    [[nodiscard]] size_t VertexCount() const
+    {
+        return Positions.size() / 3;
+    }
+
+    [[nodiscard]] SkinnedMeshStreams Streams() const;
+};
+
+enum class SkinningMethod : uint8_t
+{
+    Linear,         ///< Blends matrices; cheapest, but joints collapse when twisted.
+    DualQuaternion, ///< Blends rigid transforms; keeps volume, but ignores scale in the palette.
+};
+
+/// @brief Skins vertices on the CPU for tools, picking and platforms without GPU skinning.
+///
+/// The vertices are split into ranges across the pool, and each range runs a kernel
+/// that skins 8 vertices at once when AVX2 is available. Normals and tangents are
+/// renormalized after skinning.
+class CpuSkinner final
+{
+public:
+    /// @brief Gets the name of the instruction set the kernels dispatch to.
+    [[nodiscard]] static const char* PathName();
+
+    /// @param [in] palette Skinning matrices, e.g. from AnimationSampler::ComputePalette.
+    /// @param [out] output Streams with room for mesh.VertexCount elements.
+    void Skin(const SkinnedMeshStreams&   mesh,
+              std::span<const Matrix>     palette,
+              SkinningMethod              method,
+              const SkinnedVertexStreams& output,
+              ThreadPool&                 pool);
+
+private:
+    std::vector<float> m_dualQuaternions;
+};
@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Skinning.hpp"
+#include "TransformKernelTable.hpp"
+
+/// Floats per joint in a dual quaternion palette: the rotation xyzw, then the dual part xyzw.
+constexpr size_t DualQuaternionStride = 8;
+
+/// One implementation of the skinning kernels for a particular instruction set.
+/// Each kernel skins vertices [begin, end) of the mesh.
+struct SkinningKernelTable
+{
+    const char* Name;
+    void (*SkinLinear)(const SkinnedMeshStreams&   mesh,
+                       size_t                      begin,
+                       size_t                      end,
+                       const Matrix*               palette,
+                       const SkinnedVertexStreams& output);
+    void (*SkinDualQuaternion)(const SkinnedMeshStreams&   mesh,
+                               size_t                      begin,
+                               size_t                      end,
+                               const float*                dualQuaternions,
+                               const SkinnedVertexStreams& output);
+};
+
+/// @brief Converts skinning matrices to the palette SkinDualQuaternion reads, ignoring their scale.
+void ComputeDualQuaternions(std::span<const Matrix> palette, std::vector<float>& dualQuaternions);
+
+/// DirectXMath implementation, one vertex at a time.
+extern const SkinningKernelTable GenericSkinningKernels;
+
+#ifdef TRANSFORM_KERNELS_X64
+extern const SkinningKernelTable Avx2SkinningKernels;
+#endif
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SkinningKernelTable.hpp"
+
+#ifdef TRANSFORM_KERNELS_X64
+
+#include <immintrin.h>
+
+#define AVX2_TARGET KERNEL_TARGET("avx2,fma")
+
+static_assert(sizeof(Matrix) == 16 * sizeof(float));
+
+namespace
+{
+    constexpr size_t Width = 8;
+    constexpr size_t InfluenceCount = 4;
+
+    /// Eight vectors, one per lane.
+    struct Lanes3
+    {
+        __m256 X;
+        __m256 Y;
+        __m256 Z;
+    };
+
+    AVX2_TARGET Lanes3 Load(const ConstVector3Stream stream, const size_t index)
+    {
+        return {_mm256_loadu_ps(stream.X + index), _mm256_loadu_ps(stream.Y + index),
+                _mm256_loadu_ps(stream.Z + index)};
+    }
+
+    AVX2_TARGET void Store(const Vector3Stream stream, const size_t index, const Lanes3& value)
+    {
+        _mm256_storeu_ps(stream.X + index, value.X);
+        _mm256_storeu_ps(stream.Y + index, value.Y);
+        _mm256_storeu_ps(stream.Z + index, value.Z);
+    }
+
+    AVX2_TARGET Lanes3 Normalize(const Lanes3& v)
+    {
+        __m256 lengthSquared = _mm256_mul_ps(v.X, v.X);
+        lengthSquared = _mm256_fmadd_ps(v.Y, v.Y, lengthSquared);
+        lengthSquared = _mm256_fmadd_ps(v.Z, v.Z, lengthSquared);
+
+        const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+        return {_mm256_mul_ps(v.X, inverseLength), _mm256_mul_ps(v.Y, inverseLength),
+                _mm256_mul_ps(v.Z, inverseLength)};
+    }
+
+    AVX2_TARGET Lanes3 Cross(const Lanes3& a, const Lanes3& b)
+    {
+        return {_mm256_fmsub_ps(a.Y, b.Z, _mm256_mul_ps(a.Z, b.Y)), _mm256_fmsub_ps(a.Z, b.X, _mm256_mul_ps(a.X, b.Z)),
+                _mm256_fmsub_ps(a.X, b.Y, _mm256_mul_ps(a.Y, b.X))};
+    }
+
+    /// Joint indices of one influence of eight vertices, scaled to float offsets into the palette.
+    AVX2_TARGET __m256i LoadOffsets(const uint16_t* joints, const int shift)
+    {
+        const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(joints));
+        return _mm256_slli_epi32(_mm256_cvtepu16_epi32(indices), shift);
+    }
+
+    template <bool Translate>
+    AVX2_TARGET Lanes3 Transform(const __m256 (&m)[4][3], const Lanes3& v)
+    {
+        __m256 r[3];
+        for (int column = 0; column < 3; ++column)
+        {
+            r[column] = Translate ? m[3][column] : _mm256_setzero_ps();
+            r[column] = _mm256_fmadd_ps(v.X, m[0][column], r[column]);
+            r[column] = _mm256_fmadd_ps(v.Y, m[1][column], r[column]);
+            r[column] = _mm256_fmadd_ps(v.Z, m[2][column], r[column]);
+        }
+        return {r[0], r[1], r[2]};
+    }
+
+    AVX2_TARGET void SkinLinear(const SkinnedMeshStreams&   mesh,
+                                const size_t                begin,
+                                const size_t                end,
+                                const Matrix*               palette,
+                                const SkinnedVertexStreams& output)
+    {
+        const size_t count = mesh.VertexCount;
+        const float* elements = &palette[0].m[0][0];
+
+        size_t v = begin;
+        for (; v + Width <= end; v += Width)
+        {
+            // Weighted sum of the upper 4x3 of each influence's matrix, one vertex per lane.
+            __m256 m[4][3];
+            for (auto& row : m)
+            {
+                for (__m256& element : row)
+                {
+                    element = _mm256_setzero_ps();
+                }
+            }
+
+            for (size_t i = 0; i < InfluenceCount; ++i)
+            {
+                const __m256i offsets = LoadOffsets(mesh.Joints + i * count + v, 4);
+                const __m256  weight = _mm256_loadu_ps(mesh.Weights + i * count + v);
+                for (int row = 0; row < 4; ++row)
+                {
+                    for (int column = 0; column < 3; ++column)
+                    {
+                        const __m256 element = _mm256_i32gather_ps(elements + row * 4 + column, offsets, 4);
+                        m[row][column] = _mm256_fmadd_ps(element, weight, m[row][column]);
+                    }
+                }
+            }
+
+            Store(output.Positions, v, Transform<true>(m, Load(mesh.Positions, v)));
+            if (output.Normals.X != nullptr)
+            {
+                Store(output.Normals, v, Normalize(Transform<false>(m, Load(mesh.Normals, v))));
+            }
+            if (output.Tangents.X != nullptr)
+            {
+                Store(output.Tangents, v, Normalize(Transform<false>(m, Load(mesh.Tangents, v))));
+            }
+        }
+
+        GenericSkinningKernels.SkinLinear(mesh, v, end, palette, output);
+    }
+
+    /// Rotates v by unit quaternions: v + 2 * q.xyz x (q.xyz x v + q.w * v).
+    AVX2_TARGET Lanes3 Rotate(const Lanes3& real, const __m256 realW, const Lanes3& v)
+    {
+        const Lanes3 cross = Cross(real, v);
+        const Lanes3 inner = {_mm256_fmadd_ps(realW, v.X, cross.X), _mm256_fmadd_ps(realW, v.Y, cross.Y),
+                              _mm256_fmadd_ps(realW, v.Z, cross.Z)};
+        const Lanes3 outer = Cross(real, inner);
+
+        const __m256 two = _mm256_set1_ps(2.0f);
+        return {_mm256_fmadd_ps(outer.X, two, v.X), _mm256_fmadd_ps(outer.Y, two, v.Y),
+                _mm256_fmadd_ps(outer.Z, two, v.Z)};
+    }
+
+    AVX2_TARGET void SkinDualQuaternion(const SkinnedMeshStreams&   mesh,
+                                        const size_t                begin,
+                                        const size_t                end,
+                                        const float*                dualQuaternions,
+                                        const SkinnedVertexStreams& output)
+    {
+        static_assert(DualQuaternionStride == 8);
+
+        const size_t count = mesh.VertexCount;
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+        size_t v = begin;
+        for (; v + Width <= end; v += Width)
+        {
+            __m256 pivot[4];
+            __m256 real[4];
+            __m256 dual[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                real[k] = _mm256_setzero_ps();
+                dual[k] = _mm256_setzero_ps();
+            }
+
+            for (size_t i = 0; i < InfluenceCount; ++i)
+            {
+                const __m256i offsets = LoadOffsets(mesh.Joints + i * count + v, 3);
+                __m256        weight = _mm256_loadu_ps(mesh.Weights + i * count + v);
+
+                __m256 jointReal[4];
+                __m256 jointDual[4];
+                for (int k = 0; k < 4; ++k)
+                {
+                    jointReal[k] = _mm256_i32gather_ps(dualQuaternions + k, offsets, 4);
+                    jointDual[k] = _mm256_i32gather_ps(dualQuaternions + 4 + k, offsets, 4);
+                }
+
+                // Blend every influence in the hemisphere of the first one.
+                if (i == 0)
+                {
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        pivot[k] = jointReal[k];
+                    }
+                }
+                else
+                {
+                    __m256 dot = _mm256_mul_ps(jointReal[0], pivot[0]);
+                    for (int k = 1; k < 4; ++k)
+                    {
+                        dot = _mm256_fmadd_ps(jointReal[k], pivot[k], dot);
+                    }
+                    weight = _mm256_xor_ps(weight, _mm256_and_ps(dot, signMask));
+                }
+
+                for (int k = 0; k < 4; ++k)
+                {
+                    real[k] = _mm256_fmadd_ps(jointReal[k], weight, real[k]);
+                    dual[k] = _mm256_fmadd_ps(jointDual[k], weight, dual[k]);
+                }
+            }
+
+            __m256 lengthSquared = _mm256_mul_ps(real[0], real[0]);
+            for (int k = 1; k < 4; ++k)
+            {
+                lengthSquared = _mm256_fmadd_ps(real[k], real[k], lengthSquared);
+            }
+            const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+            for (int k = 0; k < 4; ++k)
+            {
+                real[k] = _mm256_mul_ps(real[k], inverseLength);
+                dual[k] = _mm256_mul_ps(dual[k], inverseLength);
+            }
+
+            // translation = 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz)
+            const Lanes3 realXyz = {real[0], real[1], real[2]};
+            const Lanes3 dualXyz = {dual[0], dual[1], dual[2]};
+            const Lanes3 cross = Cross(realXyz, dualXyz);
+            const __m256 crossLanes[3] = {cross.X, cross.Y, cross.Z};
+            const __m256 two = _mm256_set1_ps(2.0f);
+
+            __m256 translation[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                const __m256 scaledDual = _mm256_fmadd_ps(real[3], dual[k], crossLanes[k]);
+                translation[k] = _mm256_mul_ps(_mm256_fnmadd_ps(dual[3], real[k], scaledDual), two);
+            }
+
+            const Lanes3 position = Rotate(realXyz, real[3], Load(mesh.Positions, v));
+            Store(output.Positions, v,
+                  {_mm256_add_ps(position.X, translation[0]), _mm256_add_ps(position.Y, translation[1]),
+                   _mm256_add_ps(position.Z, translation[2])});
+            if (output.Normals.X != nullptr)
+            {
+                Store(output.Normals, v, Normalize(Rotate(realXyz, real[3], Load(mesh.Normals, v))));
+            }
+            if (output.Tangents.X != nullptr)
+            {
+                Store(output.Tangents, v, Normalize(Rotate(realXyz, real[3], Load(mesh.Tangents, v))));
+            }
+        }
+
+        GenericSkinningKernels.SkinDualQuaternion(mesh, v, end, dualQuaternions, output);
+    }
+} // namespace
+
+const SkinningKernelTable Avx2SkinningKernels = {
+    "AVX2",
+    SkinLinear,
+    SkinDualQuaternion,
+};
+
+#endif
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SkinningKernelTable.hpp"
+
+namespace
+{
+    constexpr size_t InfluenceCount = 4;
+
+    XMVECTOR Load(const ConstVector3Stream stream, const size_t index)
+    {
+        return XMVectorSet(stream.X[index], stream.Y[index], stream.Z[index], 0.0f);
+    }
+
+    void Store(const Vector3Stream stream, const size_t index, const FXMVECTOR value)
+    {
+        stream.X[index] = XMVectorGetX(value);
+        stream.Y[index] = XMVectorGetY(value);
+        stream.Z[index] = XMVectorGetZ(value);
+    }
+
+    /// Rotates v by a unit quaternion: v + 2 * q.xyz x (q.xyz x v + q.w * v).
+    XMVECTOR Rotate(const FXMVECTOR real, const FXMVECTOR v)
+    {
+        const XMVECTOR inner = XMVectorMultiplyAdd(XMVectorSplatW(real), v, XMVector3Cross(real, v));
+        return XMVectorAdd(v, XMVectorScale(XMVector3Cross(real, inner), 2.0f));
+    }
+
+    void SkinLinear(const SkinnedMeshStreams&   mesh,
+                    const size_t                begin,
+                    const size_t                end,
+                    const Matrix*               palette,
+                    const SkinnedVertexStreams& output)
+    {
+        const size_t count = mesh.VertexCount;
+        for (size_t v = begin; v < end; ++v)
+        {
+            XMMATRIX blended(XMVectorZero(), XMVectorZero(), XMVectorZero(), XMVectorZero());
+            for (size_t i = 0; i < InfluenceCount; ++i)
+            {
+                const float weight = mesh.Weights[i * count + v];
+                if (weight == 0.0f)
+                {
+                    continue;
+                }
+
+                const XMMATRIX joint = XMLoadFloat4x4(&palette[mesh.Joints[i * count + v]]);
+                const XMVECTOR w = XMVectorReplicate(weight);
+                for (int row = 0; row < 4; ++row)
+                {
+                    blended.r[row] = XMVectorMultiplyAdd(joint.r[row], w, blended.r[row]);
+                }
+            }
+
+            Store(output.Positions, v, XMVector3Transform(Load(mesh.Positions, v), blended));
+            if (output.Normals.X != nullptr)
+            {
+                Store(output.Normals, v, XMVector3Normalize(XMVector3TransformNormal(Load(mesh.Normals, v), blended)));
+            }
+            if (output.Tangents.X != nullptr)
+            {
+                Store(output.Tangents, v,
+                      XMVector3Normalize(XMVector3TransformNormal(Load(mesh.Tangents, v), blended)));
+            }
+        }
+    }
+
+    void SkinDualQuaternion(const SkinnedMeshStreams&   mesh,
+                            const size_t                begin,
+                            const size_t                end,
+                            const float*                dualQuaternions,
+                            const SkinnedVertexStreams& output)
+    {
+        const size_t count = mesh.VertexCount;
+        for (size_t v = begin; v < end; ++v)
+        {
+            const float*   first = dualQuaternions + mesh.Joints[v] * DualQuaternionStride;
+            const XMVECTOR pivot = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(first));
+
+            XMVECTOR real = XMVectorZero();
+            XMVECTOR dual = XMVectorZero();
+            for (size_t i = 0; i < InfluenceCount; ++i)
+            {
+                const float*   joint = dualQuaternions + mesh.Joints[i * count + v] * DualQuaternionStride;
+                const XMVECTOR jointReal = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(joint));
+                const XMVECTOR jointDual = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(joint + 4));
+
+                // Blend every influence in the hemisphere of the first one.
+                float weight = mesh.Weights[i * count + v];
+                if (XMVectorGetX(XMVector4Dot(jointReal, pivot)) < 0.0f)
+                {
+                    weight = -weight;
+                }
+
+                const XMVECTOR w = XMVectorReplicate(weight);
+                real = XMVectorMultiplyAdd(jointReal, w, real);
+                dual = XMVectorMultiplyAdd(jointDual, w, dual);
+            }
+
+            const XMVECTOR inverseLength = XMVectorReciprocalSqrt(XMVector4Dot(real, real));
+            real = XMVectorMultiply(real, inverseLength);
+            dual = XMVectorMultiply(dual, inverseLength);
+
+            // translation = 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz)
+            XMVECTOR translation = XMVectorMultiply(XMVectorSplatW(real), dual);
+            translation = XMVectorNegativeMultiplySubtract(XMVectorSplatW(dual), real, translation);
+            translation = XMVectorScale(XMVectorAdd(translation, XMVector3Cross(real, dual)), 2.0f);
+
+            Store(output.Positions, v, XMVectorAdd(Rotate(real, Load(mesh.Positions, v)), translation));
+            if (output.Normals.X != nullptr)
+            {
+                Store(output.Normals, v, XMVector3Normalize(Rotate(real, Load(mesh.Normals, v))));
+            }
+            if (output.Tangents.X != nullptr)
+            {
+                Store(output.Tangents, v, XMVector3Normalize(Rotate(real, Load(mesh.Tangents, v))));
+            }
+        }
+    }
+} // namespace
+
+const SkinningKernelTable GenericSkinningKernels = {
+#if defined(_XM_ARM_NEON_INTRINSICS_)
+    "NEON",
+#elif defined(_XM_NO_INTRINSICS_)
+    "Scalar",
+#else
+    "SSE2",
+#endif
+    SkinLinear,
+    SkinDualQuaternion,
+};
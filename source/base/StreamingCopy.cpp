@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StreamingCopy.hpp"
+
+#include <cassert>
+
+#include "CpuFeatures.hpp"
+#include "StreamingCopyKernelTable.hpp"
+
+namespace
+{
+    const StreamingCopyKernelTable& SelectKernels()
+    {
+#ifdef TRANSFORM_KERNELS_X64
+        switch (SelectedSimdLevel())
+        {
+        case SimdLevel::AVX512:
+        case SimdLevel::AVX2:
+            return Avx2StreamingCopyKernels;
+        case SimdLevel::SSE41:
+        case SimdLevel::SSE2:
+            return Sse2StreamingCopyKernels;
+        default:
+            break;
+        }
+#elif defined(STREAMING_COPY_NEON)
+        if (SelectedSimdLevel() == SimdLevel::NEON)
+        {
+            return NeonStreamingCopyKernels;
+        }
+#endif
+        return GenericStreamingCopyKernels;
+    }
+
+    const StreamingCopyKernelTable& Kernels()
+    {
+        static const StreamingCopyKernelTable& kernels = SelectKernels();
+        return kernels;
+    }
+} // namespace
+
+namespace StreamingCopy
+{
+    const char* PathName()
+    {
+        return Kernels().Name;
+    }
+
+    void Copy(void* destination, const void* source, const size_t size)
+    {
+        auto*       to = static_cast<uint8_t*>(destination);
+        const auto* from = static_cast<const uint8_t*>(source);
+        assert(to + size <= from || from + size <= to);
+        Kernels().Copy(to, from, size);
+    }
+
+    void Fence()
+    {
+        Kernels().Fence();
+    }
+} // namespace StreamingCopy
@@ -0,0 +1,29 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+/// @brief Copies into memory the CPU writes but never reads, such as mapped upload heap pages.
+///
+/// Upload heaps are write-combined, so the copy must write whole lines in order and never
+/// read the destination. The vector paths use non-temporal stores, which also keep the
+/// data out of the CPU caches where it would only evict the working set. The destination
+/// is brought to the vector alignment with naturally aligned scalar stores, and the tail
+/// is written the same way. The path comes from SelectedSimdLevel the first time a copy
+/// runs. Streaming stores are weakly ordered, so call Fence() once after the copies of a
+/// frame and before submitting the command lists that read them; a fence per copy would
+/// wait for every line to reach memory. The ranges must not overlap.
+namespace StreamingCopy
+{
+    /// @brief Gets the name of the instruction set the copies use.
+    [[nodiscard]] const char* PathName();
+
+    void Copy(void* destination, const void* source, size_t size);
+
+    /// @brief Makes every copy made so far by this thread visible to other threads and the GPU.
+    void Fence();
+} // namespace StreamingCopy
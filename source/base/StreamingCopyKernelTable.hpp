@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "TransformKernelTable.hpp"
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+#define STREAMING_COPY_NEON
+#endif
+
+/// One implementation of the streaming copy for a particular instruction set.
+struct StreamingCopyKernelTable
+{
+    const char* Name;
+    void (*Copy)(uint8_t* destination, const uint8_t* source, size_t size);
+    void (*Fence)();
+};
+
+/// Plain 64-bit stores, for targets without a vector path.
+extern const StreamingCopyKernelTable GenericStreamingCopyKernels;
+
+#ifdef TRANSFORM_KERNELS_X64
+extern const StreamingCopyKernelTable Sse2StreamingCopyKernels;
+extern const StreamingCopyKernelTable Avx2StreamingCopyKernels;
+#endif
+
+#ifdef STREAMING_COPY_NEON
+extern const StreamingCopyKernelTable NeonStreamingCopyKernels;
+#endif
+
+/// @brief Copies size bytes if width is one of its bits, then moves past them.
+template <size_t width>
+inline void CopyIfSet(uint8_t*& destination, const uint8_t*& source, const size_t size)
+{
+    if ((size & width) != 0)
+    {
+        std::memcpy(destination, source, width);
+        destination += width;
+        source += width;
+    }
+}
+
+/// @brief Copies the head bytes that bring the destination to a multiple of 16, narrowest first.
+///
+/// Pass the distance to the alignment; each store is then naturally aligned.
+inline void CopyHead(uint8_t* destination, const uint8_t* source, const size_t head)
+{
+    CopyIfSet<1>(destination, source, head);
+    CopyIfSet<2>(destination, source, head);
+    CopyIfSet<4>(destination, source, head);
+    CopyIfSet<8>(destination, source, head);
+}
+
+/// @brief Copies fewer than 16 bytes, widest first.
+///
+/// After an aligned block each store is naturally aligned.
+inline void CopyTail(uint8_t* destination, const uint8_t* source, const size_t size)
+{
+    CopyIfSet<8>(destination, source, size);
+    CopyIfSet<4>(destination, source, size);
+    CopyIfSet<2>(destination, source, size);
+    CopyIfSet<1>(destination, source, size);
+}
+
+/// Bytes from address to the next multiple of alignment, which must be a power of two.
+inline size_t DistanceToAlignment(const void* address, const size_t alignment)
+{
+    return (alignment - (reinterpret_cast<uintptr_t>(address) & (alignment - 1))) & (alignment - 1);
+}
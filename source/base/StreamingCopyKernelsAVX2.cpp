@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StreamingCopyKernelTable.hpp"
+
+#ifdef TRANSFORM_KERNELS_X64
+
+#include <immintrin.h>
+
+#define AVX2_TARGET KERNEL_TARGET("avx2")
+
+namespace
+{
+    constexpr size_t Width = 32;
+    constexpr size_t HalfWidth = 16;
+
+    AVX2_TARGET void Copy(uint8_t* destination, const uint8_t* source, size_t size)
+    {
+        if (size >= HalfWidth)
+        {
+            const size_t head = DistanceToAlignment(destination, HalfWidth);
+            CopyHead(destination, source, head);
+            destination += head;
+            source += head;
+            size -= head;
+        }
+        if (size >= Width && DistanceToAlignment(destination, Width) != 0)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(destination),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+            destination += HalfWidth;
+            source += HalfWidth;
+            size -= HalfWidth;
+        }
+
+        // Two full 64-byte lines per iteration.
+        for (; size >= 4 * Width; size -= 4 * Width, destination += 4 * Width, source += 4 * Width)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + Width));
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 2 * Width));
+            const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 3 * Width));
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(destination), a);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(destination + Width), b);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(destination + 2 * Width), c);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(destination + 3 * Width), d);
+        }
+        for (; size >= Width; size -= Width, destination += Width, source += Width)
+        {
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(destination),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+        }
+        if (size >= HalfWidth)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(destination),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+            destination += HalfWidth;
+            source += HalfWidth;
+            size -= HalfWidth;
+        }
+        CopyTail(destination, source, size);
+    }
+
+    void Fence()
+    {
+        _mm_sfence();
+    }
+} // namespace
+
+const StreamingCopyKernelTable Avx2StreamingCopyKernels = {
+    "AVX2",
+    Copy,
+    Fence,
+};
+
+#endif
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StreamingCopyKernelTable.hpp"
+
+#include <atomic>
+
+namespace
+{
+    constexpr size_t Width = sizeof(uint64_t);
+
+    /// Without streaming stores, aligned 64-bit stores in address order still let the
+    /// write-combining buffers fill whole lines, and the destination is never read.
+    void Copy(uint8_t* destination, const uint8_t* source, size_t size)
+    {
+        if (size >= Width)
+        {
+            const size_t head = DistanceToAlignment(destination, Width);
+            CopyHead(destination, source, head);
+            destination += head;
+            source += head;
+            size -= head;
+        }
+
+        for (; size >= 4 * Width; size -= 4 * Width, destination += 4 * Width, source += 4 * Width)
+        {
+            uint64_t words[4];
+            std::memcpy(words, source, sizeof(words));
+            std::memcpy(destination, words, sizeof(words));
+        }
+        for (; size >= Width; size -= Width, destination += Width, source += Width)
+        {
+            std::memcpy(destination, source, Width);
+        }
+        CopyTail(destination, source, size);
+    }
+
+    /// Stores to write-combined memory are weakly ordered even without the streaming hint,
+    /// and only a full fence orders them on every target.
+    void Fence()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+} // namespace
+
+const StreamingCopyKernelTable GenericStreamingCopyKernels = {
+    "Scalar",
+    Copy,
+    Fence,
+};
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StreamingCopyKernelTable.hpp"
+
+#ifdef STREAMING_COPY_NEON
+
+#include <arm_neon.h>
+
+namespace
+{
+    constexpr size_t Width = 16;
+
+    /// Stores a pair of registers with STNP, the non-temporal hint. MSVC has no intrinsic for
+    /// it, so there the pair is stored normally.
+    inline void StorePair(uint8_t* destination, const uint8x16_t a, const uint8x16_t b)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("stnp %q[a], %q[b], [%[destination]]"
+                     :
+                     : [a] "w"(a), [b] "w"(b), [destination] "r"(destination)
+                     : "memory");
+#else
+        vst1q_u8(destination, a);
+        vst1q_u8(destination + Width, b);
+#endif
+    }
+
+    void Copy(uint8_t* destination, const uint8_t* source, size_t size)
+    {
+        if (size >= Width)
+        {
+            const size_t head = DistanceToAlignment(destination, Width);
+            CopyHead(destination, source, head);
+            destination += head;
+            source += head;
+            size -= head;
+        }
+
+        for (; size >= 4 * Width; size -= 4 * Width, destination += 4 * Width, source += 4 * Width)
+        {
+            const uint8x16_t a = vld1q_u8(source);
+            const uint8x16_t b = vld1q_u8(source + Width);
+            const uint8x16_t c = vld1q_u8(source + 2 * Width);
+            const uint8x16_t d = vld1q_u8(source + 3 * Width);
+            StorePair(destination, a, b);
+            StorePair(destination + 2 * Width, c, d);
+        }
+        for (; size >= Width; size -= Width, destination += Width, source += Width)
+        {
+            vst1q_u8(destination, vld1q_u8(source));
+        }
+        CopyTail(destination, source, size);
+    }
+
+    /// Waits for stores to reach the outer shareable domain, which the GPU is part of.
+    void Fence()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("dmb oshst" : : : "memory");
+#else
+        __dmb(_ARM64_BARRIER_OSHST);
+#endif
+    }
+} // namespace
+
+const StreamingCopyKernelTable NeonStreamingCopyKernels = {
+    "NEON",
+    Copy,
+    Fence,
+};
+
+#endif
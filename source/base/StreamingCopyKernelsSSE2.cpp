@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StreamingCopyKernelTable.hpp"
+
+#ifdef TRANSFORM_KERNELS_X64
+
+#include <emmintrin.h>
+
+namespace
+{
+    constexpr size_t Width = 16;
+
+    void Copy(uint8_t* destination, const uint8_t* source, size_t size)
+    {
+        if (size >= Width)
+        {
+            const size_t head = DistanceToAlignment(destination, Width);
+            CopyHead(destination, source, head);
+            destination += head;
+            source += head;
+            size -= head;
+        }
+
+        // A full 64-byte line per iteration, so each write-combining buffer flushes once.
+        for (; size >= 4 * Width; size -= 4 * Width, destination += 4 * Width, source += 4 * Width)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + Width));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 2 * Width));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 3 * Width));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(destination), a);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(destination + Width), b);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(destination + 2 * Width), c);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(destination + 3 * Width), d);
+        }
+        for (; size >= Width; size -= Width, destination += Width, source += Width)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(destination),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+        }
+        CopyTail(destination, source, size);
+    }
+
+    void Fence()
+    {
+        _mm_sfence();
+    }
+} // namespace
+
+const StreamingCopyKernelTable Sse2StreamingCopyKernels = {
+    "SSE2",
+    Copy,
+    Fence,
+};
+
+#endif
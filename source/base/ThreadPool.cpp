@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    /// Pool whose chunks the current thread is running, so nested calls can be detected.
+    thread_local const ThreadPool* t_runningPool = nullptr;
+    thread_local uint32_t          t_threadIndex = 0;
+} // namespace
+
+ThreadPool::ThreadPool(int32_t workerCount)
+{
+    if (workerCount < 0)
+    {
+        const auto hardwareThreads = static_cast<int32_t>(std::thread::hardware_concurrency());
+        workerCount = std::max(hardwareThreads - 1, 0);
+    }
+
+    m_workers.reserve(workerCount);
+    for (int32_t i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&ThreadPool::WorkerMain, this, static_cast<uint32_t>(i + 1));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+uint32_t ThreadPool::ThreadCount() const
+{
+    return static_cast<uint32_t>(m_workers.size()) + 1;
+}
+
+uint32_t ThreadPool::WorkerCount() const
+{
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+void ThreadPool::ParallelFor(const size_t count, size_t grainSize, const RangeFunction& function)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    if (t_runningPool == this)
+    {
+        // Called from one of our own chunks: the workers are busy with the outer call, so
+        // waiting for them would deadlock. Run the whole range on this thread instead.
+        function(0, count, t_threadIndex);
+        return;
+    }
+    if (m_workers.empty() || count <= grainSize)
+    {
+        function(0, count, 0);
+        return;
+    }
+
+    // Only one job is in flight at a time; concurrent submitters queue up here.
+    std::lock_guard submitLock(m_submitMutex);
+    {
+        std::lock_guard lock(m_mutex);
+        m_function = &function;
+        m_count = count;
+        m_grainSize = grainSize;
+        m_nextIndex.store(0, std::memory_order_relaxed);
+        m_busyWorkers = static_cast<uint32_t>(m_workers.size());
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_wakeCondition.notify_all();
+
+    RunChunks(0);
+
+    // Workers may still be reading the job description, so wait until every one has checked out.
+    std::unique_lock lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_busyWorkers == 0; });
+    m_function = nullptr;
+    if (m_error)
+    {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+}
+
+void ThreadPool::WorkerMain(const uint32_t threadIndex)
+{
+    uint64_t seenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_wakeCondition.wait(lock, [&] { return m_stopping || m_generation != seenGeneration; });
+            if (m_stopping)
+            {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+
+        RunChunks(threadIndex);
+
+        {
+            std::lock_guard lock(m_mutex);
+            --m_busyWorkers;
+        }
+        m_doneCondition.notify_one();
+    }
+}
+
+void ThreadPool::RunChunks(const uint32_t threadIndex)
+{
+    // Restored afterwards, as the chunks may belong to a call nested in another pool's chunk.
+    const ThreadPool* const outerPool = std::exchange(t_runningPool, this);
+    const uint32_t          outerIndex = std::exchange(t_threadIndex, threadIndex);
+    try
+    {
+        while (true)
+        {
+            const size_t begin = m_nextIndex.fetch_add(m_grainSize, std::memory_order_relaxed);
+            if (begin >= m_count)
+            {
+                break;
+            }
+
+            (*m_function)(begin, std::min(begin + m_grainSize, m_count), threadIndex);
+        }
+    }
+    catch (...)
+    {
+        // Keep the first exception for the caller and let the other threads run dry.
+        m_nextIndex.store(m_count, std::memory_order_relaxed);
+        std::lock_guard lock(m_mutex);
+        if (!m_error)
+        {
+            m_error = std::current_exception();
+        }
+    }
+    t_runningPool = outerPool;
+    t_threadIndex = outerIndex;
+}
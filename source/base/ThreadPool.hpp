@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief A small fork-join worker pool for data-parallel CPU work.
+///
+/// The calling thread always participates in a ParallelFor, so a pool created with
+/// zero workers simply runs everything inline. Thread index 0 is the caller and
+/// indices 1..WorkerCount() are the workers, which lets callers keep per-thread
+/// scratch storage sized by ThreadCount().
+class ThreadPool final
+{
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end, uint32_t threadIndex)>;
+
+    /// @brief Constructor
+    /// @param [in] workerCount Number of worker threads, or -1 to use hardware concurrency minus one.
+    explicit ThreadPool(int32_t workerCount = -1);
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    ~ThreadPool();
+
+    /// @brief Gets the number of threads that may execute work, including the caller.
+    [[nodiscard]] uint32_t ThreadCount() const;
+
+    /// @brief Gets the number of background worker threads.
+    [[nodiscard]] uint32_t WorkerCount() const;
+
+    /// @brief Splits [0, count) into chunks of grainSize and runs them across the pool.
+    /// @param [in] count Number of items.
+    /// @param [in] grainSize Number of items processed per chunk.
+    /// @param [in] function Invoked once per chunk; blocks until all chunks complete.
+    ///
+    /// A call from inside a chunk of the same pool runs its whole range inline on that thread.
+    /// If chunks throw, the remaining chunks are skipped and the first exception is rethrown
+    /// once every thread has finished with the job.
+    void ParallelFor(size_t count, size_t grainSize, const RangeFunction& function);
+
+private:
+    void WorkerMain(uint32_t threadIndex);
+
+    void RunChunks(uint32_t threadIndex);
+
+    std::vector<std::thread> m_workers;
+    std::mutex               m_submitMutex;
+    std::mutex               m_mutex;
+    std::condition_variable  m_wakeCondition;
+    std::condition_variable  m_doneCondition;
+    const RangeFunction*     m_function = nullptr;
+    size_t                   m_count = 0;
+    size_t                   m_grainSize = 1;
+    std::atomic<size_t>      m_nextIndex = 0;
+    uint32_t                 m_busyWorkers = 0;
+    uint64_t                 m_generation = 0;
+    std::exception_ptr       m_error; ///< First exception a chunk threw, guarded by m_mutex.
+    bool                     m_stopping = false;
+};
@@ -0,0 +1,387 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TransformHierarchy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#include "ThreadPool.hpp"
+#include "TransformKernels.hpp"
+
+namespace
+{
+    template <typename T>
+    void Permute(std::vector<T>& values, const std::vector<uint32_t>& order)
+    {
+        std::vector<T> sorted;
+        sorted.reserve(values.size());
+        for (const uint32_t oldIndex : order)
+        {
+            sorted.push_back(values[oldIndex]);
+        }
+        values = std::move(sorted);
+    }
+} // namespace
+
+TransformHierarchy::NodeId TransformHierarchy::AddNode(const NodeId      parent,
+                                                       const Vector3&    position,
+                                                       const Quaternion& rotation,
+                                                       const Vector3&    scale)
+{
+    uint32_t parentIndex = InvalidNode;
+    if (parent != InvalidNode)
+    {
+        if (parent >= m_nodeToIndex.size())
+        {
+            throw std::out_of_range("Parent node does not exist");
+        }
+        parentIndex = m_nodeToIndex[parent];
+    }
+
+    const auto index = static_cast<uint32_t>(m_parent.size());
+    const auto node = static_cast<NodeId>(m_nodeToIndex.size());
+
+    // Appending keeps depth-first order only if the parent's subtree currently ends the array.
+    if (parentIndex != InvalidNode && !m_needsSort)
+    {
+        if (parentIndex + m_subtreeSize[parentIndex] == index)
+        {
+            for (uint32_t ancestor = parentIndex; ancestor != InvalidNode; ancestor = m_parent[ancestor])
+            {
+                ++m_subtreeSize[ancestor];
+            }
+        }
+        else
+        {
+            m_needsSort = true;
+        }
+    }
+
+    m_parent.push_back(parentIndex);
+    m_subtreeSize.push_back(1);
+    m_position.push_back(position);
+    m_rotation.push_back(rotation);
+    m_scale.push_back(scale);
+    m_local.push_back(Matrix::Identity);
+    m_world.push_back(Matrix::Identity);
+    m_dirty.push_back(DirtyLocal);
+    m_indexToNode.push_back(node);
+    m_nodeToIndex.push_back(index);
+    m_anyDirty = true;
+
+    return node;
+}
+
+void TransformHierarchy::SetPosition(const NodeId node, const Vector3& position)
+{
+    m_position[m_nodeToIndex[node]] = position;
+    MarkDirty(node);
+}
+
+void TransformHierarchy::SetRotation(const NodeId node, const Quaternion& rotation)
+{
+    m_rotation[m_nodeToIndex[node]] = rotation;
+    MarkDirty(node);
+}
+
+void TransformHierarchy::SetScale(const NodeId node, const Vector3& scale)
+{
+    m_scale[m_nodeToIndex[node]] = scale;
+    MarkDirty(node);
+}
+
+void TransformHierarchy::SetLocal(const NodeId      node,
+                                  const Vector3&    position,
+                                  const Quaternion& rotation,
+                                  const Vector3&    scale)
+{
+    const uint32_t index = m_nodeToIndex[node];
+    m_position[index] = position;
+    m_rotation[index] = rotation;
+    m_scale[index] = scale;
+    MarkDirty(node);
+}
+
+TransformHierarchy::NodeId TransformHierarchy::Parent(const NodeId node) const
+{
+    const uint32_t parentIndex = m_parent[m_nodeToIndex[node]];
+    return parentIndex == InvalidNode ? InvalidNode : m_indexToNode[parentIndex];
+}
+
+size_t TransformHierarchy::NodeCount() const
+{
+    return m_parent.size();
+}
+
+const Matrix& TransformHierarchy::WorldMatrix(const NodeId node) const
+{
+    return m_world[m_nodeToIndex[node]];
+}
+
+uint32_t TransformHierarchy::UpdatedNodeCount() const
+{
+    return m_updatedNodeCount;
+}
+
+void TransformHierarchy::MarkDirty(const NodeId node)
+{
+    m_dirty[m_nodeToIndex[node]] |= DirtyLocal;
+    m_anyDirty = true;
+}
+
+void TransformHierarchy::SortDepthFirst()
+{
+    const auto nodeCount = static_cast<uint32_t>(m_parent.size());
+
+    // Bucket children by parent, preserving insertion order among siblings.
+    std::vector<uint32_t> childOffsets(nodeCount + 1, 0);
+    for (const uint32_t parent : m_parent)
+    {
+        if (parent != InvalidNode)
+        {
+            ++childOffsets[parent + 1];
+        }
+    }
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        childOffsets[i + 1] += childOffsets[i];
+    }
+
+    std::vector<uint32_t> children(childOffsets[nodeCount]);
+    std::vector<uint32_t> fill(childOffsets.begin(), childOffsets.end() - 1);
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        if (m_parent[i] != InvalidNode)
+        {
+            children[fill[m_parent[i]]++] = i;
+        }
+    }
+
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> stack;
+    order.reserve(nodeCount);
+    for (uint32_t root = 0; root < nodeCount; ++root)
+    {
+        if (m_parent[root] != InvalidNode)
+        {
+            continue;
+        }
+
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            const uint32_t index = stack.back();
+            stack.pop_back();
+            order.push_back(index);
+
+            // Push in reverse so the first child is visited first.
+            for (uint32_t child = childOffsets[index + 1]; child > childOffsets[index]; --child)
+            {
+                stack.push_back(children[child - 1]);
+            }
+        }
+    }
+
+    std::vector<uint32_t> oldToNew(nodeCount);
+    for (uint32_t newIndex = 0; newIndex < nodeCount; ++newIndex)
+    {
+        oldToNew[order[newIndex]] = newIndex;
+    }
+
+    Permute(m_parent, order);
+    Permute(m_position, order);
+    Permute(m_rotation, order);
+    Permute(m_scale, order);
+    Permute(m_local, order);
+    Permute(m_world, order);
+    Permute(m_dirty, order);
+    Permute(m_indexToNode, order);
+
+    for (uint32_t index = 0; index < nodeCount; ++index)
+    {
+        if (m_parent[index] != InvalidNode)
+        {
+            m_parent[index] = oldToNew[m_parent[index]];
+        }
+        m_nodeToIndex[m_indexToNode[index]] = index;
+    }
+
+    // Children follow their parents, so a reverse sweep accumulates subtree sizes bottom-up.
+    std::ranges::fill(m_subtreeSize, 1u);
+    for (uint32_t index = nodeCount; index-- > 0;)
+    {
+        if (m_parent[index] != InvalidNode)
+        {
+            m_subtreeSize[m_parent[index]] += m_subtreeSize[index];
+        }
+    }
+
+    m_needsSort = false;
+}
+
+void TransformHierarchy::Update(ThreadPool& pool)
+{
+    m_updatedNodeCount = 0;
+
+    if (m_needsSort)
+    {
+        SortDepthFirst();
+    }
+
+    if (!m_anyDirty)
+    {
+        return;
+    }
+
+    if (m_scratch.size() < pool.ThreadCount())
+    {
+        m_scratch.resize(pool.ThreadCount());
+    }
+
+    // Nodes above the grain size are evaluated here; their subtrees become independent jobs.
+    m_jobs.clear();
+    uint32_t updated = 0;
+    for (uint32_t root = 0; root < m_parent.size(); root += m_subtreeSize[root])
+    {
+        ScheduleSubtree(root, m_jobs, updated);
+    }
+
+    std::atomic<uint32_t> jobUpdated = 0;
+    pool.ParallelFor(m_jobs.size(), 1,
+                     [this, &jobUpdated](const size_t begin, const size_t end, const uint32_t thread) {
+                         uint32_t localUpdated = 0;
+                         for (size_t job = begin; job < end; ++job)
+                         {
+                             localUpdated += UpdateRange(m_jobs[job].Begin, m_jobs[job].End, m_scratch[thread]);
+                         }
+                         jobUpdated.fetch_add(localUpdated, std::memory_order_relaxed);
+                     });
+
+    // Descendants in other jobs read their ancestors' flags, so clear only once everything finished.
+    std::ranges::fill(m_dirty, uint8_t{0});
+    m_anyDirty = false;
+    m_updatedNodeCount = updated + jobUpdated.load();
+}
+
+void TransformHierarchy::ScheduleSubtree(const uint32_t index, std::vector<NodeRange>& jobs, uint32_t& updated)
+{
+    const uint32_t size = m_subtreeSize[index];
+    if (size <= SubtreeGrainSize)
+    {
+        // Coalesce neighbouring small subtrees so tiny jobs don't dominate scheduling.
+        if (!jobs.empty() && jobs.back().End == index && jobs.back().End - jobs.back().Begin + size <= SubtreeGrainSize)
+        {
+            jobs.back().End += size;
+        }
+        else
+        {
+            jobs.push_back({index, index + size});
+        }
+        return;
+    }
+
+    updated += UpdateRange(index, index + 1, m_scratch.front());
+    for (uint32_t child = index + 1; child < index + size; child += m_subtreeSize[child])
+    {
+        ScheduleSubtree(child, jobs, updated);
+    }
+}
+
+uint32_t TransformHierarchy::UpdateRange(const uint32_t begin, const uint32_t end, LevelScratch& scratch)
+{
+    // Refresh dirty locals and flag every node whose world changes, counting them per level.
+    // Parents precede children, so a parent's flags and level are final when a child reads them.
+    scratch.Levels.resize(end - begin);
+    scratch.LevelOffsets.clear();
+    uint32_t updated = 0;
+    for (uint32_t index = begin; index < end; ++index)
+    {
+        uint8_t        flags = m_dirty[index];
+        const uint32_t parent = m_parent[index];
+        if (parent != InvalidNode && (m_dirty[parent] & DirtyWorld) != 0)
+        {
+            flags |= DirtyWorld;
+        }
+
+        const uint32_t level = parent != InvalidNode && parent >= begin ? scratch.Levels[parent - begin] + 1 : 0;
+        scratch.Levels[index - begin] = level;
+        if (flags == 0)
+        {
+            continue;
+        }
+
+        if ((flags & DirtyLocal) != 0)
+        {
+            const XMMATRIX local =
+                XMMatrixAffineTransformation(XMLoadFloat3(&m_scale[index]), XMVectorZero(),
+                                             XMLoadFloat4(&m_rotation[index]), XMLoadFloat3(&m_position[index]));
+            XMStoreFloat4x4(&m_local[index], local);
+        }
+
+        if (scratch.LevelOffsets.size() < level + 2)
+        {
+            scratch.LevelOffsets.resize(level + 2, 0);
+        }
+        ++scratch.LevelOffsets[level + 1];
+        m_dirty[index] = flags | DirtyWorld;
+        ++updated;
+    }
+
+    if (updated == 0)
+    {
+        return 0;
+    }
+
+    for (size_t level = 1; level < scratch.LevelOffsets.size(); ++level)
+    {
+        scratch.LevelOffsets[level] += scratch.LevelOffsets[level - 1];
+    }
+    scratch.Nodes.resize(updated);
+    for (uint32_t index = begin; index < end; ++index)
+    {
+        if ((m_dirty[index] & DirtyWorld) != 0)
+        {
+            scratch.Nodes[scratch.LevelOffsets[scratch.Levels[index - begin]]++] = index;
+        }
+    }
+
+    // Filling moved each offset to the end of its level, which is where the next level starts.
+    uint32_t levelBegin = 0;
+    for (const uint32_t levelEnd : scratch.LevelOffsets)
+    {
+        scratch.Locals.clear();
+        scratch.ParentWorlds.clear();
+        for (uint32_t i = levelBegin; i < levelEnd; ++i)
+        {
+            const uint32_t index = scratch.Nodes[i];
+            const uint32_t parent = m_parent[index];
+            if (parent == InvalidNode)
+            {
+                m_world[index] = m_local[index];
+                continue;
+            }
+            scratch.Locals.push_back(m_local[index]);
+            scratch.ParentWorlds.push_back(m_world[parent]);
+        }
+
+        scratch.Worlds.resize(scratch.Locals.size());
+        TransformKernels::MultiplyMatrices(scratch.Locals, scratch.ParentWorlds, scratch.Worlds);
+
+        size_t product = 0;
+        for (uint32_t i = levelBegin; i < levelEnd; ++i)
+        {
+            const uint32_t index = scratch.Nodes[i];
+            if (m_parent[index] != InvalidNode)
+            {
+                m_world[index] = scratch.Worlds[product++];
+            }
+        }
+        levelBegin = levelEnd;
+    }
+
+    return updated;
+}
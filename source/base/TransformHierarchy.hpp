@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GraphicsMath.hpp"
+
+class ThreadPool;
+
+/// @brief Flattened scene transform hierarchy.
+///
+/// Local translation, rotation and scale live in separate arrays stored in depth-first
+/// order, so every parent precedes its children and every subtree is a contiguous
+/// range. Only nodes whose local transform changed, and their descendants, are
+/// recomputed by Update(), and large subtrees are split into independent ranges
+/// that are evaluated in parallel. Within a range, the dirty nodes of each depth
+/// level are gathered and multiplied by their parents' world matrices in one
+/// TransformKernels::MultiplyMatrices() batch.
+class TransformHierarchy final
+{
+public:
+    using NodeId = uint32_t;
+
+    static constexpr NodeId InvalidNode = UINT32_MAX;
+
+    /// @brief Adds a node. Parents must be added before their children.
+    /// @param [in] parent Parent node, or InvalidNode for a root.
+    /// @return Stable identifier of the new node.
+    NodeId AddNode(NodeId            parent = InvalidNode,
+                   const Vector3&    position = Vector3::Zero,
+                   const Quaternion& rotation = Quaternion::Identity,
+                   const Vector3&    scale = Vector3::One);
+
+    void SetPosition(NodeId node, const Vector3& position);
+
+    void SetRotation(NodeId node, const Quaternion& rotation);
+
+    void SetScale(NodeId node, const Vector3& scale);
+
+    void SetLocal(NodeId node, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+    [[nodiscard]] NodeId Parent(NodeId node) const;
+
+    [[nodiscard]] size_t NodeCount() const;
+
+    /// @brief Gets the world matrix computed by the last Update().
+    [[nodiscard]] const Matrix& WorldMatrix(NodeId node) const;
+
+    /// @brief Gets the number of world matrices recomputed by the last Update().
+    [[nodiscard]] uint32_t UpdatedNodeCount() const;
+
+    /// @brief Recomputes world matrices for all dirty subtrees.
+    /// @param [in] pool Pool used to evaluate independent subtrees in parallel.
+    void Update(ThreadPool& pool);
+
+private:
+    /// Subtrees at or below this many nodes are evaluated as one job.
+    static constexpr uint32_t SubtreeGrainSize = 1024;
+
+    enum DirtyFlags : uint8_t
+    {
+        DirtyLocal = 1 << 0,
+        DirtyWorld = 1 << 1,
+    };
+
+    struct NodeRange
+    {
+        uint32_t Begin;
+        uint32_t End;
+    };
+
+    /// Per-thread storage for the level batches of UpdateRange(), kept between updates.
+    struct LevelScratch
+    {
+        std::vector<uint32_t> Levels;       ///< Depth of each node of the range below the first ancestor outside it.
+        std::vector<uint32_t> LevelOffsets; ///< Start of each level in Nodes.
+        std::vector<uint32_t> Nodes;        ///< Updated nodes, grouped by level.
+        std::vector<Matrix>   Locals;
+        std::vector<Matrix>   ParentWorlds;
+        std::vector<Matrix>   Worlds;
+    };
+
+    void MarkDirty(NodeId node);
+
+    void SortDepthFirst();
+
+    void ScheduleSubtree(uint32_t index, std::vector<NodeRange>& jobs, uint32_t& updated);
+
+    uint32_t UpdateRange(uint32_t begin, uint32_t end, LevelScratch& scratch);
+
+    // Per-node arrays indexed by depth-first position.
+    std::vector<uint32_t>   m_parent;
+    std::vector<uint32_t>   m_subtreeSize;
+    std::vector<Vector3>    m_position;
+    std::vector<Quaternion> m_rotation;
+    std::vector<Vector3>    m_scale;
+    std::vector<Matrix>     m_local;
+    std::vector<Matrix>     m_world;
+    std::vector<uint8_t>    m_dirty;
+    std::vector<NodeId>     m_indexToNode;
+
+    // Stable NodeId to depth-first position.
+    std::vector<uint32_t> m_nodeToIndex;
+
+    std::vector<NodeRange>    m_jobs;
+    std::vector<LevelScratch> m_scratch; ///< One per pool thread; ScheduleSubtree() uses the first.
+    uint32_t                  m_updatedNodeCount = 0;
+    bool                      m_anyDirty = false;
+    bool                      m_needsSort = false;
+};
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CpuFeatures.hpp"
+#include "TransformKernels.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define TRANSFORM_KERNELS_X64
+#endif
+
+// Each instruction set level gets its own translation unit. GCC and Clang only allow
+// intrinsics in functions compiled for their instruction set, so the kernels are
+// tagged individually rather than compiling whole files with -mavx2. That keeps
+// inline functions from shared headers (DirectXMath included) at the baseline, so
+// the linker can never pick an AVX copy for code that runs on older CPUs. MSVC
+// accepts the intrinsics as is.
+#if defined(__GNUC__) || defined(__clang__)
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define KERNEL_TARGET(isa)
+#endif
+
+/// One implementation of every transform kernel for a particular instruction set.
+struct TransformKernelTable
+{
+    const char* Name;
+    void (*TransformPoints)(const Vector3* points, size_t count, const Matrix& matrix, Vector3* results);
+    void (*TransformPointsIndexed)(
+        const Vector3* points, size_t count, const Matrix* matrices, const uint32_t* indices, Vector3* results);
+    void (*TransformNormals)(const Vector3* normals, size_t count, const Matrix& matrix, Vector3* results);
+    void (*TransformPointsSoA)(ConstVector3Stream points, size_t count, const Matrix& matrix, Vector3Stream results);
+    void (*TransformNormalsSoA)(ConstVector3Stream normals, size_t count, const Matrix& matrix, Vector3Stream results);
+    void (*TransformBounds)(const BoundingBox* bounds, size_t count, const Matrix& matrix, BoundingBox* results);
+    void (*TransformBoundsMany)(const BoundingBox* bounds, size_t count, const Matrix* matrices, BoundingBox* results);
+    void (*MultiplyMatrices)(const Matrix* a, size_t count, const Matrix* b, size_t bStride, Matrix* results);
+};
+
+/// DirectXMath implementation, using SSE2 or NEON depending on the target.
+extern const TransformKernelTable GenericTransformKernels;
+
+#ifdef TRANSFORM_KERNELS_X64
+extern const TransformKernelTable Sse41TransformKernels;
+extern const TransformKernelTable Avx2TransformKernels;
+extern const TransformKernelTable Avx512TransformKernels;
+#endif
+
+/// @brief Gets the table a level dispatches to; levels without their own table use the generic one.
+[[nodiscard]] const TransformKernelTable& TransformKernelsFor(SimdLevel level);
+
+/// Streams offset by a number of elements.
+inline ConstVector3Stream Advance(const ConstVector3Stream stream, const size_t offset)
+{
+    return {stream.X + offset, stream.Y + offset, stream.Z + offset};
+}
+
+inline Vector3Stream Advance(const Vector3Stream stream, const size_t offset)
+{
+    return {stream.X + offset, stream.Y + offset, stream.Z + offset};
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TransformKernels.hpp"
+
+#include <cassert>
+
+#include "CpuFeatures.hpp"
+#include "TransformKernelTable.hpp"
+
+namespace
+{
+    const TransformKernelTable& Kernels()
+    {
+        static const TransformKernelTable& kernels = TransformKernelsFor(SelectedSimdLevel());
+        return kernels;
+    }
+} // namespace
+
+const TransformKernelTable& TransformKernelsFor([[maybe_unused]] const SimdLevel level)
+{
+#ifdef TRANSFORM_KERNELS_X64
+    switch (level)
+    {
+    case SimdLevel::AVX512:
+        return Avx512TransformKernels;
+    case SimdLevel::AVX2:
+        return Avx2TransformKernels;
+    case SimdLevel::SSE41:
+        return Sse41TransformKernels;
+    default:
+        break;
+    }
+#endif
+    return GenericTransformKernels;
+}
+
+namespace TransformKernels
+{
+    const char* PathName()
+    {
+        return Kernels().Name;
+    }
+
+    void TransformPoints(const std::span<const Vector3> points, const Matrix& matrix, const std::span<Vector3> results)
+    {
+        assert(results.size() >= points.size());
+        Kernels().TransformPoints(points.data(), points.size(), matrix, results.data());
+    }
+
+    void TransformPoints(const std::span<const Vector3>  points,
+                         const std::span<const Matrix>   matrices,
+                         const std::span<const uint32_t> matrixIndices,
+                         const std::span<Vector3>        results)
+    {
+        assert(matrixIndices.size() >= points.size() && results.size() >= points.size());
+        Kernels().TransformPointsIndexed(points.data(), points.size(), matrices.data(), matrixIndices.data(),
+                                         results.data());
+    }
+
+    void TransformNormals(const std::span<const Vector3> normals,
+                          const Matrix&                  matrix,
+                          const std::span<Vector3>       results)
+    {
+        assert(results.size() >= normals.size());
+        Kernels().TransformNormals(normals.data(), normals.size(), matrix, results.data());
+    }
+
+    void TransformPoints(const ConstVector3Stream points,
+                         const size_t             count,
+                         const Matrix&            matrix,
+                         const Vector3Stream      results)
+    {
+        Kernels().TransformPointsSoA(points, count, matrix, results);
+    }
+
+    void TransformNormals(const ConstVector3Stream normals,
+                          const size_t             count,
+                          const Matrix&            matrix,
+                          const Vector3Stream      results)
+    {
+        Kernels().TransformNormalsSoA(normals, count, matrix, results);
+    }
+
+    void TransformBounds(const std::span<const BoundingBox> bounds,
+                         const Matrix&                      matrix,
+                         const std::span<BoundingBox>       results)
+    {
+        assert(results.size() >= bounds.size());
+        Kernels().TransformBounds(bounds.data(), bounds.size(), matrix, results.data());
+    }
+
+    void TransformBounds(const std::span<const BoundingBox> bounds,
+                         const std::span<const Matrix>      matrices,
+                         const std::span<BoundingBox>       results)
+    {
+        assert(matrices.size() >= bounds.size() && results.size() >= bounds.size());
+        Kernels().TransformBoundsMany(bounds.data(), bounds.size(), matrices.data(), results.data());
+    }
+
+    void MultiplyMatrices(const std::span<const Matrix> a,
+                          const std::span<const Matrix> b,
+                          const std::span<Matrix>       results)
+    {
+        assert((b.size() == 1 || b.size() >= a.size()) && results.size() >= a.size());
+        if (a.empty())
+        {
+            return;
+        }
+
+        Kernels().MultiplyMatrices(a.data(), a.size(), b.data(), b.size() == 1 ? 0 : 1, results.data());
+    }
+} // namespace TransformKernels
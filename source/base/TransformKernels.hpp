@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "GraphicsMath.hpp"
+
+/// Vector3 components stored as separate arrays.
+struct Vector3Stream
+{
+    float* X;
+    float* Y;
+    float* Z;
+};
+
+/// Read-only Vector3 components stored as separate arrays.
+struct ConstVector3Stream
+{
+    const float* X;
+    const float* Y;
+    const float* Z;
+};
+
+/// @brief Bulk transforms for positions, normals and bounding boxes.
+///
+/// These replace loops over Vector3::Transform and BoundingBox::Transform with kernels
+/// that keep the matrix in registers and work on 4, 8 or 16 elements at once. The
+/// path comes from SelectedSimdLevel the first time a kernel runs. Matrices are
+/// treated as affine, so no perspective divide happens. Normals are transformed by
+/// the upper 3x3 only and are not renormalized; pass the inverse transpose for
+/// non-uniform scales. Results may alias the inputs exactly but must not partially
+/// overlap them.
+namespace TransformKernels
+{
+    /// @brief Gets the name of the instruction set the kernels dispatch to.
+    [[nodiscard]] const char* PathName();
+
+    void TransformPoints(std::span<const Vector3> points, const Matrix& matrix, std::span<Vector3> results);
+
+    /// @brief Transforms each point by the matrix its index selects, e.g. for rigid skinning.
+    void TransformPoints(std::span<const Vector3>  points,
+                         std::span<const Matrix>   matrices,
+                         std::span<const uint32_t> matrixIndices,
+                         std::span<Vector3>        results);
+
+    void TransformNormals(std::span<const Vector3> normals, const Matrix& matrix, std::span<Vector3> results);
+
+    void TransformPoints(ConstVector3Stream points, size_t count, const Matrix& matrix, Vector3Stream results);
+
+    void TransformNormals(ConstVector3Stream normals, size_t count, const Matrix& matrix, Vector3Stream results);
+
+    /// @brief Computes the axis-aligned bounds of each transformed box.
+    void TransformBounds(std::span<const BoundingBox> bounds, const Matrix& matrix, std::span<BoundingBox> results);
+
+    /// @brief Computes the axis-aligned bounds of bounds[i] transformed by matrices[i].
+    void TransformBounds(std::span<const BoundingBox> bounds,
+                         std::span<const Matrix>      matrices,
+                         std::span<BoundingBox>       results);
+
+    /// @brief Computes a[i] * b[i], or a[i] * b[0] when b holds a single matrix.
+    void MultiplyMatrices(std::span<const Matrix> a, std::span<const Matrix> b, std::span<Matrix> results);
+} // namespace TransformKernels
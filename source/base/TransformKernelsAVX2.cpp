@@ -0,0 +1,317 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TransformKernelTable.hpp"
+
+#ifdef TRANSFORM_KERNELS_X64
+
+#include <immintrin.h>
+
+#define AVX2_TARGET KERNEL_TARGET("avx2,fma")
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float));
+static_assert(sizeof(BoundingBox) == 6 * sizeof(float));
+static_assert(sizeof(Matrix) == 16 * sizeof(float));
+
+namespace
+{
+    constexpr size_t Width = 8;
+
+    /// The upper 4x3 of a matrix with every element broadcast across a register.
+    struct MatrixLanes
+    {
+        __m256 M[4][3];
+    };
+
+    AVX2_TARGET MatrixLanes Broadcast(const Matrix& matrix)
+    {
+        MatrixLanes lanes;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                lanes.M[row][column] = _mm256_broadcast_ss(&matrix.m[row][column]);
+            }
+        }
+        return lanes;
+    }
+
+    /// Gathers the upper 4x3 of eight matrices, one per lane, from 16-float strided indices.
+    AVX2_TARGET MatrixLanes Gather(const Matrix* matrices, const __m256i indices)
+    {
+        const __m256i base = _mm256_slli_epi32(indices, 4);
+        const float*  elements = &matrices[0].m[0][0];
+
+        MatrixLanes lanes;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                const __m256i offset = _mm256_add_epi32(base, _mm256_set1_epi32(row * 4 + column));
+                lanes.M[row][column] = _mm256_i32gather_ps(elements, offset, 4);
+            }
+        }
+        return lanes;
+    }
+
+    template <bool Translate>
+    AVX2_TARGET void Transform(const MatrixLanes& m, __m256& x, __m256& y, __m256& z)
+    {
+        __m256 r[3];
+        for (int column = 0; column < 3; ++column)
+        {
+            r[column] = Translate ? m.M[3][column] : _mm256_setzero_ps();
+            r[column] = _mm256_fmadd_ps(x, m.M[0][column], r[column]);
+            r[column] = _mm256_fmadd_ps(y, m.M[1][column], r[column]);
+            r[column] = _mm256_fmadd_ps(z, m.M[2][column], r[column]);
+        }
+
+        x = r[0];
+        y = r[1];
+        z = r[2];
+    }
+
+    /// Splits eight packed xyz triples into one register per component.
+    AVX2_TARGET void Deinterleave(const float* p, __m256& x, __m256& y, __m256& z)
+    {
+        // Each 128-bit half holds four triples: points 0-3 below and 4-7 above.
+        __m256 m03 = _mm256_castps128_ps256(_mm_loadu_ps(p));
+        __m256 m14 = _mm256_castps128_ps256(_mm_loadu_ps(p + 4));
+        __m256 m25 = _mm256_castps128_ps256(_mm_loadu_ps(p + 8));
+        m03 = _mm256_insertf128_ps(m03, _mm_loadu_ps(p + 12), 1);
+        m14 = _mm256_insertf128_ps(m14, _mm_loadu_ps(p + 16), 1);
+        m25 = _mm256_insertf128_ps(m25, _mm_loadu_ps(p + 20), 1);
+
+        const __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+        const __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+        x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+    }
+
+    /// Inverse of Deinterleave.
+    AVX2_TARGET void Interleave(float* p, const __m256 x, const __m256 y, const __m256 z)
+    {
+        const __m256 xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m256 zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m256 m03 = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 m14 = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m256 m25 = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+
+        _mm_storeu_ps(p, _mm256_castps256_ps128(m03));
+        _mm_storeu_ps(p + 4, _mm256_castps256_ps128(m14));
+        _mm_storeu_ps(p + 8, _mm256_castps256_ps128(m25));
+        _mm_storeu_ps(p + 12, _mm256_extractf128_ps(m03, 1));
+        _mm_storeu_ps(p + 16, _mm256_extractf128_ps(m14, 1));
+        _mm_storeu_ps(p + 20, _mm256_extractf128_ps(m25, 1));
+    }
+
+    template <bool Translate>
+    AVX2_TARGET size_t TransformPacked(const Vector3* input,
+                                       const size_t   count,
+                                       const Matrix&  matrix,
+                                       Vector3*       output)
+    {
+        const MatrixLanes m = Broadcast(matrix);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            __m256 x, y, z;
+            Deinterleave(&input[i].x, x, y, z);
+            Transform<Translate>(m, x, y, z);
+            Interleave(&output[i].x, x, y, z);
+        }
+        return i;
+    }
+
+    AVX2_TARGET void TransformPoints(const Vector3* points, const size_t count, const Matrix& matrix, Vector3* results)
+    {
+        const size_t done = TransformPacked<true>(points, count, matrix, results);
+        GenericTransformKernels.TransformPoints(points + done, count - done, matrix, results + done);
+    }
+
+    AVX2_TARGET void TransformNormals(const Vector3* normals,
+                                      const size_t   count,
+                                      const Matrix&  matrix,
+                                      Vector3*       results)
+    {
+        const size_t done = TransformPacked<false>(normals, count, matrix, results);
+        GenericTransformKernels.TransformNormals(normals + done, count - done, matrix, results + done);
+    }
+
+    AVX2_TARGET void TransformPointsIndexed(
+        const Vector3* points, const size_t count, const Matrix* matrices, const uint32_t* indices, Vector3* results)
+    {
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            const __m256i     lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+            const MatrixLanes m = Gather(matrices, lanes);
+
+            __m256 x, y, z;
+            Deinterleave(&points[i].x, x, y, z);
+            Transform<true>(m, x, y, z);
+            Interleave(&results[i].x, x, y, z);
+        }
+
+        GenericTransformKernels.TransformPointsIndexed(points + i, count - i, matrices, indices + i, results + i);
+    }
+
+    template <bool Translate>
+    AVX2_TARGET void TransformStream(const ConstVector3Stream input,
+                                     const size_t             count,
+                                     const Matrix&            matrix,
+                                     const Vector3Stream      output)
+    {
+        const MatrixLanes m = Broadcast(matrix);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            __m256 x = _mm256_loadu_ps(input.X + i);
+            __m256 y = _mm256_loadu_ps(input.Y + i);
+            __m256 z = _mm256_loadu_ps(input.Z + i);
+            Transform<Translate>(m, x, y, z);
+            _mm256_storeu_ps(output.X + i, x);
+            _mm256_storeu_ps(output.Y + i, y);
+            _mm256_storeu_ps(output.Z + i, z);
+        }
+
+        if (Translate)
+        {
+            GenericTransformKernels.TransformPointsSoA(Advance(input, i), count - i, matrix, Advance(output, i));
+        }
+        else
+        {
+            GenericTransformKernels.TransformNormalsSoA(Advance(input, i), count - i, matrix, Advance(output, i));
+        }
+    }
+
+    AVX2_TARGET void TransformPointsSoA(const ConstVector3Stream points,
+                                        const size_t             count,
+                                        const Matrix&            matrix,
+                                        const Vector3Stream      results)
+    {
+        TransformStream<true>(points, count, matrix, results);
+    }
+
+    AVX2_TARGET void TransformNormalsSoA(const ConstVector3Stream normals,
+                                         const size_t             count,
+                                         const Matrix&            matrix,
+                                         const Vector3Stream      results)
+    {
+        TransformStream<false>(normals, count, matrix, results);
+    }
+
+    /// Transforms eight boxes; centers by the full matrix and extents by its absolute 3x3.
+    AVX2_TARGET void TransformBoxes(const BoundingBox* bounds, const MatrixLanes& m, BoundingBox* results)
+    {
+        const __m256i stride = _mm256_setr_epi32(0, 6, 12, 18, 24, 30, 36, 42);
+        const float*  elements = &bounds[0].Center.x;
+
+        __m256 values[6];
+        for (int k = 0; k < 6; ++k)
+        {
+            values[k] = _mm256_i32gather_ps(elements, _mm256_add_epi32(stride, _mm256_set1_epi32(k)), 4);
+        }
+
+        Transform<true>(m, values[0], values[1], values[2]);
+
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256       extents[3];
+        for (int column = 0; column < 3; ++column)
+        {
+            extents[column] = _mm256_mul_ps(values[3], _mm256_andnot_ps(signMask, m.M[0][column]));
+            extents[column] = _mm256_fmadd_ps(values[4], _mm256_andnot_ps(signMask, m.M[1][column]), extents[column]);
+            extents[column] = _mm256_fmadd_ps(values[5], _mm256_andnot_ps(signMask, m.M[2][column]), extents[column]);
+        }
+
+        // AVX2 has no scatter, so go through memory to rebuild the 24-byte boxes.
+        alignas(32) float transformed[6][Width];
+        for (int k = 0; k < 3; ++k)
+        {
+            _mm256_store_ps(transformed[k], values[k]);
+            _mm256_store_ps(transformed[3 + k], extents[k]);
+        }
+
+        for (size_t lane = 0; lane < Width; ++lane)
+        {
+            results[lane].Center = XMFLOAT3(transformed[0][lane], transformed[1][lane], transformed[2][lane]);
+            results[lane].Extents = XMFLOAT3(transformed[3][lane], transformed[4][lane], transformed[5][lane]);
+        }
+    }
+
+    AVX2_TARGET void TransformBounds(const BoundingBox* bounds,
+                                     const size_t       count,
+                                     const Matrix&      matrix,
+                                     BoundingBox*       results)
+    {
+        const MatrixLanes m = Broadcast(matrix);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            TransformBoxes(bounds + i, m, results + i);
+        }
+
+        GenericTransformKernels.TransformBounds(bounds + i, count - i, matrix, results + i);
+    }
+
+    AVX2_TARGET void TransformBoundsMany(const BoundingBox* bounds,
+                                         const size_t       count,
+                                         const Matrix*      matrices,
+                                         BoundingBox*       results)
+    {
+        const __m256i sequence = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            TransformBoxes(bounds + i, Gather(matrices + i, sequence), results + i);
+        }
+
+        GenericTransformKernels.TransformBoundsMany(bounds + i, count - i, matrices + i, results + i);
+    }
+
+    /// Multiplies two rows of a at once, with each row of b broadcast to both halves.
+    AVX2_TARGET void MultiplyMatrices(
+        const Matrix* a, const size_t count, const Matrix* b, const size_t bStride, Matrix* results)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float* rowsB = b[i * bStride].m[0];
+            const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rowsB));
+            const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rowsB + 4));
+            const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rowsB + 8));
+            const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rowsB + 12));
+
+            for (int pair = 0; pair < 2; ++pair)
+            {
+                const __m256 rows = _mm256_loadu_ps(a[i].m[2 * pair]);
+                __m256       r = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+                r = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(1, 1, 1, 1)), b1, r);
+                r = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(2, 2, 2, 2)), b2, r);
+                r = _mm256_fmadd_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(3, 3, 3, 3)), b3, r);
+                _mm256_storeu_ps(results[i].m[2 * pair], r);
+            }
+        }
+    }
+} // namespace
+
+const TransformKernelTable Avx2TransformKernels = {
+    "AVX2",
+    TransformPoints,
+    TransformPointsIndexed,
+    TransformNormals,
+    TransformPointsSoA,
+    TransformNormalsSoA,
+    TransformBounds,
+    TransformBoundsMany,
+    MultiplyMatrices,
+};
+
+#endif
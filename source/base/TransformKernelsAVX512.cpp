@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TransformKernelTable.hpp"
+
+#ifdef TRANSFORM_KERNELS_X64
+
+#include <array>
+
+#include <immintrin.h>
+
+#define AVX512_TARGET KERNEL_TARGET("avx512f")
+
+namespace
+{
+    constexpr size_t Width = 16;
+
+    using PermuteIndices = std::array<int32_t, Width>;
+
+    /// Indices gathering component k of sixteen packed triples held in three registers.
+    /// The first permute pulls what it can from the first two registers and the second
+    /// fills the remaining lanes from the third.
+    constexpr std::array<PermuteIndices, 2> DeinterleaveIndices(const int32_t k)
+    {
+        std::array<PermuteIndices, 2> indices{};
+        for (int32_t lane = 0; lane < static_cast<int32_t>(Width); ++lane)
+        {
+            const int32_t source = 3 * lane + k;
+            indices[0][lane] = source < 32 ? source : 0;
+            indices[1][lane] = source < 32 ? lane : 16 + source - 32;
+        }
+        return indices;
+    }
+
+    /// Indices building packed output register q from the x, y and z registers.
+    constexpr std::array<PermuteIndices, 2> InterleaveIndices(const int32_t q)
+    {
+        std::array<PermuteIndices, 2> indices{};
+        for (int32_t lane = 0; lane < static_cast<int32_t>(Width); ++lane)
+        {
+            const int32_t element = 16 * q + lane;
+            const int32_t point = element / 3;
+            const int32_t component = element % 3;
+            indices[0][lane] = component == 1 ? 16 + point : point;
+            indices[1][lane] = component == 2 ? 16 + point : lane;
+        }
+        return indices;
+    }
+
+    constexpr std::array<std::array<PermuteIndices, 2>, 3> Deinterleaves = {
+        DeinterleaveIndices(0), DeinterleaveIndices(1), DeinterleaveIndices(2)};
+    constexpr std::array<std::array<PermuteIndices, 2>, 3> Interleaves = {
+        InterleaveIndices(0), InterleaveIndices(1), InterleaveIndices(2)};
+
+    struct MatrixLanes
+    {
+        __m512 M[4][3];
+    };
+
+    AVX512_TARGET MatrixLanes Broadcast(const Matrix& matrix)
+    {
+        MatrixLanes lanes;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                lanes.M[row][column] = _mm512_set1_ps(matrix.m[row][column]);
+            }
+        }
+        return lanes;
+    }
+
+    AVX512_TARGET MatrixLanes Gather(const Matrix* matrices, const __m512i indices)
+    {
+        const __m512i base = _mm512_slli_epi32(indices, 4);
+        const float*  elements = &matrices[0].m[0][0];
+
+        MatrixLanes lanes;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                const __m512i offset = _mm512_add_epi32(base, _mm512_set1_epi32(row * 4 + column));
+                lanes.M[row][column] = _mm512_i32gather_ps(offset, elements, 4);
+            }
+        }
+        return lanes;
+    }
+
+    AVX512_TARGET __m512i LoadIndices(const PermuteIndices& indices)
+    {
+        return _mm512_loadu_si512(indices.data());
+    }
+
+    template <bool Translate>
+    AVX512_TARGET void Transform(const MatrixLanes& m, __m512& x, __m512& y, __m512& z)
+    {
+        __m512 r[3];
+        for (int column = 0; column < 3; ++column)
+        {
+            r[column] = Translate ? m.M[3][column] : _mm512_setzero_ps();
+            r[column] = _mm512_fmadd_ps(x, m.M[0][column], r[column]);
+            r[column] = _mm512_fmadd_ps(y, m.M[1][column], r[column]);
+            r[column] = _mm512_fmadd_ps(z, m.M[2][column], r[column]);
+        }
+
+        x = r[0];
+        y = r[1];
+        z = r[2];
+    }
+
+    AVX512_TARGET void Deinterleave(const float* p, __m512 (&components)[3])
+    {
+        const __m512 a = _mm512_loadu_ps(p);
+        const __m512 b = _mm512_loadu_ps(p + 16);
+        const __m512 c = _mm512_loadu_ps(p + 32);
+        for (int k = 0; k < 3; ++k)
+        {
+            const __m512 ab = _mm512_permutex2var_ps(a, LoadIndices(Deinterleaves[k][0]), b);
+            components[k] = _mm512_permutex2var_ps(ab, LoadIndices(Deinterleaves[k][1]), c);
+        }
+    }
+
+    AVX512_TARGET void Interleave(float* p, const __m512 (&components)[3])
+    {
+        for (int q = 0; q < 3; ++q)
+        {
+            const __m512 xy = _mm512_permutex2var_ps(components[0], LoadIndices(Interleaves[q][0]), components[1]);
+            _mm512_storeu_ps(p + 16 * q, _mm512_permutex2var_ps(xy, LoadIndices(Interleaves[q][1]), components[2]));
+        }
+    }
+
+    template <bool Translate>
+    AVX512_TARGET size_t TransformPacked(const Vector3*     input,
+                                         const size_t       count,
+                                         const MatrixLanes& m,
+                                         Vector3*           output)
+    {
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            __m512 v[3];
+            Deinterleave(&input[i].x, v);
+            Transform<Translate>(m, v[0], v[1], v[2]);
+            Interleave(&output[i].x, v);
+        }
+        return i;
+    }
+
+    AVX512_TARGET void TransformPoints(const Vector3* points,
+                                       const size_t   count,
+                                       const Matrix&  matrix,
+                                       Vector3*       results)
+    {
+        const size_t done = TransformPacked<true>(points, count, Broadcast(matrix), results);
+        GenericTransformKernels.TransformPoints(points + done, count - done, matrix, results + done);
+    }
+
+    AVX512_TARGET void TransformNormals(const Vector3* normals,
+                                       const size_t   count,
+                                       const Matrix&  matrix,
+                                       Vector3*       results)
+    {
+        const size_t done = TransformPacked<false>(normals, count, Broadcast(matrix), results);
+        GenericTransformKernels.TransformNormals(normals + done, count - done, matrix, results + done);
+    }
+
+    AVX512_TARGET void TransformPointsIndexed(
+        const Vector3* points, const size_t count, const Matrix* matrices, const uint32_t* indices, Vector3* results)
+    {
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            const MatrixLanes m = Gather(matrices, _mm512_loadu_si512(indices + i));
+
+            __m512 v[3];
+            Deinterleave(&points[i].x, v);
+            Transform<true>(m, v[0], v[1], v[2]);
+            Interleave(&results[i].x, v);
+        }
+
+        GenericTransformKernels.TransformPointsIndexed(points + i, count - i, matrices, indices + i, results + i);
+    }
+
+    template <bool Translate>
+    AVX512_TARGET void TransformStream(const ConstVector3Stream input,
+                                       const size_t             count,
+                                       const Matrix&            matrix,
+                                       const Vector3Stream      output)
+    {
+        const MatrixLanes m = Broadcast(matrix);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            __m512 x = _mm512_loadu_ps(input.X + i);
+            __m512 y = _mm512_loadu_ps(input.Y + i);
+            __m512 z = _mm512_loadu_ps(input.Z + i);
+            Transform<Translate>(m, x, y, z);
+            _mm512_storeu_ps(output.X + i, x);
+            _mm512_storeu_ps(output.Y + i, y);
+            _mm512_storeu_ps(output.Z + i, z);
+        }
+
+        if (Translate)
+        {
+            GenericTransformKernels.TransformPointsSoA(Advance(input, i), count - i, matrix, Advance(output, i));
+        }
+        else
+        {
+            GenericTransformKernels.TransformNormalsSoA(Advance(input, i), count - i, matrix, Advance(output, i));
+        }
+    }
+
+    AVX512_TARGET void TransformPointsSoA(const ConstVector3Stream points,
+                                          const size_t             count,
+                                          const Matrix&            matrix,
+                                          const Vector3Stream      results)
+    {
+        TransformStream<true>(points, count, matrix, results);
+    }
+
+    AVX512_TARGET void TransformNormalsSoA(const ConstVector3Stream normals,
+                                           const size_t             count,
+                                           const Matrix&            matrix,
+                                           const Vector3Stream      results)
+    {
+        TransformStream<false>(normals, count, matrix, results);
+    }
+
+    /// Transforms sixteen boxes using gathers and scatters over their six floats.
+    AVX512_TARGET void TransformBoxes(const BoundingBox* bounds, const MatrixLanes& m, BoundingBox* results)
+    {
+        const __m512i stride = _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(6));
+
+        __m512 values[6];
+        for (int k = 0; k < 6; ++k)
+        {
+            values[k] = _mm512_i32gather_ps(_mm512_add_epi32(stride, _mm512_set1_epi32(k)), &bounds[0].Center.x, 4);
+        }
+
+        Transform<true>(m, values[0], values[1], values[2]);
+
+        __m512 extents[3];
+        for (int column = 0; column < 3; ++column)
+        {
+            extents[column] = _mm512_mul_ps(values[3], _mm512_abs_ps(m.M[0][column]));
+            extents[column] = _mm512_fmadd_ps(values[4], _mm512_abs_ps(m.M[1][column]), extents[column]);
+            extents[column] = _mm512_fmadd_ps(values[5], _mm512_abs_ps(m.M[2][column]), extents[column]);
+        }
+
+        for (int k = 0; k < 3; ++k)
+        {
+            _mm512_i32scatter_ps(&results[0].Center.x, _mm512_add_epi32(stride, _mm512_set1_epi32(k)), values[k], 4);
+            _mm512_i32scatter_ps(&results[0].Center.x, _mm512_add_epi32(stride, _mm512_set1_epi32(3 + k)), extents[k],
+                                 4);
+        }
+    }
+
+    AVX512_TARGET void TransformBounds(const BoundingBox* bounds,
+                                       const size_t       count,
+                                       const Matrix&      matrix,
+                                       BoundingBox*       results)
+    {
+        const MatrixLanes m = Broadcast(matrix);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            TransformBoxes(bounds + i, m, results + i);
+        }
+
+        GenericTransformKernels.TransformBounds(bounds + i, count - i, matrix, results + i);
+    }
+
+    AVX512_TARGET void TransformBoundsMany(const BoundingBox* bounds,
+                                           const size_t       count,
+                                           const Matrix*      matrices,
+                                           BoundingBox*       results)
+    {
+        const __m512i sequence = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            TransformBoxes(bounds + i, Gather(matrices + i, sequence), results + i);
+        }
+
+        GenericTransformKernels.TransformBoundsMany(bounds + i, count - i, matrices + i, results + i);
+    }
+
+    /// Multiplies all four rows of a at once, with each row of b broadcast to every 128-bit lane.
+    AVX512_TARGET void MultiplyMatrices(
+        const Matrix* a, const size_t count, const Matrix* b, const size_t bStride, Matrix* results)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float* rowsB = b[i * bStride].m[0];
+            const __m512 b0 = _mm512_broadcast_f32x4(_mm_loadu_ps(rowsB));
+            const __m512 b1 = _mm512_broadcast_f32x4(_mm_loadu_ps(rowsB + 4));
+            const __m512 b2 = _mm512_broadcast_f32x4(_mm_loadu_ps(rowsB + 8));
+            const __m512 b3 = _mm512_broadcast_f32x4(_mm_loadu_ps(rowsB + 12));
+
+            const __m512 rows = _mm512_loadu_ps(a[i].m[0]);
+            __m512       r = _mm512_mul_ps(_mm512_permute_ps(rows, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+            r = _mm512_fmadd_ps(_mm512_permute_ps(rows, _MM_SHUFFLE(1, 1, 1, 1)), b1, r);
+            r = _mm512_fmadd_ps(_mm512_permute_ps(rows, _MM_SHUFFLE(2, 2, 2, 2)), b2, r);
+            r = _mm512_fmadd_ps(_mm512_permute_ps(rows, _MM_SHUFFLE(3, 3, 3, 3)), b3, r);
+            _mm512_storeu_ps(results[i].m[0], r);
+        }
+    }
+} // namespace
+
+const TransformKernelTable Avx512TransformKernels = {
+    "AVX-512",
+    TransformPoints,
+    TransformPointsIndexed,
+    TransformNormals,
+    TransformPointsSoA,
+    TransformNormalsSoA,
+    TransformBounds,
+    TransformBoundsMany,
+    MultiplyMatrices,
+};
+
+#endif
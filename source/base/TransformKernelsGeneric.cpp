@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TransformKernelTable.hpp"
+
+namespace
+{
+    void TransformPoints(const Vector3* points, const size_t count, const Matrix& matrix, Vector3* results)
+    {
+        const XMMATRIX m = XMLoadFloat4x4(&matrix);
+        for (size_t i = 0; i < count; ++i)
+        {
+            XMStoreFloat3(&results[i], XMVector3Transform(XMLoadFloat3(&points[i]), m));
+        }
+    }
+
+    void TransformPointsIndexed(
+        const Vector3* points, const size_t count, const Matrix* matrices, const uint32_t* indices, Vector3* results)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const XMMATRIX m = XMLoadFloat4x4(&matrices[indices[i]]);
+            XMStoreFloat3(&results[i], XMVector3Transform(XMLoadFloat3(&points[i]), m));
+        }
+    }
+
+    void TransformNormals(const Vector3* normals, const size_t count, const Matrix& matrix, Vector3* results)
+    {
+        const XMMATRIX m = XMLoadFloat4x4(&matrix);
+        for (size_t i = 0; i < count; ++i)
+        {
+            XMStoreFloat3(&results[i], XMVector3TransformNormal(XMLoadFloat3(&normals[i]), m));
+        }
+    }
+
+    template <bool Translate>
+    void TransformStream(const ConstVector3Stream input,
+                         const size_t             count,
+                         const Matrix&            matrix,
+                         const Vector3Stream      output)
+    {
+        XMVECTOR m[4][3];
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                m[row][column] = XMVectorReplicate(matrix.m[row][column]);
+            }
+        }
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const XMVECTOR x = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(input.X + i));
+            const XMVECTOR y = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(input.Y + i));
+            const XMVECTOR z = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(input.Z + i));
+
+            float* const outputs[3] = {output.X + i, output.Y + i, output.Z + i};
+            for (int column = 0; column < 3; ++column)
+            {
+                XMVECTOR r = Translate ? m[3][column] : XMVectorZero();
+                r = XMVectorMultiplyAdd(x, m[0][column], r);
+                r = XMVectorMultiplyAdd(y, m[1][column], r);
+                r = XMVectorMultiplyAdd(z, m[2][column], r);
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(outputs[column]), r);
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            const float x = input.X[i];
+            const float y = input.Y[i];
+            const float z = input.Z[i];
+            const float w = Translate ? 1.0f : 0.0f;
+            output.X[i] = x * matrix._11 + y * matrix._21 + z * matrix._31 + w * matrix._41;
+            output.Y[i] = x * matrix._12 + y * matrix._22 + z * matrix._32 + w * matrix._42;
+            output.Z[i] = x * matrix._13 + y * matrix._23 + z * matrix._33 + w * matrix._43;
+        }
+    }
+
+    void TransformPointsSoA(const ConstVector3Stream points,
+                            const size_t             count,
+                            const Matrix&            matrix,
+                            Vector3Stream            results)
+    {
+        TransformStream<true>(points, count, matrix, results);
+    }
+
+    void TransformNormalsSoA(const ConstVector3Stream normals,
+                             const size_t             count,
+                             const Matrix&            matrix,
+                             Vector3Stream            results)
+    {
+        TransformStream<false>(normals, count, matrix, results);
+    }
+
+    /// Transforms the center and sums the extents along the absolute basis vectors.
+    void TransformBox(const BoundingBox& box, FXMMATRIX m, BoundingBox& result)
+    {
+        const XMVECTOR extents = XMLoadFloat3(&box.Extents);
+        XMVECTOR       e = XMVectorMultiply(XMVectorSplatX(extents), XMVectorAbs(m.r[0]));
+        e = XMVectorMultiplyAdd(XMVectorSplatY(extents), XMVectorAbs(m.r[1]), e);
+        e = XMVectorMultiplyAdd(XMVectorSplatZ(extents), XMVectorAbs(m.r[2]), e);
+
+        XMStoreFloat3(&result.Center, XMVector3Transform(XMLoadFloat3(&box.Center), m));
+        XMStoreFloat3(&result.Extents, e);
+    }
+
+    void TransformBounds(const BoundingBox* bounds, const size_t count, const Matrix& matrix, BoundingBox* results)
+    {
+        const XMMATRIX m = XMLoadFloat4x4(&matrix);
+        for (size_t i = 0; i < count; ++i)
+        {
+            TransformBox(bounds[i], m, results[i]);
+        }
+    }
+
+    void TransformBoundsMany(const BoundingBox* bounds,
+                             const size_t       count,
+                             const Matrix*      matrices,
+                             BoundingBox*       results)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            TransformBox(bounds[i], XMLoadFloat4x4(&matrices[i]), results[i]);
+        }
+    }
+
+    void MultiplyMatrices(
+        const Matrix* a, const size_t count, const Matrix* b, const size_t bStride, Matrix* results)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const XMMATRIX product = XMMatrixMultiply(XMLoadFloat4x4(&a[i]), XMLoadFloat4x4(&b[i * bStride]));
+            XMStoreFloat4x4(&results[i], product);
+        }
+    }
+} // namespace
+
+const TransformKernelTable GenericTransformKernels = {
+#if defined(_XM_ARM_NEON_INTRINSICS_)
+    "NEON",
+#elif defined(_XM_NO_INTRINSICS_)
+    "Scalar",
+#else
+    "SSE2",
+#endif
+    TransformPoints,
+    TransformPointsIndexed,
+    TransformNormals,
+    TransformPointsSoA,
+    TransformNormalsSoA,
+    TransformBounds,
+    TransformBoundsMany,
+    MultiplyMatrices,
+};
@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TransformKernelTable.hpp"
+
+#ifdef TRANSFORM_KERNELS_X64
+
+#include <smmintrin.h>
+
+#define SSE41_TARGET KERNEL_TARGET("sse4.1")
+
+namespace
+{
+    constexpr size_t Width = 4;
+
+    struct MatrixLanes
+    {
+        __m128 M[4][3];
+    };
+
+    SSE41_TARGET MatrixLanes Broadcast(const Matrix& matrix)
+    {
+        MatrixLanes lanes;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                lanes.M[row][column] = _mm_set1_ps(matrix.m[row][column]);
+            }
+        }
+        return lanes;
+    }
+
+    template <bool Translate>
+    SSE41_TARGET void Transform(const MatrixLanes& m, __m128& x, __m128& y, __m128& z)
+    {
+        __m128 r[3];
+        for (int column = 0; column < 3; ++column)
+        {
+            r[column] = _mm_mul_ps(x, m.M[0][column]);
+            r[column] = _mm_add_ps(r[column], _mm_mul_ps(y, m.M[1][column]));
+            r[column] = _mm_add_ps(r[column], _mm_mul_ps(z, m.M[2][column]));
+            if (Translate)
+            {
+                r[column] = _mm_add_ps(r[column], m.M[3][column]);
+            }
+        }
+
+        x = r[0];
+        y = r[1];
+        z = r[2];
+    }
+
+    /// Splits four packed xyz triples into one register per component.
+    SSE41_TARGET void Deinterleave(const float* p, __m128& x, __m128& y, __m128& z)
+    {
+        const __m128 m0 = _mm_loadu_ps(p);
+        const __m128 m1 = _mm_loadu_ps(p + 4);
+        const __m128 m2 = _mm_loadu_ps(p + 8);
+
+        const __m128 xy = _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 1, 3, 2));
+        const __m128 yz = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 0, 2, 1));
+        x = _mm_shuffle_ps(m0, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        z = _mm_shuffle_ps(yz, m2, _MM_SHUFFLE(3, 0, 3, 1));
+    }
+
+    /// Inverse of Deinterleave.
+    SSE41_TARGET void Interleave(float* p, const __m128 x, const __m128 y, const __m128 z)
+    {
+        const __m128 xy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_ps(p, _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(p + 4, _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm_storeu_ps(p + 8, _mm_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+
+    /// Loads three floats without reading past them.
+    SSE41_TARGET __m128 Load3(const XMFLOAT3& value)
+    {
+        const __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&value.x)));
+        return _mm_insert_ps(xy, _mm_load_ss(&value.z), 0x20);
+    }
+
+    /// Stores three floats without writing past them.
+    SSE41_TARGET void Store3(XMFLOAT3& value, const __m128 v)
+    {
+        _mm_store_sd(reinterpret_cast<double*>(&value.x), _mm_castps_pd(v));
+        _mm_store_ss(&value.z, _mm_movehl_ps(v, v));
+    }
+
+    template <bool Translate>
+    SSE41_TARGET size_t TransformPacked(const Vector3* input,
+                                        const size_t   count,
+                                        const Matrix&  matrix,
+                                        Vector3*       output)
+    {
+        const MatrixLanes m = Broadcast(matrix);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            __m128 x, y, z;
+            Deinterleave(&input[i].x, x, y, z);
+            Transform<Translate>(m, x, y, z);
+            Interleave(&output[i].x, x, y, z);
+        }
+        return i;
+    }
+
+    SSE41_TARGET void TransformPoints(const Vector3* points,
+                                      const size_t   count,
+                                      const Matrix&  matrix,
+                                      Vector3*       results)
+    {
+        const size_t done = TransformPacked<true>(points, count, matrix, results);
+        GenericTransformKernels.TransformPoints(points + done, count - done, matrix, results + done);
+    }
+
+    SSE41_TARGET void TransformNormals(const Vector3* normals,
+                                       const size_t   count,
+                                       const Matrix&  matrix,
+                                       Vector3*       results)
+    {
+        const size_t done = TransformPacked<false>(normals, count, matrix, results);
+        GenericTransformKernels.TransformNormals(normals + done, count - done, matrix, results + done);
+    }
+
+    SSE41_TARGET void TransformPointsIndexed(
+        const Vector3* points, const size_t count, const Matrix* matrices, const uint32_t* indices, Vector3* results)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float* m = matrices[indices[i]].m[0];
+            const __m128 v = Load3(points[i]);
+
+            __m128 r = _mm_add_ps(_mm_loadu_ps(m + 12), _mm_mul_ps(_mm_shuffle_ps(v, v, 0x00), _mm_loadu_ps(m)));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0x55), _mm_loadu_ps(m + 4)));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xaa), _mm_loadu_ps(m + 8)));
+            Store3(results[i], r);
+        }
+    }
+
+    template <bool Translate>
+    SSE41_TARGET void TransformStream(const ConstVector3Stream input,
+                                      const size_t             count,
+                                      const Matrix&            matrix,
+                                      const Vector3Stream      output)
+    {
+        const MatrixLanes m = Broadcast(matrix);
+
+        size_t i = 0;
+        for (; i + Width <= count; i += Width)
+        {
+            __m128 x = _mm_loadu_ps(input.X + i);
+            __m128 y = _mm_loadu_ps(input.Y + i);
+            __m128 z = _mm_loadu_ps(input.Z + i);
+            Transform<Translate>(m, x, y, z);
+            _mm_storeu_ps(output.X + i, x);
+            _mm_storeu_ps(output.Y + i, y);
+            _mm_storeu_ps(output.Z + i, z);
+        }
+
+        if (Translate)
+        {
+            GenericTransformKernels.TransformPointsSoA(Advance(input, i), count - i, matrix, Advance(output, i));
+        }
+        else
+        {
+            GenericTransformKernels.TransformNormalsSoA(Advance(input, i), count - i, matrix, Advance(output, i));
+        }
+    }
+
+    SSE41_TARGET void TransformPointsSoA(const ConstVector3Stream points,
+                                         const size_t             count,
+                                         const Matrix&            matrix,
+                                         const Vector3Stream      results)
+    {
+        TransformStream<true>(points, count, matrix, results);
+    }
+
+    SSE41_TARGET void TransformNormalsSoA(const ConstVector3Stream normals,
+                                          const size_t             count,
+                                          const Matrix&            matrix,
+                                          const Vector3Stream      results)
+    {
+        TransformStream<false>(normals, count, matrix, results);
+    }
+
+    /// Transforms one box with the matrix rows and their absolute values already loaded.
+    SSE41_TARGET void TransformBox(const BoundingBox& box, const __m128 (&rows)[4], BoundingBox& result)
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 center = Load3(box.Center);
+        const __m128 extents = Load3(box.Extents);
+
+        __m128 c = _mm_add_ps(rows[3], _mm_mul_ps(_mm_shuffle_ps(center, center, 0x00), rows[0]));
+        c = _mm_add_ps(c, _mm_mul_ps(_mm_shuffle_ps(center, center, 0x55), rows[1]));
+        c = _mm_add_ps(c, _mm_mul_ps(_mm_shuffle_ps(center, center, 0xaa), rows[2]));
+
+        __m128 e = _mm_mul_ps(_mm_shuffle_ps(extents, extents, 0x00), _mm_andnot_ps(signMask, rows[0]));
+        e = _mm_add_ps(e, _mm_mul_ps(_mm_shuffle_ps(extents, extents, 0x55), _mm_andnot_ps(signMask, rows[1])));
+        e = _mm_add_ps(e, _mm_mul_ps(_mm_shuffle_ps(extents, extents, 0xaa), _mm_andnot_ps(signMask, rows[2])));
+
+        Store3(result.Center, c);
+        Store3(result.Extents, e);
+    }
+
+    SSE41_TARGET void TransformBounds(const BoundingBox* bounds,
+                                      const size_t       count,
+                                      const Matrix&      matrix,
+                                      BoundingBox*       results)
+    {
+        const __m128 rows[4] = {_mm_loadu_ps(matrix.m[0]), _mm_loadu_ps(matrix.m[1]), _mm_loadu_ps(matrix.m[2]),
+                                _mm_loadu_ps(matrix.m[3])};
+        for (size_t i = 0; i < count; ++i)
+        {
+            TransformBox(bounds[i], rows, results[i]);
+        }
+    }
+
+    SSE41_TARGET void TransformBoundsMany(const BoundingBox* bounds,
+                                          const size_t       count,
+                                          const Matrix*      matrices,
+                                          BoundingBox*       results)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Matrix& matrix = matrices[i];
+            const __m128  rows[4] = {_mm_loadu_ps(matrix.m[0]), _mm_loadu_ps(matrix.m[1]), _mm_loadu_ps(matrix.m[2]),
+                                     _mm_loadu_ps(matrix.m[3])};
+            TransformBox(bounds[i], rows, results[i]);
+        }
+    }
+
+    SSE41_TARGET void MultiplyMatrices(
+        const Matrix* a, const size_t count, const Matrix* b, const size_t bStride, Matrix* results)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Matrix& right = b[i * bStride];
+            const __m128  b0 = _mm_loadu_ps(right.m[0]);
+            const __m128  b1 = _mm_loadu_ps(right.m[1]);
+            const __m128  b2 = _mm_loadu_ps(right.m[2]);
+            const __m128  b3 = _mm_loadu_ps(right.m[3]);
+
+            for (int row = 0; row < 4; ++row)
+            {
+                const __m128 v = _mm_loadu_ps(a[i].m[row]);
+                __m128       r = _mm_mul_ps(_mm_shuffle_ps(v, v, 0x00), b0);
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0x55), b1));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xaa), b2));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xff), b3));
+                _mm_storeu_ps(results[i].m[row], r);
+            }
+        }
+    }
+} // namespace
+
+const TransformKernelTable Sse41TransformKernels = {
+    "SSE4.1",
+    TransformPoints,
+    TransformPointsIndexed,
+    TransformNormals,
+    TransformPointsSoA,
+    TransformNormalsSoA,
+    TransformBounds,
+    TransformBoundsMany,
+    MultiplyMatrices,
+};
+
+#endif
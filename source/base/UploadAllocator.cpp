@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "UploadAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+UploadAllocator::UploadAllocator(UploadPageSource& source, const uint64_t pageSize)
+    : m_source(source), m_pageSize(pageSize)
+{
+}
+
+UploadAllocator::~UploadAllocator()
+{
+    for (const UploadPage& page : m_freePages)
+    {
+        m_source.DestroyPage(page);
+    }
+    for (const RetiredPage& retired : m_retiredPages)
+    {
+        m_source.DestroyPage(retired.Page);
+    }
+    for (const UploadPage& page : m_framePages)
+    {
+        m_source.DestroyPage(page);
+    }
+    for (const UploadPage& page : m_frameDedicatedPages)
+    {
+        m_source.DestroyPage(page);
+    }
+    if (m_page.CpuAddress != nullptr)
+    {
+        m_source.DestroyPage(m_page);
+    }
+}
+
+UploadAllocation UploadAllocator::Allocate(const uint64_t size, const uint64_t alignment)
+{
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+    const uint64_t alignedSize = (size + alignment - 1) & ~(alignment - 1);
+
+    // Pages are aligned to ConstantBufferAlignment, so larger alignments need a page of their own too.
+    if (alignedSize > m_pageSize || alignment > ConstantBufferAlignment)
+    {
+        const UploadPage page = m_source.CreatePage(alignedSize + alignment);
+        if (page.CpuAddress == nullptr)
+        {
+            throw std::runtime_error("Failed to create upload page");
+        }
+        m_frameDedicatedPages.push_back(page);
+        m_stats.ReservedBytes += page.Size;
+        ++m_stats.Pages;
+        m_stats.FrameBytes += page.Size;
+
+        const uint64_t padding = (alignment - (page.GpuAddress & (alignment - 1))) & (alignment - 1);
+        return {page.CpuAddress + padding, page.GpuAddress + padding, size};
+    }
+
+    uint64_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+    if (m_page.CpuAddress == nullptr || offset + alignedSize > m_page.Size)
+    {
+        NextPage();
+        offset = 0;
+    }
+
+    m_stats.FrameBytes += offset + alignedSize - m_offset;
+    m_offset = offset + alignedSize;
+    return {m_page.CpuAddress + offset, m_page.GpuAddress + offset, size};
+}
+
+void UploadAllocator::BeginFrame(const uint64_t completedFenceValue)
+{
+    const auto finished = std::find_if(m_retiredPages.begin(), m_retiredPages.end(), [&](const RetiredPage& retired) {
+        return retired.FenceValue > completedFenceValue;
+    });
+    for (auto retired = m_retiredPages.begin(); retired != finished; ++retired)
+    {
+        if (retired->Dedicated)
+        {
+            m_stats.ReservedBytes -= retired->Page.Size;
+            --m_stats.Pages;
+            m_source.DestroyPage(retired->Page);
+        }
+        else
+        {
+            m_freePages.push_back(retired->Page);
+        }
+    }
+    m_retiredPages.erase(m_retiredPages.begin(), finished);
+}
+
+void UploadAllocator::EndFrame(const uint64_t fenceValue)
+{
+    if (m_page.CpuAddress != nullptr)
+    {
+        m_framePages.push_back(m_page);
+        m_page = {};
+        m_offset = 0;
+    }
+    for (const UploadPage& page : m_framePages)
+    {
+        m_retiredPages.push_back({fenceValue, page, false});
+    }
+    for (const UploadPage& page : m_frameDedicatedPages)
+    {
+        m_retiredPages.push_back({fenceValue, page, true});
+    }
+    m_framePages.clear();
+    m_frameDedicatedPages.clear();
+
+    m_stats.HighWaterBytes = std::max(m_stats.HighWaterBytes, m_stats.FrameBytes);
+    m_stats.FrameBytes = 0;
+}
+
+const UploadAllocator::Statistics& UploadAllocator::Stats() const
+{
+    return m_stats;
+}
+
+void UploadAllocator::NextPage()
+{
+    if (m_page.CpuAddress != nullptr)
+    {
+        // The unused tail of the page counts towards the frame, since nothing else can use it.
+        m_stats.FrameBytes += m_page.Size - m_offset;
+        m_framePages.push_back(m_page);
+    }
+
+    if (!m_freePages.empty())
+    {
+        m_page = m_freePages.back();
+        m_freePages.pop_back();
+    }
+    else
+    {
+        m_page = m_source.CreatePage(m_pageSize);
+        if (m_page.CpuAddress == nullptr)
+        {
+            throw std::runtime_error("Failed to create upload page");
+        }
+        m_stats.ReservedBytes += m_page.Size;
+        ++m_stats.Pages;
+    }
+    m_offset = 0;
+}
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "StreamingCopy.hpp"
+
+struct ID3D12Device;
+
+/// Persistently mapped block of upload memory.
+struct UploadPage
+{
+    uint8_t* CpuAddress = nullptr;
+    uint64_t GpuAddress = 0;
+    uint64_t Size = 0;
+    void*    Owner = nullptr; ///< Whatever the UploadPageSource needs to release the page.
+};
+
+/// @brief Creates and releases the pages an UploadAllocator hands out slices of.
+class UploadPageSource
+{
+public:
+    virtual ~UploadPageSource() = default;
+
+    [[nodiscard]] virtual UploadPage CreatePage(uint64_t size) = 0;
+
+    virtual void DestroyPage(const UploadPage& page) = 0;
+};
+
+/// @brief UploadPageSource that maps buffers in the D3D12 upload heap.
+class D3D12UploadPageSource final : public UploadPageSource
+{
+public:
+    explicit D3D12UploadPageSource(ID3D12Device* device);
+
+    [[nodiscard]] UploadPage CreatePage(uint64_t size) override;
+
+    void DestroyPage(const UploadPage& page) override;
+
+private:
+    ID3D12Device* m_device;
+};
+
+/// Slice of upload memory that is valid until the frame it was allocated in finishes.
+struct UploadAllocation
+{
+    uint8_t* CpuAddress = nullptr;
+    uint64_t GpuAddress = 0;
+    uint64_t Size = 0;
+};
+
+/// @brief Hands out upload memory for data that changes every frame, such as constants.
+///
+/// Allocation bumps an offset in the current page and takes another page when it is
+/// full, creating one when none is free, so the allocator grows to what a frame needs.
+/// EndFrame() tags the pages of the frame with the fence value it signals and
+/// BeginFrame() recycles the pages of frames the GPU has finished. Slices that do not
+/// fit in a page get a page of their own, released instead of recycled.
+class UploadAllocator final
+{
+public:
+    static constexpr uint64_t ConstantBufferAlignment = 256;
+    static constexpr uint64_t DefaultPageSize = 64 * 1024;
+
+    struct Statistics
+    {
+        uint64_t FrameBytes = 0;     ///< Bytes allocated by the current frame, including alignment padding.
+        uint64_t HighWaterBytes = 0; ///< Most bytes any frame allocated.
+        uint64_t ReservedBytes = 0;  ///< Size of all pages, free or in use.
+        uint32_t Pages = 0;
+    };
+
+    explicit UploadAllocator(UploadPageSource& source, uint64_t pageSize = DefaultPageSize);
+
+    UploadAllocator(const UploadAllocator&) = delete;
+    UploadAllocator& operator=(const UploadAllocator&) = delete;
+
+    ~UploadAllocator();
+
+    /// @param [in] alignment Power of two; the default suits constant buffer views.
+    [[nodiscard]] UploadAllocation Allocate(uint64_t size, uint64_t alignment = ConstantBufferAlignment);
+
+    /// @brief Allocates a constant buffer slice and streams data into it.
+    template <typename T>
+    [[nodiscard]] UploadAllocation Upload(const T& data)
+    {
+        const UploadAllocation allocation = Allocate(sizeof(T));
+        StreamingCopy::Copy(allocation.CpuAddress, &data, sizeof(T));
+        return allocation;
+    }
+
+    /// @brief Recycles the pages of frames whose fence value has completed.
+    void BeginFrame(uint64_t completedFenceValue);
+
+    /// @brief Tags the pages allocated from since the last call with the fence value the frame signals.
+    void EndFrame(uint64_t fenceValue);
+
+    [[nodiscard]] const Statistics& Stats() const;
+
+private:
+    struct RetiredPage
+    {
+        uint64_t   FenceValue;
+        UploadPage Page;
+        bool       Dedicated;
+    };
+
+    void NextPage();
+
+    UploadPageSource&        m_source;
+    uint64_t                 m_pageSize;
+    std::vector<UploadPage>  m_freePages;
+    std::vector<RetiredPage> m_retiredPages; ///< In fence order.
+    std::vector<UploadPage>  m_framePages;   ///< Full pages of the current frame.
+    std::vector<UploadPage>  m_frameDedicatedPages;
+    UploadPage               m_page;
+    uint64_t                 m_offset = 0;
+    Statistics               m_stats;
+};
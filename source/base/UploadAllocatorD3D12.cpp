@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "UploadAllocator.hpp"
+
+#include <directx/d3d12.h>
+#include <directx/d3dx12.h>
+#include <winrt/base.h>
+
+D3D12UploadPageSource::D3D12UploadPageSource(ID3D12Device* device) : m_device(device)
+{
+}
+
+UploadPage D3D12UploadPageSource::CreatePage(const uint64_t size)
+{
+    const auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    const auto resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+    winrt::com_ptr<ID3D12Resource> buffer;
+    winrt::check_hresult(m_device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc,
+                                                           D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+                                                           IID_PPV_ARGS(&buffer)));
+    winrt::check_hresult(buffer->SetName(L"UploadAllocator::Page"));
+
+    // Upload heap pages stay mapped for their whole life; the CPU never reads them.
+    UploadPage          page;
+    const CD3DX12_RANGE readRange(0, 0);
+    winrt::check_hresult(buffer->Map(0, &readRange, reinterpret_cast<void**>(&page.CpuAddress)));
+    page.GpuAddress = buffer->GetGPUVirtualAddress();
+    page.Size = size;
+    page.Owner = buffer.detach();
+    return page;
+}
+
+void D3D12UploadPageSource::DestroyPage(const UploadPage& page)
+{
+    winrt::com_ptr<ID3D12Resource> buffer;
+    buffer.attach(static_cast<ID3D12Resource*>(page.Owner));
+    buffer->Unmap(0, nullptr);
+}
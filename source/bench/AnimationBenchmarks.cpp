@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Animation.hpp"
+#include "AnimationCompression.hpp"
+#include "GraphicsMath.hpp"
+#include "ThreadPool.hpp"
+
+namespace
+{
+    constexpr uint32_t CharacterCount = 64;
+    constexpr uint32_t KeyCount = 30;
+
+    float Random(std::mt19937& random, const float low, const float high)
+    {
+        return std::uniform_real_distribution<float>(low, high)(random);
+    }
+
+    /// A binary tree of joints, a rough stand-in for a humanoid with fingers and face bones.
+    Skeleton MakeSkeleton(const uint32_t jointCount)
+    {
+        Skeleton skeleton;
+        for (uint32_t joint = 0; joint < jointCount; ++joint)
+        {
+            JointPose pose;
+            pose.Translation = Vector3(0.0f, 0.1f, 0.0f);
+
+            skeleton.JointNames.push_back(fmt::format("joint{}", joint));
+            skeleton.Parents.push_back(joint == 0 ? Skeleton::NoParent : static_cast<int32_t>((joint - 1) / 2));
+            skeleton.BindPose.push_back(pose);
+            skeleton.InverseBindMatrices.push_back(Matrix::Identity);
+        }
+        return skeleton;
+    }
+
+    /// A one second clip that rotates every joint and moves the root.
+    AnimationClip MakeClip(std::mt19937& random, const uint32_t jointCount)
+    {
+        AnimationClip clip;
+        clip.Duration = 1.0f;
+        for (uint32_t joint = 0; joint < jointCount; ++joint)
+        {
+            JointTrack& track = clip.Tracks.emplace_back();
+            track.Joint = joint;
+            for (uint32_t key = 0; key < KeyCount; ++key)
+            {
+                const float time = static_cast<float>(key) / static_cast<float>(KeyCount - 1);
+                track.Rotation.Times.push_back(time);
+                track.Rotation.Values.push_back(Quaternion::CreateFromYawPitchRoll(
+                    Random(random, -0.5f, 0.5f), Random(random, -0.5f, 0.5f), Random(random, -0.5f, 0.5f)));
+
+                if (joint == 0)
+                {
+                    track.Translation.Times.push_back(time);
+                    track.Translation.Values.emplace_back(Random(random, -1.0f, 1.0f), 1.0f, time);
+                }
+            }
+        }
+        return clip;
+    }
+
+    /// A two second clip sampled at 30 Hz from smooth curves, as exported from a DCC tool.
+    AnimationClip MakeSmoothClip(std::mt19937& random, const uint32_t jointCount)
+    {
+        constexpr uint32_t FrameCount = 61;
+
+        AnimationClip clip;
+        clip.Duration = 2.0f;
+        for (uint32_t joint = 0; joint < jointCount; ++joint)
+        {
+            const Vector3 amplitude(Random(random, 0.0f, 0.6f), Random(random, 0.0f, 0.3f), Random(random, 0.0f, 0.3f));
+            const float   phase = Random(random, 0.0f, XM_2PI);
+
+            JointTrack& track = clip.Tracks.emplace_back();
+            track.Joint = joint;
+            for (uint32_t frame = 0; frame < FrameCount; ++frame)
+            {
+                const float time = static_cast<float>(frame) / 30.0f;
+                const float wave = std::sin(time * XM_PI + phase);
+                track.Rotation.Times.push_back(time);
+                track.Rotation.Values.push_back(
+                    Quaternion::CreateFromYawPitchRoll(amplitude.x * wave, amplitude.y * wave, amplitude.z * wave));
+
+                // Scale keys that never change, as exporters often write them.
+                track.Scale.Times.push_back(time);
+                track.Scale.Values.push_back(Vector3::One);
+
+                if (joint == 0)
+                {
+                    track.Translation.Times.push_back(time);
+                    track.Translation.Values.emplace_back(0.0f, 1.0f + 0.05f * wave, time * 1.5f);
+                }
+            }
+        }
+        return clip;
+    }
+
+    /// @brief Compresses a clip, printing the size and error of the result.
+    CompressedClip CompressAndReport(const Skeleton& skeleton, const AnimationClip& clip)
+    {
+        AnimationCompressor      compressor;
+        CompressedClip           compressed = compressor.Compress(skeleton, clip);
+        const CompressionReport& report = compressor.Report();
+        fmt::print("  {} bones: {} -> {} bytes ({:.1f}x), {} of {} keys, max error {:.3f} mm, {:.5f} rad\n",
+                   skeleton.JointCount(), report.RawBytes, report.CompressedBytes, report.Ratio(),
+                   report.CompressedKeys, report.RawKeys, report.MaxPositionError * 1000.0f, report.MaxRotationError);
+        return compressed;
+    }
+
+    /// @brief Compresses the clip the benchmarks sample and checks the round trip.
+    /// @throws std::runtime_error if a decoded track exceeds its error bound.
+    void ValidateCompression(const uint32_t jointCount)
+    {
+        std::mt19937        random(jointCount);
+        const Skeleton      skeleton = MakeSkeleton(jointCount);
+        AnimationCompressor compressor;
+        (void)compressor.Compress(skeleton, MakeSmoothClip(random, jointCount));
+
+        const CompressionReport& report = compressor.Report();
+        if (report.ToleranceViolations > 0)
+        {
+            throw std::runtime_error(
+                fmt::format("Compressed clip exceeded its error bounds in {} samples", report.ToleranceViolations));
+        }
+    }
+
+    /// One pose per call, playing forwards at 60 Hz so compressed decoding takes the sequential path.
+    void AddCompressionBenchmarks(BenchmarkRunner& runner, const uint32_t jointCount)
+    {
+        runner.AddCheck(fmt::format("AnimationCompression/Error bounds, {} bones", jointCount),
+                        [jointCount] { ValidateCompression(jointCount); });
+
+        runner.Add(fmt::format("AnimationCompression/Sample raw, {} bones", jointCount), 1, [jointCount] {
+            std::mt19937 random(jointCount);
+            auto         skeleton = std::make_shared<Skeleton>(MakeSkeleton(jointCount));
+            return [skeleton, clip = MakeSmoothClip(random, jointCount), pose = std::vector<JointPose>(jointCount),
+                    sampler = AnimationSampler(), time = 0.0f]() mutable {
+                time += 1.0f / 60.0f;
+                sampler.Sample(*skeleton, clip, time, true, pose);
+                DoNotOptimize(pose.back());
+            };
+        });
+
+        runner.Add(fmt::format("AnimationCompression/Sample compressed, {} bones", jointCount), 1, [jointCount] {
+            std::mt19937 random(jointCount);
+            auto         skeleton = std::make_shared<Skeleton>(MakeSkeleton(jointCount));
+            auto         clip = CompressAndReport(*skeleton, MakeSmoothClip(random, jointCount));
+            return [skeleton, clip = std::move(clip), pose = std::vector<JointPose>(jointCount),
+                    sampler = AnimationSampler(), cursor = CompressedClipCursor(), time = 0.0f]() mutable {
+                time += 1.0f / 60.0f;
+                sampler.Sample(*skeleton, clip, cursor, time, true, pose);
+                DoNotOptimize(pose.back());
+            };
+        });
+    }
+
+    /// Every character blends two clips, as during a locomotion cross-fade.
+    void AddCharacterBenchmark(BenchmarkRunner& runner, const uint32_t jointCount, const RotationBlend rotationBlend)
+    {
+        const char* blendName = rotationBlend == RotationBlend::Nlerp ? "nlerp" : "slerp";
+        const auto  name =
+            fmt::format("Animation/Evaluate {} characters, {} bones, {}", CharacterCount, jointCount, blendName);
+
+        runner.Add(name, CharacterCount, [jointCount, rotationBlend] {
+            std::mt19937 random(jointCount);
+            auto         skeleton = std::make_shared<Skeleton>(MakeSkeleton(jointCount));
+            auto         clips = std::make_shared<std::vector<AnimationClip>>();
+            clips->push_back(MakeClip(random, jointCount));
+            clips->push_back(MakeClip(random, jointCount));
+
+            std::vector<AnimatedCharacter> characters(CharacterCount);
+            for (AnimatedCharacter& character : characters)
+            {
+                character.Rig = skeleton.get();
+                character.Layers = {{&(*clips)[0], Random(random, 0.0f, 1.0f), 0.7f},
+                                    {&(*clips)[1], Random(random, 0.0f, 1.0f), 0.3f}};
+            }
+
+            return [skeleton, clips, characters = std::move(characters), pool = std::make_shared<ThreadPool>(),
+                    animator = std::make_shared<CharacterAnimator>(rotationBlend)]() mutable {
+                for (AnimatedCharacter& character : characters)
+                {
+                    for (AnimationSampler::Layer& layer : character.Layers)
+                    {
+                        layer.Time += 1.0f / 60.0f;
+                    }
+                }
+
+                animator->Evaluate(characters, *pool);
+                DoNotOptimize(characters.front().Palette.back());
+            };
+        });
+    }
+} // namespace
+
+/// Evaluate items are characters, so characters per millisecond is 1e6 divided by the reported ns/item.
+/// The compressed sampling benchmarks print the size and error of their clip.
+void AddAnimationBenchmarks(BenchmarkRunner& runner)
+{
+    for (const uint32_t jointCount : {64u, 128u, 256u})
+    {
+        AddCharacterBenchmark(runner, jointCount, RotationBlend::Nlerp);
+    }
+    AddCharacterBenchmark(runner, 128, RotationBlend::Slerp);
+
+    for (const uint32_t jointCount : {64u, 256u})
+    {
+        AddCompressionBenchmarks(runner, jointCount);
+    }
+}
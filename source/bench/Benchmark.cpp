@@ -0,0 +1,350 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "CpuFeatures.hpp"
+#include "TransformKernels.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define BENCHMARK_HAS_TSC
+#ifndef _MSC_VER
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t ReadCycleCounter()
+    {
+#ifdef BENCHMARK_HAS_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    double ElapsedNanoseconds(const Clock::time_point start, const Clock::time_point end)
+    {
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    /// Nearest-rank percentile of sorted values.
+    double Percentile(const std::vector<double>& sorted, const double percentile)
+    {
+        const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    std::string EscapeJson(const std::string& text)
+    {
+        std::string escaped;
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    /// Reads the flat objects of a JSON document into key/value maps. Only strings,
+    /// numbers and null are kept; nesting is flattened, which is all WriteJson produces.
+    std::vector<std::map<std::string, std::string>> ReadJsonObjects(const std::string& text)
+    {
+        std::vector<std::map<std::string, std::string>> objects;
+        std::vector<std::map<std::string, std::string>> open;
+        std::string                                     key;
+
+        size_t i = 0;
+        while (i < text.size())
+        {
+            const char c = text[i];
+            if (c == '{')
+            {
+                open.emplace_back();
+                key.clear();
+                ++i;
+            }
+            else if (c == '}')
+            {
+                if (open.empty())
+                {
+                    throw std::runtime_error("Unbalanced braces in JSON");
+                }
+                objects.push_back(std::move(open.back()));
+                open.pop_back();
+                ++i;
+            }
+            else if (c == '"')
+            {
+                std::string value;
+                for (++i; i < text.size() && text[i] != '"'; ++i)
+                {
+                    if (text[i] == '\\' && i + 1 < text.size())
+                    {
+                        ++i;
+                    }
+                    value += text[i];
+                }
+                ++i;
+
+                if (key.empty())
+                {
+                    key = std::move(value);
+                }
+                else if (!open.empty())
+                {
+                    open.back()[key] = std::move(value);
+                    key.clear();
+                }
+            }
+            else if (c == '-' || c == '.' || std::isalnum(static_cast<unsigned char>(c)))
+            {
+                const size_t start = i;
+                while (i < text.size() && (text[i] == '-' || text[i] == '+' || text[i] == '.' ||
+                                           std::isalnum(static_cast<unsigned char>(text[i]))))
+                {
+                    ++i;
+                }
+
+                if (!key.empty() && !open.empty())
+                {
+                    open.back()[key] = text.substr(start, i - start);
+                }
+                key.clear();
+            }
+            else
+            {
+                // Arrays only matter for the objects they contain.
+                if (c == '[')
+                {
+                    key.clear();
+                }
+                ++i;
+            }
+        }
+
+        return objects;
+    }
+} // namespace
+
+void BenchmarkRunner::Add(std::string name, const uint64_t itemsPerCall, Setup setup)
+{
+    m_entries.push_back({std::move(name), std::max<uint64_t>(itemsPerCall, 1), std::move(setup)});
+}
+
+void BenchmarkRunner::AddCheck(std::string name, Check check)
+{
+    m_checks.emplace_back(std::move(name), std::move(check));
+}
+
+std::vector<std::string> BenchmarkRunner::Names() const
+{
+    std::vector<std::string> names;
+    for (const Entry& entry : m_entries)
+    {
+        names.push_back(entry.Name);
+    }
+    return names;
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::Run(const Settings& settings) const
+{
+    fmt::print("{:<56} {:>12} {:>12} {:>10}\n", "benchmark", "median ns", "p99 ns", "cycles");
+
+    std::vector<BenchmarkResult> results;
+    for (const Entry& entry : m_entries)
+    {
+        if (entry.Name.find(settings.Filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        const BenchmarkResult& result = results.emplace_back(Measure(entry, settings));
+        const std::string      cycles = result.CyclesPerItem < 0.0 ? "-" : fmt::format("{:.1f}", result.CyclesPerItem);
+        fmt::print("{:<56} {:>12.2f} {:>12.2f} {:>10}\n", result.Name, result.MedianNanoseconds,
+                   result.P99Nanoseconds, cycles);
+    }
+
+    return results;
+}
+
+uint32_t BenchmarkRunner::Validate() const
+{
+    uint32_t failures = 0;
+    for (const auto& [name, check] : m_checks)
+    {
+        try
+        {
+            check();
+            fmt::print("{:<56} ok\n", name);
+        }
+        catch (const std::exception& e)
+        {
+            ++failures;
+            fmt::print("{:<56} FAILED: {}\n", name, e.what());
+        }
+    }
+
+    fmt::print("\n{} of {} checks failed\n", failures, m_checks.size());
+    return failures;
+}
+
+BenchmarkResult BenchmarkRunner::Measure(const Entry& entry, const Settings& settings)
+{
+    const Body body = entry.Create();
+
+    // Warm caches, branch predictors and clocks, and count how many calls fit in the warmup.
+    uint64_t     warmupCalls = 0;
+    const auto   warmupStart = Clock::now();
+    const double warmupNanoseconds = settings.WarmupMilliseconds * 1e6;
+    double       warmupElapsed = 0.0;
+    do
+    {
+        body();
+        ++warmupCalls;
+        warmupElapsed = ElapsedNanoseconds(warmupStart, Clock::now());
+    } while (warmupElapsed < warmupNanoseconds);
+
+    const double nanosecondsPerCall = warmupElapsed / static_cast<double>(warmupCalls);
+    const auto   callsPerSample =
+        static_cast<uint64_t>(std::max(1.0, std::ceil(settings.SampleMilliseconds * 1e6 / nanosecondsPerCall)));
+    const double itemsPerSample = static_cast<double>(callsPerSample * entry.ItemsPerCall);
+
+    std::vector<double> nanoseconds(std::max<uint32_t>(settings.Samples, 1));
+    std::vector<double> cycles(nanoseconds.size());
+    for (size_t sample = 0; sample < nanoseconds.size(); ++sample)
+    {
+        const auto     start = Clock::now();
+        const uint64_t startCycles = ReadCycleCounter();
+        for (uint64_t call = 0; call < callsPerSample; ++call)
+        {
+            body();
+        }
+        const uint64_t endCycles = ReadCycleCounter();
+        const auto     end = Clock::now();
+
+        nanoseconds[sample] = ElapsedNanoseconds(start, end) / itemsPerSample;
+        cycles[sample] = static_cast<double>(endCycles - startCycles) / itemsPerSample;
+    }
+
+    std::sort(nanoseconds.begin(), nanoseconds.end());
+    std::sort(cycles.begin(), cycles.end());
+
+    BenchmarkResult result;
+    result.Name = entry.Name;
+    result.ItemsPerCall = entry.ItemsPerCall;
+    result.CallsPerSample = callsPerSample;
+    result.Samples = static_cast<uint32_t>(nanoseconds.size());
+    result.MedianNanoseconds = Percentile(nanoseconds, 50.0);
+    result.P99Nanoseconds = Percentile(nanoseconds, 99.0);
+    result.MinNanoseconds = nanoseconds.front();
+#ifdef BENCHMARK_HAS_TSC
+    result.CyclesPerItem = Percentile(cycles, 50.0);
+#endif
+    return result;
+}
+
+void BenchmarkRunner::WriteJson(const std::vector<BenchmarkResult>& results, const std::string& path)
+{
+    std::ofstream stream(path, std::ios::trunc);
+    if (!stream)
+    {
+        throw std::runtime_error(fmt::format("Failed to open {} for write", path));
+    }
+
+    stream << "{\n";
+    stream << fmt::format("  \"simd_level\": \"{}\",\n", SimdLevelName(SelectedSimdLevel()));
+    stream << fmt::format("  \"transform_kernels\": \"{}\",\n", TransformKernels::PathName());
+    stream << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        const std::string      cycles =
+            result.CyclesPerItem < 0.0 ? "null" : fmt::format("{:.3f}", result.CyclesPerItem);
+
+        stream << "    {";
+        stream << fmt::format("\"name\": \"{}\", ", EscapeJson(result.Name));
+        stream << fmt::format("\"items_per_call\": {}, ", result.ItemsPerCall);
+        stream << fmt::format("\"calls_per_sample\": {}, ", result.CallsPerSample);
+        stream << fmt::format("\"samples\": {}, ", result.Samples);
+        stream << fmt::format("\"median_ns\": {:.4f}, ", result.MedianNanoseconds);
+        stream << fmt::format("\"p99_ns\": {:.4f}, ", result.P99Nanoseconds);
+        stream << fmt::format("\"min_ns\": {:.4f}, ", result.MinNanoseconds);
+        stream << fmt::format("\"cycles_per_item\": {}", cycles);
+        stream << (i + 1 < results.size() ? "},\n" : "}\n");
+    }
+    stream << "  ]\n";
+    stream << "}\n";
+}
+
+std::vector<std::pair<std::string, double>> BenchmarkRunner::ReadBaseline(const std::string& path)
+{
+    std::ifstream stream(path);
+    if (!stream)
+    {
+        throw std::runtime_error(fmt::format("Failed to open {} for read", path));
+    }
+
+    std::stringstream text;
+    text << stream.rdbuf();
+
+    std::vector<std::pair<std::string, double>> baseline;
+    for (const auto& object : ReadJsonObjects(text.str()))
+    {
+        const auto name = object.find("name");
+        const auto median = object.find("median_ns");
+        if (name != object.end() && median != object.end())
+        {
+            baseline.emplace_back(name->second, std::stod(median->second));
+        }
+    }
+
+    return baseline;
+}
+
+uint32_t BenchmarkRunner::Compare(const std::vector<BenchmarkResult>&                results,
+                                  const std::vector<std::pair<std::string, double>>& baseline,
+                                  const double                                       tolerance)
+{
+    fmt::print("\n{:<56} {:>12} {:>12} {:>9}\n", "benchmark", "baseline ns", "median ns", "change");
+
+    uint32_t regressions = 0;
+    for (const BenchmarkResult& result : results)
+    {
+        const auto match = std::find_if(baseline.begin(), baseline.end(),
+                                        [&](const auto& entry) { return entry.first == result.Name; });
+        if (match == baseline.end() || match->second <= 0.0)
+        {
+            fmt::print("{:<56} {:>12} {:>12.2f} {:>9}\n", result.Name, "-", result.MedianNanoseconds, "new");
+            continue;
+        }
+
+        const double change = result.MedianNanoseconds / match->second - 1.0;
+        const bool   regressed = change > tolerance;
+        regressions += regressed ? 1 : 0;
+
+        fmt::print("{:<56} {:>12.2f} {:>12.2f} {:>+8.1f}%{}\n", result.Name, match->second, result.MedianNanoseconds,
+                   change * 100.0, regressed ? "  REGRESSION" : "");
+    }
+
+    return regressions;
+}
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// @brief Keeps the compiler from discarding a value whose computation is being measured.
+template <typename T>
+void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const volatile void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#endif
+}
+
+/// @brief Summary of all samples taken for one benchmark.
+struct BenchmarkResult
+{
+    std::string Name;
+    uint64_t    ItemsPerCall = 1;
+    uint64_t    CallsPerSample = 0;
+    uint32_t    Samples = 0;
+    double      MedianNanoseconds = 0.0; ///< Median time per item.
+    double      P99Nanoseconds = 0.0;    ///< 99th percentile (nearest rank) time per item.
+    double      MinNanoseconds = 0.0;
+    double      CyclesPerItem = -1.0; ///< Median time stamp counter ticks per item, negative when unavailable.
+};
+
+/// @brief Collects benchmarks, runs them and compares the results with a baseline.
+///
+/// Every benchmark is warmed up for a fixed time, which also calibrates how many
+/// calls make up one sample. Each sample is then timed as a whole and divided by the
+/// number of items processed, so a call that transforms 1024 points reports the cost
+/// per point. Correctness checks are registered next to the benchmarks they cover but
+/// run separately, untimed and regardless of the filter.
+class BenchmarkRunner final
+{
+public:
+    /// Measured function. Each call processes ItemsPerCall items.
+    using Body = std::function<void()>;
+
+    /// Builds the state a benchmark needs and returns the function to measure. The
+    /// returned function, and anything it captures, is destroyed once the benchmark ends.
+    using Setup = std::function<Body()>;
+
+    /// Correctness check, which throws std::runtime_error on the first mismatch.
+    using Check = std::function<void()>;
+
+    struct Settings
+    {
+        std::string Filter;                 ///< Only benchmarks whose name contains this run.
+        double      WarmupMilliseconds = 100.0;
+        double      SampleMilliseconds = 2.0; ///< Minimum duration of one sample.
+        uint32_t    Samples = 31;
+    };
+
+    void Add(std::string name, uint64_t itemsPerCall, Setup setup);
+
+    void AddCheck(std::string name, Check check);
+
+    /// @brief Gets the names of all registered benchmarks.
+    [[nodiscard]] std::vector<std::string> Names() const;
+
+    /// @brief Runs every benchmark that matches the filter and prints a line for each.
+    [[nodiscard]] std::vector<BenchmarkResult> Run(const Settings& settings) const;
+
+    /// @brief Runs every check once and prints a line for each.
+    /// @return Number of checks that failed.
+    [[nodiscard]] uint32_t Validate() const;
+
+    /// @brief Writes results as JSON, including the SIMD level they were measured with.
+    static void WriteJson(const std::vector<BenchmarkResult>& results, const std::string& path);
+
+    /// @brief Reads the median time per item of each benchmark from a file written by WriteJson.
+    static std::vector<std::pair<std::string, double>> ReadBaseline(const std::string& path);
+
+    /// @brief Prints how each result compares with the baseline.
+    /// @param [in] tolerance Allowed relative slowdown, e.g. 0.1 for 10%.
+    /// @return Number of benchmarks whose median regressed beyond the tolerance.
+    static uint32_t Compare(const std::vector<BenchmarkResult>&                results,
+                            const std::vector<std::pair<std::string, double>>& baseline,
+                            double                                             tolerance);
+
+private:
+    struct Entry
+    {
+        std::string Name;
+        uint64_t    ItemsPerCall;
+        Setup       Create;
+    };
+
+    static BenchmarkResult Measure(const Entry& entry, const Settings& settings);
+
+    std::vector<Entry>                         m_entries;
+    std::vector<std::pair<std::string, Check>> m_checks;
+};
+
+void AddMathBenchmarks(BenchmarkRunner& runner);
+
+void AddPlatformBenchmarks(BenchmarkRunner& runner);
+
+void AddSceneBenchmarks(BenchmarkRunner& runner);
+
+void AddAnimationBenchmarks(BenchmarkRunner& runner);
+
+void AddSkinningBenchmarks(BenchmarkRunner& runner);
+
+void AddMorphBenchmarks(BenchmarkRunner& runner);
+
+void AddFrameGraphBenchmarks(BenchmarkRunner& runner);
+
+void AddDescriptorBenchmarks(BenchmarkRunner& runner);
+
+void AddUploadBenchmarks(BenchmarkRunner& runner);
+
+void AddCopyBenchmarks(BenchmarkRunner& runner);
+
+void AddCommandContextBenchmarks(BenchmarkRunner& runner);
+
+void AddCommandListBenchmarks(BenchmarkRunner& runner);
+
+void AddFenceTimelineBenchmarks(BenchmarkRunner& runner);
+
+void AddPipelineBenchmarks(BenchmarkRunner& runner);
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "CommandContext.hpp"
+
+namespace
+{
+    constexpr uint32_t TriangleList = 4; ///< D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST
+
+    enum class Call : uint8_t
+    {
+        RootSignature,
+        DescriptorHeaps,
+        PipelineState,
+        Topology,
+        DescriptorTable,
+        ConstantBufferView,
+        Constants,
+        VertexBuffers,
+        IndexBuffer,
+        Barrier,
+        Draw,
+    };
+
+    /// @brief Backend that keeps the calls it received in order, standing in for the command list.
+    class RecordingBackend final : public CommandBackend
+    {
+    public:
+        std::vector<Call> Calls;
+
+        void SetGraphicsRootSignature(ID3D12RootSignature*) override
+        {
+            Calls.push_back(Call::RootSignature);
+        }
+
+        void SetDescriptorHeaps(uint32_t, ID3D12DescriptorHeap* const*) override
+        {
+            Calls.push_back(Call::DescriptorHeaps);
+        }
+
+        void SetPipelineState(ID3D12PipelineState*) override
+        {
+            Calls.push_back(Call::PipelineState);
+        }
+
+        void IASetPrimitiveTopology(uint32_t) override
+        {
+            Calls.push_back(Call::Topology);
+        }
+
+        void SetGraphicsRootDescriptorTable(uint32_t, uint64_t) override
+        {
+            Calls.push_back(Call::DescriptorTable);
+        }
+
+        void SetGraphicsRootConstantBufferView(uint32_t, uint64_t) override
+        {
+            Calls.push_back(Call::ConstantBufferView);
+        }
+
+        void SetGraphicsRoot32BitConstants(uint32_t, uint32_t, const void*, uint32_t) override
+        {
+            Calls.push_back(Call::Constants);
+        }
+
+        void IASetVertexBuffers(uint32_t, uint32_t, const VertexBufferView*) override
+        {
+            Calls.push_back(Call::VertexBuffers);
+        }
+
+        void IASetIndexBuffer(const IndexBufferView*) override
+        {
+            Calls.push_back(Call::IndexBuffer);
+        }
+
+        void ResourceBarrier(uint32_t, const D3D12_RESOURCE_BARRIER*) override
+        {
+            Calls.push_back(Call::Barrier);
+        }
+
+        void DrawInstanced(uint32_t, uint32_t, uint32_t, uint32_t) override
+        {
+            Calls.push_back(Call::Draw);
+        }
+
+        void DrawIndexedInstanced(uint32_t, uint32_t, uint32_t, int32_t, uint32_t) override
+        {
+            Calls.push_back(Call::Draw);
+        }
+    };
+
+    /// Distinct fake objects; the context only compares the pointers.
+    template <typename T>
+    T* FakeObject(const uintptr_t id)
+    {
+        return reinterpret_cast<T*>(id * 0x100);
+    }
+
+    /// Everything one draw binds, in the order an example binds it.
+    struct DrawBindings
+    {
+        ID3D12DescriptorHeap* Heap = nullptr;
+        ID3D12RootSignature*  RootSignature = nullptr;
+        uint64_t              Table = 0;
+        uint64_t              Constants = 0;
+        ID3D12PipelineState*  Pipeline = nullptr;
+        VertexBufferView      Vertices;
+        IndexBufferView       Indices;
+    };
+
+    /// Makes eight filterable calls and one draw.
+    void RecordDraw(CommandContext& context, const DrawBindings& bindings)
+    {
+        context.SetDescriptorHeaps(1, &bindings.Heap);
+        context.SetGraphicsRootSignature(bindings.RootSignature);
+        context.SetGraphicsRootDescriptorTable(0, bindings.Table);
+        context.SetGraphicsRootConstantBufferView(1, bindings.Constants);
+        context.SetPipelineState(bindings.Pipeline);
+        context.IASetPrimitiveTopology(TriangleList);
+        context.IASetVertexBuffers(0, 1, &bindings.Vertices);
+        context.IASetIndexBuffer(&bindings.Indices);
+        context.DrawIndexedInstanced(36, 1, 0, 0, 0);
+    }
+
+    void ExpectStep(const char*                       step,
+                    const CommandContext&             context,
+                    RecordingBackend&                 backend,
+                    const uint32_t                    issued,
+                    const uint32_t                    elided,
+                    const std::initializer_list<Call> calls)
+    {
+        const CommandContext::Statistics& stats = context.Stats();
+        if (stats.Issued != issued || stats.Elided != elided)
+        {
+            throw std::runtime_error(fmt::format("{}: {} issued and {} elided, expected {} and {}", step, stats.Issued,
+                                                 stats.Elided, issued, elided));
+        }
+        if (!std::ranges::equal(backend.Calls, calls))
+        {
+            throw std::runtime_error(
+                fmt::format("{}: backend received {} calls, expected {}", step, backend.Calls.size(), calls.size()));
+        }
+        backend.Calls.clear();
+    }
+
+    /// @brief Checks which calls reach the backend and the D3D12 invalidation rules the context models.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateCommandContext()
+    {
+        DrawBindings bindings;
+        bindings.Heap = FakeObject<ID3D12DescriptorHeap>(1);
+        bindings.RootSignature = FakeObject<ID3D12RootSignature>(2);
+        bindings.Table = 0x1000;
+        bindings.Constants = 0x2000;
+        bindings.Pipeline = FakeObject<ID3D12PipelineState>(3);
+        bindings.Vertices = {0x3000, 1024, 32};
+        bindings.Indices = {0x4000, 512, 57};
+
+        RecordingBackend backend;
+        CommandContext   context;
+        context.Begin(backend);
+
+        RecordDraw(context, bindings);
+        ExpectStep("First draw", context, backend, 8, 0,
+                   {Call::DescriptorHeaps, Call::RootSignature, Call::DescriptorTable, Call::ConstantBufferView,
+                    Call::PipelineState, Call::Topology, Call::VertexBuffers, Call::IndexBuffer, Call::Draw});
+
+        RecordDraw(context, bindings);
+        ExpectStep("Repeated draw", context, backend, 8, 8, {Call::Draw});
+
+        // New heaps invalidate the descriptor tables but not the root views.
+        bindings.Heap = FakeObject<ID3D12DescriptorHeap>(4);
+        RecordDraw(context, bindings);
+        ExpectStep("Heap change", context, backend, 10, 14,
+                   {Call::DescriptorHeaps, Call::DescriptorTable, Call::Draw});
+
+        // A new root signature invalidates every root argument, but not the pipeline or input assembler state.
+        bindings.RootSignature = FakeObject<ID3D12RootSignature>(5);
+        RecordDraw(context, bindings);
+        ExpectStep("Root signature change", context, backend, 13, 19,
+                   {Call::RootSignature, Call::DescriptorTable, Call::ConstantBufferView, Call::Draw});
+
+        bindings.Constants = 0x2100;
+        bindings.Indices.Format = 42;
+        RecordDraw(context, bindings);
+        ExpectStep("Argument change", context, backend, 15, 25,
+                   {Call::ConstantBufferView, Call::IndexBuffer, Call::Draw});
+
+        // A reset list has undefined state, so everything is issued again and the counts start over.
+        context.Begin(backend);
+        RecordDraw(context, bindings);
+        ExpectStep("Reset", context, backend, 8, 0,
+                   {Call::DescriptorHeaps, Call::RootSignature, Call::DescriptorTable, Call::ConstantBufferView,
+                    Call::PipelineState, Call::Topology, Call::VertexBuffers, Call::IndexBuffer, Call::Draw});
+
+        RecordingBackend next;
+        context.Continue(next);
+        RecordDraw(context, bindings);
+        ExpectStep("Continue", context, next, 16, 0,
+                   {Call::DescriptorHeaps, Call::RootSignature, Call::DescriptorTable, Call::ConstantBufferView,
+                    Call::PipelineState, Call::Topology, Call::VertexBuffers, Call::IndexBuffer, Call::Draw});
+
+        uint32_t constants[4] = {};
+        context.SetGraphicsRoot32BitConstants(2, 4, constants, 0);
+        context.SetGraphicsRoot32BitConstants(2, 4, constants, 0);
+        context.ResourceBarrier(0, nullptr);
+        ExpectStep("Pass-through calls", context, next, 16, 0, {Call::Constants, Call::Constants, Call::Barrier});
+    }
+
+    /// A frame sorted the way DrawQueue orders it: few pipelines, more materials, new constants per draw.
+    std::vector<DrawBindings> MakeSortedFrame(const uint32_t drawCount)
+    {
+        std::vector<DrawBindings> frame(drawCount);
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            DrawBindings& bindings = frame[i];
+            bindings.Heap = FakeObject<ID3D12DescriptorHeap>(1);
+            bindings.RootSignature = FakeObject<ID3D12RootSignature>(2);
+            bindings.Pipeline = FakeObject<ID3D12PipelineState>(16 + i / 400);
+            bindings.Table = 0x100000 + uint64_t{i / 40} * 64;
+            bindings.Constants = 0x200000 + uint64_t{i} * 256;
+            bindings.Vertices = {0x300000 + uint64_t{i / 8 % 64} * 0x10000, 0x10000, 32};
+            bindings.Indices = {0x800000 + uint64_t{i / 8 % 64} * 0x4000, 0x4000, 57};
+        }
+        return frame;
+    }
+} // namespace
+
+void AddCommandContextBenchmarks(BenchmarkRunner& runner)
+{
+    constexpr uint32_t DrawCount = 10 * 1000;
+
+    runner.AddCheck("CommandContext/Filtering", ValidateCommandContext);
+    runner.Add("CommandContext/filter 10k sorted draws", DrawCount, [] {
+        auto frame = std::make_shared<std::vector<DrawBindings>>(MakeSortedFrame(DrawCount));
+        auto backend = std::make_shared<RecordingBackend>();
+        auto context = std::make_shared<CommandContext>();
+        backend->Calls.reserve(DrawCount * 9);
+
+        context->Begin(*backend);
+        for (const DrawBindings& bindings : *frame)
+        {
+            RecordDraw(*context, bindings);
+        }
+        const CommandContext::Statistics& stats = context->Stats();
+        fmt::print("  {} calls issued, {} elided ({:.1f}%)\n", stats.Issued, stats.Elided,
+                   100.0 * stats.Elided / (stats.Issued + stats.Elided));
+
+        return [frame, backend, context] {
+            backend->Calls.clear();
+            context->Begin(*backend);
+            for (const DrawBindings& bindings : *frame)
+            {
+                RecordDraw(*context, bindings);
+            }
+            DoNotOptimize(context->Stats().Issued);
+        };
+    });
+}
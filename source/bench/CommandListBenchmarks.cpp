@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "CommandListPool.hpp"
+#include "DrawQueue.hpp"
+#include "ThreadPool.hpp"
+
+namespace
+{
+    constexpr uint32_t FramesInFlight = 3;
+    constexpr uint32_t PacketCount = 16 * 1024;
+    constexpr size_t   MinPacketsPerList = 512;
+    constexpr uint32_t FrameMarker = UINT32_MAX;
+
+    /// What a command list would encode for one call, about the size of a D3D12 draw.
+    struct MockCommand
+    {
+        uint32_t Kind;
+        uint32_t Value;
+        uint32_t Arguments[6];
+    };
+
+    struct MockList
+    {
+        std::vector<MockCommand> Commands;
+        uint64_t                 SubmittedFence = 0;
+        bool                     Open = false;
+    };
+
+    /// @brief Lists in ordinary memory, with a simulated GPU that finishes CompletedFence.
+    ///
+    /// Checks that lists are only opened when their last submission has completed and only
+    /// executed when closed, and keeps the commands of the last Execute() in order.
+    class MockCommandListSource final : public CommandListSource
+    {
+    public:
+        uint64_t                 SubmitFence = 0;    ///< Fence value the frame being submitted signals.
+        uint64_t                 CompletedFence = 0; ///< Last fence value the simulated GPU finished.
+        uint32_t                 ExecuteCalls = 0;
+        uint32_t                 LiveLists = 0;
+        std::vector<MockCommand> Executed;
+
+        PooledCommandList Create() override
+        {
+            m_lists.push_back(std::make_unique<MockList>());
+            ++LiveLists;
+            return {m_lists.back().get(), m_lists.back().get()};
+        }
+
+        void Destroy(const PooledCommandList&) override
+        {
+            --LiveLists;
+        }
+
+        void Open(const PooledCommandList& list) override
+        {
+            MockList& mock = Get(list);
+            if (mock.Open || mock.SubmittedFence > CompletedFence)
+            {
+                throw std::runtime_error(
+                    fmt::format("Allocator reset while fence {} may still run it", mock.SubmittedFence));
+            }
+            mock.Commands.clear();
+            mock.Open = true;
+        }
+
+        void Close(const PooledCommandList& list) override
+        {
+            Get(list).Open = false;
+        }
+
+        void Execute(const std::span<const PooledCommandList> lists) override
+        {
+            ++ExecuteCalls;
+            Executed.clear();
+            for (const PooledCommandList& list : lists)
+            {
+                MockList& mock = Get(list);
+                if (mock.Open)
+                {
+                    throw std::runtime_error("Open command list was executed");
+                }
+                mock.SubmittedFence = SubmitFence;
+                Executed.insert(Executed.end(), mock.Commands.begin(), mock.Commands.end());
+            }
+        }
+
+    private:
+        static MockList& Get(const PooledCommandList& list)
+        {
+            return *static_cast<MockList*>(list.List);
+        }
+
+        std::vector<std::unique_ptr<MockList>> m_lists;
+    };
+
+    /// Encodes the sorted draws of a range into a mock list, like a worker would into a command list.
+    class ListSubmitter final : public DrawSubmitter
+    {
+    public:
+        explicit ListSubmitter(const PooledCommandList& list) : m_commands(static_cast<MockList*>(list.List)->Commands)
+        {
+        }
+
+        void BindPipeline(const uint32_t pipelineId) override
+        {
+            m_commands.push_back({0, pipelineId, {}});
+        }
+
+        void BindMaterial(const uint32_t materialId) override
+        {
+            m_commands.push_back({1, materialId, {}});
+        }
+
+        void BindGeometry(const uint32_t geometryId) override
+        {
+            m_commands.push_back({2, geometryId, {}});
+        }
+
+        void Draw(const DrawPacket& packet) override
+        {
+            m_commands.push_back({3,
+                                  packet.ObjectIndex,
+                                  {packet.IndexCount, packet.InstanceCount, packet.StartIndex,
+                                   static_cast<uint32_t>(packet.BaseVertex), packet.ObjectIndex, 0}});
+        }
+
+    private:
+        std::vector<MockCommand>& m_commands;
+    };
+
+    std::unique_ptr<DrawQueue> MakeQueue(const uint32_t count, std::mt19937& random)
+    {
+        auto queue = std::make_unique<DrawQueue>();
+        queue->Reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            DrawPacket packet;
+            packet.PipelineId = random() % 32;
+            packet.MaterialId = random() % 512;
+            packet.GeometryId = random() % 2048;
+            packet.IndexCount = 36;
+            packet.ObjectIndex = i;
+            packet.Key = DrawKey::Make(0, 0, packet.PipelineId, packet.MaterialId, 0.0f);
+            queue->Push(packet);
+        }
+        ThreadPool serial(0);
+        queue->Sort(serial);
+        return queue;
+    }
+
+    /// Records one frame: a list of its own before and after the draws, as D3D12Context does.
+    void RecordFrame(CommandListPool& lists, ThreadPool& pool, const DrawQueue& queue)
+    {
+        const PooledCommandList before = lists.Acquire();
+        static_cast<MockList*>(before.List)->Commands.push_back({FrameMarker, 0, {}});
+
+        const auto record = [&](const PooledCommandList& list, const size_t begin, const size_t end) {
+            ListSubmitter submitter(list);
+            (void)queue.Submit(submitter, begin, end - begin);
+        };
+        lists.Record(pool, queue.Size(), MinPacketsPerList, record);
+
+        const PooledCommandList after = lists.Acquire();
+        static_cast<MockList*>(after.List)->Commands.push_back({FrameMarker, 1, {}});
+    }
+
+    /// @brief Runs frames whose fences complete a few frames late and checks that allocators are only
+    /// reset once their frame finished, that each frame executes once, and that the draws run in
+    /// sorted order between the lists recorded before and after them.
+    /// @throws std::runtime_error on the first mismatch.
+    void Validate()
+    {
+        MockCommandListSource source;
+        ThreadPool            pool(3);
+        std::mt19937          random(PacketCount);
+        {
+            CommandListPool lists(source);
+            for (uint64_t fence = 1; fence <= 200; ++fence)
+            {
+                if (fence > FramesInFlight)
+                {
+                    source.CompletedFence = fence - FramesInFlight;
+                    lists.BeginFrame(source.CompletedFence);
+                }
+
+                const auto queue = MakeQueue(random() % 4096, random);
+                RecordFrame(lists, pool, *queue);
+                source.SubmitFence = fence;
+                lists.Submit(fence);
+
+                if (source.ExecuteCalls != fence || source.Executed.size() < queue->Size() + 2 ||
+                    source.Executed.front().Kind != FrameMarker || source.Executed.back().Kind != FrameMarker)
+                {
+                    throw std::runtime_error(fmt::format("Frame {} was not executed in one call", fence));
+                }
+                size_t next = 0;
+                for (const MockCommand& command : source.Executed)
+                {
+                    if (command.Kind == 3 && command.Value != queue->Packet(queue->SortedIndices()[next++]).ObjectIndex)
+                    {
+                        throw std::runtime_error(fmt::format("Draws of frame {} ran out of order", fence));
+                    }
+                }
+                if (next != queue->Size())
+                {
+                    throw std::runtime_error(fmt::format("Frame {} lost draws", fence));
+                }
+
+                const uint32_t maxListsPerFrame = pool.ThreadCount() + 2;
+                if (lists.Stats().FrameLists > maxListsPerFrame ||
+                    lists.Stats().Lists > maxListsPerFrame * (FramesInFlight + 1))
+                {
+                    throw std::runtime_error("Command list pool grew beyond the frames in flight");
+                }
+            }
+            source.CompletedFence = UINT64_MAX;
+            lists.BeginFrame(source.CompletedFence);
+        }
+
+        if (source.LiveLists != 0)
+        {
+            throw std::runtime_error("Command list pool leaked lists");
+        }
+    }
+
+    /// A frame of sorted draws recorded in a loop, with fences completing a few frames late.
+    struct RecordingState
+    {
+        MockCommandListSource       Source;
+        CommandListPool             Lists{Source};
+        std::unique_ptr<ThreadPool> Pool;
+        std::unique_ptr<DrawQueue>  Queue;
+        uint64_t                    Fence = 0;
+
+        explicit RecordingState(const int32_t workerCount) : Pool(std::make_unique<ThreadPool>(workerCount))
+        {
+            std::mt19937 random(PacketCount);
+            Queue = MakeQueue(PacketCount, random);
+        }
+
+        ~RecordingState()
+        {
+            Lists.BeginFrame(UINT64_MAX);
+        }
+
+        void Frame()
+        {
+            ++Fence;
+            if (Fence > FramesInFlight)
+            {
+                Source.CompletedFence = Fence - FramesInFlight;
+                Lists.BeginFrame(Source.CompletedFence);
+            }
+            RecordFrame(Lists, *Pool, *Queue);
+            Source.SubmitFence = Fence;
+            Lists.Submit(Fence);
+        }
+    };
+} // namespace
+
+/// Items are draw packets recorded into command lists, including the submission.
+void AddCommandListBenchmarks(BenchmarkRunner& runner)
+{
+    runner.AddCheck("CommandLists/Fenced reuse", Validate);
+
+    // Fixed worker counts, so results compare across machines.
+    for (const int32_t workerCount : {0, 3})
+    {
+        runner.Add(fmt::format("CommandLists/Record {} draws with {} workers", PacketCount, workerCount), PacketCount,
+                   [workerCount] {
+                       auto state = std::make_shared<RecordingState>(workerCount);
+
+                       return [state] {
+                           state->Frame();
+                           DoNotOptimize(state->Source.Executed.size());
+                       };
+                   });
+    }
+}
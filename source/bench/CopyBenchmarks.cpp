@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "StreamingCopy.hpp"
+
+namespace
+{
+    constexpr size_t KiB = 1024;
+    constexpr size_t HotSize = 16 * KiB;
+    constexpr size_t ColdChunk = 1024 * KiB;
+    constexpr size_t ColdSize = 64 * ColdChunk;
+    constexpr uint8_t Guard = 0xCD;
+
+    /// @brief Copies every size up to a few lines to every destination alignment, plus a few
+    /// large sizes, and checks the bytes copied and the bytes around them.
+    /// @throws std::runtime_error on the first mismatch.
+    void Validate()
+    {
+        constexpr size_t     MaxOffset = 64;
+        constexpr size_t     Sizes[] = {1000, 4097, 65536 + 13};
+        std::vector<uint8_t> source(Sizes[2] + 2 * MaxOffset);
+        for (size_t i = 0; i < source.size(); ++i)
+        {
+            source[i] = static_cast<uint8_t>(i * 7 + 1);
+        }
+        std::vector<uint8_t> destination(source.size() + 2 * MaxOffset);
+
+        const auto check = [&](const size_t sourceOffset, const size_t destinationOffset, const size_t size) {
+            const size_t checked = destinationOffset + size + MaxOffset;
+            std::memset(destination.data(), Guard, checked);
+            StreamingCopy::Copy(destination.data() + destinationOffset, source.data() + sourceOffset, size);
+            for (size_t i = 0; i < checked; ++i)
+            {
+                const bool    inside = i >= destinationOffset && i < destinationOffset + size;
+                const uint8_t expected = inside ? source[i - destinationOffset + sourceOffset] : Guard;
+                if (destination[i] != expected)
+                {
+                    throw std::runtime_error(fmt::format("Copy of {} bytes from offset {} to {} is wrong at byte {}",
+                                                         size, sourceOffset, destinationOffset, i));
+                }
+            }
+        };
+
+        for (size_t destinationOffset = 0; destinationOffset < MaxOffset; ++destinationOffset)
+        {
+            for (const size_t sourceOffset : {size_t{0}, size_t{1}, size_t{8}, destinationOffset})
+            {
+                for (size_t size = 0; size <= 4 * MaxOffset; ++size)
+                {
+                    check(sourceOffset, destinationOffset, size);
+                }
+            }
+        }
+        for (const size_t size : Sizes)
+        {
+            check(3, 5, size);
+        }
+    }
+
+    /// Destination larger than the caches, written a chunk at a time, so every store misses like
+    /// it does on write-combined memory; the source stays cached.
+    struct ColdCopy
+    {
+        std::vector<uint8_t> Source = std::vector<uint8_t>(ColdChunk, 1);
+        std::vector<uint8_t> Destination = std::vector<uint8_t>(ColdSize);
+        size_t               Offset = 0;
+
+        uint8_t* Next()
+        {
+            uint8_t* destination = Destination.data() + Offset;
+            Offset = (Offset + ColdChunk) % ColdSize;
+            return destination;
+        }
+    };
+
+    using CopyFunction = void* (*)(void*, const void*, size_t);
+
+    /// Fences every copy, as if each were the only upload of a frame.
+    void* Stream(void* destination, const void* source, const size_t size)
+    {
+        StreamingCopy::Copy(destination, source, size);
+        StreamingCopy::Fence();
+        return destination;
+    }
+
+    void AddPair(BenchmarkRunner& runner, const char* name, const CopyFunction copy)
+    {
+        runner.Add(fmt::format("Copy/{} {} KB hot", name, HotSize / KiB), HotSize / KiB, [copy] {
+            auto buffers = std::make_shared<std::vector<uint8_t>>(2 * HotSize, 1);
+
+            return [buffers, copy] {
+                DoNotOptimize(copy(buffers->data() + HotSize, buffers->data(), HotSize));
+            };
+        });
+
+        runner.Add(fmt::format("Copy/{} {} KB to cold memory", name, ColdChunk / KiB), ColdChunk / KiB, [copy] {
+            auto state = std::make_shared<ColdCopy>();
+
+            return [state, copy] {
+                DoNotOptimize(copy(state->Next(), state->Source.data(), ColdChunk));
+            };
+        });
+    }
+} // namespace
+
+/// Items are KB copied. memcpy is the baseline the streaming copy is measured against.
+void AddCopyBenchmarks(BenchmarkRunner& runner)
+{
+    runner.AddCheck("Copy/Streaming", Validate);
+
+    AddPair(runner, "memcpy", std::memcpy);
+    AddPair(runner, fmt::format("Streaming {}", StreamingCopy::PathName()).c_str(), Stream);
+}
@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "BindlessRegistry.hpp"
+#include "DescriptorAllocator.hpp"
+
+namespace
+{
+    constexpr uint32_t PersistentCapacity = 1u << 16;
+    constexpr uint32_t LiveAllocations = 4096;
+    constexpr uint32_t ChurnCount = 1024;
+    constexpr uint32_t RingCapacity = 4096;
+    constexpr uint32_t FramesInFlight = 3;
+    constexpr uint32_t TablesPerFrame = 256;
+    constexpr uint32_t BindlessViews = 16384;
+
+    /// Mostly single descriptors, like the views of a texture, with the odd table of a material.
+    uint32_t RandomCount(std::mt19937& random)
+    {
+        std::uniform_int_distribution<uint32_t> roll(0, 15);
+        const uint32_t                          kind = roll(random);
+        return kind < 12 ? 1 : kind < 15 ? 4 + kind : 64;
+    }
+
+    /// Heap usage of a level that streams textures in and out.
+    struct PersistentWorkload
+    {
+        DescriptorAllocator               Allocator{PersistentCapacity};
+        std::vector<DescriptorAllocation> Live;
+        std::mt19937                      Random{LiveAllocations};
+
+        PersistentWorkload()
+        {
+            for (uint32_t i = 0; i < LiveAllocations; ++i)
+            {
+                Live.push_back(Allocator.Allocate(RandomCount(Random)));
+            }
+        }
+
+        /// Frees a random allocation and replaces it with one of a random size.
+        void Churn()
+        {
+            DescriptorAllocation& slot = Live[Random() % Live.size()];
+            Allocator.Free(slot);
+            slot = Allocator.Allocate(RandomCount(Random));
+        }
+    };
+
+    /// @brief Checks that no two live allocations overlap and that freeing merges every range back.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidatePersistent()
+    {
+        PersistentWorkload workload;
+        std::vector<bool>  owned(PersistentCapacity);
+        for (uint32_t i = 0; i < ChurnCount * 16; ++i)
+        {
+            workload.Churn();
+        }
+
+        for (const DescriptorAllocation& allocation : workload.Live)
+        {
+            if (!allocation.IsValid() || allocation.Offset + allocation.Count > PersistentCapacity)
+            {
+                throw std::runtime_error("Persistent allocation failed with free space left");
+            }
+            for (uint32_t i = allocation.Offset; i < allocation.Offset + allocation.Count; ++i)
+            {
+                if (owned[i])
+                {
+                    throw std::runtime_error(fmt::format("Descriptor {} was handed out twice", i));
+                }
+                owned[i] = true;
+            }
+        }
+
+        for (const DescriptorAllocation& allocation : workload.Live)
+        {
+            workload.Allocator.Free(allocation);
+        }
+        if (workload.Allocator.AllocatedCount() != 0 ||
+            !workload.Allocator.Allocate(PersistentCapacity).IsValid())
+        {
+            throw std::runtime_error("Freed ranges did not merge back into one");
+        }
+    }
+
+    /// @brief Runs frames whose fences complete a few frames late and checks that no table is
+    /// reused while a frame in flight may still read it.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateRing()
+    {
+        DescriptorRing        ring(RingCapacity);
+        std::vector<uint64_t> ownerFence(RingCapacity, 0);
+        std::mt19937          random(RingCapacity);
+        uint64_t              completed = 0;
+
+        for (uint64_t fence = 1; fence <= 1000; ++fence)
+        {
+            if (fence > FramesInFlight)
+            {
+                completed = fence - FramesInFlight;
+                ring.Release(completed);
+            }
+
+            for (uint32_t table = 0; table < TablesPerFrame / 4; ++table)
+            {
+                const DescriptorAllocation allocation = ring.Allocate(RandomCount(random));
+                if (!allocation.IsValid())
+                {
+                    throw std::runtime_error(fmt::format("Ring ran out of space in frame {}", fence));
+                }
+                for (uint32_t i = allocation.Offset; i < allocation.Offset + allocation.Count; ++i)
+                {
+                    if (ownerFence[i] > completed)
+                    {
+                        throw std::runtime_error(
+                            fmt::format("Descriptor {} reused while frame {} may read it", i, ownerFence[i]));
+                    }
+                    ownerFence[i] = fence;
+                }
+            }
+            ring.EndFrame(fence);
+        }
+    }
+
+    /// Views of streamed textures registered for bindless access and released as BindlessResources does it,
+    /// with frames whose fences complete FramesInFlight frames late.
+    struct BindlessWorkload
+    {
+        DescriptorAllocator         Allocator{BindlessViews};
+        BindlessRegistry            Registry;
+        std::vector<BindlessHandle> Live;
+        std::mt19937                Random{BindlessViews};
+        uint64_t                    Fence = 0;
+
+        struct Swap
+        {
+            BindlessHandle Released;
+            BindlessHandle Registered;
+        };
+
+        BindlessWorkload()
+        {
+            for (uint32_t i = 0; i < BindlessViews / 2; ++i)
+            {
+                Live.push_back(Registry.Register(Allocator.Allocate(1)));
+            }
+        }
+
+        /// Releases a random view and registers a new one, which may reuse an index released frames ago.
+        Swap Churn()
+        {
+            BindlessHandle&      slot = Live[Random() % Live.size()];
+            const BindlessHandle released = slot;
+            Allocator.FreeDeferred(Registry.Unregister(slot));
+            slot = Registry.Register(Allocator.Allocate(1));
+            return {released, slot};
+        }
+
+        /// Ends the frame being recorded and recycles the indices of finished frames.
+        void EndFrame()
+        {
+            Allocator.EndFrame(++Fence);
+            if (Fence > FramesInFlight)
+            {
+                Allocator.Release(CompletedFence());
+            }
+        }
+
+        [[nodiscard]] uint64_t CompletedFence() const
+        {
+            return Fence > FramesInFlight ? Fence - FramesInFlight : 0;
+        }
+    };
+
+    /// @brief Checks that an index is only registered again once the frame that released it has finished,
+    /// that live handles resolve to distinct indices and that released handles stay invalid after their
+    /// index is reused.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateBindless()
+    {
+        BindlessWorkload            workload;
+        std::vector<BindlessHandle> released;
+        std::vector<uint64_t>       releaseFence(BindlessViews, 0);
+        for (uint32_t frame = 0; frame < 16; ++frame)
+        {
+            for (uint32_t i = 0; i < ChurnCount; ++i)
+            {
+                const BindlessWorkload::Swap swap = workload.Churn();
+                released.push_back(swap.Released);
+                releaseFence[swap.Released.Index] = workload.Fence + 1;
+
+                const uint64_t fence = releaseFence[swap.Registered.Index];
+                if (fence > workload.CompletedFence())
+                {
+                    throw std::runtime_error(fmt::format("Index {} was registered again while frame {} may read it",
+                                                         swap.Registered.Index, fence));
+                }
+            }
+            workload.EndFrame();
+        }
+
+        std::vector<bool> owned(BindlessViews);
+        for (const BindlessHandle& handle : workload.Live)
+        {
+            const uint32_t index = workload.Registry.Resolve(handle);
+            if (index == BindlessHandle::InvalidIndex || owned[index])
+            {
+                throw std::runtime_error(fmt::format("Live bindless handle {} does not resolve", handle.Index));
+            }
+            owned[index] = true;
+        }
+
+        uint32_t reused = 0;
+        for (const BindlessHandle& handle : released)
+        {
+            if (workload.Registry.IsValid(handle))
+            {
+                throw std::runtime_error(fmt::format("Released bindless handle {} still resolves", handle.Index));
+            }
+            reused += owned[handle.Index] ? 1 : 0;
+        }
+        if (reused == 0)
+        {
+            throw std::runtime_error("No index was reused, so stale handles were not exercised");
+        }
+
+        if (workload.Registry.Unregister(released.front()).IsValid() || workload.Registry.IsValid(BindlessHandle{}) ||
+            workload.Registry.LiveCount() != workload.Live.size())
+        {
+            throw std::runtime_error("Stale or default bindless handle was accepted");
+        }
+    }
+} // namespace
+
+/// Items are allocations; a churn item frees one allocation and makes another.
+void AddDescriptorBenchmarks(BenchmarkRunner& runner)
+{
+    runner.AddCheck("Descriptors/Persistent", ValidatePersistent);
+    runner.AddCheck("Descriptors/Transient ring", ValidateRing);
+    runner.AddCheck("Descriptors/Bindless", ValidateBindless);
+
+    runner.Add(fmt::format("Descriptors/Persistent churn {} live", LiveAllocations), ChurnCount, [] {
+        auto workload = std::make_shared<PersistentWorkload>();
+
+        return [workload] {
+            for (uint32_t i = 0; i < ChurnCount; ++i)
+            {
+                workload->Churn();
+            }
+            DoNotOptimize(workload->Allocator.AllocatedCount());
+        };
+    });
+
+    runner.Add(fmt::format("Descriptors/Transient ring {} tables", TablesPerFrame), TablesPerFrame, [] {
+        auto ring = std::make_shared<DescriptorRing>(RingCapacity * FramesInFlight);
+        auto fence = std::make_shared<uint64_t>(0);
+
+        return [ring, fence] {
+            ++*fence;
+            if (*fence > FramesInFlight)
+            {
+                ring->Release(*fence - FramesInFlight);
+            }
+            for (uint32_t i = 0; i < TablesPerFrame; ++i)
+            {
+                DoNotOptimize(ring->Allocate(1 + i % 8));
+            }
+            ring->EndFrame(*fence);
+        };
+    });
+
+    runner.Add(fmt::format("Descriptors/Bindless churn {} views", BindlessViews / 2), ChurnCount, [] {
+        auto workload = std::make_shared<BindlessWorkload>();
+
+        return [workload] {
+            for (uint32_t i = 0; i < ChurnCount; ++i)
+            {
+                DoNotOptimize(workload->Churn());
+            }
+            workload->EndFrame();
+        };
+    });
+}
@@ -0,0 +1,470 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "DeferredReleaseQueue.hpp"
+#include "FenceTimeline.hpp"
+
+namespace
+{
+    constexpr uint32_t FramesInFlight = 3;
+    constexpr uint32_t PointQueries = 1024;
+    constexpr uint32_t ReleasesPerFrame = 256;
+
+    /// @brief Queues of a simulated GPU that run signals and waits in order, a step at a time.
+    ///
+    /// A queue stalls on a wait until the other queue reaches the value, as a D3D12 queue does.
+    /// Each signal remembers the completed values of the other queues when it ran, so callers can
+    /// check that cross-queue waits held back the work after them.
+    class SimulatedBackend final : public TimelineBackend
+    {
+    public:
+        uint32_t Waits = 0;
+        uint32_t Queries = 0;
+
+        void Signal(const QueueType queue, const uint64_t value) override
+        {
+            Pending(queue).push_back({false, {queue, value}});
+        }
+
+        void Wait(const QueueType queue, const TimelinePoint point) override
+        {
+            Pending(queue).push_back({true, point});
+            ++Waits;
+        }
+
+        uint64_t CompletedValue(const QueueType queue) override
+        {
+            ++Queries;
+            return m_completed[static_cast<size_t>(queue)];
+        }
+
+        void WaitForCompletion(const TimelinePoint point) override
+        {
+            while (m_completed[static_cast<size_t>(point.Queue)] < point.Value)
+            {
+                if (!Step(point.Queue) && !Step(QueueType::Direct) && !Step(QueueType::Compute) &&
+                    !Step(QueueType::Copy))
+                {
+                    throw std::runtime_error(fmt::format("Queues deadlocked waiting for value {}", point.Value));
+                }
+            }
+        }
+
+        /// @brief Runs the next operation of the queue unless it is an unmet wait.
+        bool Step(const QueueType queue)
+        {
+            std::deque<Operation>& pending = Pending(queue);
+            if (pending.empty())
+            {
+                return false;
+            }
+
+            const Operation operation = pending.front();
+            if (operation.IsWait)
+            {
+                if (m_completed[static_cast<size_t>(operation.Point.Queue)] < operation.Point.Value)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                uint64_t& completed = m_completed[static_cast<size_t>(queue)];
+                if (operation.Point.Value <= completed)
+                {
+                    throw std::runtime_error("Queue signaled a value that does not increase");
+                }
+                completed = operation.Point.Value;
+                m_reached[static_cast<size_t>(queue)].push_back(m_completed);
+            }
+            pending.pop_front();
+            return true;
+        }
+
+        /// @brief Completed values of every queue when the queue signaled value.
+        [[nodiscard]] const std::array<uint64_t, QueueTypeCount>& ReachedAt(const TimelinePoint point) const
+        {
+            return m_reached[static_cast<size_t>(point.Queue)][point.Value - 1];
+        }
+
+        [[nodiscard]] bool Idle() const
+        {
+            for (const std::deque<Operation>& pending : m_pending)
+            {
+                if (!pending.empty())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] uint64_t Completed(const QueueType queue) const
+        {
+            return m_completed[static_cast<size_t>(queue)];
+        }
+
+    private:
+        struct Operation
+        {
+            bool          IsWait;
+            TimelinePoint Point;
+        };
+
+        std::deque<Operation>& Pending(const QueueType queue)
+        {
+            return m_pending[static_cast<size_t>(queue)];
+        }
+
+        std::array<std::deque<Operation>, QueueTypeCount>                              m_pending;
+        std::array<uint64_t, QueueTypeCount>                                           m_completed{};
+        std::array<std::vector<std::array<uint64_t, QueueTypeCount>>, QueueTypeCount> m_reached;
+    };
+
+    /// A point the work before a signal must have waited for.
+    struct Dependency
+    {
+        TimelinePoint Signal;
+        TimelinePoint Required;
+    };
+
+    /// @brief Records a frame with uploads on the copy queue and async compute between two
+    /// direct passes, and returns the point the frame signals.
+    ///
+    /// Four waits cross queues; the other three are repeats or on the same queue and have to be elided.
+    TimelinePoint RecordFrame(FenceTimeline& timeline, std::vector<Dependency>& dependencies)
+    {
+        const TimelinePoint uploads = timeline.Signal(QueueType::Copy);
+
+        timeline.Wait(QueueType::Direct, uploads);
+        timeline.Wait(QueueType::Direct, uploads);
+        const TimelinePoint geometry = timeline.Signal(QueueType::Direct);
+        dependencies.push_back({geometry, uploads});
+
+        timeline.Wait(QueueType::Compute, geometry);
+        timeline.Wait(QueueType::Compute, uploads);
+        timeline.Wait(QueueType::Compute, geometry);
+        const TimelinePoint lighting = timeline.Signal(QueueType::Compute);
+        dependencies.push_back({lighting, geometry});
+
+        timeline.Wait(QueueType::Direct, lighting);
+        timeline.Wait(QueueType::Direct, {QueueType::Direct, geometry.Value});
+        const TimelinePoint frame = timeline.Signal(QueueType::Direct);
+        dependencies.push_back({frame, lighting});
+        return frame;
+    }
+
+    /// @brief Runs frames on a simulated GPU that advances the queues at random, and checks that
+    /// values increase by one per signal, that work after a cross-queue wait never ran before the
+    /// point it waited for, that IsComplete() matches the fences, and that redundant waits and
+    /// queries never reach the backend.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateTimeline()
+    {
+        SimulatedBackend        backend;
+        FenceTimeline           timeline(backend);
+        std::vector<Dependency> dependencies;
+        std::deque<uint64_t>    frames;
+        std::mt19937            random(PointQueries);
+
+        for (uint64_t frame = 1; frame <= 500; ++frame)
+        {
+            if (frames.size() == FramesInFlight)
+            {
+                timeline.WaitForCompletion({QueueType::Direct, frames.front()});
+                frames.pop_front();
+            }
+
+            const uint64_t expected = 2 * frame;
+            const uint64_t signaled = RecordFrame(timeline, dependencies).Value;
+            frames.push_back(signaled);
+            if (signaled != expected || timeline.NextValue(QueueType::Direct) != expected + 1 ||
+                timeline.LastSignaled(QueueType::Compute).Value != frame ||
+                timeline.LastSignaled(QueueType::Copy).Value != frame)
+            {
+                throw std::runtime_error(fmt::format("Timeline values of frame {} skipped or repeated", frame));
+            }
+
+            for (uint32_t steps = random() % 12; steps > 0; --steps)
+            {
+                (void)backend.Step(static_cast<QueueType>(random() % QueueTypeCount));
+            }
+
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                const auto          queue = static_cast<QueueType>(random() % QueueTypeCount);
+                const uint64_t      last = timeline.LastSignaled(queue).Value;
+                const TimelinePoint point = {queue, last - random() % std::min<uint64_t>(last, 8)};
+                if (timeline.IsComplete(point) != (backend.Completed(queue) >= point.Value))
+                {
+                    throw std::runtime_error(fmt::format("IsComplete disagrees with the fence for {}", point.Value));
+                }
+            }
+        }
+
+        timeline.WaitForIdle();
+        if (!backend.Idle())
+        {
+            throw std::runtime_error("WaitForIdle returned with work left on a queue");
+        }
+        for (const Dependency& dependency : dependencies)
+        {
+            if (backend.ReachedAt(dependency.Signal)[static_cast<size_t>(dependency.Required.Queue)] <
+                dependency.Required.Value)
+            {
+                throw std::runtime_error(fmt::format("Value {} ran before the value {} it waited for",
+                                                     dependency.Signal.Value, dependency.Required.Value));
+            }
+        }
+
+        const FenceTimeline::Statistics& stats = timeline.Stats();
+        if (stats.GpuWaits != backend.Waits || stats.GpuWaits != 500 * 4 || stats.ElidedGpuWaits != 500 * 3)
+        {
+            throw std::runtime_error("Redundant waits reached the backend");
+        }
+
+        const uint32_t queries = backend.Queries;
+        for (uint32_t queue = 0; queue < QueueTypeCount; ++queue)
+        {
+            if (!timeline.IsComplete(timeline.LastSignaled(static_cast<QueueType>(queue))))
+            {
+                throw std::runtime_error("Signaled value is not complete after WaitForIdle");
+            }
+        }
+        if (backend.Queries != queries)
+        {
+            throw std::runtime_error("IsComplete queried the fence for a value it knew was complete");
+        }
+    }
+
+    /// Frames of cross-queue work with a few in flight, checking whether resources are free.
+    struct TimelineState
+    {
+        SimulatedBackend           Backend;
+        FenceTimeline              Timeline{Backend};
+        std::vector<Dependency>    Dependencies;
+        std::vector<TimelinePoint> Points;
+        std::deque<uint64_t>       Frames;
+
+        TimelineState()
+        {
+            std::mt19937 random(PointQueries);
+            for (uint32_t i = 0; i < PointQueries; ++i)
+            {
+                Points.push_back({static_cast<QueueType>(random() % QueueTypeCount), 1 + random() % 64});
+            }
+        }
+
+        void Frame()
+        {
+            if (Frames.size() == FramesInFlight)
+            {
+                Timeline.WaitForCompletion({QueueType::Direct, Frames.front()});
+                Frames.pop_front();
+            }
+            Frames.push_back(RecordFrame(Timeline, Dependencies).Value);
+            Dependencies.clear();
+
+            uint32_t complete = 0;
+            for (const TimelinePoint& point : Points)
+            {
+                complete += Timeline.IsComplete(point) ? 1 : 0;
+            }
+            DoNotOptimize(complete);
+        }
+    };
+
+    /// Object retired to a DeferredReleaseQueue, which checks the GPU is done with it when released.
+    struct TrackedObject
+    {
+        const SimulatedBackend*              Backend;
+        std::array<uint64_t, QueueTypeCount> Required;
+        uint64_t                             Bytes;
+        bool                                 Released = false;
+
+        static void Release(void* object)
+        {
+            auto& tracked = *static_cast<TrackedObject*>(object);
+            for (uint32_t queue = 0; queue < QueueTypeCount; ++queue)
+            {
+                if (tracked.Backend->Completed(static_cast<QueueType>(queue)) < tracked.Required[queue])
+                {
+                    throw std::runtime_error(
+                        fmt::format("Object released while value {} may still use it", tracked.Required[queue]));
+                }
+            }
+            if (tracked.Released)
+            {
+                throw std::runtime_error("Object released twice");
+            }
+            tracked.Released = true;
+        }
+    };
+
+    /// @brief Retires objects used by one or more queues in frames on the simulated GPU, and checks
+    /// that each is released once, only after every queue that used it, and at the first
+    /// BeginFrame() that sees it complete, with the counters matching what is left.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateReleases()
+    {
+        SimulatedBackend                            backend;
+        FenceTimeline                               timeline(backend);
+        std::vector<std::unique_ptr<TrackedObject>> objects;
+        std::vector<Dependency>                     dependencies;
+        std::deque<uint64_t>                        frames;
+        std::mt19937                                random(ReleasesPerFrame);
+        uint64_t                                    retiredBytes = 0;
+        {
+            DeferredReleaseQueue releases(timeline);
+            const auto           retire = [&](const std::span<const TimelinePoint> points) {
+                auto object = std::make_unique<TrackedObject>(TrackedObject{&backend, {}, 1 + random() % 4096});
+                if (points.empty())
+                {
+                    object->Required[0] = timeline.NextValue(QueueType::Direct);
+                    releases.Retire(object.get(), &TrackedObject::Release, object->Bytes);
+                }
+                else
+                {
+                    for (const TimelinePoint& point : points)
+                    {
+                        object->Required[static_cast<size_t>(point.Queue)] = point.Value;
+                    }
+                    releases.Retire(object.get(), &TrackedObject::Release, object->Bytes, points);
+                }
+                retiredBytes += object->Bytes;
+                objects.push_back(std::move(object));
+            };
+
+            for (uint64_t frame = 1; frame <= 300; ++frame)
+            {
+                if (frames.size() == FramesInFlight)
+                {
+                    timeline.WaitForCompletion({QueueType::Direct, frames.front()});
+                    frames.pop_front();
+                }
+
+                releases.BeginFrame();
+                uint32_t pending = 0;
+                uint64_t pendingBytes = 0;
+                for (const auto& object : objects)
+                {
+                    bool complete = true;
+                    for (uint32_t queue = 0; queue < QueueTypeCount; ++queue)
+                    {
+                        const uint64_t completed = backend.Completed(static_cast<QueueType>(queue));
+                        complete = complete && completed >= object->Required[queue];
+                    }
+                    if (complete != object->Released)
+                    {
+                        throw std::runtime_error(fmt::format("Completed object was kept past frame {}", frame));
+                    }
+                    pending += object->Released ? 0 : 1;
+                    pendingBytes += object->Released ? 0 : object->Bytes;
+                }
+                if (releases.Stats().PendingReleases != pending || releases.Stats().PendingBytes != pendingBytes ||
+                    releases.Stats().ReleasedBytes + pendingBytes != retiredBytes)
+                {
+                    throw std::runtime_error(fmt::format("Release counters of frame {} are wrong", frame));
+                }
+
+                for (uint32_t i = random() % 16; i > 0; --i)
+                {
+                    const TimelinePoint compute = {QueueType::Compute, timeline.NextValue(QueueType::Compute)};
+                    const TimelinePoint copy = timeline.LastSignaled(QueueType::Copy);
+                    const TimelinePoint points[] = {compute, copy};
+                    retire(std::span(points, random() % 3));
+                }
+                frames.push_back(RecordFrame(timeline, dependencies).Value);
+
+                for (uint32_t steps = random() % 12; steps > 0; --steps)
+                {
+                    (void)backend.Step(static_cast<QueueType>(random() % QueueTypeCount));
+                }
+            }
+
+            // Whatever is left when the queue is destroyed is released by its destructor.
+            timeline.WaitForIdle();
+            releases.BeginFrame();
+            retire({});
+            timeline.WaitForIdle();
+        }
+
+        for (const auto& object : objects)
+        {
+            if (!object->Released)
+            {
+                throw std::runtime_error("Deferred release queue leaked an object");
+            }
+        }
+    }
+
+    /// Resources retired every frame and released a few frames later, like evicted textures.
+    struct ReleaseState
+    {
+        SimulatedBackend     Backend;
+        FenceTimeline        Timeline{Backend};
+        DeferredReleaseQueue Releases{Timeline};
+        std::deque<uint64_t> Frames;
+        uint32_t             Released = 0;
+
+        ~ReleaseState()
+        {
+            Timeline.WaitForIdle();
+            Releases.BeginFrame();
+        }
+
+        void Frame()
+        {
+            if (Frames.size() == FramesInFlight)
+            {
+                Timeline.WaitForCompletion({QueueType::Direct, Frames.front()});
+                Frames.pop_front();
+            }
+            Releases.BeginFrame();
+
+            for (uint32_t i = 0; i < ReleasesPerFrame; ++i)
+            {
+                Releases.Retire(&Released, [](void* object) { ++*static_cast<uint32_t*>(object); }, 64 * 1024);
+            }
+            Frames.push_back(Timeline.Signal(QueueType::Direct).Value);
+        }
+    };
+} // namespace
+
+/// Items are IsComplete() queries, run once per frame after the frame's signals and waits, or
+/// objects retired and released.
+void AddFenceTimelineBenchmarks(BenchmarkRunner& runner)
+{
+    runner.AddCheck("Timeline/Queues", ValidateTimeline);
+    runner.AddCheck("Timeline/Deferred releases", ValidateReleases);
+
+    runner.Add(fmt::format("Timeline/Frame with {} queries", PointQueries), PointQueries, [] {
+        auto state = std::make_shared<TimelineState>();
+
+        return [state] { state->Frame(); };
+    });
+
+    runner.Add(fmt::format("Timeline/Deferred releases {} per frame", ReleasesPerFrame), ReleasesPerFrame, [] {
+        auto state = std::make_shared<ReleaseState>();
+
+        return [state] {
+            state->Frame();
+            DoNotOptimize(state->Released);
+        };
+    });
+}
@@ -0,0 +1,421 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "FrameGraph.hpp"
+
+namespace
+{
+    constexpr uint32_t PassCount = 100;
+    constexpr uint32_t CascadeCount = 4;
+    constexpr uint32_t DebugInterval = 10;
+    constexpr uint32_t HistoryLength = 4;
+    constexpr uint32_t Width = 1920;
+    constexpr uint32_t Height = 1080;
+    constexpr uint32_t ShadowSize = 2048;
+
+    /// Marks a resource between the two halves of a split barrier, where no pass may use it.
+    constexpr uint32_t InTransition = ~0u;
+
+    struct Use
+    {
+        FrameGraphResource Resource;
+        uint32_t           Usage;
+        bool               Write;
+    };
+
+    struct PassRecipe
+    {
+        std::string      Name;
+        std::vector<Use> Uses;
+    };
+
+    struct ResourceRecipe
+    {
+        std::string     Name;
+        bool            Imported = false;
+        uint32_t        InitialUsage = ResourceUsage::None;
+        uint32_t        FinalUsage = ResourceUsage::None;
+        TransientMemory Memory;
+    };
+
+    /// Memory of a texture, rounded to the placement alignment as GetResourceAllocationInfo does.
+    TransientMemory TextureMemory(const uint32_t width, const uint32_t height, const uint32_t bytesPerPixel)
+    {
+        const uint64_t alignment = TransientMemory::DefaultAlignment;
+        const uint64_t size = static_cast<uint64_t>(width) * height * bytesPerPixel;
+        return {(size + alignment - 1) / alignment * alignment, alignment, 0};
+    }
+
+    /// A deferred frame: shadow cascades and a G-buffer, lighting, then a long chain of
+    /// post-processing passes that alternate between render targets and in-place compute.
+    /// Every tenth pass draws a debug view nobody reads, so it should be culled.
+    struct FrameRecipe
+    {
+        std::vector<ResourceRecipe> Resources;
+        std::vector<PassRecipe>     Passes;
+        uint32_t                    DebugPasses = 0;
+
+        FrameGraphResource AddResource(std::string name, const TransientMemory& memory)
+        {
+            Resources.push_back({std::move(name), false, ResourceUsage::None, ResourceUsage::None, memory});
+            return static_cast<FrameGraphResource>(Resources.size() - 1);
+        }
+
+        void Build(FrameGraph& graph) const
+        {
+            graph.Reset();
+            for (const ResourceRecipe& resource : Resources)
+            {
+                if (resource.Imported)
+                {
+                    graph.Import(resource.Name, resource.InitialUsage, resource.FinalUsage);
+                }
+                else
+                {
+                    graph.CreateTransient(resource.Name, resource.Memory);
+                }
+            }
+
+            for (const PassRecipe& recipe : Passes)
+            {
+                const FrameGraphPass pass = graph.AddPass(recipe.Name, {});
+                for (const Use& use : recipe.Uses)
+                {
+                    if (use.Write)
+                    {
+                        graph.Write(pass, use.Resource, use.Usage);
+                    }
+                    else
+                    {
+                        graph.Read(pass, use.Resource, use.Usage);
+                    }
+                }
+            }
+        }
+    };
+
+    FrameRecipe MakeFrame()
+    {
+        FrameRecipe frame;
+        frame.Resources.push_back({"BackBuffer", true, ResourceUsage::Present, ResourceUsage::Present, {}});
+        frame.Resources.push_back({"Depth", true, ResourceUsage::DepthWrite, ResourceUsage::DepthWrite, {}});
+        const FrameGraphResource backBuffer = 0;
+        const FrameGraphResource depth = 1;
+
+        const TransientMemory shadowMemory = TextureMemory(ShadowSize, ShadowSize, 4);
+        const TransientMemory colorMemory = TextureMemory(Width, Height, 4);
+        const TransientMemory hdrMemory = TextureMemory(Width, Height, 8);
+
+        std::vector<FrameGraphResource> shadows;
+        for (uint32_t cascade = 0; cascade < CascadeCount; ++cascade)
+        {
+            shadows.push_back(frame.AddResource(fmt::format("Shadow{}", cascade), shadowMemory));
+            frame.Passes.push_back(
+                {fmt::format("Shadow{}", cascade), {{shadows.back(), ResourceUsage::DepthWrite, true}}});
+        }
+
+        const FrameGraphResource albedo = frame.AddResource("Albedo", colorMemory);
+        const FrameGraphResource normals = frame.AddResource("Normals", colorMemory);
+        frame.Passes.push_back({"GBuffer",
+                                {{albedo, ResourceUsage::RenderTarget, true},
+                                 {normals, ResourceUsage::RenderTarget, true},
+                                 {depth, ResourceUsage::DepthWrite, true}}});
+
+        PassRecipe lighting{"Lighting", {}};
+        for (const FrameGraphResource resource : {albedo, normals, depth})
+        {
+            lighting.Uses.push_back({resource, ResourceUsage::PixelShaderResource, false});
+        }
+        for (const FrameGraphResource shadow : shadows)
+        {
+            lighting.Uses.push_back({shadow, ResourceUsage::PixelShaderResource, false});
+        }
+        const FrameGraphResource hdr = frame.AddResource("Hdr", hdrMemory);
+        lighting.Uses.push_back({hdr, ResourceUsage::RenderTarget, true});
+        frame.Passes.push_back(std::move(lighting));
+
+        // Each post pass reads the latest image and one of the few before it, and either renders
+        // a new image or updates the latest one in place with a compute shader.
+        std::mt19937                    random(PassCount);
+        std::vector<FrameGraphResource> images = {hdr, albedo, normals};
+        while (frame.Passes.size() < PassCount - 1)
+        {
+            const auto index = static_cast<uint32_t>(frame.Passes.size());
+            if (index % DebugInterval == 0)
+            {
+                const FrameGraphResource view = frame.AddResource(fmt::format("Debug{}", index), colorMemory);
+                frame.Passes.push_back({fmt::format("Debug{}", index),
+                                        {{images[random() % images.size()], ResourceUsage::PixelShaderResource, false},
+                                         {view, ResourceUsage::RenderTarget, true}}});
+                ++frame.DebugPasses;
+                continue;
+            }
+
+            const FrameGraphResource latest = images.front();
+            const FrameGraphResource older = images[1 + random() % std::min<size_t>(images.size() - 1, HistoryLength)];
+            if (random() % 3 == 0)
+            {
+                frame.Passes.push_back({fmt::format("Compute{}", index),
+                                        {{older, ResourceUsage::NonPixelShaderResource, false},
+                                         {latest, ResourceUsage::UnorderedAccess, true}}});
+                continue;
+            }
+
+            const FrameGraphResource image = frame.AddResource(fmt::format("Post{}", index), hdrMemory);
+            frame.Passes.push_back({fmt::format("Post{}", index),
+                                    {{latest, ResourceUsage::PixelShaderResource, false},
+                                     {older, ResourceUsage::PixelShaderResource, false},
+                                     {image, ResourceUsage::RenderTarget, true}}});
+            images.insert(images.begin(), image);
+        }
+
+        frame.Passes.push_back({"Tonemap",
+                                {{images.front(), ResourceUsage::PixelShaderResource, false},
+                                 {backBuffer, ResourceUsage::RenderTarget, true}}});
+        return frame;
+    }
+
+    /// Resources placed in overlapping heap memory, indexed by resource.
+    std::vector<std::vector<FrameGraphResource>> FindAliases(const FrameRecipe& frame, const FrameGraph& graph)
+    {
+        const auto                                   resourceCount = static_cast<uint32_t>(frame.Resources.size());
+        std::vector<std::vector<FrameGraphResource>> aliases(resourceCount);
+        for (FrameGraphResource a = 0; a < resourceCount; ++a)
+        {
+            const AliasingPlacement& placementA = graph.Aliasing().Placement(a);
+            for (FrameGraphResource b = a + 1; b < resourceCount; ++b)
+            {
+                const AliasingPlacement& placementB = graph.Aliasing().Placement(b);
+                if (placementA.Heap != UINT32_MAX && placementA.Heap == placementB.Heap &&
+                    placementA.Offset < placementB.Offset + frame.Resources[b].Memory.Size &&
+                    placementB.Offset < placementA.Offset + frame.Resources[a].Memory.Size)
+                {
+                    aliases[a].push_back(b);
+                    aliases[b].push_back(a);
+                }
+            }
+        }
+        return aliases;
+    }
+
+    /// @brief Replays the compiled barriers and checks every pass sees its resources in the right
+    ///        state, and that no pass touches memory another resource has claimed.
+    /// @throws std::runtime_error on the first mismatch.
+    void Validate(const FrameRecipe& frame, const FrameGraph& graph)
+    {
+        const FrameGraph::Statistics& stats = graph.Stats();
+        if (stats.CulledPasses != frame.DebugPasses)
+        {
+            throw std::runtime_error(
+                fmt::format("Culled {} passes, expected the {} debug passes", stats.CulledPasses, frame.DebugPasses));
+        }
+
+        const auto            aliases = FindAliases(frame, graph);
+        std::vector<uint32_t> states;
+        std::vector<bool>     owned;
+        for (FrameGraphResource resource = 0; resource < frame.Resources.size(); ++resource)
+        {
+            states.push_back(graph.InitialUsage(resource));
+            owned.push_back(aliases[resource].empty());
+        }
+
+        const auto apply = [&](const uint32_t step) {
+            for (const FrameGraphBarrier& barrier : graph.Barriers(step))
+            {
+                uint32_t& state = states[barrier.Resource];
+                if (barrier.Kind == FrameGraphBarrier::Type::Aliasing)
+                {
+                    owned[barrier.Resource] = true;
+                    for (const FrameGraphResource alias : aliases[barrier.Resource])
+                    {
+                        owned[alias] = false;
+                    }
+                    continue;
+                }
+                if (barrier.Kind == FrameGraphBarrier::Type::UnorderedAccess)
+                {
+                    continue;
+                }
+
+                const uint32_t expected = barrier.Part == FrameGraphBarrier::Split::End ? InTransition : barrier.Before;
+                if (state != expected)
+                {
+                    throw std::runtime_error(fmt::format("Barrier on {} before step {} expects the wrong state",
+                                                         graph.ResourceName(barrier.Resource), step));
+                }
+                state = barrier.Part == FrameGraphBarrier::Split::Begin ? InTransition : barrier.After;
+            }
+        };
+
+        const auto order = graph.ExecutionOrder();
+        for (uint32_t step = 0; step < order.size(); ++step)
+        {
+            apply(step);
+            for (const Use& use : frame.Passes[order[step]].Uses)
+            {
+                const uint32_t state = states[use.Resource];
+                if (state == InTransition || (state & use.Usage) != use.Usage)
+                {
+                    throw std::runtime_error(fmt::format("Pass {} uses {} in the wrong state",
+                                                         graph.PassName(order[step]),
+                                                         graph.ResourceName(use.Resource)));
+                }
+                if (!owned[use.Resource])
+                {
+                    throw std::runtime_error(fmt::format("Pass {} uses {} while another resource owns its memory",
+                                                         graph.PassName(order[step]),
+                                                         graph.ResourceName(use.Resource)));
+                }
+            }
+        }
+        apply(static_cast<uint32_t>(order.size()));
+
+        for (uint32_t resource = 0; resource < frame.Resources.size(); ++resource)
+        {
+            if (frame.Resources[resource].Imported && states[resource] != frame.Resources[resource].FinalUsage)
+            {
+                throw std::runtime_error(
+                    fmt::format("{} does not end the frame in its final state", frame.Resources[resource].Name));
+            }
+        }
+    }
+
+    /// Transients of three heap classes with mixed sizes, alignments and lifetimes, a few of them unplaced.
+    std::vector<TransientAllocation> MakeTransients(const uint32_t count)
+    {
+        std::mt19937                     random(count);
+        std::vector<TransientAllocation> transients(count);
+        for (TransientAllocation& transient : transients)
+        {
+            const uint64_t alignment = random() % 8 == 0 ? 4096 : random() % 8 == 0 ? 4 << 20 : 64 << 10;
+            transient.Memory.Alignment = alignment;
+            transient.Memory.Size = random() % 16 == 0 ? 0 : (1 + random() % 16) * alignment - random() % alignment;
+            transient.Memory.HeapClass = random() % 3;
+            transient.FirstUse = random() % PassCount;
+            transient.LastUse = transient.FirstUse + random() % 20;
+        }
+        return transients;
+    }
+
+    /// @brief Checks that the planner keeps resources alive at the same step apart and inside aligned
+    ///        placements of their own heap class.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateAliasingPlan(const std::vector<TransientAllocation>& transients, const AliasingPlanner& planner)
+    {
+        const auto heaps = planner.Heaps();
+        for (uint32_t a = 0; a < transients.size(); ++a)
+        {
+            const TransientMemory&   memory = transients[a].Memory;
+            const AliasingPlacement& placement = planner.Placement(a);
+            if (memory.Size == 0)
+            {
+                if (placement.Heap != UINT32_MAX)
+                {
+                    throw std::runtime_error(fmt::format("Transient {} has no memory but was placed", a));
+                }
+                continue;
+            }
+            if (placement.Heap >= heaps.size() || heaps[placement.Heap].HeapClass != memory.HeapClass ||
+                placement.Offset % memory.Alignment != 0 || placement.Offset + memory.Size > heaps[placement.Heap].Size)
+            {
+                throw std::runtime_error(fmt::format("Transient {} is placed outside an aligned range of its heap", a));
+            }
+
+            for (uint32_t b = a + 1; b < transients.size(); ++b)
+            {
+                const AliasingPlacement& other = planner.Placement(b);
+                const bool alive = transients[a].FirstUse <= transients[b].LastUse &&
+                                   transients[b].FirstUse <= transients[a].LastUse;
+                const bool overlap = other.Heap == placement.Heap &&
+                                     placement.Offset < other.Offset + transients[b].Memory.Size &&
+                                     other.Offset < placement.Offset + memory.Size;
+                if (alive && overlap)
+                {
+                    throw std::runtime_error(
+                        fmt::format("Transients {} and {} are alive together in overlapping memory", a, b));
+                }
+            }
+        }
+    }
+} // namespace
+
+/// Items are passes. The graph is rebuilt from scratch every frame, so building and compiling
+/// together is the per-frame cost.
+void AddFrameGraphBenchmarks(BenchmarkRunner& runner)
+{
+    runner.AddCheck("FrameGraph/Barriers and aliasing", [] {
+        const FrameRecipe frame = MakeFrame();
+        FrameGraph        graph;
+        frame.Build(graph);
+        graph.Compile();
+        Validate(frame, graph);
+    });
+
+    runner.AddCheck("FrameGraph/Aliasing plan", [] {
+        const std::vector<TransientAllocation> transients = MakeTransients(1000);
+        AliasingPlanner                        planner;
+        planner.Plan(transients);
+        ValidateAliasingPlan(transients, planner);
+    });
+
+    runner.Add(fmt::format("FrameGraph/Build and compile {} passes", PassCount), PassCount, [] {
+        auto frame = std::make_shared<FrameRecipe>(MakeFrame());
+        auto graph = std::make_shared<FrameGraph>();
+        frame->Build(*graph);
+        graph->Compile();
+
+        const FrameGraph::Statistics&      stats = graph->Stats();
+        const AliasingPlanner::Statistics& aliasing = graph->Aliasing().Stats();
+        fmt::print("  {} passes, {} culled, {} barriers in {} batches, {} split\n", stats.Passes, stats.CulledPasses,
+                   stats.Barriers, stats.BarrierBatches, stats.SplitBarriers);
+        fmt::print("  {} transients: {:.1f} MB unaliased, {:.1f} MB aliased, {:.1f} MB peak alive, {} barriers\n",
+                   aliasing.Resources, static_cast<double>(aliasing.UnaliasedBytes) / 1.0e6,
+                   static_cast<double>(aliasing.AliasedBytes) / 1.0e6,
+                   static_cast<double>(aliasing.PeakLiveBytes) / 1.0e6, aliasing.Barriers);
+
+        return [frame, graph] {
+            frame->Build(*graph);
+            graph->Compile();
+            DoNotOptimize(graph->Stats().Barriers);
+        };
+    });
+
+    runner.Add("FrameGraph/Plan aliasing of 1000 transients", 1000, [] {
+        auto transients = std::make_shared<std::vector<TransientAllocation>>(MakeTransients(1000));
+        auto planner = std::make_shared<AliasingPlanner>();
+        planner->Plan(*transients);
+
+        const AliasingPlanner::Statistics& stats = planner->Stats();
+        fmt::print("  {:.1f} MB unaliased, {:.1f} MB aliased, {:.1f} MB peak alive\n",
+                   static_cast<double>(stats.UnaliasedBytes) / 1.0e6, static_cast<double>(stats.AliasedBytes) / 1.0e6,
+                   static_cast<double>(stats.PeakLiveBytes) / 1.0e6);
+
+        return [transients, planner] {
+            planner->Plan(*transients);
+            DoNotOptimize(planner->Stats().AliasedBytes);
+        };
+    });
+
+    runner.Add(fmt::format("FrameGraph/Compile {} passes", PassCount), PassCount, [] {
+        auto graph = std::make_shared<FrameGraph>();
+        MakeFrame().Build(*graph);
+
+        return [graph] {
+            graph->Compile();
+            DoNotOptimize(graph->Stats().Barriers);
+        };
+    });
+}
@@ -0,0 +1,553 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Camera.hpp"
+#include "CpuFeatures.hpp"
+#include "GraphicsMath.hpp"
+#include "TransformKernelTable.hpp"
+
+namespace
+{
+    constexpr size_t MatrixCount = 1024;
+    constexpr size_t PointCount = 4096;
+
+    float Random(std::mt19937& random, const float low, const float high)
+    {
+        return std::uniform_real_distribution<float>(low, high)(random);
+    }
+
+    Vector3 RandomVector(std::mt19937& random, const float extent)
+    {
+        return {Random(random, -extent, extent), Random(random, -extent, extent), Random(random, -extent, extent)};
+    }
+
+    Quaternion RandomRotation(std::mt19937& random)
+    {
+        return Quaternion::CreateFromYawPitchRoll(Random(random, -XM_PI, XM_PI), Random(random, -XM_PI, XM_PI),
+                                                  Random(random, -XM_PI, XM_PI));
+    }
+
+    /// Invertible scale, rotation and translation matrices.
+    std::vector<Matrix> RandomMatrices(std::mt19937& random, const size_t count)
+    {
+        std::vector<Matrix> matrices(count);
+        for (Matrix& matrix : matrices)
+        {
+            matrix = Matrix::CreateScale(Random(random, 0.5f, 2.0f)) *
+                     Matrix::CreateFromQuaternion(RandomRotation(random)) *
+                     Matrix::CreateTranslation(RandomVector(random, 100.0f));
+        }
+        return matrices;
+    }
+
+    std::vector<Vector3> RandomPoints(std::mt19937& random, const size_t count)
+    {
+        std::vector<Vector3> points(count);
+        for (Vector3& point : points)
+        {
+            point = RandomVector(random, 100.0f);
+        }
+        return points;
+    }
+
+    std::vector<BoundingBox> RandomBounds(std::mt19937& random, const size_t count)
+    {
+        std::vector<BoundingBox> bounds(count);
+        for (BoundingBox& box : bounds)
+        {
+            box.Center = RandomVector(random, 100.0f);
+            box.Extents = Vector3(Random(random, 0.1f, 5.0f), Random(random, 0.1f, 5.0f), Random(random, 0.1f, 5.0f));
+        }
+        return bounds;
+    }
+
+    /// Kernel tables of the levels this CPU supports, i.e. every path D3D12_SIMD_LEVEL can select, narrowest first.
+    std::vector<const TransformKernelTable*> SupportedKernelTables()
+    {
+        std::vector<const TransformKernelTable*> tables;
+        for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::NEON, SimdLevel::SSE2, SimdLevel::SSE41,
+                                      SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            const TransformKernelTable* table = &TransformKernelsFor(level);
+            if (CpuFeatures::Get().Supports(level) && std::ranges::find(tables, table) == tables.end())
+            {
+                tables.push_back(table);
+            }
+        }
+        return tables;
+    }
+
+    Camera MakeCamera()
+    {
+        return {Vector3(0.0f, 2.0f, 10.0f),
+                Vector3::Forward,
+                Vector3::Up,
+                XMConvertToRadians(75.0f),
+                16.0f / 9.0f,
+                0.1f,
+                1000.0f,
+                1920.0f,
+                1080.0f};
+    }
+
+    /// Relative to the largest expected element, since the paths round differently.
+    constexpr float Tolerance = 1e-5f;
+
+    bool Near(const std::span<const float> actual, const std::span<const float> expected)
+    {
+        float largest = 1.0f;
+        for (const float value : expected)
+        {
+            largest = std::max(largest, std::abs(value));
+        }
+
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            if (std::abs(actual[i] - expected[i]) > Tolerance * largest)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Vectors, boxes and matrices are all plain floats.
+    template <typename T>
+    std::span<const float> Floats(const std::vector<T>& values)
+    {
+        static_assert(sizeof(T) % sizeof(float) == 0);
+        return {reinterpret_cast<const float*>(values.data()), values.size() * sizeof(T) / sizeof(float)};
+    }
+
+    bool Near(const Matrix& actual, const Matrix& expected)
+    {
+        return Near(std::span<const float>(actual.m[0], 16), std::span<const float>(expected.m[0], 16));
+    }
+
+    /// @brief Checks both computeViewProjections overloads against view * projection, including
+    /// cameras that changed after their matrices were last read.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateViewProjections()
+    {
+        // Not a multiple of the vector width, so the kernels' tails run too.
+        constexpr size_t ViewCount = 7;
+
+        std::mt19937              random(13);
+        const std::vector<Matrix> views = RandomMatrices(random, ViewCount);
+        const std::vector<Matrix> projections = RandomMatrices(random, ViewCount);
+        const Matrix              shared = MakeCamera().projection();
+        std::vector<Matrix>       results(ViewCount);
+
+        Camera::computeViewProjections(views, {&shared, 1}, results);
+        for (size_t i = 0; i < ViewCount; ++i)
+        {
+            if (!Near(results[i], views[i] * shared))
+            {
+                throw std::runtime_error(fmt::format("View {} with the shared projection differs", i));
+            }
+        }
+
+        Camera::computeViewProjections(views, projections, results);
+        for (size_t i = 0; i < ViewCount; ++i)
+        {
+            if (!Near(results[i], views[i] * projections[i]))
+            {
+                throw std::runtime_error(fmt::format("View {} with its own projection differs", i));
+            }
+        }
+
+        std::vector<Camera> cameras(3, MakeCamera());
+        for (const Camera& camera : cameras)
+        {
+            DoNotOptimize(camera.viewProjection());
+        }
+        cameras[0].rotate(0.3f, -0.7f);
+        cameras[1].moveForward(0.5f);
+        cameras[1].strafeLeft(0.25f);
+        cameras[2].setProjection(XMConvertToRadians(60.0f), 4.0f / 3.0f, 0.5f, 200.0f, 1024.0f, 768.0f);
+
+        const Camera* const pointers[] = {&cameras[0], &cameras[1], &cameras[2]};
+        Camera::computeViewProjections(pointers, results);
+        for (size_t i = 0; i < cameras.size(); ++i)
+        {
+            const Camera& camera = cameras[i];
+            const Matrix  expected =
+                Matrix::CreateLookAt(camera.position(), camera.position() + camera.direction(), Vector3::Up) *
+                Matrix::CreatePerspectiveFieldOfView(camera.fieldOfView(), camera.aspectRatio(), camera.nearPlane(),
+                                                     camera.farPlane());
+            if (!Near(results[i], expected) || !Near(camera.viewProjection(), expected))
+            {
+                throw std::runtime_error(fmt::format("Camera {} has a stale view-projection", i));
+            }
+        }
+    }
+
+    /// @brief Runs one kernel out of place and in place and compares both with GenericTransformKernels.
+    /// @param run Calls the kernel of the table it is given, reading from the first pointer and writing the second.
+    /// @throws std::runtime_error on mismatch.
+    template <typename T, typename Kernel>
+    void ExpectMatchesGeneric(const TransformKernelTable& table,
+                              const char*                 kernel,
+                              const size_t                count,
+                              const std::vector<T>&       input,
+                              const Kernel&               run)
+    {
+        std::vector<T> expected(input.size());
+        std::vector<T> actual(input.size());
+        std::vector<T> inPlace = input;
+        run(GenericTransformKernels, input.data(), expected.data());
+        run(table, input.data(), actual.data());
+        run(table, inPlace.data(), inPlace.data());
+
+        if (!Near(Floats(actual), Floats(expected)) || !Near(Floats(inPlace), Floats(expected)))
+        {
+            throw std::runtime_error(fmt::format("{} {} differs from {} for {} elements", table.Name, kernel,
+                                                 GenericTransformKernels.Name, count));
+        }
+    }
+
+    /// @brief Checks every kernel of a table against the generic one on lengths that leave a partial vector.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateTransformKernels(const TransformKernelTable& table)
+    {
+        std::mt19937 random(21);
+        for (const size_t count : {1, 3, 7, 13, 17, 31, 33})
+        {
+            const std::vector<Vector3>     points = RandomPoints(random, count);
+            const std::vector<BoundingBox> bounds = RandomBounds(random, count);
+            const std::vector<Matrix>      matrices = RandomMatrices(random, count);
+            const std::vector<Matrix>      others = RandomMatrices(random, count);
+            const Matrix&                  matrix = matrices.front();
+
+            std::vector<uint32_t> indices(count);
+            for (uint32_t& index : indices)
+            {
+                index = static_cast<uint32_t>(random() % count);
+            }
+
+            // Every X, then every Y, then every Z.
+            std::vector<float> components(count * 3);
+            for (float& component : components)
+            {
+                component = Random(random, -100.0f, 100.0f);
+            }
+
+            ExpectMatchesGeneric(table, "TransformPoints", count, points,
+                                 [&](const TransformKernelTable& kernels, const Vector3* in, Vector3* out) {
+                                     kernels.TransformPoints(in, count, matrix, out);
+                                 });
+            ExpectMatchesGeneric(table, "TransformPointsIndexed", count, points,
+                                 [&](const TransformKernelTable& kernels, const Vector3* in, Vector3* out) {
+                                     kernels.TransformPointsIndexed(in, count, matrices.data(), indices.data(), out);
+                                 });
+            ExpectMatchesGeneric(table, "TransformNormals", count, points,
+                                 [&](const TransformKernelTable& kernels, const Vector3* in, Vector3* out) {
+                                     kernels.TransformNormals(in, count, matrix, out);
+                                 });
+            ExpectMatchesGeneric(table, "TransformPointsSoA", count, components,
+                                 [&](const TransformKernelTable& kernels, const float* in, float* out) {
+                                     kernels.TransformPointsSoA({in, in + count, in + count * 2}, count, matrix,
+                                                                {out, out + count, out + count * 2});
+                                 });
+            ExpectMatchesGeneric(table, "TransformNormalsSoA", count, components,
+                                 [&](const TransformKernelTable& kernels, const float* in, float* out) {
+                                     kernels.TransformNormalsSoA({in, in + count, in + count * 2}, count, matrix,
+                                                                 {out, out + count, out + count * 2});
+                                 });
+            ExpectMatchesGeneric(table, "TransformBounds", count, bounds,
+                                 [&](const TransformKernelTable& kernels, const BoundingBox* in, BoundingBox* out) {
+                                     kernels.TransformBounds(in, count, matrix, out);
+                                 });
+            ExpectMatchesGeneric(table, "TransformBoundsMany", count, bounds,
+                                 [&](const TransformKernelTable& kernels, const BoundingBox* in, BoundingBox* out) {
+                                     kernels.TransformBoundsMany(in, count, matrices.data(), out);
+                                 });
+            ExpectMatchesGeneric(table, "MultiplyMatrices", count, matrices,
+                                 [&](const TransformKernelTable& kernels, const Matrix* in, Matrix* out) {
+                                     kernels.MultiplyMatrices(in, count, others.data(), 1, out);
+                                 });
+            ExpectMatchesGeneric(table, "MultiplyMatrices with a shared matrix", count, matrices,
+                                 [&](const TransformKernelTable& kernels, const Matrix* in, Matrix* out) {
+                                     kernels.MultiplyMatrices(in, count, others.data(), 0, out);
+                                 });
+
+            // The generic table is XMMatrixMultiply too, so check the product itself once more.
+            std::vector<Matrix> products(count);
+            table.MultiplyMatrices(matrices.data(), count, others.data(), 1, products.data());
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!Near(products[i], Matrix(XMMatrixMultiply(matrices[i], others[i]))))
+                {
+                    throw std::runtime_error(
+                        fmt::format("{} MultiplyMatrices differs from XMMatrixMultiply at {}", table.Name, i));
+                }
+            }
+        }
+    }
+
+    /// @brief Checks that the dispatched kernels are the validated table of the selected level.
+    /// @throws std::runtime_error on mismatch.
+    void ValidateDispatchedKernels()
+    {
+        const TransformKernelTable& selected = TransformKernelsFor(SelectedSimdLevel());
+        if (std::string_view(TransformKernels::PathName()) != selected.Name)
+        {
+            throw std::runtime_error(fmt::format("Dispatched {} kernels, but {} selects {}",
+                                                 TransformKernels::PathName(), SimdLevelName(SelectedSimdLevel()),
+                                                 selected.Name));
+        }
+
+        std::mt19937              random(22);
+        const std::vector<Matrix> a = RandomMatrices(random, 5);
+        const std::vector<Matrix> b = RandomMatrices(random, 5);
+        std::vector<Matrix>       results(5);
+        TransformKernels::MultiplyMatrices(a, b, results);
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            if (!Near(results[i], Matrix(XMMatrixMultiply(a[i], b[i]))))
+            {
+                throw std::runtime_error(fmt::format("Dispatched MultiplyMatrices differs at {}", i));
+            }
+        }
+    }
+
+    void AddSimpleMathBenchmarks(BenchmarkRunner& runner)
+    {
+        runner.Add("SimpleMath/Matrix multiply", MatrixCount, [] {
+            std::mt19937 random(1);
+            return [a = RandomMatrices(random, MatrixCount), b = RandomMatrices(random, MatrixCount),
+                    results = std::vector<Matrix>(MatrixCount)]() mutable {
+                for (size_t i = 0; i < MatrixCount; ++i)
+                {
+                    results[i] = a[i] * b[i];
+                }
+                DoNotOptimize(results.front());
+            };
+        });
+
+        runner.Add("SimpleMath/Matrix invert", MatrixCount, [] {
+            std::mt19937 random(2);
+            return [matrices = RandomMatrices(random, MatrixCount),
+                    results = std::vector<Matrix>(MatrixCount)]() mutable {
+                for (size_t i = 0; i < MatrixCount; ++i)
+                {
+                    results[i] = matrices[i].Invert();
+                }
+                DoNotOptimize(results.front());
+            };
+        });
+
+        runner.Add("SimpleMath/Matrix from scale, rotation, translation", MatrixCount, [] {
+            std::mt19937            random(3);
+            std::vector<Quaternion> rotations(MatrixCount);
+            for (Quaternion& rotation : rotations)
+            {
+                rotation = RandomRotation(random);
+            }
+
+            return [rotations = std::move(rotations), translations = RandomPoints(random, MatrixCount),
+                    results = std::vector<Matrix>(MatrixCount)]() mutable {
+                for (size_t i = 0; i < MatrixCount; ++i)
+                {
+                    results[i] = Matrix::CreateScale(1.5f) * Matrix::CreateFromQuaternion(rotations[i]) *
+                                 Matrix::CreateTranslation(translations[i]);
+                }
+                DoNotOptimize(results.front());
+            };
+        });
+
+        runner.Add("SimpleMath/Quaternion multiply", MatrixCount, [] {
+            std::mt19937            random(4);
+            std::vector<Quaternion> a(MatrixCount);
+            std::vector<Quaternion> b(MatrixCount);
+            for (size_t i = 0; i < MatrixCount; ++i)
+            {
+                a[i] = RandomRotation(random);
+                b[i] = RandomRotation(random);
+            }
+
+            return [a = std::move(a), b = std::move(b), results = std::vector<Quaternion>(MatrixCount)]() mutable {
+                for (size_t i = 0; i < MatrixCount; ++i)
+                {
+                    results[i] = a[i] * b[i];
+                }
+                DoNotOptimize(results.front());
+            };
+        });
+
+        runner.Add("SimpleMath/Quaternion slerp", MatrixCount, [] {
+            std::mt19937            random(5);
+            std::vector<Quaternion> a(MatrixCount);
+            std::vector<Quaternion> b(MatrixCount);
+            for (size_t i = 0; i < MatrixCount; ++i)
+            {
+                a[i] = RandomRotation(random);
+                b[i] = RandomRotation(random);
+            }
+
+            return [a = std::move(a), b = std::move(b), results = std::vector<Quaternion>(MatrixCount)]() mutable {
+                for (size_t i = 0; i < MatrixCount; ++i)
+                {
+                    results[i] = Quaternion::Slerp(a[i], b[i], 0.35f);
+                }
+                DoNotOptimize(results.front());
+            };
+        });
+
+        runner.Add("SimpleMath/Quaternion from yaw, pitch, roll", MatrixCount, [] {
+            std::mt19937 random(6);
+            return [angles = RandomPoints(random, MatrixCount),
+                    results = std::vector<Quaternion>(MatrixCount)]() mutable {
+                for (size_t i = 0; i < MatrixCount; ++i)
+                {
+                    results[i] = Quaternion::CreateFromYawPitchRoll(angles[i]);
+                }
+                DoNotOptimize(results.front());
+            };
+        });
+
+        runner.Add("SimpleMath/Vector3 transform", PointCount, [] {
+            std::mt19937 random(7);
+            return [points = RandomPoints(random, PointCount), matrix = RandomMatrices(random, 1).front(),
+                    results = std::vector<Vector3>(PointCount)]() mutable {
+                for (size_t i = 0; i < PointCount; ++i)
+                {
+                    Vector3::Transform(points[i], matrix, results[i]);
+                }
+                DoNotOptimize(results.front());
+            };
+        });
+
+        runner.Add("SimpleMath/BoundingBox transform", PointCount, [] {
+            std::mt19937 random(8);
+            return [bounds = RandomBounds(random, PointCount), matrix = RandomMatrices(random, 1).front(),
+                    results = std::vector<BoundingBox>(PointCount)]() mutable {
+                for (size_t i = 0; i < PointCount; ++i)
+                {
+                    bounds[i].Transform(results[i], matrix);
+                }
+                DoNotOptimize(results.front());
+            };
+        });
+    }
+
+    /// Each kernel is measured with every table the CPU supports so the paths can be compared directly.
+    void AddTransformKernelBenchmarks(BenchmarkRunner& runner)
+    {
+        runner.AddCheck("TransformKernels/Dispatch", ValidateDispatchedKernels);
+        for (const TransformKernelTable* table : SupportedKernelTables())
+        {
+            const std::string suffix = std::string("/") + table->Name;
+            runner.AddCheck("TransformKernels" + suffix, [table] { ValidateTransformKernels(*table); });
+
+            runner.Add("TransformKernels/TransformPoints" + suffix, PointCount, [table] {
+                std::mt19937 random(7);
+                return [table, points = RandomPoints(random, PointCount), matrix = RandomMatrices(random, 1).front(),
+                        results = std::vector<Vector3>(PointCount)]() mutable {
+                    table->TransformPoints(points.data(), PointCount, matrix, results.data());
+                    DoNotOptimize(results.front());
+                };
+            });
+
+            runner.Add("TransformKernels/TransformNormals" + suffix, PointCount, [table] {
+                std::mt19937 random(9);
+                return [table, normals = RandomPoints(random, PointCount), matrix = RandomMatrices(random, 1).front(),
+                        results = std::vector<Vector3>(PointCount)]() mutable {
+                    table->TransformNormals(normals.data(), PointCount, matrix, results.data());
+                    DoNotOptimize(results.front());
+                };
+            });
+
+            runner.Add("TransformKernels/TransformPoints SoA" + suffix, PointCount, [table] {
+                std::mt19937       random(10);
+                std::vector<float> components(PointCount * 6);
+                for (size_t i = 0; i < PointCount * 3; ++i)
+                {
+                    components[i] = Random(random, -100.0f, 100.0f);
+                }
+
+                return [table, components = std::move(components),
+                        matrix = RandomMatrices(random, 1).front()]() mutable {
+                    float* data = components.data();
+                    table->TransformPointsSoA({data, data + PointCount, data + PointCount * 2}, PointCount, matrix,
+                                              {data + PointCount * 3, data + PointCount * 4, data + PointCount * 5});
+                    DoNotOptimize(components.back());
+                };
+            });
+
+            runner.Add("TransformKernels/TransformBounds" + suffix, PointCount, [table] {
+                std::mt19937 random(8);
+                return [table, bounds = RandomBounds(random, PointCount), matrix = RandomMatrices(random, 1).front(),
+                        results = std::vector<BoundingBox>(PointCount)]() mutable {
+                    table->TransformBounds(bounds.data(), PointCount, matrix, results.data());
+                    DoNotOptimize(results.front());
+                };
+            });
+
+            runner.Add("TransformKernels/MultiplyMatrices" + suffix, MatrixCount, [table] {
+                std::mt19937 random(1);
+                return [table, a = RandomMatrices(random, MatrixCount), b = RandomMatrices(random, MatrixCount),
+                        results = std::vector<Matrix>(MatrixCount)]() mutable {
+                    table->MultiplyMatrices(a.data(), MatrixCount, b.data(), 1, results.data());
+                    DoNotOptimize(results.front());
+                };
+            });
+        }
+    }
+
+    void AddCameraBenchmarks(BenchmarkRunner& runner)
+    {
+        runner.Add("Camera/rotate + viewProjection", 1, [] {
+            return [camera = MakeCamera()]() mutable {
+                camera.rotate(0.001f, 0.002f);
+                DoNotOptimize(camera.viewProjection());
+            };
+        });
+
+        runner.Add("Camera/viewProjection unchanged", 1, [] {
+            return [camera = MakeCamera()] { DoNotOptimize(camera.viewProjection()); };
+        });
+
+        runner.AddCheck("Camera/computeViewProjections", ValidateViewProjections);
+
+        // Six views sharing one projection, as when rendering a cube map.
+        runner.Add("Camera/computeViewProjections 6 views", 6, [] {
+            std::mt19937 random(11);
+            return [views = RandomMatrices(random, 6), projection = MakeCamera().projection(),
+                    results = std::vector<Matrix>(6)]() mutable {
+                Camera::computeViewProjections(views, {&projection, 1}, results);
+                DoNotOptimize(results.front());
+            };
+        });
+
+        runner.Add("Camera/computeViewProjections 1024 views", MatrixCount, [] {
+            std::mt19937 random(12);
+            return [views = RandomMatrices(random, MatrixCount), projections = RandomMatrices(random, MatrixCount),
+                    results = std::vector<Matrix>(MatrixCount)]() mutable {
+                Camera::computeViewProjections(views, projections, results);
+                DoNotOptimize(results.front());
+            };
+        });
+    }
+} // namespace
+
+void AddMathBenchmarks(BenchmarkRunner& runner)
+{
+    AddSimpleMathBenchmarks(runner);
+    AddTransformKernelBenchmarks(runner);
+    AddCameraBenchmarks(runner);
+}
@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "GraphicsMath.hpp"
+#include "MorphTargets.hpp"
+
+namespace
+{
+    constexpr uint32_t RingCount = 150;
+    constexpr uint32_t RingVertexCount = 200;
+    constexpr uint32_t VertexCount = RingCount * RingVertexCount;
+    constexpr uint32_t TargetCount = 64;
+    constexpr uint32_t KeyCount = 30;
+
+    /// A unit sphere standing in for a head, with planar positions and normals.
+    struct Head
+    {
+        std::vector<float> Positions;
+        std::vector<float> Normals;
+        MorphTargetSet     Targets;
+
+        [[nodiscard]] ConstVector3Stream BasePositions() const
+        {
+            return {Positions.data(), Positions.data() + VertexCount, Positions.data() + VertexCount * 2};
+        }
+
+        [[nodiscard]] ConstVector3Stream BaseNormals() const
+        {
+            return {Normals.data(), Normals.data() + VertexCount, Normals.data() + VertexCount * 2};
+        }
+    };
+
+    /// Every target pushes out a smooth bump around a random point, like a facial expression
+    /// moving one region of the face.
+    std::shared_ptr<Head> MakeHead()
+    {
+        auto head = std::make_shared<Head>();
+        head->Positions.resize(VertexCount * 3);
+        for (uint32_t ring = 0; ring < RingCount; ++ring)
+        {
+            const float latitude = XM_PI * (static_cast<float>(ring) + 0.5f) / RingCount;
+            for (uint32_t step = 0; step < RingVertexCount; ++step)
+            {
+                const uint32_t v = ring * RingVertexCount + step;
+                const float    longitude = XM_2PI * static_cast<float>(step) / RingVertexCount;
+                head->Positions[v] = std::sin(latitude) * std::cos(longitude);
+                head->Positions[VertexCount + v] = std::cos(latitude);
+                head->Positions[VertexCount * 2 + v] = std::sin(latitude) * std::sin(longitude);
+            }
+        }
+        head->Normals = head->Positions;
+
+        std::mt19937                          random(TargetCount);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> radius(0.3f, 0.8f);
+
+        std::vector<float> positionDeltas(VertexCount * 3);
+        std::vector<float> normalDeltas(VertexCount * 3);
+        head->Targets.VertexCount = VertexCount;
+        for (uint32_t target = 0; target < TargetCount; ++target)
+        {
+            const Vector3 center = XMVector3Normalize(XMVectorSet(unit(random), unit(random), unit(random), 0.0f));
+            const float   reach = radius(random);
+
+            std::fill(positionDeltas.begin(), positionDeltas.end(), 0.0f);
+            std::fill(normalDeltas.begin(), normalDeltas.end(), 0.0f);
+            for (uint32_t v = 0; v < VertexCount; ++v)
+            {
+                const Vector3 position(head->Positions[v], head->Positions[VertexCount + v],
+                                       head->Positions[VertexCount * 2 + v]);
+                const float   distance = Vector3::Distance(position, center);
+                if (distance >= reach)
+                {
+                    continue;
+                }
+
+                const float falloff = 1.0f - distance / reach;
+                for (uint32_t component = 0; component < 3; ++component)
+                {
+                    const float normal = head->Normals[component * VertexCount + v];
+                    positionDeltas[component * VertexCount + v] = 0.02f * falloff * falloff * normal;
+                    normalDeltas[component * VertexCount + v] = 0.1f * falloff * normal;
+                }
+            }
+
+            const float* p = positionDeltas.data();
+            const float* n = normalDeltas.data();
+            head->Targets.Targets.push_back(MakeSparseMorphTarget(fmt::format("target{}", target), VertexCount,
+                                                                  {p, p + VertexCount, p + VertexCount * 2},
+                                                                  {n, n + VertexCount, n + VertexCount * 2}));
+        }
+        head->Targets.DefaultWeights.assign(TargetCount, 0.0f);
+        return head;
+    }
+
+    /// A one second track that animates the first activeCount weights and keeps the others at zero.
+    MorphWeightTrack MakeWeightTrack(const uint32_t activeCount)
+    {
+        std::mt19937                          random(activeCount);
+        std::uniform_real_distribution<float> weight(0.05f, 1.0f);
+
+        MorphWeightTrack track;
+        track.Duration = 1.0f;
+        track.TargetCount = TargetCount;
+        for (uint32_t key = 0; key < KeyCount; ++key)
+        {
+            track.Times.push_back(static_cast<float>(key) / static_cast<float>(KeyCount - 1));
+            for (uint32_t target = 0; target < TargetCount; ++target)
+            {
+                track.Values.push_back(target < activeCount ? weight(random) : 0.0f);
+            }
+        }
+        return track;
+    }
+
+    void PrintStorage(const MorphTargetSet& targets)
+    {
+        size_t stored = 0;
+        for (const MorphTarget& target : targets.Targets)
+        {
+            stored += target.DeltaCount;
+        }
+
+        const size_t dense = targets.VertexCount * targets.Targets.size();
+        fmt::print("  {} targets: deltas stored for {:.1f}% of vertices, {:.1f} MB instead of {:.1f} MB\n",
+                   targets.Targets.size(), 100.0 * static_cast<double>(stored) / static_cast<double>(dense),
+                   static_cast<double>(stored * 6 * sizeof(float)) / 1.0e6,
+                   static_cast<double>(dense * 6 * sizeof(float)) / 1.0e6);
+    }
+
+    /// One frame per call: the weights are evaluated once, then every active target is applied.
+    void AddBlendBenchmark(BenchmarkRunner& runner, const uint32_t activeCount)
+    {
+        const auto name = fmt::format("MorphTargets/Blend {}k vertices, {} of {} targets active", VertexCount / 1000,
+                                      activeCount, TargetCount);
+
+        runner.Add(name, VertexCount, [activeCount] {
+            auto head = MakeHead();
+            PrintStorage(head->Targets);
+
+            auto output = std::make_shared<std::vector<float>>(VertexCount * 6);
+            return [head, output, track = MakeWeightTrack(activeCount), weights = std::vector<float>(TargetCount),
+                    blender = MorphBlender(), time = 0.0f]() mutable {
+                time += 1.0f / 60.0f;
+                track.Evaluate(time, true, weights);
+
+                float* planes = output->data();
+                blender.Blend(head->Targets, weights, head->BasePositions(), head->BaseNormals(),
+                              {planes, planes + VertexCount, planes + VertexCount * 2},
+                              {planes + VertexCount * 3, planes + VertexCount * 4, planes + VertexCount * 5});
+                DoNotOptimize(output->back());
+            };
+        });
+    }
+
+    /// The same frame with dense deltas, applying every target to every vertex, for comparison.
+    void AddDenseBlendBenchmark(BenchmarkRunner& runner)
+    {
+        const auto name = fmt::format("MorphTargets/Blend {}k vertices, {} dense targets", VertexCount / 1000,
+                                      TargetCount);
+
+        runner.Add(name, VertexCount, [] {
+            auto head = MakeHead();
+            auto deltas = std::make_shared<std::vector<float>>(static_cast<size_t>(VertexCount) * 6 * TargetCount);
+            for (uint32_t target = 0; target < TargetCount; ++target)
+            {
+                const MorphTarget& sparse = head->Targets.Targets[target];
+                float*             dense = deltas->data() + static_cast<size_t>(VertexCount) * 6 * target;
+                for (const MorphSpan& span : sparse.Spans)
+                {
+                    for (uint32_t component = 0; component < 3; ++component)
+                    {
+                        const size_t from = component * sparse.DeltaCount + span.FirstDelta;
+                        std::copy_n(sparse.PositionDeltas.begin() + from, span.VertexCount,
+                                    dense + component * VertexCount + span.FirstVertex);
+                        std::copy_n(sparse.NormalDeltas.begin() + from, span.VertexCount,
+                                    dense + (component + 3) * VertexCount + span.FirstVertex);
+                    }
+                }
+            }
+
+            auto output = std::make_shared<std::vector<float>>(VertexCount * 6);
+            return [head, deltas, output, track = MakeWeightTrack(TargetCount),
+                    weights = std::vector<float>(TargetCount), time = 0.0f]() mutable {
+                time += 1.0f / 60.0f;
+                track.Evaluate(time, true, weights);
+
+                std::copy(head->Positions.begin(), head->Positions.end(), output->begin());
+                std::copy(head->Normals.begin(), head->Normals.end(), output->begin() + VertexCount * 3);
+                for (uint32_t target = 0; target < TargetCount; ++target)
+                {
+                    const float* dense = deltas->data() + static_cast<size_t>(VertexCount) * 6 * target;
+                    for (size_t i = 0; i < output->size(); ++i)
+                    {
+                        (*output)[i] += dense[i] * weights[target];
+                    }
+                }
+                DoNotOptimize(output->back());
+            };
+        });
+    }
+} // namespace
+
+/// Items are vertices of the head. The blend benchmarks print how much of the dense delta
+/// storage the sparse targets need.
+void AddMorphBenchmarks(BenchmarkRunner& runner)
+{
+    for (const uint32_t activeCount : {16u, 52u, 64u})
+    {
+        AddBlendBenchmark(runner, activeCount);
+    }
+    AddDenseBlendBenchmark(runner);
+}
@@ -0,0 +1,511 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "PipelineCache.hpp"
+
+namespace
+{
+    constexpr size_t   ShaderSize = 4096;
+    constexpr uint32_t CachedKeys = 1024;
+    constexpr uint32_t RequestedKeys = 64;
+    constexpr uint32_t FailingKey = 13;
+
+    /// Shaders and input layout the descriptions of the benchmark point at.
+    struct PipelineSource
+    {
+        std::vector<std::byte>                         VertexShader;
+        std::vector<std::byte>                         PixelShader;
+        std::vector<PipelineDescription::InputElement> InputLayout = {
+            {"POSITION", 0, 6, 0, 0}, {"COLOR", 0, 2, 0, 12}, {"TEXCOORD", 0, 16, 0, 28}};
+
+        explicit PipelineSource(const size_t shaderSize)
+        {
+            std::mt19937 random(static_cast<uint32_t>(shaderSize));
+            for (size_t i = 0; i < shaderSize; ++i)
+            {
+                VertexShader.push_back(static_cast<std::byte>(random()));
+                PixelShader.push_back(static_cast<std::byte>(random()));
+            }
+        }
+
+        /// @brief Describes an opaque, depth tested pipeline drawing triangles to one target.
+        [[nodiscard]] PipelineDescription Describe() const
+        {
+            PipelineDescription desc;
+            desc.RootSignature = {1, 2};
+            desc.Shaders[0] = VertexShader;
+            desc.Shaders[1] = PixelShader;
+            for (PipelineDescription::TargetBlend& target : desc.Blend)
+            {
+                target.RenderTargetWriteMask = 0xF;
+            }
+            desc.SampleMask = UINT32_MAX;
+            desc.FillMode = 3;
+            desc.CullMode = 3;
+            desc.DepthClipEnable = 1;
+            desc.DepthEnable = 1;
+            desc.DepthWriteMask = 1;
+            desc.DepthFunc = 2;
+            desc.StencilReadMask = 0xFF;
+            desc.StencilWriteMask = 0xFF;
+            desc.FrontFace = {1, 1, 1, 8};
+            desc.BackFace = {1, 1, 1, 8};
+            desc.InputLayout = InputLayout;
+            desc.PrimitiveTopologyType = 3;
+            desc.NumRenderTargets = 1;
+            desc.RTVFormats[0] = 87;
+            desc.DSVFormat = 40;
+            desc.SampleCount = 1;
+            return desc;
+        }
+    };
+
+    /// Counts keys the way a hash table sees them: each 64-bit half on its own.
+    class KeySet
+    {
+    public:
+        void Insert(const PipelineKey& key, const std::string& variant)
+        {
+            if (!m_low.insert(key.Low).second || !m_high.insert(key.High).second)
+            {
+                throw std::runtime_error(fmt::format("Pipeline key of {} collides with another variant", variant));
+            }
+        }
+
+        [[nodiscard]] size_t Size() const
+        {
+            return m_low.size();
+        }
+
+    private:
+        std::unordered_set<uint64_t> m_low;
+        std::unordered_set<uint64_t> m_high;
+    };
+
+    /// @brief Checks that keys stay the same across runs and that variants of a description
+    /// differing in one field, one shader bit or the shader length never collide in either half.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateKeys()
+    {
+        // Keys name pipelines on disk, so changing the hash orphans every saved library.
+        const std::byte   bytes[] = {std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}, std::byte{5}};
+        const PipelineKey known = PipelineHasher().Add("PipelineKey").Add(uint32_t{42}).Add(bytes).Key();
+        if (known.ToString() != "27c328c9a62e3c77eccae87f9458e072")
+        {
+            throw std::runtime_error(fmt::format("Pipeline key changed to {}", known.ToString()));
+        }
+
+        const std::byte zero[] = {std::byte{1}, std::byte{0}};
+        if (PipelineHasher().Add("ab").Add("c").Key() == PipelineHasher().Add("a").Add("bc").Key() ||
+            PipelineHasher().Add(static_cast<const char*>(nullptr)).Key() == PipelineHasher().Add("").Key() ||
+            PipelineHasher().Add(zero).Key() == PipelineHasher().Add(std::span(zero, 1)).Key() ||
+            PipelineHasher().Add(0u).Key() == PipelineHasher().Key())
+        {
+            throw std::runtime_error("Pipeline keys of neighbouring fields trade bytes");
+        }
+
+        using Desc = PipelineDescription;
+        using Element = PipelineDescription::InputElement;
+
+        const PipelineSource source(ShaderSize);
+        const Desc           base = source.Describe();
+        KeySet               keys;
+        keys.Insert(base.Key(), "the base");
+        if (base.Key() != PipelineSource(source).Describe().Key())
+        {
+            throw std::runtime_error("Pipeline key of a copy differs");
+        }
+
+        std::vector<std::byte> vertexShader = source.VertexShader;
+        std::vector<std::byte> pixelShader = source.PixelShader;
+        for (size_t bit = 0; bit < ShaderSize * 8; ++bit)
+        {
+            const std::byte flip = std::byte{1} << (bit % 8);
+
+            Desc vertex = base;
+            vertex.Shaders[0] = vertexShader;
+            vertexShader[bit / 8] ^= flip;
+            keys.Insert(vertex.Key(), fmt::format("vertex shader bit {}", bit));
+            vertexShader[bit / 8] ^= flip;
+
+            Desc pixel = base;
+            pixel.Shaders[1] = pixelShader;
+            pixelShader[bit / 8] ^= flip;
+            keys.Insert(pixel.Key(), fmt::format("pixel shader bit {}", bit));
+            pixelShader[bit / 8] ^= flip;
+        }
+        for (size_t size = 0; size < ShaderSize; ++size)
+        {
+            Desc shorter = base;
+            shorter.Shaders[0] = base.Shaders[0].first(size);
+            keys.Insert(shorter.Key(), fmt::format("vertex shader of {} bytes", size));
+        }
+
+        constexpr std::pair<const char*, uint32_t Desc::*> Fields[] = {
+            {"rasterized stream", &Desc::RasterizedStream},
+            {"alpha to coverage", &Desc::AlphaToCoverageEnable},
+            {"independent blend", &Desc::IndependentBlendEnable},
+            {"sample mask", &Desc::SampleMask},
+            {"fill mode", &Desc::FillMode},
+            {"cull mode", &Desc::CullMode},
+            {"front counter clockwise", &Desc::FrontCounterClockwise},
+            {"depth clip", &Desc::DepthClipEnable},
+            {"multisample", &Desc::MultisampleEnable},
+            {"antialiased lines", &Desc::AntialiasedLineEnable},
+            {"forced sample count", &Desc::ForcedSampleCount},
+            {"conservative raster", &Desc::ConservativeRaster},
+            {"depth enable", &Desc::DepthEnable},
+            {"depth write mask", &Desc::DepthWriteMask},
+            {"depth func", &Desc::DepthFunc},
+            {"stencil enable", &Desc::StencilEnable},
+            {"strip cut value", &Desc::IBStripCutValue},
+            {"topology", &Desc::PrimitiveTopologyType},
+            {"target count", &Desc::NumRenderTargets},
+            {"depth format", &Desc::DSVFormat},
+            {"sample count", &Desc::SampleCount},
+            {"sample quality", &Desc::SampleQuality},
+            {"node mask", &Desc::NodeMask},
+            {"flags", &Desc::Flags}};
+        constexpr std::pair<const char*, uint32_t Desc::TargetBlend::*> BlendFields[] = {
+            {"blend enable", &Desc::TargetBlend::BlendEnable},
+            {"logic op enable", &Desc::TargetBlend::LogicOpEnable},
+            {"source blend", &Desc::TargetBlend::SrcBlend},
+            {"destination blend", &Desc::TargetBlend::DestBlend},
+            {"blend op", &Desc::TargetBlend::BlendOp},
+            {"source alpha blend", &Desc::TargetBlend::SrcBlendAlpha},
+            {"destination alpha blend", &Desc::TargetBlend::DestBlendAlpha},
+            {"alpha blend op", &Desc::TargetBlend::BlendOpAlpha},
+            {"logic op", &Desc::TargetBlend::LogicOp}};
+        constexpr std::pair<const char*, uint32_t Desc::StencilOp::*> StencilFields[] = {
+            {"stencil fail op", &Desc::StencilOp::StencilFailOp},
+            {"stencil depth fail op", &Desc::StencilOp::StencilDepthFailOp},
+            {"stencil pass op", &Desc::StencilOp::StencilPassOp},
+            {"stencil func", &Desc::StencilOp::StencilFunc}};
+        constexpr std::pair<const char*, uint32_t Element::*> ElementFields[] = {
+            {"semantic index", &Element::SemanticIndex},
+            {"element format", &Element::Format},
+            {"input slot", &Element::InputSlot},
+            {"element offset", &Element::AlignedByteOffset},
+            {"input slot class", &Element::InputSlotClass},
+            {"instance step rate", &Element::InstanceDataStepRate}};
+
+        // Every change moves the field off its base value, so a field left out of the key collides with the base.
+        for (uint32_t value = 1; value < 256; ++value)
+        {
+            auto vary = [&](const std::string& field, auto&& change) {
+                Desc variant = base;
+                change(variant);
+                keys.Insert(variant.Key(), fmt::format("{} = {}", field, value));
+            };
+            auto varyElement = [&](const std::string& field, auto&& change) {
+                std::vector<Element> layout = source.InputLayout;
+                change(layout[value % layout.size()]);
+                vary(field, [&](Desc& d) { d.InputLayout = layout; });
+            };
+            const auto                    byte = static_cast<uint8_t>(value);
+            const std::string             semantic = fmt::format("COLOR{:c}", static_cast<char>(value));
+            const Desc::StreamOutputEntry entry = {value, "SV_Position", 0, 0, 4, 0};
+
+            vary("root signature", [&](Desc& d) { d.RootSignature.Low += value; });
+            for (const size_t stage : {2, 3, 4})
+            {
+                vary(fmt::format("shader {}", stage),
+                     [&](Desc& d) { d.Shaders[stage] = base.Shaders[0].first(value); });
+            }
+            vary("stream output entry", [&](Desc& d) { d.StreamOutput = std::span(&entry, 1); });
+            vary("stream output stride", [&](Desc& d) { d.StreamOutputStrides = std::span(&value, 1); });
+            for (const auto& [field, member] : Fields)
+            {
+                vary(field, [&](Desc& d) { d.*member += value; });
+            }
+            for (const auto& [field, member] : BlendFields)
+            {
+                vary(field, [&](Desc& d) { d.Blend[value % 8].*member += 1 + value / 8; });
+            }
+            vary("write mask", [&](Desc& d) { d.Blend[value % 8].RenderTargetWriteMask += 1 + value / 8; });
+            vary("depth bias", [&](Desc& d) { d.DepthBias = -static_cast<int32_t>(value); });
+            vary("depth bias clamp", [&](Desc& d) { d.DepthBiasClamp = value * 0.25f; });
+            vary("slope bias", [&](Desc& d) { d.SlopeScaledDepthBias = value * 0.25f; });
+            vary("stencil read mask", [&](Desc& d) { d.StencilReadMask ^= byte; });
+            vary("stencil write mask", [&](Desc& d) { d.StencilWriteMask ^= byte; });
+            for (const auto& [field, member] : StencilFields)
+            {
+                vary(fmt::format("front {}", field), [&](Desc& d) { d.FrontFace.*member += value; });
+                vary(fmt::format("back {}", field), [&](Desc& d) { d.BackFace.*member += value; });
+            }
+            varyElement("semantic", [&](Element& e) { e.SemanticName = semantic.c_str(); });
+            for (const auto& [field, member] : ElementFields)
+            {
+                varyElement(field, [&](Element& e) { e.*member += value; });
+            }
+            vary("target format", [&](Desc& d) { d.RTVFormats[1 + value % 7] = value; });
+        }
+    }
+
+    struct TrackedPipeline
+    {
+        uint32_t Id;
+    };
+
+    std::atomic<uint32_t> ReleasedPipelines = 0;
+
+    void ReleaseTracked(void* pipeline)
+    {
+        delete static_cast<TrackedPipeline*>(pipeline);
+        ReleasedPipelines.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PipelineKey KeyOf(const uint32_t id)
+    {
+        return PipelineHasher().Add(id).Key();
+    }
+
+    /// @brief Holds compiles back until opened, so the test sees pipelines while they are pending.
+    /// Opens when destroyed, so a failed check does not leave workers waiting forever.
+    struct Gate
+    {
+        std::promise<void>       Signal;
+        std::shared_future<void> Opened = Signal.get_future().share();
+        bool                     IsOpen = false;
+
+        void Open()
+        {
+            if (!IsOpen)
+            {
+                Signal.set_value();
+                IsOpen = true;
+            }
+        }
+
+        ~Gate()
+        {
+            Open();
+        }
+    };
+
+    /// @brief Checks that each key is created once, that Get() hands out the fallback until its
+    /// pipeline is ready, that failures stay visible and that every pipeline is released once.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateCache()
+    {
+        ReleasedPipelines = 0;
+        std::vector<std::atomic<uint32_t>> creates(RequestedKeys);
+        TrackedPipeline                    fallback = {UINT32_MAX};
+        {
+            PipelineCache cache(ReleaseTracked, 2);
+            Gate          gate;
+            for (uint32_t pass = 0; pass < 2; ++pass)
+            {
+                for (uint32_t id = 0; id < RequestedKeys; ++id)
+                {
+                    const bool inserted = cache.Request(KeyOf(id), [&creates, opened = gate.Opened, id]() -> void* {
+                        opened.wait();
+                        creates[id].fetch_add(1);
+                        if (id == FailingKey)
+                        {
+                            throw std::runtime_error("Shader does not compile");
+                        }
+                        return new TrackedPipeline{id};
+                    });
+                    if (inserted != (pass == 0))
+                    {
+                        throw std::runtime_error(fmt::format("Pipeline {} was queued {} times", id, pass + 1));
+                    }
+                }
+            }
+
+            for (uint32_t id = 0; id < RequestedKeys; ++id)
+            {
+                if (cache.Get(KeyOf(id), &fallback) != &fallback)
+                {
+                    throw std::runtime_error(fmt::format("Pipeline {} was handed out before it was created", id));
+                }
+            }
+            const PipelineCache::Statistics pending = cache.Stats();
+            if (pending.Requests != 2 * RequestedKeys || pending.Pipelines != RequestedKeys ||
+                pending.Pending != RequestedKeys || pending.Fallbacks != RequestedKeys)
+            {
+                throw std::runtime_error("Pipeline counters are wrong while compiling");
+            }
+
+            gate.Open();
+            for (uint32_t id = 0; id < RequestedKeys; ++id)
+            {
+                if (id == FailingKey)
+                {
+                    continue;
+                }
+                auto* pipeline = static_cast<TrackedPipeline*>(cache.Wait(KeyOf(id)));
+                if (pipeline == nullptr || pipeline->Id != id || cache.Get(KeyOf(id), &fallback) != pipeline)
+                {
+                    throw std::runtime_error(fmt::format("Pipeline {} is not the one its create function made", id));
+                }
+            }
+
+            bool rethrown = false;
+            try
+            {
+                cache.Wait(KeyOf(FailingKey));
+            }
+            catch (const std::runtime_error&)
+            {
+                rethrown = true;
+            }
+            bool unknown = false;
+            try
+            {
+                cache.Wait(KeyOf(RequestedKeys));
+            }
+            catch (const std::out_of_range&)
+            {
+                unknown = true;
+            }
+            if (!rethrown || !unknown || cache.Get(KeyOf(FailingKey), &fallback) != &fallback)
+            {
+                throw std::runtime_error("Failed or unknown pipeline was not reported");
+            }
+
+            cache.WaitForIdle();
+            const PipelineCache::Statistics done = cache.Stats();
+            if (done.Pending != 0 || done.Failed != 1 || ReleasedPipelines != 0)
+            {
+                throw std::runtime_error("Pipeline counters are wrong after compiling");
+            }
+        }
+        for (uint32_t id = 0; id < RequestedKeys; ++id)
+        {
+            if (creates[id] != 1)
+            {
+                throw std::runtime_error(fmt::format("Pipeline {} was created {} times", id, creates[id].load()));
+            }
+        }
+        if (ReleasedPipelines != RequestedKeys - 1)
+        {
+            throw std::runtime_error(fmt::format("{} of {} pipelines were released", ReleasedPipelines.load(),
+                                                 RequestedKeys - 1));
+        }
+
+        // Destroying the cache mid-compile drops queued work but releases whatever was made.
+        ReleasedPipelines = 0;
+        std::atomic<uint32_t> created = 0;
+        {
+            PipelineCache cache(ReleaseTracked, 1);
+            for (uint32_t id = 0; id < CachedKeys; ++id)
+            {
+                cache.Request(KeyOf(id), [&, id]() -> void* {
+                    created.fetch_add(1);
+                    return new TrackedPipeline{id};
+                });
+            }
+        }
+        if (ReleasedPipelines != created)
+        {
+            throw std::runtime_error("Pipelines made while the cache shut down leaked");
+        }
+
+        // Without workers, Request() creates the pipeline before it returns.
+        {
+            PipelineCache cache(ReleaseTracked, 0);
+            cache.Request(KeyOf(0), [] { return static_cast<void*>(new TrackedPipeline{0}); });
+            if (cache.Get(KeyOf(0)) == nullptr || cache.Stats().Pending != 0)
+            {
+                throw std::runtime_error("Pipeline cache without workers did not create inline");
+            }
+        }
+    }
+
+    void RewriteByte(const std::filesystem::path& path, const std::streamoff offset)
+    {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        char         value = 0;
+        stream.seekg(offset);
+        stream.get(value);
+        stream.seekp(offset);
+        stream.put(static_cast<char>(value ^ 0x20));
+    }
+
+    /// @brief Checks that a library blob survives the round trip and that damaged files read as empty.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateLibraryFile()
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "bench_pipeline_library.bin";
+        const std::vector<std::byte> blob = PipelineSource(ShaderSize).VertexShader;
+
+        PipelineLibraryFile::Write(path, {});
+        const auto headerSize = static_cast<std::streamoff>(std::filesystem::file_size(path));
+
+        auto expect = [&](const bool valid, const char* what) {
+            if (PipelineLibraryFile::Read(path) != (valid ? blob : std::vector<std::byte>()))
+            {
+                std::filesystem::remove(path);
+                throw std::runtime_error(fmt::format("Pipeline library {} was misread", what));
+            }
+        };
+
+        PipelineLibraryFile::Write(path, blob);
+        expect(true, "round trip");
+
+        RewriteByte(path, headerSize + 100);
+        expect(false, "with a corrupted byte");
+
+        PipelineLibraryFile::Write(path, blob);
+        RewriteByte(path, 4);
+        expect(false, "of another version");
+
+        PipelineLibraryFile::Write(path, blob);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        expect(false, "that was truncated");
+
+        std::filesystem::remove(path);
+        expect(false, "that is missing");
+    }
+} // namespace
+
+/// Items are pipeline descriptions keyed, or pipelines looked up.
+void AddPipelineBenchmarks(BenchmarkRunner& runner)
+{
+    runner.AddCheck("Pipelines/Keys", ValidateKeys);
+    runner.AddCheck("Pipelines/Library file", ValidateLibraryFile);
+    runner.AddCheck("Pipelines/Cache", ValidateCache);
+
+    runner.Add(fmt::format("Pipelines/Key with {} KB shaders", 2 * ShaderSize / 1024), 1, [] {
+        auto source = std::make_shared<PipelineSource>(ShaderSize);
+
+        return [source, desc = source->Describe()] { DoNotOptimize(desc.Key()); };
+    });
+
+    runner.Add(fmt::format("Pipelines/Cached lookups {} keys", CachedKeys), CachedKeys, [] {
+        auto cache = std::make_shared<PipelineCache>(ReleaseTracked, 0);
+        auto keys = std::make_shared<std::vector<PipelineKey>>();
+        for (uint32_t id = 0; id < CachedKeys; ++id)
+        {
+            keys->push_back(KeyOf(id));
+            cache->Request(keys->back(), [id] { return static_cast<void*>(new TrackedPipeline{id}); });
+        }
+
+        return [cache, keys] {
+            for (const PipelineKey& key : *keys)
+            {
+                DoNotOptimize(cache->Get(key));
+            }
+        };
+    });
+}
@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <SDL3/SDL.h>
+
+#include "File.hpp"
+#include "GameTimer.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+#include "ThreadPool.hpp"
+
+namespace
+{
+    /// A file next to the executable, which is where File looks, that is removed again once the benchmark ends.
+    class ScratchFile final
+    {
+    public:
+        ScratchFile(const char* fileName, const size_t size) : m_fileName(fileName)
+        {
+            m_path = std::filesystem::path(SDL_GetBasePath()) / fileName;
+
+            std::ofstream stream(m_path, std::ios::binary | std::ios::trunc);
+            if (!stream)
+            {
+                throw std::runtime_error(fmt::format("Failed to open {} for write", m_path.string()));
+            }
+
+            std::vector<char> bytes(size);
+            std::iota(bytes.begin(), bytes.end(), static_cast<char>(0));
+            stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        ScratchFile(const ScratchFile& other) = delete;
+        ScratchFile& operator=(const ScratchFile& other) = delete;
+
+        ~ScratchFile()
+        {
+            std::error_code error;
+            std::filesystem::remove(m_path, error);
+        }
+
+        [[nodiscard]] const char* FileName() const
+        {
+            return m_fileName;
+        }
+
+    private:
+        const char*           m_fileName;
+        std::filesystem::path m_path;
+    };
+
+    void AddFileBenchmark(BenchmarkRunner& runner, const char* name, const char* fileName, const size_t size)
+    {
+        runner.Add(name, 1, [fileName, size] {
+            auto scratch = std::make_shared<ScratchFile>(fileName, size);
+            auto file = std::make_shared<File>(scratch->FileName());
+            return [scratch, file] { DoNotOptimize(file->ReadAll()); };
+        });
+    }
+
+    /// @brief Checks that nested calls run every item once and that a throwing chunk reaches the caller.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateThreadPool()
+    {
+        constexpr size_t OuterCount = 64;
+        constexpr size_t InnerCount = 100;
+
+        ThreadPool                         pool(3);
+        std::vector<std::atomic<uint32_t>> hits(OuterCount * InnerCount);
+        pool.ParallelFor(OuterCount, 1, [&](const size_t begin, const size_t end, uint32_t) {
+            for (size_t outer = begin; outer < end; ++outer)
+            {
+                pool.ParallelFor(InnerCount, 8, [&](const size_t innerBegin, const size_t innerEnd, uint32_t) {
+                    for (size_t inner = innerBegin; inner < innerEnd; ++inner)
+                    {
+                        hits[outer * InnerCount + inner].fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+        });
+        if (std::any_of(hits.begin(), hits.end(), [](const std::atomic<uint32_t>& hit) { return hit != 1; }))
+        {
+            throw std::runtime_error("Nested ParallelFor did not run every item once");
+        }
+
+        for (const size_t failing : {size_t{0}, OuterCount - 1})
+        {
+            bool caught = false;
+            try
+            {
+                pool.ParallelFor(OuterCount, 1, [&](const size_t begin, size_t, uint32_t) {
+                    if (begin == failing)
+                    {
+                        throw std::invalid_argument("chunk failed");
+                    }
+                });
+            }
+            catch (const std::invalid_argument&)
+            {
+                caught = true;
+            }
+            if (!caught)
+            {
+                throw std::runtime_error(fmt::format("Exception of chunk {} did not reach the caller", failing));
+            }
+        }
+
+        std::atomic<size_t> items = 0;
+        pool.ParallelFor(OuterCount, 1, [&](const size_t begin, const size_t end, uint32_t) { items += end - begin; });
+        if (items != OuterCount)
+        {
+            throw std::runtime_error("ThreadPool did not recover from an exception");
+        }
+    }
+} // namespace
+
+void AddPlatformBenchmarks(BenchmarkRunner& runner)
+{
+    runner.Add("GameTimer/Tick variable step", 1, [] {
+        return [timer = std::make_shared<GameTimer>(), frames = uint64_t{0}]() mutable {
+            timer->Tick([&] { ++frames; });
+            DoNotOptimize(frames);
+        };
+    });
+
+    runner.Add("GameTimer/Tick fixed step", 1, [] {
+        auto timer = std::make_shared<GameTimer>();
+        timer->SetFixedTimeStep(true);
+        timer->SetTargetElapsedSeconds(1.0 / 60.0);
+        return [timer, frames = uint64_t{0}]() mutable {
+            timer->Tick([&] { ++frames; });
+            DoNotOptimize(frames);
+        };
+    });
+
+    AddFileBenchmark(runner, "File/ReadAll 4 KiB", "bench_base_4k.bin", 4 * 1024);
+    AddFileBenchmark(runner, "File/ReadAll 1 MiB", "bench_base_1m.bin", 1024 * 1024);
+
+    // One frame of typical input: a few key and mouse events, the queries a camera controller makes, then Update.
+    runner.Add("Keyboard/frame", 1, [] {
+        return [keyboard = std::make_shared<Keyboard>(), frame = uint32_t{0}]() mutable {
+            constexpr SDL_Scancode keys[] = {SDL_SCANCODE_W, SDL_SCANCODE_A, SDL_SCANCODE_S, SDL_SCANCODE_D};
+
+            SDL_KeyboardEvent event{};
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                event.scancode = keys[(frame + i) % 4];
+                event.down = (frame + i) % 2 == 0;
+                keyboard->RegisterKeyEvent(&event);
+            }
+
+            bool any = false;
+            for (const SDL_Scancode key : keys)
+            {
+                any |= keyboard->IsKeyPressed(key) || keyboard->IsKeyClicked(key);
+            }
+            keyboard->Update();
+            ++frame;
+            DoNotOptimize(any);
+        };
+    });
+
+    runner.Add("Mouse/frame", 1, [] {
+        return [mouse = std::make_shared<Mouse>(nullptr), frame = uint32_t{0}]() mutable {
+            SDL_MouseMotionEvent motion{};
+            motion.x = static_cast<float>(frame % 1920);
+            motion.y = static_cast<float>(frame % 1080);
+            motion.xrel = 1.0f;
+            motion.yrel = -1.0f;
+            mouse->RegisterMouseMotion(&motion);
+
+            SDL_MouseButtonEvent button{};
+            button.button = SDL_BUTTON_LEFT;
+            button.down = frame % 2 == 0;
+            button.clicks = 1;
+            mouse->RegisterMouseButton(&button);
+
+            SDL_MouseWheelEvent wheel{};
+            wheel.y = 1.0f;
+            mouse->RegisterMouseWheel(&wheel);
+
+            const int32_t state = mouse->RelativeX() + mouse->RelativeY() + (mouse->LeftClick() ? 1 : 0) +
+                                  (mouse->LeftPressed() ? 1 : 0) + static_cast<int32_t>(mouse->WheelY());
+            mouse->Update();
+            ++frame;
+            DoNotOptimize(state);
+        };
+    });
+
+    runner.AddCheck("ThreadPool/ParallelFor", ValidateThreadPool);
+    runner.Add("ThreadPool/ParallelFor dispatch", 1, [] {
+        return [pool = std::make_shared<ThreadPool>()] {
+            std::atomic<uint32_t> chunks = 0;
+            pool->ParallelFor(pool->ThreadCount() * 4, 1, [&](size_t, size_t, uint32_t) {
+                chunks.fetch_add(1, std::memory_order_relaxed);
+            });
+            DoNotOptimize(chunks);
+        };
+    });
+
+    constexpr size_t SumCount = 1 << 20;
+    runner.Add("ThreadPool/ParallelFor sum 1M floats", SumCount, [] {
+        auto pool = std::make_shared<ThreadPool>();
+        return [pool, values = std::vector<float>(SumCount, 1.0f),
+                partial = std::vector<double>(pool->ThreadCount())]() mutable {
+            std::fill(partial.begin(), partial.end(), 0.0);
+            pool->ParallelFor(values.size(), 16 * 1024,
+                              [&](const size_t begin, const size_t end, const uint32_t threadIndex) {
+                                  partial[threadIndex] +=
+                                      std::accumulate(values.begin() + begin, values.begin() + end, 0.0);
+                              });
+            DoNotOptimize(partial.front());
+        };
+    });
+}
@@ -0,0 +1,882 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Camera.hpp"
+#include "DrawQueue.hpp"
+#include "GraphicsMath.hpp"
+#include "LightClusters.hpp"
+#include "LodSelector.hpp"
+#include "OcclusionCuller.hpp"
+#include "ShadowCascades.hpp"
+#include "ThreadPool.hpp"
+#include "TransformHierarchy.hpp"
+
+namespace
+{
+    float Random(std::mt19937& random, const float low, const float high)
+    {
+        return std::uniform_real_distribution<float>(low, high)(random);
+    }
+
+    /// A point in the 400 x 40 x 400 unit region in front of the camera from MakeCamera.
+    Vector3 RandomScenePoint(std::mt19937& random)
+    {
+        return {Random(random, -200.0f, 200.0f), Random(random, 0.0f, 40.0f), Random(random, -400.0f, 0.0f)};
+    }
+
+    std::vector<BoundingBox> RandomSceneBounds(std::mt19937& random, const size_t count)
+    {
+        std::vector<BoundingBox> bounds(count);
+        for (BoundingBox& box : bounds)
+        {
+            box.Center = RandomScenePoint(random);
+            box.Extents = Vector3(Random(random, 0.5f, 4.0f), Random(random, 0.5f, 4.0f), Random(random, 0.5f, 4.0f));
+        }
+        return bounds;
+    }
+
+    Camera MakeCamera()
+    {
+        return {Vector3(0.0f, 10.0f, 20.0f),
+                Vector3::Forward,
+                Vector3::Up,
+                XMConvertToRadians(75.0f),
+                16.0f / 9.0f,
+                0.1f,
+                500.0f,
+                1920.0f,
+                1080.0f};
+    }
+
+    /// Counts calls so submission is not optimized away.
+    class CountingSubmitter final : public DrawSubmitter
+    {
+    public:
+        void BindPipeline(const uint32_t pipelineId) override
+        {
+            m_checksum += pipelineId;
+        }
+
+        void BindMaterial(const uint32_t materialId) override
+        {
+            m_checksum += materialId;
+        }
+
+        void BindGeometry(const uint32_t geometryId) override
+        {
+            m_checksum += geometryId;
+        }
+
+        void Draw(const DrawPacket& packet) override
+        {
+            m_checksum += packet.IndexCount;
+        }
+
+        [[nodiscard]] uint64_t Checksum() const
+        {
+            return m_checksum;
+        }
+
+    private:
+        uint64_t m_checksum = 0;
+    };
+
+    constexpr uint32_t HierarchyNodeCount = 16 * 1024;
+
+    /// Bushy tree where parents sit close to their children.
+    std::vector<TransformHierarchy::NodeId> BuildHierarchy(TransformHierarchy& hierarchy, std::mt19937& random)
+    {
+        std::vector<TransformHierarchy::NodeId> nodes;
+        nodes.reserve(HierarchyNodeCount);
+        for (uint32_t i = 0; i < HierarchyNodeCount; ++i)
+        {
+            const TransformHierarchy::NodeId parent =
+                i == 0 ? TransformHierarchy::InvalidNode
+                       : nodes[std::uniform_int_distribution<uint32_t>(i > 64 ? i - 64 : 0, i - 1)(random)];
+            nodes.push_back(hierarchy.AddNode(parent, Vector3(Random(random, -1.0f, 1.0f), 1.0f, 0.0f)));
+        }
+        return nodes;
+    }
+
+    /// Local transforms kept beside the hierarchy, to rebuild world matrices the slow way.
+    struct ReferenceNode
+    {
+        TransformHierarchy::NodeId Parent;
+        Vector3                    Position;
+        Quaternion                 Rotation;
+        Vector3                    Scale;
+    };
+
+    /// World matrices as local * parent world, in NodeId order, which puts parents first.
+    std::vector<Matrix> ReferenceWorlds(const std::vector<ReferenceNode>& nodes)
+    {
+        std::vector<Matrix> worlds(nodes.size());
+        for (size_t node = 0; node < nodes.size(); ++node)
+        {
+            const ReferenceNode& reference = nodes[node];
+            const Matrix         local = Matrix::CreateScale(reference.Scale) *
+                                 Matrix::CreateFromQuaternion(reference.Rotation) *
+                                 Matrix::CreateTranslation(reference.Position);
+            worlds[node] =
+                reference.Parent == TransformHierarchy::InvalidNode ? local : local * worlds[reference.Parent];
+        }
+        return worlds;
+    }
+
+    /// @brief Checks every world matrix against local * parent world evaluated node by node,
+    /// after the first update and after updates that only touch some subtrees.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateTransformHierarchy()
+    {
+        std::mt19937                                  random(21);
+        TransformHierarchy                            hierarchy;
+        ThreadPool                                    pool(3);
+        const std::vector<TransformHierarchy::NodeId> nodes = BuildHierarchy(hierarchy, random);
+
+        std::vector<ReferenceNode> reference(hierarchy.NodeCount());
+        for (const TransformHierarchy::NodeId node : nodes)
+        {
+            reference[node].Parent = hierarchy.Parent(node);
+        }
+
+        for (uint32_t pass = 0; pass < 3; ++pass)
+        {
+            // The first pass sets every node, later ones a few hundred, so dirty subtrees are exercised.
+            const uint32_t changes = pass == 0 ? HierarchyNodeCount : 300;
+            for (uint32_t i = 0; i < changes; ++i)
+            {
+                const TransformHierarchy::NodeId node = pass == 0 ? nodes[i] : nodes[random() % nodes.size()];
+                ReferenceNode&                   local = reference[node];
+                local.Position = Vector3(Random(random, -1.0f, 1.0f), Random(random, 0.5f, 1.5f), 0.0f);
+                local.Rotation = Quaternion::CreateFromYawPitchRoll(Random(random, -0.3f, 0.3f),
+                                                                   Random(random, -0.3f, 0.3f), 0.0f);
+                local.Scale = Vector3(Random(random, 0.98f, 1.02f));
+                hierarchy.SetLocal(node, local.Position, local.Rotation, local.Scale);
+            }
+            hierarchy.Update(pool);
+
+            const std::vector<Matrix> expectedWorlds = ReferenceWorlds(reference);
+            for (const TransformHierarchy::NodeId node : nodes)
+            {
+                const Matrix& expected = expectedWorlds[node];
+                const Matrix& world = hierarchy.WorldMatrix(node);
+                for (int row = 0; row < 4; ++row)
+                {
+                    for (int column = 0; column < 4; ++column)
+                    {
+                        if (std::abs(world.m[row][column] - expected.m[row][column]) >
+                            1e-3f * (1.0f + std::abs(expected.m[row][column])))
+                        {
+                            throw std::runtime_error(
+                                fmt::format("World matrix of node {} differs after update {}", node, pass));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void AddTransformHierarchyBenchmarks(BenchmarkRunner& runner)
+    {
+        runner.AddCheck("TransformHierarchy/World matrices", ValidateTransformHierarchy);
+        for (const uint32_t dirtyPercent : {1u, 10u, 100u})
+        {
+            const std::string name = fmt::format("TransformHierarchy/Update 16k nodes, {}% dirty", dirtyPercent);
+            runner.Add(name, 1, [dirtyPercent] {
+                std::mt19937                            random(21);
+                auto                                    hierarchy = std::make_shared<TransformHierarchy>();
+                std::vector<TransformHierarchy::NodeId> nodes = BuildHierarchy(*hierarchy, random);
+
+                std::shuffle(nodes.begin(), nodes.end(), random);
+                nodes.resize(std::max<size_t>(HierarchyNodeCount * dirtyPercent / 100, 1));
+
+                auto pool = std::make_shared<ThreadPool>();
+                hierarchy->Update(*pool);
+
+                return [hierarchy, pool, nodes = std::move(nodes), frame = 0.0f]() mutable {
+                    frame += 0.01f;
+                    for (const TransformHierarchy::NodeId node : nodes)
+                    {
+                        hierarchy->SetRotation(node, Quaternion::CreateFromYawPitchRoll(frame, 0.0f, 0.0f));
+                    }
+                    hierarchy->Update(*pool);
+                    DoNotOptimize(hierarchy->UpdatedNodeCount());
+                };
+            });
+        }
+    }
+
+    /// Checks that packets arrive in key order, each once, and that every bind changes the bound id.
+    class OrderCheckingSubmitter final : public DrawSubmitter
+    {
+    public:
+        explicit OrderCheckingSubmitter(const size_t packetCount) : m_drawn(packetCount)
+        {
+        }
+
+        void BindPipeline(const uint32_t pipelineId) override
+        {
+            Bind(m_pipeline, pipelineId, "pipeline");
+        }
+
+        void BindMaterial(const uint32_t materialId) override
+        {
+            Bind(m_material, materialId, "material");
+        }
+
+        void BindGeometry(const uint32_t geometryId) override
+        {
+            Bind(m_geometry, geometryId, "geometry");
+        }
+
+        void Draw(const DrawPacket& packet) override
+        {
+            if (packet.Key < m_lastKey)
+            {
+                throw std::runtime_error(fmt::format("Packet {} was submitted out of key order", packet.ObjectIndex));
+            }
+            if (packet.PipelineId != m_pipeline || packet.MaterialId != m_material || packet.GeometryId != m_geometry)
+            {
+                throw std::runtime_error(fmt::format("Packet {} was drawn with stale state", packet.ObjectIndex));
+            }
+            if (m_drawn[packet.ObjectIndex])
+            {
+                throw std::runtime_error(fmt::format("Packet {} was drawn twice", packet.ObjectIndex));
+            }
+            m_drawn[packet.ObjectIndex] = true;
+            m_lastKey = packet.Key;
+            ++m_draws;
+        }
+
+        [[nodiscard]] uint32_t Binds() const
+        {
+            return m_binds;
+        }
+
+        [[nodiscard]] uint32_t Draws() const
+        {
+            return m_draws;
+        }
+
+    private:
+        void Bind(uint32_t& bound, const uint32_t id, const char* state)
+        {
+            if (bound == id)
+            {
+                throw std::runtime_error(fmt::format("Redundant {} bind of {}", state, id));
+            }
+            bound = id;
+            ++m_binds;
+        }
+
+        std::vector<bool> m_drawn;
+        uint64_t          m_lastKey = 0;
+        uint32_t          m_pipeline = UINT32_MAX;
+        uint32_t          m_material = UINT32_MAX;
+        uint32_t          m_geometry = UINT32_MAX;
+        uint32_t          m_binds = 0;
+        uint32_t          m_draws = 0;
+    };
+
+    /// @brief Submits a sorted queue and checks key order, redundant binds and the reported statistics.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateDrawQueue(DrawQueue& queue)
+    {
+        OrderCheckingSubmitter checker(queue.Size());
+        queue.Submit(checker);
+
+        const DrawQueue::Statistics& stats = queue.Stats();
+        if (checker.Draws() != queue.Size() || stats.Packets != queue.Size() || stats.StateChanges != checker.Binds())
+        {
+            throw std::runtime_error("Draw queue statistics do not match the submission");
+        }
+        if (stats.StateChangesAvoided == 0)
+        {
+            throw std::runtime_error("Sorting did not avoid any state changes");
+        }
+    }
+
+    void AddDrawQueueBenchmarks(BenchmarkRunner& runner)
+    {
+        constexpr uint32_t PacketCount = 100 * 1000;
+
+        const auto fill = [] {
+            std::mt19937 random(22);
+            auto         queue = std::make_shared<DrawQueue>();
+            queue->Reserve(PacketCount);
+            for (uint32_t i = 0; i < PacketCount; ++i)
+            {
+                DrawPacket packet;
+                packet.PipelineId = random() % 32;
+                packet.MaterialId = random() % 512;
+                packet.GeometryId = random() % 2048;
+                packet.IndexCount = 36;
+                packet.ObjectIndex = i;
+                packet.Key = DrawKey::Make(0, random() % 2, packet.PipelineId, packet.MaterialId,
+                                           Random(random, 0.0f, 1.0f));
+                queue->Push(packet);
+            }
+            return queue;
+        };
+
+        runner.Add("DrawQueue/Sort 100k packets", PacketCount, [fill] {
+            return [queue = fill(), pool = std::make_shared<ThreadPool>()] {
+                queue->Sort(*pool);
+                DoNotOptimize(queue->SortedIndices().front());
+            };
+        });
+
+        runner.AddCheck("DrawQueue/Submission order", [fill] {
+            auto       queue = fill();
+            ThreadPool pool(3);
+            queue->Sort(pool);
+            ValidateDrawQueue(*queue);
+        });
+
+        runner.Add("DrawQueue/Submit 100k packets", PacketCount, [fill] {
+            auto       queue = fill();
+            ThreadPool pool(3);
+            queue->Sort(pool);
+
+            CountingSubmitter counter;
+            queue->Submit(counter);
+            const DrawQueue::Statistics& stats = queue->Stats();
+            fmt::print("  {} binds issued, {} avoided by sorting\n", stats.StateChanges, stats.StateChangesAvoided);
+
+            return [queue] {
+                CountingSubmitter submitter;
+                queue->Submit(submitter);
+                DoNotOptimize(submitter.Checksum());
+            };
+        });
+    }
+
+    /// @brief Moves one object through the hysteresis band around the threshold and checks that it
+    /// only switches level once its error leaves the band.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateLodHysteresis()
+    {
+        constexpr float    errors[] = {0.001f, 0.1f};
+        constexpr uint32_t triangles[] = {1000, 100};
+
+        const Camera camera = MakeCamera();
+        const float  pixelsPerUnit = camera.viewHeight() / (2.0f * std::tan(0.5f * camera.fieldOfView()));
+
+        // Default settings switch to the coarse level below 0.8 pixels and back to the fine one above 1.2.
+        LodSelector selector;
+        selector.AddObject(camera.position(), 0.0f, errors, triangles);
+
+        struct Step
+        {
+            float    CoarseErrorPixels;
+            uint32_t ExpectedLod;
+        };
+        constexpr Step steps[] = {{0.5f, 1}, {1.1f, 1}, {1.5f, 0}, {0.9f, 0}, {0.7f, 1}, {0.5f, 1}};
+        for (const Step& step : steps)
+        {
+            const float distance = errors[1] * pixelsPerUnit / step.CoarseErrorPixels;
+            selector.SetBounds(0, camera.position() + Vector3::Forward * distance, 0.0f);
+            selector.Select(camera);
+            if (selector.Lod(0) != step.ExpectedLod)
+            {
+                throw std::runtime_error(fmt::format("Object with a {} pixel error is at LOD {}, expected {}",
+                                                     step.CoarseErrorPixels, selector.Lod(0), step.ExpectedLod));
+            }
+        }
+    }
+
+    /// @brief Selects a few frames and checks that the reported triangles match the chosen levels
+    /// and, with a budget, fit within it.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateLodBudget(LodSelector&                    selector,
+                           const Camera&                   camera,
+                           const uint64_t                  budget,
+                           const std::span<const uint32_t> triangles)
+    {
+        constexpr uint32_t Frames = 8;
+        for (uint32_t frame = 0; frame < Frames; ++frame)
+        {
+            selector.Select(camera);
+
+            uint64_t selected = 0;
+            for (uint32_t object = 0; object < selector.ObjectCount(); ++object)
+            {
+                selected += triangles[selector.Lod(object)];
+            }
+            if (selected != selector.Stats().Triangles)
+            {
+                throw std::runtime_error(fmt::format("Frame {} reported {} triangles, the levels add up to {}", frame,
+                                                     selector.Stats().Triangles, selected));
+            }
+            if (budget != 0 && selected > budget)
+            {
+                throw std::runtime_error(fmt::format("Frame {} selected {} triangles over a budget of {}", frame,
+                                                     selected, budget));
+            }
+        }
+        if (budget != 0 && (selector.Stats().Frames != Frames || selector.Stats().BudgetHitRate() != 1.0f))
+        {
+            throw std::runtime_error("Budget statistics do not match the selected frames");
+        }
+    }
+
+    void AddLodSelectorBenchmarks(BenchmarkRunner& runner)
+    {
+        static constexpr uint32_t ObjectCount = 10 * 1000;
+        static constexpr float    Errors[] = {0.01f, 0.05f, 0.2f, 1.0f};
+        static constexpr uint32_t Triangles[] = {20000, 5000, 1200, 300};
+
+        const auto makeSelector = [](const uint64_t budget) {
+            std::mt19937 random(23);
+            auto         selector = std::make_shared<LodSelector>(LodSelector::Settings{.TriangleBudget = budget});
+            for (uint32_t i = 0; i < ObjectCount; ++i)
+            {
+                selector->AddObject(RandomScenePoint(random), Random(random, 0.5f, 4.0f), Errors, Triangles);
+            }
+            return selector;
+        };
+
+        runner.AddCheck("LodSelector/Hysteresis", ValidateLodHysteresis);
+
+        // The coarsest levels alone add up to 3M triangles, so the budget has to be above that to be met.
+        for (const uint64_t budget : {uint64_t{0}, uint64_t{4'000'000}})
+        {
+            const std::string suffix = budget == 0 ? "no budget" : "4M triangle budget";
+            runner.AddCheck(fmt::format("LodSelector/Triangles, {}", suffix), [makeSelector, budget] {
+                ValidateLodBudget(*makeSelector(budget), MakeCamera(), budget, Triangles);
+            });
+
+            runner.Add(fmt::format("LodSelector/Select 10k objects, {}", suffix), ObjectCount, [makeSelector, budget] {
+                auto         selector = makeSelector(budget);
+                const Camera camera = MakeCamera();
+                selector->Select(camera);
+                const LodSelector::Statistics& stats = selector->Stats();
+                fmt::print("  {} triangles, error scale {:.1f}, budget hit rate {:.0f}%\n", stats.Triangles,
+                           stats.ErrorScale, 100.0f * stats.BudgetHitRate());
+
+                return [selector, camera] {
+                    selector->Select(camera);
+                    DoNotOptimize(selector->Lod(0));
+                };
+            });
+        }
+    }
+
+    /// Unit cube the occluders are made of, scaled and placed by their world matrix.
+    constexpr Vector3 OccluderCorners[] = {
+        {-1.0f, -1.0f, -1.0f}, {1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, -1.0f}, {-1.0f, 1.0f, -1.0f},
+        {-1.0f, -1.0f, 1.0f},  {1.0f, -1.0f, 1.0f},  {1.0f, 1.0f, 1.0f},  {-1.0f, 1.0f, 1.0f},
+    };
+    constexpr uint16_t OccluderIndices[] = {0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+                                            3, 6, 2, 3, 7, 6, 0, 4, 7, 0, 7, 3, 1, 2, 6, 1, 6, 5};
+
+    void RasterizeOccluders(OcclusionCuller& culler, const Camera& camera, const std::vector<Matrix>& occluders,
+                            ThreadPool& pool)
+    {
+        culler.BeginFrame(camera);
+        for (const Matrix& world : occluders)
+        {
+            culler.AddOccluder(OccluderCorners, OccluderIndices, world);
+        }
+        culler.Rasterize(pool);
+    }
+
+    /// @brief Puts a 40 x 20 wall 40 units in front of the camera and checks that a box behind
+    /// it is culled, while boxes in front of it and beside it are kept.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateOcclusion()
+    {
+        OcclusionCuller culler;
+        ThreadPool      pool(2);
+        RasterizeOccluders(culler, MakeCamera(), {Matrix::CreateScale(20.0f, 10.0f, 1.0f) *
+                                                  Matrix::CreateTranslation(0.0f, 10.0f, -20.0f)},
+                           pool);
+
+        const BoundingBox bounds[] = {
+            {Vector3(0.0f, 10.0f, -60.0f), Vector3(2.0f, 2.0f, 2.0f)},  // Behind the wall.
+            {Vector3(0.0f, 10.0f, -5.0f), Vector3(2.0f, 2.0f, 2.0f)},   // In front of it.
+            {Vector3(80.0f, 10.0f, -60.0f), Vector3(2.0f, 2.0f, 2.0f)}, // Beside it.
+        };
+        uint8_t visible[std::size(bounds)] = {};
+        culler.TestVisibility(bounds, visible, pool);
+        for (size_t i = 0; i < std::size(bounds); ++i)
+        {
+            if ((visible[i] != 0) != (i != 0) || culler.IsVisible(bounds[i]) != (i != 0))
+            {
+                throw std::runtime_error(fmt::format("Occlusion test of box {} is wrong", i));
+            }
+        }
+    }
+
+    void AddOcclusionCullerBenchmarks(BenchmarkRunner& runner)
+    {
+        constexpr uint32_t OccluderCount = 64;
+        constexpr uint32_t ObjectCount = 10 * 1000;
+
+        const auto makeOccluders = [] {
+            std::mt19937        random(24);
+            std::vector<Matrix> occluders(OccluderCount);
+            for (Matrix& world : occluders)
+            {
+                world = Matrix::CreateScale(Random(random, 4.0f, 12.0f), Random(random, 2.0f, 8.0f), 1.0f) *
+                        Matrix::CreateTranslation(RandomScenePoint(random) * Vector3(0.5f, 0.5f, 0.25f));
+            }
+            return occluders;
+        };
+
+        runner.AddCheck("OcclusionCuller/Wall", ValidateOcclusion);
+
+        // Items are occluders transformed, binned and rasterized.
+        runner.Add("OcclusionCuller/Rasterize 64 occluders", OccluderCount, [makeOccluders] {
+            return [culler = std::make_shared<OcclusionCuller>(), pool = std::make_shared<ThreadPool>(),
+                    camera = MakeCamera(), occluders = makeOccluders()] {
+                RasterizeOccluders(*culler, camera, occluders, *pool);
+                DoNotOptimize(culler->Stats().BinnedTriangles);
+            };
+        });
+
+        // Items are bounds tested against the depth buffer of the same occluders.
+        runner.Add("OcclusionCuller/Test 10k bounds", ObjectCount, [makeOccluders] {
+            auto culler = std::make_shared<OcclusionCuller>();
+            auto pool = std::make_shared<ThreadPool>();
+            RasterizeOccluders(*culler, MakeCamera(), makeOccluders(), *pool);
+
+            std::mt19937 random(25);
+            return [culler, pool, bounds = RandomSceneBounds(random, ObjectCount),
+                    visible = std::vector<uint8_t>(ObjectCount)]() mutable {
+                culler->TestVisibility(bounds, visible, *pool);
+                DoNotOptimize(visible.front());
+            };
+        });
+    }
+
+    /// The part of the view frustum one cluster covers: a depth range and a rectangle in NDC.
+    struct ClusterVolume
+    {
+        float   Near;
+        float   Far;
+        Vector2 NdcMin;
+        Vector2 NdcMax;
+        Vector2 Projection; ///< NDC per unit of view-space x and y at depth 1.
+    };
+
+    ClusterVolume MakeClusterVolume(const Camera& camera, const LightClusters& clusters, const uint32_t cluster)
+    {
+        const LightClusters::ShaderParameters parameters = clusters.Parameters();
+        const uint32_t                        tileX = cluster % parameters.TilesX;
+        const uint32_t                        tileY = cluster / parameters.TilesX % parameters.TilesY;
+        const uint32_t                        slice = cluster / (parameters.TilesX * parameters.TilesY);
+
+        const float depthRatio = camera.farPlane() / camera.nearPlane();
+        const float slices = static_cast<float>(parameters.Slices);
+        const float tilesX = static_cast<float>(parameters.TilesX);
+        const float tilesY = static_cast<float>(parameters.TilesY);
+        const float tanHalfFov = std::tan(0.5f * camera.fieldOfView());
+
+        // Tile rows run top to bottom while NDC y runs bottom to top.
+        ClusterVolume volume;
+        volume.Near = camera.nearPlane() * std::pow(depthRatio, static_cast<float>(slice) / slices);
+        volume.Far = camera.nearPlane() * std::pow(depthRatio, static_cast<float>(slice + 1) / slices);
+        volume.NdcMin = Vector2(-1.0f + 2.0f * static_cast<float>(tileX) / tilesX,
+                                1.0f - 2.0f * static_cast<float>(tileY + 1) / tilesY);
+        volume.NdcMax = Vector2(-1.0f + 2.0f * static_cast<float>(tileX + 1) / tilesX,
+                                1.0f - 2.0f * static_cast<float>(tileY) / tilesY);
+        volume.Projection = Vector2(1.0f / (camera.aspectRatio() * tanHalfFov), 1.0f / tanHalfFov);
+        return volume;
+    }
+
+    /// A view-space point inside the cluster, found by clamping the depth and then x and y at that depth.
+    Vector3 ClampToCluster(const ClusterVolume& volume, const Vector3& viewPoint)
+    {
+        const float depth = std::clamp(-viewPoint.z, volume.Near, volume.Far);
+        const float x = std::clamp(viewPoint.x, volume.NdcMin.x * depth / volume.Projection.x,
+                                   volume.NdcMax.x * depth / volume.Projection.x);
+        const float y = std::clamp(viewPoint.y, volume.NdcMin.y * depth / volume.Projection.y,
+                                   volume.NdcMax.y * depth / volume.Projection.y);
+        return {x, y, -depth};
+    }
+
+    /// Whether the bounding box of a view-space sphere overlaps the bounding box of the cluster.
+    bool OverlapsClusterBounds(const ClusterVolume& volume, const Vector3& viewCenter, const float radius)
+    {
+        const float slack = 1e-3f * volume.Far;
+        const float depth = -viewCenter.z;
+        if (depth + radius < volume.Near - slack || depth - radius > volume.Far + slack)
+        {
+            return false;
+        }
+
+        const float minX = std::min(volume.NdcMin.x * volume.Near, volume.NdcMin.x * volume.Far) / volume.Projection.x;
+        const float maxX = std::max(volume.NdcMax.x * volume.Near, volume.NdcMax.x * volume.Far) / volume.Projection.x;
+        const float minY = std::min(volume.NdcMin.y * volume.Near, volume.NdcMin.y * volume.Far) / volume.Projection.y;
+        const float maxY = std::max(volume.NdcMax.y * volume.Near, volume.NdcMax.y * volume.Far) / volume.Projection.y;
+        return viewCenter.x + radius >= minX - slack && viewCenter.x - radius <= maxX + slack &&
+               viewCenter.y + radius >= minY - slack && viewCenter.y - radius <= maxY + slack;
+    }
+
+    /// @brief Compares a sample of clusters with a brute-force test of every light.
+    ///
+    /// A light must be listed when it contains a point of the cluster, and may only be listed
+    /// when its bounds overlap the cluster's bounding box; binning is conservative in between.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateLightClusters(const LightClusters&              clusters,
+                               const Camera&                     camera,
+                               const std::span<const PointLight> pointLights,
+                               const std::span<const SpotLight>  spotLights)
+    {
+        constexpr uint32_t ClusterStride = 7;
+
+        const Matrix view = camera.view();
+        uint32_t     required = 0;
+        for (uint32_t cluster = 0; cluster < clusters.ClusterCount(); cluster += ClusterStride)
+        {
+            const LightClusters::ClusterRange range = clusters.Clusters()[cluster];
+            std::vector<uint32_t>             listed(clusters.LightIndices().begin() + range.Offset,
+                                                     clusters.LightIndices().begin() + range.Offset + range.Count);
+            std::ranges::sort(listed);
+            if (std::ranges::adjacent_find(listed) != listed.end())
+            {
+                throw std::runtime_error(fmt::format("Cluster {} lists a light twice", cluster));
+            }
+
+            const ClusterVolume volume = MakeClusterVolume(camera, clusters, cluster);
+            const float         slack = 1e-3f * volume.Far;
+            const auto          check = [&](const uint32_t light, const bool contains, const bool overlaps) {
+                const bool isListed = std::ranges::binary_search(listed, light);
+                if (contains && !isListed)
+                {
+                    throw std::runtime_error(fmt::format("Cluster {} is missing light {}", cluster, light));
+                }
+                if (isListed && !overlaps)
+                {
+                    throw std::runtime_error(
+                        fmt::format("Cluster {} lists light {}, which is outside it", cluster, light));
+                }
+                required += contains ? 1 : 0;
+            };
+
+            for (uint32_t i = 0; i < pointLights.size(); ++i)
+            {
+                const PointLight& light = pointLights[i];
+                const Vector3     center = Vector3::Transform(light.Position, view);
+                const float       distance = Vector3::Distance(ClampToCluster(volume, center), center);
+                check(i, distance + slack < light.Radius, OverlapsClusterBounds(volume, center, light.Radius));
+            }
+
+            for (uint32_t i = 0; i < spotLights.size(); ++i)
+            {
+                const SpotLight& light = spotLights[i];
+                const Vector3    apex = Vector3::Transform(light.Position, view);
+                const Vector3    direction = Vector3::TransformNormal(light.Direction, view);
+                const Vector3    toPoint = ClampToCluster(volume, apex + direction * (0.5f * light.Range)) - apex;
+                const float      distance = toPoint.Length();
+                const bool       contains = distance + slack < light.Range &&
+                                      toPoint.Dot(direction) > distance * std::cos(light.HalfAngle) + slack;
+
+                // The cone's bounding sphere lies within sqrt(2) ranges of the apex.
+                check(static_cast<uint32_t>(pointLights.size()) + i, contains,
+                      OverlapsClusterBounds(volume, apex, 1.5f * light.Range));
+            }
+        }
+
+        if (required == 0)
+        {
+            throw std::runtime_error("No light reaches into the sampled clusters");
+        }
+    }
+
+    /// Lights scattered over the scene, a quarter of them spots.
+    struct SceneLights
+    {
+        std::vector<PointLight> Points;
+        std::vector<SpotLight>  Spots;
+    };
+
+    SceneLights MakeLights(const uint32_t lightCount)
+    {
+        std::mt19937 random(25);
+        SceneLights  lights;
+        lights.Points.resize(lightCount - lightCount / 4);
+        for (PointLight& light : lights.Points)
+        {
+            light = {RandomScenePoint(random), Random(random, 1.0f, 10.0f)};
+        }
+
+        // Half angles on both sides of 45 degrees, where the cone's bounding sphere changes shape.
+        lights.Spots.resize(lightCount / 4);
+        for (SpotLight& light : lights.Spots)
+        {
+            Vector3 direction(Random(random, -1.0f, 1.0f), Random(random, -1.0f, -0.2f), Random(random, -1.0f, 1.0f));
+            direction.Normalize();
+            light = {RandomScenePoint(random), Random(random, 2.0f, 15.0f), direction, Random(random, 0.2f, 1.2f)};
+        }
+        return lights;
+    }
+
+    void AddLightClusterBenchmarks(BenchmarkRunner& runner)
+    {
+        for (const uint32_t lightCount : {1024u, 16u * 1024u, 64u * 1024u})
+        {
+            runner.AddCheck(fmt::format("LightClusters/Binning {}k lights", lightCount / 1024), [lightCount] {
+                const SceneLights lights = MakeLights(lightCount);
+                LightClusters     clusters;
+                ThreadPool        pool;
+                const Camera      camera = MakeCamera();
+                clusters.Build(camera, lights.Points, lights.Spots, pool);
+                ValidateLightClusters(clusters, camera, lights.Points, lights.Spots);
+            });
+
+            const std::string name = fmt::format("LightClusters/Build {}k lights, a quarter spot", lightCount / 1024);
+            runner.Add(name, lightCount, [lightCount] {
+                return [clusters = std::make_shared<LightClusters>(), pool = std::make_shared<ThreadPool>(),
+                        camera = MakeCamera(), lights = MakeLights(lightCount)] {
+                    clusters->Build(camera, lights.Points, lights.Spots, *pool);
+                    DoNotOptimize(clusters->LightIndices().size());
+                };
+            });
+        }
+    }
+
+    /// @brief Throws unless a world-space point lands inside the cascade's viewport and depth range.
+    void ExpectInCascade(const ShadowCascade& cascade, const uint32_t mapSize, const Vector3& point, const char* what)
+    {
+        constexpr float Tolerance = 1e-4f;
+
+        const Vector3 texture = Vector3::Transform(point, cascade.ShadowTransform);
+        const float   width = static_cast<float>(cascade.ViewportWidth) / static_cast<float>(mapSize);
+        const float   height = static_cast<float>(cascade.ViewportHeight) / static_cast<float>(mapSize);
+        if (texture.x < -Tolerance || texture.x > width + Tolerance || texture.y < -Tolerance ||
+            texture.y > height + Tolerance || texture.z < -Tolerance || texture.z > 1.0f + Tolerance)
+        {
+            throw std::runtime_error(fmt::format("{} at ({}, {}, {}) maps to ({}, {}, {}), outside the cascade", what,
+                                                 point.x, point.y, point.z, texture.x, texture.y, texture.z));
+        }
+    }
+
+    /// @brief Checks that the splits tile the shadowed depth range, that a receiver filling the
+    /// scene gets every point of the view frustum into its cascade, and that the centre of every
+    /// visible receiver lands in its cascade.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateShadowCascades(ShadowCascades&                    cascades,
+                                const Camera&                      camera,
+                                const Vector3&                     lightDirection,
+                                const std::span<const BoundingBox> receivers,
+                                const std::span<const BoundingBox> casters,
+                                ThreadPool&                        pool)
+    {
+        constexpr uint32_t MapSize = ShadowCascades::Settings{}.ShadowMapSize;
+
+        const Matrix viewToWorld = camera.view().Invert();
+        const float  tanY = std::tan(0.5f * camera.fieldOfView());
+        const float  tanX = tanY * camera.aspectRatio();
+        const auto   toWorld = [&](const float ndcX, const float ndcY, const float depth) {
+            return Vector3::Transform(Vector3(ndcX * depth * tanX, ndcY * depth * tanY, -depth), viewToWorld);
+        };
+
+        // Wide enough to hold the far corners of the frustum.
+        const BoundingBox scene(camera.position(), Vector3(2.0f * camera.farPlane()));
+        cascades.Plan(camera, lightDirection, {&scene, 1}, {&scene, 1}, pool);
+
+        float previous = camera.nearPlane();
+        for (uint32_t c = 0; c < cascades.CascadeCount(); ++c)
+        {
+            const ShadowCascade& cascade = cascades.Cascade(c);
+            if (cascade.SplitNear != previous || cascade.SplitFar <= cascade.SplitNear)
+            {
+                throw std::runtime_error(fmt::format("Cascade {} does not continue where the previous one ends", c));
+            }
+            previous = cascade.SplitFar;
+
+            for (const float t : {0.001f, 0.5f, 0.999f})
+            {
+                const float depth = cascade.SplitNear + t * (cascade.SplitFar - cascade.SplitNear);
+                for (const float ndcY : {-0.999f, -0.5f, 0.0f, 0.5f, 0.999f})
+                {
+                    for (const float ndcX : {-0.999f, -0.5f, 0.0f, 0.5f, 0.999f})
+                    {
+                        ExpectInCascade(cascade, MapSize, toWorld(ndcX, ndcY, depth), "Frustum point");
+                    }
+                }
+            }
+        }
+        if (std::abs(previous - camera.farPlane()) > 1e-3f * camera.farPlane())
+        {
+            throw std::runtime_error("Cascades end before the far plane");
+        }
+
+        cascades.Plan(camera, lightDirection, receivers, casters, pool);
+        const Matrix view = camera.view();
+        for (const BoundingBox& receiver : receivers)
+        {
+            const Vector3 center = Vector3::Transform(receiver.Center, view);
+            const float   depth = -center.z;
+            if (depth < camera.nearPlane() || depth >= previous || std::abs(center.x) > depth * tanX ||
+                std::abs(center.y) > depth * tanY)
+            {
+                continue;
+            }
+
+            uint32_t c = 0;
+            while (depth >= cascades.Cascade(c).SplitFar)
+            {
+                ++c;
+            }
+            ExpectInCascade(cascades.Cascade(c), MapSize, receiver.Center, "Receiver centre");
+        }
+    }
+
+    void AddShadowCascadeBenchmarks(BenchmarkRunner& runner)
+    {
+        constexpr uint32_t CasterCount = 100 * 1000;
+        constexpr uint32_t ReceiverCount = 10 * 1000;
+
+        runner.AddCheck("ShadowCascades/Coverage", [] {
+            std::mt19937   random(26);
+            ShadowCascades cascades;
+            ThreadPool     pool;
+            const auto     receivers = RandomSceneBounds(random, ReceiverCount);
+            const auto     casters = RandomSceneBounds(random, CasterCount);
+            ValidateShadowCascades(cascades, MakeCamera(), Vector3(0.3f, -1.0f, -0.2f), receivers, casters, pool);
+        });
+
+        runner.Add("ShadowCascades/Plan 100k casters, 10k receivers", 1, [] {
+            std::mt19937  random(26);
+            const Vector3 lightDirection(0.3f, -1.0f, -0.2f);
+            auto          cascades = std::make_shared<ShadowCascades>();
+            auto          pool = std::make_shared<ThreadPool>();
+            const Camera  camera = MakeCamera();
+            auto          receivers = RandomSceneBounds(random, ReceiverCount);
+            auto          casters = RandomSceneBounds(random, CasterCount);
+
+            return [cascades, pool, camera, lightDirection, receivers = std::move(receivers),
+                    casters = std::move(casters)] {
+                cascades->Plan(camera, lightDirection, receivers, casters, *pool);
+                DoNotOptimize(cascades->Cascade(0).Casters.size());
+            };
+        });
+    }
+} // namespace
+
+void AddSceneBenchmarks(BenchmarkRunner& runner)
+{
+    AddTransformHierarchyBenchmarks(runner);
+    AddDrawQueueBenchmarks(runner);
+    AddLodSelectorBenchmarks(runner);
+    AddOcclusionCullerBenchmarks(runner);
+    AddLightClusterBenchmarks(runner);
+    AddShadowCascadeBenchmarks(runner);
+}
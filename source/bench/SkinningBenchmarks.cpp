@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "CpuFeatures.hpp"
+#include "GraphicsMath.hpp"
+#include "Skinning.hpp"
+#include "SkinningKernelTable.hpp"
+#include "ThreadPool.hpp"
+
+namespace
+{
+    constexpr uint32_t RingCount = 500;
+    constexpr uint32_t RingVertexCount = 100;
+    constexpr uint32_t VertexCount = RingCount * RingVertexCount;
+    constexpr uint32_t JointCount = 64;
+
+    /// A tube along y bound to a chain of joints, each vertex weighted to the four nearest joints.
+    SkinnedMesh MakeTube()
+    {
+        constexpr size_t Count = VertexCount;
+
+        SkinnedMesh mesh;
+        mesh.Positions.resize(Count * 3);
+        mesh.Normals.resize(Count * 3);
+        mesh.Tangents.resize(Count * 3);
+        mesh.Joints.resize(Count * 4);
+        mesh.Weights.resize(Count * 4);
+        for (uint32_t ring = 0; ring < RingCount; ++ring)
+        {
+            // Position along the chain in joints, so joint j sits at y = j.
+            const float along = static_cast<float>(ring) * static_cast<float>(JointCount - 1) / (RingCount - 1);
+            const auto  nearest = static_cast<int32_t>(along);
+            for (uint32_t step = 0; step < RingVertexCount; ++step)
+            {
+                const size_t v = ring * RingVertexCount + step;
+                const float  angle = XM_2PI * static_cast<float>(step) / RingVertexCount;
+                const float  c = std::cos(angle);
+                const float  s = std::sin(angle);
+
+                mesh.Positions[v] = c * 0.5f;
+                mesh.Positions[Count + v] = along;
+                mesh.Positions[Count * 2 + v] = s * 0.5f;
+                mesh.Normals[v] = c;
+                mesh.Normals[Count * 2 + v] = s;
+                mesh.Tangents[v] = -s;
+                mesh.Tangents[Count * 2 + v] = c;
+
+                float total = 0.0f;
+                float weights[4];
+                for (int32_t i = 0; i < 4; ++i)
+                {
+                    const int32_t joint = std::clamp(nearest - 1 + i, 0, static_cast<int32_t>(JointCount - 1));
+                    weights[i] = std::max(0.0f, 2.0f - std::abs(along - static_cast<float>(joint)));
+                    total += weights[i];
+                    mesh.Joints[i * Count + v] = static_cast<uint16_t>(joint);
+                }
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    mesh.Weights[i * Count + v] = weights[i] / total;
+                }
+            }
+        }
+        return mesh;
+    }
+
+    /// Skinning matrices of the chain bent by small random rotations at every joint.
+    std::vector<Matrix> MakePalette()
+    {
+        std::mt19937                          random(JointCount);
+        std::uniform_real_distribution<float> angle(-0.3f, 0.3f);
+
+        std::vector<Matrix> palette(JointCount);
+        Matrix              parent = Matrix::Identity;
+        for (uint32_t joint = 0; joint < JointCount; ++joint)
+        {
+            const Matrix local =
+                Matrix::CreateFromQuaternion(Quaternion::CreateFromYawPitchRoll(angle(random), angle(random), 0.0f)) *
+                Matrix::CreateTranslation(Vector3(0.0f, joint == 0 ? 0.0f : 1.0f, 0.0f));
+            const Matrix model = local * parent;
+            palette[joint] = Matrix::CreateTranslation(Vector3(0.0f, -static_cast<float>(joint), 0.0f)) * model;
+            parent = model;
+        }
+        return palette;
+    }
+
+    const char* MethodName(const SkinningMethod method)
+    {
+        return method == SkinningMethod::Linear ? "Linear" : "DualQuaternion";
+    }
+
+    /// Positions, normals and tangents in nine consecutive planes of VertexCount floats.
+    SkinnedVertexStreams MakeOutputStreams(float* planes)
+    {
+        SkinnedVertexStreams streams;
+        streams.Positions = {planes, planes + VertexCount, planes + VertexCount * 2};
+        streams.Normals = {planes + VertexCount * 3, planes + VertexCount * 4, planes + VertexCount * 5};
+        streams.Tangents = {planes + VertexCount * 6, planes + VertexCount * 7, planes + VertexCount * 8};
+        return streams;
+    }
+
+#ifdef TRANSFORM_KERNELS_X64
+    /// Fills the output beforehand, so writes outside the skinned range show up as differences.
+    constexpr float Untouched = -12345.0f;
+
+    /// Relative to the largest expected element of a stream, since the paths round differently.
+    constexpr float Tolerance = 1e-4f;
+
+    /// @brief Compares the AVX2 kernels with the generic ones for both methods, on ranges that start and end
+    /// between multiples of 8 so the scalar tail runs too.
+    /// @throws std::runtime_error on the first mismatch.
+    void ValidateSkinningKernels(const SkinnedMesh& mesh, const std::vector<Matrix>& palette)
+    {
+        if (!CpuFeatures::Get().Supports(SimdLevel::AVX2))
+        {
+            return;
+        }
+
+        std::vector<float> dualQuaternions;
+        ComputeDualQuaternions(palette, dualQuaternions);
+
+        const SkinnedMeshStreams   streams = mesh.Streams();
+        std::vector<float>         expected(VertexCount * 9);
+        std::vector<float>         actual(VertexCount * 9);
+        const SkinnedVertexStreams expectedStreams = MakeOutputStreams(expected.data());
+        const SkinnedVertexStreams actualStreams = MakeOutputStreams(actual.data());
+
+        const std::pair<size_t, size_t> ranges[] = {
+            {0, 13}, {3, 29}, {16, 80}, {8, 315}, {VertexCount - 21, VertexCount}};
+        const char* const streamNames[] = {"positions", "normals", "tangents"};
+
+        for (const SkinningMethod method : {SkinningMethod::Linear, SkinningMethod::DualQuaternion})
+        {
+            for (const auto& [begin, end] : ranges)
+            {
+                std::ranges::fill(expected, Untouched);
+                std::ranges::fill(actual, Untouched);
+                if (method == SkinningMethod::Linear)
+                {
+                    GenericSkinningKernels.SkinLinear(streams, begin, end, palette.data(), expectedStreams);
+                    Avx2SkinningKernels.SkinLinear(streams, begin, end, palette.data(), actualStreams);
+                }
+                else
+                {
+                    GenericSkinningKernels.SkinDualQuaternion(streams, begin, end, dualQuaternions.data(),
+                                                              expectedStreams);
+                    Avx2SkinningKernels.SkinDualQuaternion(streams, begin, end, dualQuaternions.data(),
+                                                           actualStreams);
+                }
+
+                for (size_t stream = 0; stream < 3; ++stream)
+                {
+                    const size_t first = stream * 3 * VertexCount;
+                    const size_t last = first + 3 * VertexCount;
+
+                    float largest = 1.0f;
+                    for (size_t i = first; i < last; ++i)
+                    {
+                        if (expected[i] != Untouched)
+                        {
+                            largest = std::max(largest, std::abs(expected[i]));
+                        }
+                    }
+
+                    for (size_t i = first; i < last; ++i)
+                    {
+                        if (std::abs(actual[i] - expected[i]) > Tolerance * largest)
+                        {
+                            throw std::runtime_error(fmt::format(
+                                "{} {} skinning differs from {} in the {} of vertex {} when skinning {} to {}",
+                                Avx2SkinningKernels.Name, MethodName(method), GenericSkinningKernels.Name,
+                                streamNames[stream], (i - first) % VertexCount, begin, end));
+                        }
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    /// Output goes to preallocated planes standing in for a mapped upload buffer.
+    void AddSkinningBenchmark(BenchmarkRunner& runner, const SkinningMethod method, const uint32_t threadCount)
+    {
+        const auto name = fmt::format("Skinning/{} {}k vertices, {} threads", MethodName(method), VertexCount / 1000,
+                                      threadCount);
+
+        runner.Add(name, VertexCount, [method, threadCount] {
+            auto mesh = std::make_shared<SkinnedMesh>(MakeTube());
+            auto output = std::make_shared<std::vector<float>>(VertexCount * 9);
+            auto palette = MakePalette();
+
+            return [mesh, output, streams = MakeOutputStreams(output->data()), method, palette = std::move(palette),
+                    pool = std::make_shared<ThreadPool>(static_cast<int32_t>(threadCount) - 1),
+                    skinner = std::make_shared<CpuSkinner>()] {
+                skinner->Skin(mesh->Streams(), palette, method, streams, *pool);
+                DoNotOptimize(output->back());
+            };
+        });
+    }
+} // namespace
+
+/// Items are vertices, so vertices per millisecond is 1e6 divided by the reported ns/item.
+/// Thread counts above the hardware concurrency are skipped since they only measure oversubscription.
+void AddSkinningBenchmarks(BenchmarkRunner& runner)
+{
+#ifdef TRANSFORM_KERNELS_X64
+    runner.AddCheck("Skinning/Kernels", [] { ValidateSkinningKernels(MakeTube(), MakePalette()); });
+#endif
+
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (const SkinningMethod method : {SkinningMethod::Linear, SkinningMethod::DualQuaternion})
+    {
+        for (const uint32_t threadCount : {1u, 2u, 4u, 8u})
+        {
+            if (threadCount == 1 || threadCount <= hardwareThreads)
+            {
+                AddSkinningBenchmark(runner, method, threadCount);
+            }
+        }
+    }
+}
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "StreamingCopy.hpp"
+#include "UploadAllocator.hpp"
+
+namespace
+{
+    constexpr uint32_t FramesInFlight = 3;
+    constexpr uint32_t ConstantsPerFrame = 1024;
+    constexpr uint64_t ConstantSize = 256;
+
+    /// Pages in ordinary memory, with made up GPU addresses that keep the CPU offset, so
+    /// the allocator runs without a device.
+    class HostPageSource final : public UploadPageSource
+    {
+    public:
+        UploadPage CreatePage(const uint64_t size) override
+        {
+            const uint64_t alignedSize = (size + UploadAllocator::ConstantBufferAlignment - 1) &
+                                         ~(UploadAllocator::ConstantBufferAlignment - 1);
+            auto* memory = static_cast<uint8_t*>(::operator new(static_cast<size_t>(alignedSize), PageAlignment));
+            const uint64_t gpuAddress = m_nextGpuAddress;
+            m_nextGpuAddress += (alignedSize + 0xFFFF) & ~uint64_t{0xFFFF};
+            ++m_livePages;
+            return {memory, gpuAddress, size, memory};
+        }
+
+        void DestroyPage(const UploadPage& page) override
+        {
+            ::operator delete(page.Owner, PageAlignment);
+            --m_livePages;
+        }
+
+        [[nodiscard]] uint32_t LivePages() const
+        {
+            return m_livePages;
+        }
+
+    private:
+        static constexpr auto PageAlignment = std::align_val_t{UploadAllocator::ConstantBufferAlignment};
+
+        uint64_t m_nextGpuAddress = 0x10000;
+        uint32_t m_livePages = 0;
+    };
+
+    /// Allocator with its pages, as D3D12Context keeps them.
+    struct UploadState
+    {
+        HostPageSource  Source;
+        UploadAllocator Allocator{Source};
+        uint64_t        Fence = 0;
+    };
+
+    struct Slice
+    {
+        UploadAllocation Allocation;
+        uint8_t          Pattern;
+    };
+
+    /// @brief Runs frames whose fences complete a few frames late, each filling its slices with
+    /// a pattern, and checks that no slice changes before its frame has finished.
+    ///
+    /// Frame sizes vary and every tenth frame bursts, so the allocator has to grow, and the odd
+    /// slice is larger than a page.
+    /// @throws std::runtime_error on the first mismatch.
+    void Validate()
+    {
+        HostPageSource source;
+        {
+            UploadAllocator                allocator(source, 16 * 1024);
+            std::deque<std::vector<Slice>> inFlight;
+            std::mt19937                   random(ConstantsPerFrame);
+            uint64_t                       expectedHighWater = 0;
+
+            for (uint64_t fence = 1; fence <= 500; ++fence)
+            {
+                if (inFlight.size() == FramesInFlight)
+                {
+                    for (const Slice& slice : inFlight.front())
+                    {
+                        for (uint64_t i = 0; i < slice.Allocation.Size; ++i)
+                        {
+                            if (slice.Allocation.CpuAddress[i] != slice.Pattern)
+                            {
+                                throw std::runtime_error(fmt::format(
+                                    "Slice of frame {} was overwritten while in flight", fence - FramesInFlight));
+                            }
+                        }
+                    }
+                    inFlight.pop_front();
+                    allocator.BeginFrame(fence - FramesInFlight);
+                }
+
+                const uint32_t     count = fence % 10 == 0 ? 400 : 20 + random() % 60;
+                std::vector<Slice> slices;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const uint64_t size = i == 0 && fence % 25 == 0 ? 40000 : 16 + random() % 600;
+                    const Slice    slice = {allocator.Allocate(size), static_cast<uint8_t>(random())};
+                    if (slice.Allocation.GpuAddress % UploadAllocator::ConstantBufferAlignment != 0 ||
+                        slice.Allocation.CpuAddress == nullptr || slice.Allocation.Size != size)
+                    {
+                        throw std::runtime_error("Upload slice is misaligned or empty");
+                    }
+                    std::memset(slice.Allocation.CpuAddress, slice.Pattern, static_cast<size_t>(size));
+                    slices.push_back(slice);
+                }
+                inFlight.push_back(std::move(slices));
+
+                expectedHighWater = std::max(expectedHighWater, allocator.Stats().FrameBytes);
+                allocator.EndFrame(fence);
+                if (allocator.Stats().FrameBytes != 0 || allocator.Stats().HighWaterBytes != expectedHighWater)
+                {
+                    throw std::runtime_error("Upload frame counters are wrong");
+                }
+            }
+
+            if (allocator.Stats().Pages != source.LivePages())
+            {
+                throw std::runtime_error("Upload page count does not match the pages created");
+            }
+        }
+
+        if (source.LivePages() != 0)
+        {
+            throw std::runtime_error("Upload allocator leaked pages");
+        }
+    }
+} // namespace
+
+/// Items are constant buffer slices, each written like a draw's constants.
+void AddUploadBenchmarks(BenchmarkRunner& runner)
+{
+    runner.AddCheck("Upload/Frames in flight", Validate);
+
+    runner.Add(fmt::format("Upload/Constants {} per frame", ConstantsPerFrame), ConstantsPerFrame, [] {
+        auto state = std::make_shared<UploadState>();
+
+        return [state] {
+            const uint64_t fence = ++state->Fence;
+            if (fence > FramesInFlight)
+            {
+                state->Allocator.BeginFrame(fence - FramesInFlight);
+            }
+
+            alignas(16) uint8_t constants[ConstantSize] = {};
+            for (uint32_t i = 0; i < ConstantsPerFrame; ++i)
+            {
+                constants[0] = static_cast<uint8_t>(i);
+                const UploadAllocation allocation = state->Allocator.Allocate(ConstantSize);
+                StreamingCopy::Copy(allocation.CpuAddress, constants, ConstantSize);
+                DoNotOptimize(allocation.GpuAddress);
+            }
+            StreamingCopy::Fence();
+            state->Allocator.EndFrame(fence);
+        };
+    });
+}
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Matt Guerrette 2023-2025
+// SPDX-License-Identifier: MIT
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "Benchmark.hpp"
+#include "CpuFeatures.hpp"
+#include "TransformKernels.hpp"
+
+namespace
+{
+    struct Options
+    {
+        BenchmarkRunner::Settings Settings;
+        std::string               OutputPath;
+        std::string               BaselinePath;
+        double                    Tolerance = 0.10;
+        bool                      List = false;
+        bool                      Validate = false;
+    };
+
+    void PrintUsage()
+    {
+        fmt::print("Usage: bench_base [options]\n"
+                   "  --filter <text>       Run only benchmarks whose name contains text\n"
+                   "  --list                List benchmark names and exit\n"
+                   "  --validate            Run every correctness check once, without timing, and exit\n"
+                   "  --warmup-ms <ms>      Warmup time per benchmark (default 100)\n"
+                   "  --sample-ms <ms>      Minimum time per sample (default 2)\n"
+                   "  --samples <n>         Samples per benchmark (default 31)\n"
+                   "  --output <file>       Write results as JSON\n"
+                   "  --baseline <file>     Compare medians with a JSON file written by --output\n"
+                   "  --tolerance <ratio>   Allowed slowdown before a result counts as a regression (default 0.10)\n"
+                   "\n"
+                   "Set D3D12_SIMD_LEVEL to measure a narrower SIMD path than the CPU supports.\n");
+    }
+
+    bool ParseOptions(const int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string argument = argv[i];
+            const bool        hasValue = i + 1 < argc;
+            if (argument == "--list")
+            {
+                options.List = true;
+            }
+            else if (argument == "--validate")
+            {
+                options.Validate = true;
+            }
+            else if (argument == "--filter" && hasValue)
+            {
+                options.Settings.Filter = argv[++i];
+            }
+            else if (argument == "--warmup-ms" && hasValue)
+            {
+                options.Settings.WarmupMilliseconds = std::stod(argv[++i]);
+            }
+            else if (argument == "--sample-ms" && hasValue)
+            {
+                options.Settings.SampleMilliseconds = std::stod(argv[++i]);
+            }
+            else if (argument == "--samples" && hasValue)
+            {
+                options.Settings.Samples = static_cast<uint32_t>(std::stoul(argv[++i]));
+            }
+            else if (argument == "--output" && hasValue)
+            {
+                options.OutputPath = argv[++i];
+            }
+            else if (argument == "--baseline" && hasValue)
+            {
+                options.BaselinePath = argv[++i];
+            }
+            else if (argument == "--tolerance" && hasValue)
+            {
+                options.Tolerance = std::stod(argv[++i]);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    try
+    {
+        if (!ParseOptions(argc, argv, options))
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception&)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    BenchmarkRunner runner;
+    AddMathBenchmarks(runner);
+    AddPlatformBenchmarks(runner);
+    AddSceneBenchmarks(runner);
+    AddAnimationBenchmarks(runner);
+    AddSkinningBenchmarks(runner);
+    AddMorphBenchmarks(runner);
+    AddFrameGraphBenchmarks(runner);
+    AddDescriptorBenchmarks(runner);
+    AddUploadBenchmarks(runner);
+    AddCopyBenchmarks(runner);
+    AddCommandContextBenchmarks(runner);
+    AddCommandListBenchmarks(runner);
+    AddFenceTimelineBenchmarks(runner);
+    AddPipelineBenchmarks(runner);
+
+    if (options.List)
+    {
+        for (const std::string& name : runner.Names())
+        {
+            fmt::print("{}\n", name);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (options.Validate)
+    {
+        return runner.Validate() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    try
+    {
+        fmt::print("SIMD path: {} ({} kernels)\n\n", SimdLevelName(SelectedSimdLevel()), TransformKernels::PathName());
+
+        const std::vector<BenchmarkResult> results = runner.Run(options.Settings);
+        if (!options.OutputPath.empty())
+        {
+            BenchmarkRunner::WriteJson(results, options.OutputPath);
+        }
+
+        if (!options.BaselinePath.empty())
+        {
+            const auto     baseline = BenchmarkRunner::ReadBaseline(options.BaselinePath);
+            const uint32_t regressions = BenchmarkRunner::Compare(results, baseline, options.Tolerance);
+            if (regressions > 0)
+            {
+                fmt::print("\n{} benchmark(s) regressed by more than {:.0f}%\n", regressions,
+                           options.Tolerance * 100.0);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        fmt::print(stderr, "bench_base: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -3,13 +3,13 @@
 // SPDX-License-Identifier: MIT
 ////////////////////////////////////////////////////////////////////////////////
 
-#define CGLTF_IMPLEMENTATION
 #include <cgltf.h>
 
 #include <memory>
 
 #include "Example.hpp"
 #include "File.hpp"
+#include "StreamingCopy.hpp"
 
 #include <SDL3/SDL_main.h>
 
@@ -74,7 +74,7 @@ public:
 
     void Update(const GameTimer& timer) override;
 
-    void Render(ID3D12GraphicsCommandList* commandList, const GameTimer& timer) override;
+    void Render(CommandContext& context, const GameTimer& timer) override;
 
 private:
     void CreateRootSignature();
@@ -86,22 +86,19 @@ private:
     void UpdateUniforms();
 
     winrt::com_ptr<ID3D12RootSignature>  m_rootSignature;
-    winrt::com_ptr<ID3D12PipelineState>  m_pipelineState;
+    PipelineKey                          m_pipeline;
     winrt::com_ptr<ID3D12Resource>       m_vertexBuffer;
     winrt::com_ptr<ID3D12Resource>       m_indexBuffer;
-    winrt::com_ptr<ID3D12DescriptorHeap> m_cbvDescriptorHeap;
-    D3D12_VERTEX_BUFFER_VIEW             m_vertexBufferView;
-    D3D12_INDEX_BUFFER_VIEW              m_indexBufferView;
-    winrt::com_ptr<ID3D12Resource>       m_constBuffer;
+    VertexBufferView                     m_vertexBufferView;
+    IndexBufferView                      m_indexBufferView;
     SceneConstantBuffer                  m_constBufferData;
-    UINT8*                               m_constBufferDataBegin;
     float                                m_rotationY = 0.0f;
     float                                m_rotationX = 0.0f;
     float                                m_cubeRotationY = 0.0f;
 };
 
 HelloMesh::HelloMesh(bool fullscreen)
-    : Example("Hello, Mesh", 800, 600, fullscreen), m_vertexBufferView(), m_constBufferDataBegin(nullptr)
+    : Example("Hello, Mesh", 800, 600, fullscreen), m_vertexBufferView()
 {
 }
 
@@ -109,13 +106,6 @@ HelloMesh::~HelloMesh() = default;
 
 bool HelloMesh::Load()
 {
-    D3D12_DESCRIPTOR_HEAP_DESC cbvDescriptorHeapDesc = {};
-    cbvDescriptorHeapDesc.NumDescriptors = 1;
-    cbvDescriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-    cbvDescriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    winrt::check_hresult(
-        m_context->Device()->CreateDescriptorHeap(&cbvDescriptorHeapDesc, IID_PPV_ARGS(&m_cbvDescriptorHeap)));
-
     CreateRootSignature();
 
     CreateBuffers();
@@ -144,31 +134,37 @@ void HelloMesh::Update(const GameTimer& timer)
     m_cubeRotationY += elapsed;
 }
 
-void HelloMesh::Render(ID3D12GraphicsCommandList* commandList, const GameTimer& timer)
+void HelloMesh::Render(CommandContext& context, const GameTimer& timer)
 {
     UpdateUniforms();
 
-    // Set the root signature
-    commandList->SetGraphicsRootSignature(m_rootSignature.get());
+    // Nothing is drawn until a worker has compiled the pipeline
+    ID3D12PipelineState* pipelineState = m_pipelines->Get(m_pipeline);
+    if (pipelineState == nullptr)
+    {
+        return;
+    }
 
-    ID3D12DescriptorHeap* heaps[] = {m_cbvDescriptorHeap.get()};
-    commandList->SetDescriptorHeaps(_countof(heaps), heaps);
+    // Set the root signature
+    context.SetGraphicsRootSignature(m_rootSignature.get());
 
-    commandList->SetGraphicsRootDescriptorTable(0, m_cbvDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+    // Copy the constants of this frame to memory the frames still in flight do not read
+    const UploadAllocation constants = m_context->Uploads().Upload(m_constBufferData);
+    context.SetGraphicsRootConstantBufferView(0, constants.GpuAddress);
 
     // Set the pipeline state
-    commandList->SetPipelineState(m_pipelineState.get());
+    context.SetPipelineState(pipelineState);
 
     // Set the primitive topology
-    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     // Set the vertex buffer
-    commandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
+    context.IASetVertexBuffers(0, 1, &m_vertexBufferView);
     // Set the index buffer
-    commandList->IASetIndexBuffer(&m_indexBufferView);
+    context.IASetIndexBuffer(&m_indexBufferView);
 
     // Draw indexed geometry
-    commandList->DrawIndexedInstanced(36, 1, 0, 0, 0);
+    context.DrawIndexedInstanced(36, 1, 0, 0, 0);
 }
 
 void HelloMesh::UpdateUniforms()
@@ -190,7 +186,6 @@ void HelloMesh::UpdateUniforms()
     Matrix model = scale * rotation * translation;
 
     m_constBufferData.ModelViewProjection = model * m_camera->viewProjection();
-    memcpy(m_constBufferDataBegin, &m_constBufferData, sizeof(m_constBufferData));
 }
 
 void HelloMesh::CreateRootSignature()
@@ -204,10 +199,9 @@ void HelloMesh::CreateRootSignature()
         featureData.HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_0;
     }
 
-    CD3DX12_DESCRIPTOR_RANGE1 ranges[1];
-    CD3DX12_ROOT_PARAMETER1   rootParams[1];
-    ranges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 0, 0, D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC);
-    rootParams[0].InitAsDescriptorTable(1, &ranges[0], D3D12_SHADER_VISIBILITY_VERTEX);
+    CD3DX12_ROOT_PARAMETER1 rootParams[1];
+    rootParams[0].InitAsConstantBufferView(0, 0, D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE,
+                                           D3D12_SHADER_VISIBILITY_VERTEX);
 
     // Allow input layout and deny unnecessary access to certain pipeline stages.
     constexpr D3D12_ROOT_SIGNATURE_FLAGS rootSignatureFlags =
@@ -224,14 +218,12 @@ void HelloMesh::CreateRootSignature()
     winrt::com_ptr<ID3DBlob> error;
     winrt::check_hresult(D3DX12SerializeVersionedRootSignature(&rootSignatureDesc, featureData.HighestVersion,
                                                                signature.put(), error.put()));
-    winrt::check_hresult(device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(),
-                                                     IID_PPV_ARGS(&m_rootSignature)));
+    m_rootSignature = GraphicsPipelineCache::CreateRootSignature(device, signature->GetBufferPointer(),
+                                                                 signature->GetBufferSize());
 }
 
 void HelloMesh::CreatePipelineState()
 {
-    ID3D12Device* device = m_context->Device();
-
     // Define the vertex input layout.
     D3D12_INPUT_ELEMENT_DESC inputElementDesc[] = {
         {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
@@ -269,7 +261,7 @@ void HelloMesh::CreatePipelineState()
     psoDesc.NumRenderTargets = 1;
     psoDesc.RTVFormats[0] = m_context->BackBufferFormat();
     psoDesc.SampleDesc.Count = 1;
-    winrt::check_hresult(device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&m_pipelineState)));
+    m_pipeline = m_pipelines->Request(psoDesc);
 }
 
 void HelloMesh::CreateBuffers()
@@ -334,7 +326,7 @@ void HelloMesh::CreateBuffers()
     UINT8*              vertexDataBegin;
     const CD3DX12_RANGE readRange(0, 0);
     winrt::check_hresult(m_vertexBuffer->Map(0, &readRange, reinterpret_cast<void**>(&vertexDataBegin)));
-    memcpy(vertexDataBegin, cubeVertices, sizeof(cubeVertices));
+    StreamingCopy::Copy(vertexDataBegin, cubeVertices, sizeof(cubeVertices));
     m_vertexBuffer->Unmap(0, nullptr);
 
     m_vertexBufferView.BufferLocation = m_vertexBuffer->GetGPUVirtualAddress();
@@ -351,33 +343,11 @@ void HelloMesh::CreateBuffers()
     // Copy cube index data to index buffer
     UINT8* indexDataBegin;
     winrt::check_hresult(m_indexBuffer->Map(0, &readRange, reinterpret_cast<void**>(&indexDataBegin)));
-    memcpy(indexDataBegin, cubeIndices, sizeof(cubeIndices));
+    StreamingCopy::Copy(indexDataBegin, cubeIndices, sizeof(cubeIndices));
     m_indexBuffer->Unmap(0, nullptr);
     m_indexBufferView.BufferLocation = m_indexBuffer->GetGPUVirtualAddress();
     m_indexBufferView.Format = DXGI_FORMAT_R16_UINT;
     m_indexBufferView.SizeInBytes = indexBufferSize;
-
-    // Create the constant buffer.
-    {
-        constexpr UINT constantBufferSize = sizeof(SceneConstantBuffer); // CB size is required to be 256-byte aligned.
-
-        const auto cbHeapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-        const auto cbHeapDesc = CD3DX12_RESOURCE_DESC::Buffer(constantBufferSize);
-        winrt::check_hresult(device->CreateCommittedResource(&cbHeapProps, D3D12_HEAP_FLAG_NONE, &cbHeapDesc,
-                                                             D3D12_RESOURCE_STATE_COMMON, nullptr,
-                                                             IID_PPV_ARGS(&m_constBuffer)));
-
-        // Describe and create a constant buffer view.
-        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc;
-        cbvDesc.BufferLocation = m_constBuffer->GetGPUVirtualAddress();
-        cbvDesc.SizeInBytes = constantBufferSize;
-        device->CreateConstantBufferView(&cbvDesc, m_cbvDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
-
-        // Map and initialize the constant buffer. We don't unmap this until the
-        // app closes. Keeping things mapped for the lifetime of the resource is okay
-        winrt::check_hresult(m_constBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_constBufferDataBegin)));
-        memcpy(m_constBufferDataBegin, &m_constBufferData, sizeof(m_constBufferData));
-    }
 }
 
 int main(const int argc, char** argv)
@@ -41,13 +41,8 @@ void Texture::Upload(ID3D12Device* device, ID3D12CommandQueue* commandQueue)
     finish.wait();
 }
 
-void Texture::AddToDescriptorHeap(ID3D12Device* device, ID3D12DescriptorHeap* descriptorHeap, size_t index)
+void Texture::AddToDescriptorHeap(BindlessResources& bindless)
 {
-    m_srvDescriptorHeap = descriptorHeap;
-
-    CD3DX12_CPU_DESCRIPTOR_HANDLE hDescriptor(
-        descriptorHeap->GetCPUDescriptorHandleForHeapStart(), index,
-        device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
     srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
     srvDesc.Format = ConvertColorspace(m_resource->GetDesc().Format);
@@ -55,11 +50,10 @@ void Texture::AddToDescriptorHeap(ID3D12Device* device, ID3D12DescriptorHeap* de
     srvDesc.Texture2D.MostDetailedMip = 0;
     srvDesc.Texture2D.MipLevels = m_resource->GetDesc().MipLevels;
     srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-    device->CreateShaderResourceView(m_resource.get(), &srvDesc, hDescriptor);
+    m_srv = bindless.CreateShaderResourceView(m_resource.get(), &srvDesc);
 }
 
-void Texture::Bind(ID3D12GraphicsCommandList* commandList)
+BindlessHandle Texture::ShaderResourceView() const
 {
-    CD3DX12_GPU_DESCRIPTOR_HANDLE hDescriptor(m_srvDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
-    commandList->SetGraphicsRootDescriptorTable(0, hDescriptor);
+    return m_srv;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <directx/d3dx12.h>
 #include <winrt/base.h>
 
+#include "BindlessResources.hpp"
 #include "File.hpp"
 
 class Texture
@@ -13,11 +14,11 @@ public:
     explicit Texture(const std::string& filename);
 
     void Upload(ID3D12Device* device, ID3D12CommandQueue* commandQueue);
-    void AddToDescriptorHeap(ID3D12Device* device, ID3D12DescriptorHeap* descriptorHeap, size_t index);
-    void Bind(ID3D12GraphicsCommandList* commandList);
+    void AddToDescriptorHeap(BindlessResources& bindless);
+    [[nodiscard]] BindlessHandle ShaderResourceView() const;
 
 private:
     std::vector<uint8_t>           m_data;
     winrt::com_ptr<ID3D12Resource> m_resource;
-    ID3D12DescriptorHeap*          m_srvDescriptorHeap;
+    BindlessHandle                 m_srv;
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "Example.hpp"
 #include "File.hpp"
+#include "StreamingCopy.hpp"
 #include "Texture.hpp"
 
 #include <SDL3/SDL_main.h>
@@ -40,6 +41,12 @@ XM_ALIGNED_STRUCT(256) SceneConstantBuffer
     float  Time;
 };
 
+/// Bindless indices of one draw, matching DrawIndices in SimpleShader.hlsl.
+struct DrawIndices
+{
+    uint32_t Texture;
+};
+
 class HelloTexture final : public Example
 {
 public:
@@ -53,7 +60,7 @@ public:
 
     void Update(const GameTimer& timer) override;
 
-    void Render(ID3D12GraphicsCommandList* commandList, const GameTimer& timer) override;
+    void Render(CommandContext& context, const GameTimer& timer) override;
 
 private:
     void CreateRootSignature();
@@ -67,17 +74,14 @@ private:
     void UpdateUniforms(float deltaTime);
 
     winrt::com_ptr<ID3D12RootSignature>   m_rootSignature;
-    winrt::com_ptr<ID3D12PipelineState>   m_pipelineState;
+    PipelineKey                           m_pipeline;
     winrt::com_ptr<ID3D12Resource>        m_vertexBuffer;
     winrt::com_ptr<ID3D12Resource>        m_indexBuffer;
-    winrt::com_ptr<ID3D12DescriptorHeap>  m_srvDescriptorHeap;
     std::vector<std::unique_ptr<Texture>> m_textures;
     // winrt::com_ptr<ID3D12Resource>       m_texture;
-    D3D12_VERTEX_BUFFER_VIEW              m_vertexBufferView{};
-    D3D12_INDEX_BUFFER_VIEW               m_indexBufferView{};
-    winrt::com_ptr<ID3D12Resource>        m_constBuffer;
+    VertexBufferView                      m_vertexBufferView{};
+    IndexBufferView                       m_indexBufferView{};
     SceneConstantBuffer                   m_constBufferData{};
-    UINT8*                                m_constBufferDataBegin{};
     float                                 m_rotationY = 0.0f;
     float                                 m_rotationX = 0.0f;
     float                                 m_cubeRotationY = 0.0f;
@@ -100,17 +104,10 @@ bool HelloTexture::Load()
     m_textures.push_back(std::make_unique<Texture>("dirt.dds"));
     m_textures.push_back(std::make_unique<Texture>("bricks.dds"));
 
-    D3D12_DESCRIPTOR_HEAP_DESC srvDescriptorHeapDesc = {};
-    srvDescriptorHeapDesc.NumDescriptors = m_textures.size();
-    srvDescriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-    srvDescriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    winrt::check_hresult(
-        m_context->Device()->CreateDescriptorHeap(&srvDescriptorHeapDesc, IID_PPV_ARGS(&m_srvDescriptorHeap)));
-
-    for (uint32_t i = 0; i < m_textures.size(); ++i)
+    for (const auto& texture : m_textures)
     {
-        m_textures[i]->Upload(m_context->Device(), m_context->CommandQueue());
-        m_textures[i]->AddToDescriptorHeap(m_context->Device(), m_srvDescriptorHeap.get(), i);
+        texture->Upload(m_context->Device(), m_context->CommandQueue());
+        texture->AddToDescriptorHeap(m_context->Bindless());
     }
 
     SDL_HideCursor();
@@ -135,39 +132,44 @@ void HelloTexture::Update(const GameTimer& timer)
     m_cubeRotationY += elapsed;
 }
 
-void HelloTexture::Render(ID3D12GraphicsCommandList* commandList, const GameTimer& timer)
+void HelloTexture::Render(CommandContext& context, const GameTimer& timer)
 {
     const auto elapsed = static_cast<float>(timer.GetElapsedSeconds());
 
     UpdateUniforms(elapsed);
 
-    // Set the root signature
-    commandList->SetGraphicsRootSignature(m_rootSignature.get());
+    // Nothing is drawn until a worker has compiled the pipeline
+    ID3D12PipelineState* pipelineState = m_pipelines->Get(m_pipeline);
+    if (pipelineState == nullptr)
+    {
+        return;
+    }
 
-    ID3D12DescriptorHeap* heaps[] = {m_srvDescriptorHeap.get()};
-    commandList->SetDescriptorHeaps(_countof(heaps), heaps);
+    // Bind the descriptor heap and the root signature that indexes it
+    const BindlessResources& bindless = m_context->Bindless();
+    bindless.Bind(context, m_rootSignature.get());
 
-    CD3DX12_GPU_DESCRIPTOR_HANDLE tex(
-        m_srvDescriptorHeap->GetGPUDescriptorHandleForHeapStart(), 1,
-        m_context->Device()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
-    commandList->SetGraphicsRootDescriptorTable(0, tex);
+    // Pass the views of the draw
+    const DrawIndices indices = {bindless.Index(m_textures[1]->ShaderResourceView())};
+    context.SetGraphicsRoot32BitConstants(BindlessResources::DrawConstantsParameter, sizeof(indices) / 4, &indices, 0);
 
     // Set the constant buffer view (For scene data such as camera and timing)
-    commandList->SetGraphicsRootConstantBufferView(1, m_constBuffer->GetGPUVirtualAddress());
+    const UploadAllocation constants = m_context->Uploads().Upload(m_constBufferData);
+    context.SetGraphicsRootConstantBufferView(BindlessResources::FrameConstantsParameter, constants.GpuAddress);
 
     // Set the pipeline state
-    commandList->SetPipelineState(m_pipelineState.get());
+    context.SetPipelineState(pipelineState);
 
     // Set the primitive topology
-    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     // Set the vertex buffer
-    commandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
+    context.IASetVertexBuffers(0, 1, &m_vertexBufferView);
     // Set the index buffer
-    commandList->IASetIndexBuffer(&m_indexBufferView);
+    context.IASetIndexBuffer(&m_indexBufferView);
 
     // Draw indexed geometry
-    commandList->DrawIndexedInstanced(36, 1, 0, 0, 0);
+    context.DrawIndexedInstanced(36, 1, 0, 0, 0);
 }
 
 void HelloTexture::UpdateUniforms(float deltaTime)
@@ -193,51 +195,17 @@ void HelloTexture::UpdateUniforms(float deltaTime)
     m_constBufferData.ModelViewProjection = model * m_camera->viewProjection();
     m_constBufferData.DeltaTime = deltaTime;
     m_constBufferData.Time += deltaTime;
-    memcpy(m_constBufferDataBegin, &m_constBufferData, sizeof(m_constBufferData));
 }
 
 void HelloTexture::CreateRootSignature()
 {
-    ID3D12Device* device = m_context->Device();
-
-    D3D12_FEATURE_DATA_ROOT_SIGNATURE featureData;
-    featureData.HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_1;
-    if (FAILED(device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &featureData, sizeof(featureData))))
-    {
-        featureData.HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_0;
-    }
-
-    CD3DX12_DESCRIPTOR_RANGE1 ranges[1];
-    ranges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0);
-
-    CD3DX12_ROOT_PARAMETER1 rootParams[2];
-    rootParams[0].InitAsDescriptorTable(1, &ranges[0], D3D12_SHADER_VISIBILITY_PIXEL);
-    rootParams[1].InitAsConstantBufferView(0, 0, D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC,
-                                           D3D12_SHADER_VISIBILITY_VERTEX);
-
-    // Allow input layout and deny unnecessary access to certain pipeline stages.
-    constexpr D3D12_ROOT_SIGNATURE_FLAGS rootSignatureFlags =
-        D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT |
-        D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS |
-        D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS |
-        D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS;
-
-    CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
-    rootSignatureDesc.Init_1_1(_countof(rootParams), rootParams, m_context->Samplers().size(),
-                               m_context->Samplers().data(), rootSignatureFlags);
-
-    winrt::com_ptr<ID3DBlob> signature;
-    winrt::com_ptr<ID3DBlob> error;
-    winrt::check_hresult(D3DX12SerializeVersionedRootSignature(&rootSignatureDesc, featureData.HighestVersion,
-                                                               signature.put(), error.put()));
-    winrt::check_hresult(device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(),
-                                                     IID_PPV_ARGS(&m_rootSignature)));
+    const auto samplers = m_context->Samplers();
+    m_rootSignature = m_context->Bindless().CreateRootSignature(sizeof(DrawIndices) / 4,
+                                                                static_cast<UINT>(samplers.size()), samplers.data());
 }
 
 void HelloTexture::CreatePipelineState()
 {
-    ID3D12Device* device = m_context->Device();
-
     // Define the vertex input layout.
     D3D12_INPUT_ELEMENT_DESC inputElementDesc[] = {
         {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
@@ -278,7 +246,7 @@ void HelloTexture::CreatePipelineState()
     psoDesc.NumRenderTargets = 1;
     psoDesc.RTVFormats[0] = m_context->BackBufferFormat();
     psoDesc.SampleDesc.Count = 1;
-    winrt::check_hresult(device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&m_pipelineState)));
+    m_pipeline = m_pipelines->Request(psoDesc);
 }
 
 void HelloTexture::CreateBuffers()
@@ -343,7 +311,7 @@ void HelloTexture::CreateBuffers()
     UINT8*              vertexDataBegin;
     const CD3DX12_RANGE readRange(0, 0);
     winrt::check_hresult(m_vertexBuffer->Map(0, &readRange, reinterpret_cast<void**>(&vertexDataBegin)));
-    memcpy(vertexDataBegin, cubeVertices, sizeof(cubeVertices));
+    StreamingCopy::Copy(vertexDataBegin, cubeVertices, sizeof(cubeVertices));
     m_vertexBuffer->Unmap(0, nullptr);
 
     m_vertexBufferView.BufferLocation = m_vertexBuffer->GetGPUVirtualAddress();
@@ -360,27 +328,11 @@ void HelloTexture::CreateBuffers()
     // Copy cube index data to index buffer
     UINT8* indexDataBegin;
     winrt::check_hresult(m_indexBuffer->Map(0, &readRange, reinterpret_cast<void**>(&indexDataBegin)));
-    memcpy(indexDataBegin, cubeIndices, sizeof(cubeIndices));
+    StreamingCopy::Copy(indexDataBegin, cubeIndices, sizeof(cubeIndices));
     m_indexBuffer->Unmap(0, nullptr);
     m_indexBufferView.BufferLocation = m_indexBuffer->GetGPUVirtualAddress();
     m_indexBufferView.Format = DXGI_FORMAT_R16_UINT;
     m_indexBufferView.SizeInBytes = indexBufferSize;
-
-    // Create the constant buffer.
-    {
-        constexpr UINT constantBufferSize = sizeof(SceneConstantBuffer); // CB size is required to be 256-byte aligned.
-
-        const auto cbHeapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-        const auto cbHeapDesc = CD3DX12_RESOURCE_DESC::Buffer(constantBufferSize);
-        winrt::check_hresult(device->CreateCommittedResource(&cbHeapProps, D3D12_HEAP_FLAG_NONE, &cbHeapDesc,
-                                                             D3D12_RESOURCE_STATE_COMMON, nullptr,
-                                                             IID_PPV_ARGS(&m_constBuffer)));
-
-        //// Map and initialize the constant buffer. We don't unmap this until the
-        //// app closes. Keeping things mapped for the lifetime of the resource is okay
-        winrt::check_hresult(m_constBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_constBufferDataBegin)));
-        memcpy(m_constBufferDataBegin, &m_constBufferData, sizeof(m_constBufferData));
-    }
 }
 
 void HelloTexture::LoadTexture()